@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2006-11-01
-// Last changed: 2012-12-12
+// Last changed: 2026-10-18
 
 #include <dolfin.h>
 
@@ -34,6 +34,7 @@ int main(int argc, char* argv[])
 
   UnitCubeMesh mesh(SIZE, SIZE, SIZE);
 
+  // Iterate using mesh entity iterators
   std::size_t sum = 0;
   tic();
   for (int i = 0; i < NUM_REPS; i++)
@@ -42,10 +43,54 @@ int main(int argc, char* argv[])
       for (VertexIterator v(*c); !v.end(); ++v)
         sum += v->index();
   }
-  info("BENCH %g", toc());
+  const double t_iterator = toc();
 
-  // To prevent optimizing the loop away
-  info("Sum is %llu", (unsigned long long)sum);
+  // Iterate using entity ranges
+  std::size_t sum_range = 0;
+  tic();
+  for (int i = 0; i < NUM_REPS; i++)
+  {
+    const EntityRange cells(mesh, mesh.topology().dim());
+    const MeshConnectivity& cell_vertices = cells.connectivity(0);
+    for (std::size_t c : cells)
+      for (std::size_t j = 0; j < cell_vertices.size(c); ++j)
+        sum_range += cell_vertices(c)[j];
+  }
+  const double t_range = toc();
+
+  // Get cell coordinates using both approaches
+  std::vector<double> coordinate_dofs;
+  double sum_x = 0.0;
+  tic();
+  for (CellIterator c(mesh); !c.end(); ++c)
+  {
+    c->get_coordinate_dofs(coordinate_dofs);
+    sum_x += coordinate_dofs[0];
+  }
+  const double t_coordinates_iterator = toc();
+
+  double sum_x_range = 0.0;
+  tic();
+  {
+    const EntityRange cells(mesh, mesh.topology().dim());
+    const MeshConnectivity& cell_vertices = cells.connectivity(0);
+    for (std::size_t c : cells)
+    {
+      cells.get_coordinate_dofs(c, cell_vertices, coordinate_dofs);
+      sum_x_range += coordinate_dofs[0];
+    }
+  }
+  const double t_coordinates_range = toc();
+
+  info("BENCH %g", t_iterator);
+  info("BENCH iterator %g", t_iterator);
+  info("BENCH range %g", t_range);
+  info("BENCH coordinates-iterator %g", t_coordinates_iterator);
+  info("BENCH coordinates-range %g", t_coordinates_range);
+
+  // To prevent optimizing the loops away
+  info("Sum is %llu (%llu), %g (%g)", (unsigned long long)sum,
+       (unsigned long long)sum_range, sum_x, sum_x_range);
 
   return 0;
 }
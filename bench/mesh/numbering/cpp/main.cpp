@@ -0,0 +1,83 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Weak scaling benchmark for the global numbering of edges and
+// facets of a distributed mesh. Run with mpirun on increasing numbers
+// of processes; the mesh size grows with the number of processes so
+// that the number of cells per process is fixed.
+
+#include <cmath>
+#include <dolfin.h>
+
+using namespace dolfin;
+
+#define NUM_REPS 5
+#define SIZE 32
+
+// Use for quick testing
+//#define NUM_REPS 2
+//#define SIZE 16
+
+int main(int argc, char* argv[])
+{
+  parameters.parse(argc, argv);
+
+  // Scale mesh with number of processes
+  const int num_processes = dolfin::MPI::size(MPI_COMM_WORLD);
+  const int n = std::lround(SIZE*std::cbrt(num_processes));
+
+  info("Numbering edges and facets of unit cube of size %d x %d x %d on %d processes (%d repetitions)",
+       n, n, n, num_processes, NUM_REPS);
+
+  UnitCubeMesh mesh(n, n, n);
+  const int D = mesh.topology().dim();
+
+  for (int d : {1, D - 1})
+  {
+    const std::string name = "Number entities dim = " + std::to_string(d);
+    int num_global_entities = 0;
+    for (int i = 0; i < NUM_REPS; i++)
+    {
+      // Number entities of a copy, discarding any global numbering
+      // computed when the mesh was built (facets)
+      Mesh m(mesh);
+      m.init(d);
+      m.topology().init_global_indices(d, 0);
+      dolfin::MPI::barrier(m.mpi_comm());
+      {
+        Timer t(name);
+        m.init_global(d);
+      }
+      num_global_entities = m.num_entities_global(d);
+    }
+    info("Numbered %d entities of dimension %d", num_global_entities, d);
+  }
+
+  // Report timings
+  list_timings(TimingClear::keep, { TimingType::wall });
+
+  // Report maximum timing over processes per entity dimension
+  for (int d : {1, D - 1})
+  {
+    const auto t = timing("Number entities dim = " + std::to_string(d),
+                          TimingClear::clear);
+    info("BENCH numbering-%d %g", d,
+         dolfin::MPI::max(MPI_COMM_WORLD, std::get<1>(t)/NUM_REPS));
+  }
+
+  return 0;
+}
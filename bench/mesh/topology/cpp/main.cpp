@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2010-11-25
-// Last changed: 2012-12-12
+// Last changed: 2026-10-18
 
 #include <dolfin.h>
 #include <dolfin/log/LogLevel.h>
@@ -32,7 +32,7 @@ using namespace dolfin;
 
 int main(int argc, char* argv[])
 {
-  info("Creating cell-cell connectivity for unit cube of size %d x %d x %d (%d repetitions)",
+  info("Creating entities and cell-cell connectivity for unit cube of size %d x %d x %d (%d repetitions)",
        SIZE, SIZE, SIZE, NUM_REPS);
 
   set_log_level(DBG);
@@ -53,6 +53,19 @@ int main(int argc, char* argv[])
     dolfin::cout << "Created unit cube: " << mesh << dolfin::endl;
   }
 
+  // Compute entities of each dimension from scratch
+  for (int d = 1; d < D; d++)
+  {
+    const std::string name = "Compute entities dim = " + std::to_string(d);
+    { Timer t(name); }
+    timing(name, TimingClear::clear);
+    for (int i = 0; i < NUM_REPS; i++)
+    {
+      mesh.clean();
+      mesh.init(d);
+    }
+  }
+
   // Report timings
   list_timings(TimingClear::keep,
                { TimingType::wall, TimingType::user, TimingType::system });
@@ -61,5 +74,14 @@ int main(int argc, char* argv[])
   const auto t = timing("Compute connectivity 3-3", TimingClear::clear);
   info("BENCH %g", std::get<1>(t));
 
+  // Report timing per entity dimension (number of threads set by
+  // --num_threads)
+  for (int d = 1; d < D; d++)
+  {
+    const auto t = timing("Compute entities dim = " + std::to_string(d),
+                          TimingClear::clear);
+    info("BENCH entities-%d %g", d, std::get<1>(t));
+  }
+
   return 0;
 }
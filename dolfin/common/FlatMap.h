@@ -0,0 +1,247 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __DOLFIN_FLAT_MAP_H
+#define __DOLFIN_FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfin
+{
+
+  /// This is a map-like data structure. It stores (key, value) pairs
+  /// in a std::vector sorted by key, and looks up keys by binary
+  /// search. Compared to std::map it uses much less memory and is
+  /// faster to iterate over. Inserting a key that is larger than all
+  /// keys in the map is O(1), but inserting in the middle is O(n), so
+  /// unordered data should be added in bulk with update().
+
+  template<typename Key, typename Value>
+  class FlatMap
+  {
+  public:
+
+    /// Key type
+    typedef Key key_type;
+    /// Mapped type
+    typedef Value mapped_type;
+    /// Type of stored entries
+    typedef std::pair<Key, Value> value_type;
+    /// Size type
+    typedef std::size_t size_type;
+    /// Iterator
+    typedef typename std::vector<value_type>::iterator iterator;
+    /// Const iterator
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    /// Create empty map
+    FlatMap() {}
+
+    /// Find entry with given key and return an iterator to the
+    /// entry, or end() if not found
+    iterator find(const Key& key)
+    {
+      iterator it = lower_bound(key);
+      return (it != _x.end() && it->first == key) ? it : _x.end();
+    }
+
+    /// Find entry with given key and return an iterator to the
+    /// entry, or end() if not found (const)
+    const_iterator find(const Key& key) const
+    {
+      const_iterator it = lower_bound(key);
+      return (it != _x.end() && it->first == key) ? it : _x.end();
+    }
+
+    /// Return number of entries with given key (0 or 1)
+    std::size_t count(const Key& key) const
+    { return find(key) == _x.end() ? 0 : 1; }
+
+    /// Insert entry if its key is not present. Returns an iterator
+    /// to the entry with the key and true if the entry was inserted.
+    std::pair<iterator, bool> insert(const value_type& x)
+    {
+      if (_x.empty() || _x.back().first < x.first)
+      {
+        _x.push_back(x);
+        return {_x.end() - 1, true};
+      }
+
+      iterator it = lower_bound(x.first);
+      if (it->first == x.first)
+        return {it, false};
+      return {_x.insert(it, x), true};
+    }
+
+    /// Return reference to value with given key, inserting a
+    /// default value if the key is not present
+    Value& operator[](const Key& key)
+    { return insert(value_type(key, Value())).first->second; }
+
+    /// Return reference to value with given key. Throws
+    /// std::out_of_range if the key is not present (as std::map).
+    Value& at(const Key& key)
+    {
+      iterator it = find(key);
+      if (it == _x.end())
+        throw std::out_of_range("FlatMap::at");
+      return it->second;
+    }
+
+    /// Return reference to value with given key (const)
+    const Value& at(const Key& key) const
+    {
+      const_iterator it = find(key);
+      if (it == _x.end())
+        throw std::out_of_range("FlatMap::at");
+      return it->second;
+    }
+
+    /// Remove entry and return iterator to the following entry
+    iterator erase(const_iterator it)
+    { return _x.erase(it); }
+
+    /// Remove entry with given key, if present. Returns the number
+    /// of entries removed (0 or 1).
+    std::size_t erase(const Key& key)
+    {
+      iterator it = find(key);
+      if (it == _x.end())
+        return 0;
+      _x.erase(it);
+      return 1;
+    }
+
+    /// Insert or overwrite entries in bulk. Where a key appears more
+    /// than once in x, the last occurrence is used. The cost is
+    /// O(m log m + n) for m new and n existing entries.
+    void update(std::vector<value_type> x)
+    {
+      // Sort new entries by key, keeping the last of equal keys
+      std::stable_sort(x.begin(), x.end(),
+                       [](const value_type& a, const value_type& b)
+                       { return a.first < b.first; });
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < x.size(); ++i)
+      {
+        if (n > 0 && x[n - 1].first == x[i].first)
+          x[n - 1] = std::move(x[i]);
+        else
+          x[n++] = std::move(x[i]);
+      }
+      x.resize(n);
+
+      if (_x.empty())
+      {
+        _x = std::move(x);
+        return;
+      }
+
+      // Merge, with new entries taking precedence
+      std::vector<value_type> merged;
+      merged.reserve(_x.size() + x.size());
+      auto a = _x.begin();
+      auto b = x.begin();
+      while (a != _x.end() && b != x.end())
+      {
+        if (a->first < b->first)
+          merged.push_back(std::move(*a++));
+        else
+        {
+          if (!(b->first < a->first))
+            ++a;
+          merged.push_back(std::move(*b++));
+        }
+      }
+      merged.insert(merged.end(), std::make_move_iterator(a),
+                    std::make_move_iterator(_x.end()));
+      merged.insert(merged.end(), std::make_move_iterator(b),
+                    std::make_move_iterator(x.end()));
+      _x = std::move(merged);
+    }
+
+    /// Iterator to start of map
+    iterator begin()
+    { return _x.begin(); }
+
+    /// Iterator to beyond end of map
+    iterator end()
+    { return _x.end(); }
+
+    /// Iterator to start of map (const)
+    const_iterator begin() const
+    { return _x.begin(); }
+
+    /// Iterator to beyond end of map (const)
+    const_iterator end() const
+    { return _x.end(); }
+
+    /// Map size
+    std::size_t size() const
+    { return _x.size(); }
+
+    /// Return true if map is empty
+    bool empty() const
+    { return _x.empty(); }
+
+    /// Reserve storage for n entries
+    void reserve(std::size_t n)
+    { _x.reserve(n); }
+
+    /// Clear map
+    void clear()
+    { _x.clear(); }
+
+    /// Copy entries into a std::map, for code written against the
+    /// std::map interface
+    operator std::map<Key, Value>() const
+    { return std::map<Key, Value>(_x.begin(), _x.end()); }
+
+    /// Return the vector that stores the entries, sorted by key
+    const std::vector<value_type>& data() const
+    { return _x; }
+
+  private:
+
+    // First entry with key not less than given key
+    iterator lower_bound(const Key& key)
+    {
+      return std::lower_bound(_x.begin(), _x.end(), key,
+                              [](const value_type& a, const Key& k)
+                              { return a.first < k; });
+    }
+
+    // First entry with key not less than given key (const)
+    const_iterator lower_bound(const Key& key) const
+    {
+      return std::lower_bound(_x.begin(), _x.end(), key,
+                              [](const value_type& a, const Key& k)
+                              { return a.first < k; });
+    }
+
+    std::vector<value_type> _x;
+
+  };
+
+}
+
+#endif
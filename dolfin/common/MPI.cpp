@@ -24,9 +24,37 @@
 
 #include <numeric>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <utility>
 #include "SubSystemsManager.h"
+#include "Timer.h"
 #include "MPI.h"
 
+namespace
+{
+  // Number of calls, bytes sent and time spent in calls recorded by
+  // the profiler per (task, wrapper)
+  std::map<std::pair<std::string, std::string>, std::array<double, 3>>
+    profiler_records;
+
+  // Guards profiler_records, which wrappers called from several
+  // threads update concurrently
+  std::mutex profiler_mutex;
+
+  // Number of wrappers being recorded on this thread
+  thread_local int profiler_depth = 0;
+
+  // Return wall time in seconds
+  double profiler_time()
+  {
+    return std::chrono::duration<double>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+}
+
 //-----------------------------------------------------------------------------
 dolfin::MPI::Comm::Comm(MPI_Comm comm)
 {
@@ -119,6 +147,60 @@ MPI_Comm dolfin::MPI::Comm::comm() const
   return _comm;
 }
 //-----------------------------------------------------------------------------
+dolfin::MPI::NeighbourComm::NeighbourComm(MPI_Comm comm,
+                                          const std::vector<int>& neighbours)
+  : _neighbours(neighbours)
+{
+#ifdef HAS_MPI
+  const int err
+    = MPI_Dist_graph_create_adjacent(comm, _neighbours.size(),
+                                     _neighbours.data(), MPI_UNWEIGHTED,
+                                     _neighbours.size(), _neighbours.data(),
+                                     MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                                     &_comm);
+  if (err != MPI_SUCCESS)
+  {
+    dolfin::error("Creation of neighbourhood communicator failed "
+                  "(MPI_Dist_graph_create_adjacent)");
+  }
+#else
+  dolfin_assert(neighbours.empty());
+  _comm = comm;
+#endif
+}
+//-----------------------------------------------------------------------------
+dolfin::MPI::NeighbourComm::NeighbourComm(NeighbourComm&& comm)
+  : _neighbours(std::move(comm._neighbours)), _comm(comm._comm)
+{
+  comm._neighbours.clear();
+  comm._comm = MPI_COMM_NULL;
+}
+//-----------------------------------------------------------------------------
+dolfin::MPI::NeighbourComm::~NeighbourComm()
+{
+#ifdef HAS_MPI
+  if (_comm != MPI_COMM_NULL)
+    MPI_Comm_free(&_comm);
+#endif
+}
+//-----------------------------------------------------------------------------
+dolfin::MPI::NeighbourComm&
+dolfin::MPI::NeighbourComm::operator=(NeighbourComm&& comm)
+{
+  if (this != &comm)
+  {
+#ifdef HAS_MPI
+    if (_comm != MPI_COMM_NULL)
+      MPI_Comm_free(&_comm);
+#endif
+    _neighbours = std::move(comm._neighbours);
+    _comm = comm._comm;
+    comm._neighbours.clear();
+    comm._comm = MPI_COMM_NULL;
+  }
+  return *this;
+}
+//-----------------------------------------------------------------------------
 
 #ifdef HAS_MPI
 //-----------------------------------------------------------------------------
@@ -178,6 +260,7 @@ bool dolfin::MPI::is_receiver(const MPI_Comm comm)
 void dolfin::MPI::barrier(const MPI_Comm comm)
 {
 #ifdef HAS_MPI
+  Profiler profiler("barrier", 0);
   MPI_Barrier(comm);
 #endif
 }
@@ -186,6 +269,8 @@ std::size_t dolfin::MPI::global_offset(const MPI_Comm comm,
                                        std::size_t range, bool exclusive)
 {
 #ifdef HAS_MPI
+  Profiler profiler("global_offset", sizeof(std::size_t));
+
   // Compute inclusive or exclusive partial reduction
   std::size_t offset = 0;
   MPI_Scan(&range, &offset, 1, mpi_type<std::size_t>(), MPI_SUM, comm);
@@ -370,3 +455,178 @@ MPI_Op dolfin::MPI::MPI_AVG()
 }
 #endif
 //-----------------------------------------------------------------------------
+#ifdef HAS_MPI
+namespace
+{
+  // Duplicate communicator and sparse_all_to_all counter, attached to
+  // the parent communicator as an attribute
+  struct ExchangeComm
+  {
+    MPI_Comm comm;
+    std::size_t num_exchanges;
+  };
+
+  // Return the attribute of comm, which is created on first use
+  ExchangeComm* get_exchange_comm(MPI_Comm comm)
+  {
+    // Attribute key, with a delete callback that frees the duplicate
+    // when the parent communicator is freed
+    static const int keyval = []()
+    {
+      MPI_Comm_delete_attr_function* free_comm
+        = [](MPI_Comm, int, void* value, void*)
+      {
+        ExchangeComm* exchange_comm = static_cast<ExchangeComm*>(value);
+        MPI_Comm_free(&exchange_comm->comm);
+        delete exchange_comm;
+        return MPI_SUCCESS;
+      };
+      int key = MPI_KEYVAL_INVALID;
+      MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, free_comm, &key, NULL);
+      return key;
+    }();
+
+    void* value = NULL;
+    int found = 0;
+    MPI_Comm_get_attr(comm, keyval, &value, &found);
+    ExchangeComm* exchange_comm = static_cast<ExchangeComm*>(value);
+    if (!found)
+    {
+      exchange_comm = new ExchangeComm;
+      exchange_comm->num_exchanges = 0;
+      MPI_Comm_dup(comm, &exchange_comm->comm);
+      MPI_Comm_set_attr(comm, keyval, exchange_comm);
+    }
+
+    return exchange_comm;
+  }
+}
+//-----------------------------------------------------------------------------
+MPI_Comm dolfin::MPI::exchange_comm(MPI_Comm comm)
+{
+  return get_exchange_comm(comm)->comm;
+}
+//-----------------------------------------------------------------------------
+MPI_Comm dolfin::MPI::sparse_exchange_comm(MPI_Comm comm, int& tag)
+{
+  ExchangeComm* exchange_comm = get_exchange_comm(comm);
+  tag = exchange_comm->num_exchanges++ % 2;
+  return exchange_comm->comm;
+}
+#endif
+//-----------------------------------------------------------------------------
+bool dolfin::MPI::Profiler::_enabled = false;
+//-----------------------------------------------------------------------------
+void dolfin::MPI::Profiler::start(const char* operation,
+                                  std::size_t num_bytes)
+{
+  // Record outermost wrapper only
+  _operation = operation;
+  if (profiler_depth++ == 0)
+  {
+    _num_bytes = num_bytes;
+    _start = profiler_time();
+  }
+}
+//-----------------------------------------------------------------------------
+void dolfin::MPI::Profiler::stop()
+{
+  if (--profiler_depth == 0)
+  {
+    const double time = profiler_time() - _start;
+    std::lock_guard<std::mutex> lock(profiler_mutex);
+    std::array<double, 3>& record
+      = profiler_records.insert({{Timer::current_task(), _operation},
+                                 {{0.0, 0.0, 0.0}}}).first->second;
+    record[0] += 1.0;
+    record[1] += _num_bytes;
+    record[2] += time;
+  }
+}
+//-----------------------------------------------------------------------------
+dolfin::Table dolfin::MPI::Profiler::summary(MPI_Comm comm, bool clear)
+{
+  Table table("Summary of MPI communication");
+
+  // Pack local records, with keys separated by null characters
+  std::string keys;
+  std::vector<double> values;
+  {
+    std::lock_guard<std::mutex> lock(profiler_mutex);
+    for (const auto& record : profiler_records)
+    {
+      keys += record.first.first + '\0' + record.first.second + '\0';
+      values.insert(values.end(), record.second.begin(),
+                    record.second.end());
+    }
+    if (clear)
+      profiler_records.clear();
+  }
+
+  // Gather records on process 0, without recording the gathers
+  // (only outermost wrappers are recorded)
+  std::vector<std::string> all_keys;
+  std::vector<double> all_values;
+  ++profiler_depth;
+  gather(comm, keys, all_keys);
+  gather(comm, values, all_values);
+  --profiler_depth;
+
+  if (rank(comm) != 0)
+    return table;
+
+  // Collect records of each process per (task, wrapper)
+  const std::size_t num_processes = all_keys.size();
+  std::map<std::pair<std::string, std::string>,
+           std::vector<std::array<double, 3>>> records;
+  std::size_t pos = 0;
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    const std::string& k = all_keys[p];
+    std::size_t i = 0;
+    while (i < k.size())
+    {
+      const std::size_t j = k.find('\0', i);
+      const std::size_t l = k.find('\0', j + 1);
+      dolfin_assert(l != std::string::npos);
+      auto& process_records
+        = records[{k.substr(i, j - i), k.substr(j + 1, l - j - 1)}];
+      process_records.resize(num_processes, {{0.0, 0.0, 0.0}});
+      std::copy(all_values.begin() + pos, all_values.begin() + pos + 3,
+                process_records[p].begin());
+      pos += 3;
+      i = l + 1;
+    }
+  }
+
+  // Summarise over processes
+  for (const auto& record : records)
+  {
+    const std::string& task = record.first.first;
+    const std::string row = task.empty() ? record.first.second
+      : task + ": " + record.first.second;
+
+    double max_calls = 0.0, sum_bytes = 0.0, max_bytes = 0.0;
+    double sum_time = 0.0, max_time = 0.0;
+    double min_time = std::numeric_limits<double>::max();
+    for (const auto& r : record.second)
+    {
+      max_calls = std::max(max_calls, r[0]);
+      sum_bytes += r[1];
+      max_bytes = std::max(max_bytes, r[1]);
+      sum_time += r[2];
+      max_time = std::max(max_time, r[2]);
+      min_time = std::min(min_time, r[2]);
+    }
+
+    table(row, "calls") = static_cast<std::size_t>(max_calls);
+    table(row, "bytes avg") = sum_bytes/num_processes;
+    table(row, "bytes max") = max_bytes;
+    table(row, "time avg") = sum_time/num_processes;
+    table(row, "time max") = max_time;
+    table(row, "imbalance") = max_time - min_time;
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
@@ -122,6 +122,161 @@ namespace dolfin
       MPI_Comm _comm;
     };
 
+    /// Nonblocking exchange of data between processes when the
+    /// number of values each process receives from each other
+    /// process is already known, e.g. for replies to requests
+    /// received with sparse_all_to_all. Messages are only posted for
+    /// processes with data to send or receive, and local work can be
+    /// done between start() and wait().
+    template<typename T>
+    class NonblockingExchange
+    {
+    public:
+
+      /// Create exchange (call start() to begin communication)
+      NonblockingExchange() {}
+
+      /// Destructor (completes any pending communication)
+      ~NonblockingExchange();
+
+      // Not copyable, since pending requests refer to the buffers
+      NonblockingExchange(const NonblockingExchange&) = delete;
+      NonblockingExchange& operator=(const NonblockingExchange&) = delete;
+
+      /// Start sending in_values[p0] to process p0 and receiving
+      /// recv_sizes[p1] values from process p1 (collective). The
+      /// send buffers are taken over by the exchange, leaving
+      /// in_values empty.
+      void start(MPI_Comm comm, std::vector<std::vector<T>>& in_values,
+                 const std::vector<std::size_t>& recv_sizes);
+
+      /// Wait for the exchange to complete, and return the values
+      /// received from process p1 in entry p1
+      std::vector<std::vector<T>>& wait();
+
+    private:
+
+      // Send and receive buffers
+      std::vector<std::vector<T>> _send_values, _recv_values;
+
+      #ifdef HAS_MPI
+      // Pending requests
+      std::vector<MPI_Request> _requests;
+      #endif
+
+    };
+
+    /// Communicator for neighbourhood collectives between a process
+    /// and a list of neighbour processes, e.g. the processes that
+    /// share mesh vertices with it. The neighbour relation must be
+    /// symmetric. Wraps a distributed graph communicator
+    /// (MPI_Dist_graph_create_adjacent), which is freed on
+    /// destruction.
+    class NeighbourComm
+    {
+    public:
+
+      /// Create communicator (collective on comm)
+      NeighbourComm(MPI_Comm comm, const std::vector<int>& neighbours);
+
+      /// Destructor (frees wrapped communicator)
+      ~NeighbourComm();
+
+      // Not copyable, since the wrapped communicator is owned
+      NeighbourComm(const NeighbourComm&) = delete;
+      NeighbourComm& operator=(const NeighbourComm&) = delete;
+
+      /// Move constructor
+      NeighbourComm(NeighbourComm&& comm);
+
+      /// Move assignment
+      NeighbourComm& operator=(NeighbourComm&& comm);
+
+      /// Return the neighbour processes (ranks in the parent
+      /// communicator)
+      const std::vector<int>& neighbours() const
+      { return _neighbours; }
+
+      /// Send in_values[i] to neighbour i and receive values from
+      /// neighbour i in out_values[i] (wrapper for
+      /// MPI_Neighbor_alltoallv)
+      template<typename T>
+        void all_to_all(const std::vector<std::vector<T>>& in_values,
+                        std::vector<std::vector<T>>& out_values) const;
+
+    private:
+
+      // Neighbour processes
+      std::vector<int> _neighbours;
+
+      // Distributed graph communicator
+      MPI_Comm _comm;
+
+    };
+
+    /// Optional profiler for the communication done by the MPI
+    /// wrappers. When enabled, each call of a wrapper records the
+    /// number of bytes sent by this process and the time spent in
+    /// the call, which includes waiting for other processes, under
+    /// the name of the wrapper and the task of the innermost running
+    /// Timer. Only the outermost wrapper is recorded when wrappers
+    /// call each other. Recording costs a branch when disabled.
+    ///
+    /// Profiling must be enabled and disabled on all processes of a
+    /// communicator, and the summary is included in list_timings().
+    class Profiler
+    {
+    public:
+
+      /// Start recording a call of the named wrapper that sends
+      /// num_bytes bytes from this process
+      Profiler(const char* operation, std::size_t num_bytes)
+        : _operation(nullptr), _num_bytes(0), _start(0.0)
+      {
+        if (_enabled)
+          start(operation, num_bytes);
+      }
+
+      /// Destructor (stops recording)
+      ~Profiler()
+      {
+        if (_operation)
+          stop();
+      }
+
+      /// Turn profiling on or off
+      static void enable(bool enabled=true)
+      { _enabled = enabled; }
+
+      /// Return true if profiling is on
+      static bool enabled()
+      { return _enabled; }
+
+      /// Return summary of recorded communication (collective),
+      /// with the number of calls, bytes sent, time spent in calls
+      /// and the imbalance of this time (maximum minus minimum over
+      /// processes) per wrapper and task. The table is only filled
+      /// on process 0 of the communicator. Records are cleared if
+      /// clear is true.
+      static Table summary(MPI_Comm comm, bool clear);
+
+    private:
+
+      // Start and stop recording
+      void start(const char* operation, std::size_t num_bytes);
+      void stop();
+
+      // Recorded wrapper (null if not recording), bytes sent and
+      // start time
+      const char* _operation;
+      std::size_t _num_bytes;
+      double _start;
+
+      // True if profiling is on
+      static bool _enabled;
+
+    };
+
     /// Return process rank for the communicator
     static unsigned int rank(MPI_Comm comm);
 
@@ -155,6 +310,17 @@ namespace dolfin
                              std::vector<std::vector<T>>& in_values,
                              std::vector<T>& out_values);
 
+    /// Send in_values[p0] to process p0 and receive values from
+    /// process p1 in out_values[p1], for sparse communication
+    /// patterns. Messages are only sent to processes with data, and
+    /// senders are discovered with a nonblocking barrier (the NBX
+    /// algorithm), so the cost depends on the number of processes
+    /// that communicate rather than on the size of the communicator.
+    template<typename T>
+      static void sparse_all_to_all(MPI_Comm comm,
+                                    const std::vector<std::vector<T>>& in_values,
+                                    std::vector<std::vector<T>>& out_values);
+
     /// Broadcast vector of value from broadcaster to all processes
     template<typename T>
       static void broadcast(MPI_Comm comm, std::vector<T>& value,
@@ -228,6 +394,12 @@ namespace dolfin
     template<typename T, typename X> static
       T all_reduce(MPI_Comm comm, const T& value, X op);
 
+    /// All reduce, element-wise for a vector of values (one
+    /// MPI_Allreduce for the whole vector)
+    template<typename T, typename X> static
+      std::vector<T> all_reduce(MPI_Comm comm, const std::vector<T>& value,
+                                X op);
+
     /// Find global offset (index) (wrapper for MPI_(Ex)Scan with
     /// MPI_SUM as reduction op)
     static std::size_t global_offset(MPI_Comm comm,
@@ -283,6 +455,24 @@ namespace dolfin
     }
     #endif
 
+    #ifdef HAS_MPI
+    // Return the duplicate of comm used for the point-to-point
+    // messages of sparse_all_to_all and NonblockingExchange, which is
+    // created on first use (collective) and freed with comm
+    static MPI_Comm exchange_comm(MPI_Comm comm);
+
+    // Return exchange_comm(comm) and the tag for the next
+    // sparse_all_to_all on it. Tags alternate between consecutive
+    // exchanges, since a process may send messages for the next
+    // exchange before other processes have left the current one.
+    static MPI_Comm sparse_exchange_comm(MPI_Comm comm, int& tag);
+
+    // Tag of NonblockingExchange messages, which differs from the
+    // sparse_all_to_all tags since an exchange may be pending during
+    // a sparse_all_to_all
+    static const int nonblocking_exchange_tag = 2;
+    #endif
+
     #ifdef HAS_MPI
     // Return MPI data type
     template<typename T>
@@ -321,6 +511,9 @@ namespace dolfin
                                 unsigned int broadcaster)
   {
     #ifdef HAS_MPI
+    Profiler profiler("broadcast", MPI::rank(comm) == broadcaster
+                      ? value.size()*sizeof(T) : 0);
+
     // Broadcast cast size
     std::size_t bsize = value.size();
     MPI_Bcast(&bsize, 1, mpi_type<std::size_t>(), broadcaster, comm);
@@ -337,6 +530,8 @@ namespace dolfin
                                 unsigned int broadcaster)
   {
     #ifdef HAS_MPI
+    Profiler profiler("broadcast", MPI::rank(comm) == broadcaster
+                      ? sizeof(T) : 0);
     MPI_Bcast(&value, 1, mpi_type<T>(), broadcaster, comm);
     #endif
   }
@@ -358,6 +553,7 @@ namespace dolfin
       data_size_send[p] = in_values[p].size();
       data_offset_send[p + 1] = data_offset_send[p] + data_size_send[p];
     }
+    Profiler profiler("all_to_all", data_offset_send[comm_size]*sizeof(T));
 
     // Get received data sizes
     std::vector<int> data_size_recv(comm_size);
@@ -414,6 +610,7 @@ namespace dolfin
       data_size_send[p] = in_values[p].size();
       data_offset_send[p + 1] = data_offset_send[p] + data_size_send[p];
     }
+    Profiler profiler("all_to_all", data_offset_send[comm_size]*sizeof(T));
 
     // Get received data sizes
     std::vector<int> data_size_recv(comm_size);
@@ -444,6 +641,221 @@ namespace dolfin
     #endif
   }
   //---------------------------------------------------------------------------
+  template<typename T>
+    void dolfin::MPI::sparse_all_to_all(MPI_Comm comm,
+                                 const std::vector<std::vector<T>>& in_values,
+                                 std::vector<std::vector<T>>& out_values)
+  {
+    #ifdef HAS_MPI
+    const std::size_t comm_size = MPI::size(comm);
+    const std::size_t comm_rank = MPI::rank(comm);
+    dolfin_assert(in_values.size() == comm_size);
+    std::size_t num_bytes = 0;
+    if (Profiler::enabled())
+    {
+      for (std::size_t p = 0; p < comm_size; ++p)
+      {
+        if (p != comm_rank)
+          num_bytes += in_values[p].size()*sizeof(T);
+      }
+    }
+    Profiler profiler("sparse_all_to_all", num_bytes);
+    out_values.assign(comm_size, std::vector<T>());
+    out_values[comm_rank] = in_values[comm_rank];
+
+    // Communicate on a (cached) duplicate communicator, so that
+    // messages cannot be confused with other traffic, and with a tag
+    // that differs from the one of the previous exchange
+    int tag = 0;
+    MPI_Comm _comm = sparse_exchange_comm(comm, tag);
+
+    // Post synchronous sends, which complete once they have been
+    // matched by the destination
+    std::vector<MPI_Request> send_requests;
+    send_requests.reserve(comm_size);
+    for (std::size_t p = 0; p < comm_size; ++p)
+    {
+      if (p != comm_rank && !in_values[p].empty())
+      {
+        send_requests.push_back(MPI_REQUEST_NULL);
+        MPI_Issend(const_cast<T*>(in_values[p].data()), in_values[p].size(),
+                   mpi_type<T>(), p, tag, _comm, &send_requests.back());
+      }
+    }
+
+    // Receive messages until all processes have seen their sends
+    // matched, which is detected with a nonblocking barrier entered
+    // after the local sends complete
+    MPI_Request barrier_request = MPI_REQUEST_NULL;
+    bool barrier_active = false;
+    while (true)
+    {
+      int flag = 0;
+      MPI_Status status;
+      MPI_Iprobe(MPI_ANY_SOURCE, tag, _comm, &flag, &status);
+      if (flag)
+      {
+        int count = 0;
+        MPI_Get_count(&status, mpi_type<T>(), &count);
+        std::vector<T>& recv = out_values[status.MPI_SOURCE];
+        recv.resize(count);
+        MPI_Recv(recv.data(), count, mpi_type<T>(), status.MPI_SOURCE, tag,
+                 _comm, MPI_STATUS_IGNORE);
+      }
+
+      if (barrier_active)
+      {
+        int done = 0;
+        MPI_Test(&barrier_request, &done, MPI_STATUS_IGNORE);
+        if (done)
+          break;
+      }
+      else
+      {
+        int sent = 0;
+        MPI_Testall(send_requests.size(), send_requests.data(), &sent,
+                    MPI_STATUSES_IGNORE);
+        if (sent)
+        {
+          MPI_Ibarrier(_comm, &barrier_request);
+          barrier_active = true;
+        }
+      }
+    }
+    #else
+    dolfin_assert(in_values.size() == 1);
+    out_values = in_values;
+    #endif
+  }
+  //---------------------------------------------------------------------------
+  template<typename T>
+    dolfin::MPI::NonblockingExchange<T>::~NonblockingExchange()
+  {
+    #ifdef HAS_MPI
+    if (!_requests.empty())
+      MPI_Waitall(_requests.size(), _requests.data(), MPI_STATUSES_IGNORE);
+    #endif
+  }
+  //---------------------------------------------------------------------------
+  template<typename T>
+    void dolfin::MPI::NonblockingExchange<T>::start(MPI_Comm comm,
+                                  std::vector<std::vector<T>>& in_values,
+                                  const std::vector<std::size_t>& recv_sizes)
+  {
+    dolfin_assert(_requests.empty());
+    _send_values.clear();
+    std::swap(_send_values, in_values);
+    _recv_values.assign(recv_sizes.size(), std::vector<T>());
+
+    #ifdef HAS_MPI
+    const std::size_t comm_size = MPI::size(comm);
+    dolfin_assert(_send_values.size() == comm_size);
+    dolfin_assert(recv_sizes.size() == comm_size);
+    std::size_t num_bytes = 0;
+    if (Profiler::enabled())
+    {
+      for (std::size_t p = 0; p < comm_size; ++p)
+        num_bytes += _send_values[p].size()*sizeof(T);
+    }
+    Profiler profiler("NonblockingExchange::start", num_bytes);
+
+    // Post receives before sends, on the duplicate communicator so
+    // that messages cannot be confused with other traffic
+    const int tag = nonblocking_exchange_tag;
+    MPI_Comm _comm = exchange_comm(comm);
+    _requests.reserve(2*comm_size);
+    for (std::size_t p = 0; p < comm_size; ++p)
+    {
+      if (recv_sizes[p] > 0)
+      {
+        _recv_values[p].resize(recv_sizes[p]);
+        _requests.push_back(MPI_REQUEST_NULL);
+        MPI_Irecv(_recv_values[p].data(), recv_sizes[p], mpi_type<T>(), p,
+                  tag, _comm, &_requests.back());
+      }
+    }
+    for (std::size_t p = 0; p < comm_size; ++p)
+    {
+      if (!_send_values[p].empty())
+      {
+        _requests.push_back(MPI_REQUEST_NULL);
+        MPI_Isend(_send_values[p].data(), _send_values[p].size(),
+                  mpi_type<T>(), p, tag, _comm, &_requests.back());
+      }
+    }
+    #else
+    dolfin_assert(_send_values.size() == 1);
+    _recv_values = _send_values;
+    #endif
+  }
+  //---------------------------------------------------------------------------
+  template<typename T>
+    std::vector<std::vector<T>>& dolfin::MPI::NonblockingExchange<T>::wait()
+  {
+    #ifdef HAS_MPI
+    if (!_requests.empty())
+    {
+      Profiler profiler("NonblockingExchange::wait", 0);
+      MPI_Waitall(_requests.size(), _requests.data(), MPI_STATUSES_IGNORE);
+      _requests.clear();
+    }
+    #endif
+    _send_values.clear();
+    return _recv_values;
+  }
+  //---------------------------------------------------------------------------
+  template<typename T>
+    void dolfin::MPI::NeighbourComm::all_to_all(
+      const std::vector<std::vector<T>>& in_values,
+      std::vector<std::vector<T>>& out_values) const
+  {
+    const std::size_t num_neighbours = _neighbours.size();
+    dolfin_assert(in_values.size() == num_neighbours);
+    out_values.resize(num_neighbours);
+
+    #ifdef HAS_MPI
+    // Exchange message sizes with neighbours
+    std::vector<int> data_size_send(num_neighbours);
+    std::vector<int> data_offset_send(num_neighbours + 1, 0);
+    for (std::size_t i = 0; i < num_neighbours; ++i)
+    {
+      data_size_send[i] = in_values[i].size();
+      data_offset_send[i + 1] = data_offset_send[i] + data_size_send[i];
+    }
+    Profiler profiler("NeighbourComm::all_to_all",
+                      data_offset_send.back()*sizeof(T));
+    std::vector<int> data_size_recv(num_neighbours);
+    MPI_Neighbor_alltoall(data_size_send.data(), 1, mpi_type<int>(),
+                          data_size_recv.data(), 1, mpi_type<int>(), _comm);
+
+    std::vector<int> data_offset_recv(num_neighbours + 1, 0);
+    for (std::size_t i = 0; i < num_neighbours; ++i)
+      data_offset_recv[i + 1] = data_offset_recv[i] + data_size_recv[i];
+
+    // Pack and send data
+    std::vector<T> data_send(data_offset_send.back());
+    for (std::size_t i = 0; i < num_neighbours; ++i)
+    {
+      std::copy(in_values[i].begin(), in_values[i].end(),
+                data_send.begin() + data_offset_send[i]);
+    }
+    std::vector<T> data_recv(data_offset_recv.back());
+    MPI_Neighbor_alltoallv(data_send.data(), data_size_send.data(),
+                           data_offset_send.data(), mpi_type<T>(),
+                           data_recv.data(), data_size_recv.data(),
+                           data_offset_recv.data(), mpi_type<T>(), _comm);
+
+    // Unpack data
+    for (std::size_t i = 0; i < num_neighbours; ++i)
+    {
+      out_values[i].assign(data_recv.begin() + data_offset_recv[i],
+                           data_recv.begin() + data_offset_recv[i + 1]);
+    }
+    #else
+    out_values = in_values;
+    #endif
+  }
+  //---------------------------------------------------------------------------
 #ifndef DOXYGEN_IGNORE
   template<> inline
     void dolfin::MPI::all_to_all(MPI_Comm comm,
@@ -502,6 +914,13 @@ namespace dolfin
                               unsigned int sending_process)
   {
     #ifdef HAS_MPI
+    std::size_t num_bytes = 0;
+    if (Profiler::enabled() && MPI::rank(comm) == sending_process)
+    {
+      for (const auto& values : in_values)
+        num_bytes += values.size()*sizeof(T);
+    }
+    Profiler profiler("scatter", num_bytes);
 
     // Scatter number of values to each process
     const std::size_t comm_size = MPI::size(comm);
@@ -582,6 +1001,8 @@ namespace dolfin
                               T& out_value, unsigned int sending_process)
   {
     #ifdef HAS_MPI
+    Profiler profiler("scatter", MPI::rank(comm) == sending_process
+                      ? in_values.size()*sizeof(T) : 0);
     if (MPI::rank(comm) == sending_process)
       dolfin_assert(in_values.size() == MPI::size(comm));
 
@@ -601,6 +1022,7 @@ namespace dolfin
                            unsigned int receiving_process)
   {
     #ifdef HAS_MPI
+    Profiler profiler("gather", in_values.size()*sizeof(T));
     const std::size_t comm_size = MPI::size(comm);
 
     // Get data size on each process
@@ -632,6 +1054,7 @@ namespace dolfin
                                   unsigned int receiving_process)
   {
     #ifdef HAS_MPI
+    Profiler profiler("gather", in_values.size());
     const std::size_t comm_size = MPI::size(comm);
 
     // Get data size on each process
@@ -672,6 +1095,7 @@ namespace dolfin
                                       std::vector<std::string>& out_values)
   {
     #ifdef HAS_MPI
+    Profiler profiler("all_gather", in_values.size());
     const std::size_t comm_size = MPI::size(comm);
 
     // Get data size on each process
@@ -710,6 +1134,7 @@ namespace dolfin
                                  std::vector<T>& out_values)
   {
     #ifdef HAS_MPI
+    Profiler profiler("all_gather", in_values.size()*sizeof(T));
     out_values.resize(in_values.size()*MPI::size(comm));
     MPI_Allgather(const_cast<T*>(in_values.data()), in_values.size(),
                   mpi_type<T>(),
@@ -726,6 +1151,7 @@ namespace dolfin
                                  std::vector<std::vector<T>>& out_values)
   {
     #ifdef HAS_MPI
+    Profiler profiler("all_gather", in_values.size()*sizeof(T));
     const std::size_t comm_size = MPI::size(comm);
 
     // Get data size on each process
@@ -766,6 +1192,7 @@ namespace dolfin
                                  std::vector<T>& out_values)
   {
     #ifdef HAS_MPI
+    Profiler profiler("all_gather", sizeof(T));
     out_values.resize(MPI::size(comm));
     MPI_Allgather(const_cast<T*>(&in_value), 1, mpi_type<T>(),
                   out_values.data(), 1, mpi_type<T>(), comm);
@@ -779,6 +1206,7 @@ namespace dolfin
     T dolfin::MPI::all_reduce(MPI_Comm comm, const T& value, X op)
   {
     #ifdef HAS_MPI
+    Profiler profiler("all_reduce", sizeof(T));
     T out;
     MPI_Allreduce(const_cast<T*>(&value), &out, 1, mpi_type<T>(), op, comm);
     return out;
@@ -787,11 +1215,27 @@ namespace dolfin
     #endif
   }
   //---------------------------------------------------------------------------
+  template<typename T, typename X>
+    std::vector<T> dolfin::MPI::all_reduce(MPI_Comm comm,
+                                           const std::vector<T>& value, X op)
+  {
+    #ifdef HAS_MPI
+    Profiler profiler("all_reduce", value.size()*sizeof(T));
+    std::vector<T> out(value.size());
+    MPI_Allreduce(const_cast<T*>(value.data()), out.data(), value.size(),
+                  mpi_type<T>(), op, comm);
+    return out;
+    #else
+    return value;
+    #endif
+  }
+  //---------------------------------------------------------------------------
   template<typename T> T dolfin::MPI::max(MPI_Comm comm, const T& value)
   {
     #ifdef HAS_MPI
     // Enforce cast to MPI_Op; this is needed because template dispatch may
     // not recognize this is possible, e.g. C-enum to unsigned int in SGI MPT
+    Profiler profiler("max", sizeof(T));
     MPI_Op op = static_cast<MPI_Op>(MPI_MAX);
     return all_reduce(comm, value, op);
     #else
@@ -804,6 +1248,7 @@ namespace dolfin
     #ifdef HAS_MPI
     // Enforce cast to MPI_Op; this is needed because template dispatch may
     // not recognize this is possible, e.g. C-enum to unsigned int in SGI MPT
+    Profiler profiler("min", sizeof(T));
     MPI_Op op = static_cast<MPI_Op>(MPI_MIN);
     return all_reduce(comm, value, op);
     #else
@@ -816,6 +1261,7 @@ namespace dolfin
     #ifdef HAS_MPI
     // Enforce cast to MPI_Op; this is needed because template dispatch may
     // not recognize this is possible, e.g. C-enum to unsigned int in SGI MPT
+    Profiler profiler("sum", sizeof(T));
     MPI_Op op = static_cast<MPI_Op>(MPI_SUM);
     return all_reduce(comm, value, op);
     #else
@@ -842,6 +1288,7 @@ namespace dolfin
                                 unsigned int source, int recv_tag)
   {
     #ifdef HAS_MPI
+    Profiler profiler("send_recv", send_value.size()*sizeof(T));
     std::size_t send_size = send_value.size();
     std::size_t recv_size = 0;
     MPI_Status mpi_status;
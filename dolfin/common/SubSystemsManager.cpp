@@ -29,12 +29,14 @@
 #include <slepc.h>
 #endif
 
+#include <mutex>
 #include <boost/algorithm/string/trim.hpp>
 
 #include <dolfin/common/constants.h>
 #include <dolfin/log/log.h>
 #include <dolfin/parameter/GlobalParameters.h>
 #include "SubSystemsManager.h"
+#include "ThreadPool.h"
 
 using namespace dolfin;
 
@@ -191,10 +193,35 @@ void SubSystemsManager::init_petsc(int argc, char* argv[])
 void SubSystemsManager::finalize()
 {
   // Finalize subsystems in the correct order
+  finalize_thread_pool();
   finalize_petsc();
   finalize_mpi();
 }
 //-----------------------------------------------------------------------------
+ThreadPool& SubSystemsManager::thread_pool()
+{
+  // Tasks use the pool they run on
+  ThreadPool* current = ThreadPool::current();
+  if (current)
+    return *current;
+
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  const std::size_t num_threads = (int) parameters["num_threads"];
+  std::unique_ptr<ThreadPool>& pool = singleton()._thread_pool;
+  if (!pool or pool->size() != num_threads)
+  {
+    pool.reset();
+    pool.reset(new ThreadPool(num_threads));
+  }
+  return *pool;
+}
+//-----------------------------------------------------------------------------
+void SubSystemsManager::finalize_thread_pool()
+{
+  singleton()._thread_pool.reset();
+}
+//-----------------------------------------------------------------------------
 bool SubSystemsManager::responsible_mpi()
 {
   return singleton().control_mpi;
@@ -18,6 +18,7 @@
 #ifndef __SUB_SYSTEMS_MANAGER_H
 #define __SUB_SYSTEMS_MANAGER_H
 
+#include <memory>
 #include <string>
 
 #ifdef HAS_PETSC
@@ -27,8 +28,11 @@
 namespace dolfin
 {
 
+  class ThreadPool;
+
   /// This is a singleton class which manages the initialisation and
-  /// finalisation of various sub systems, such as MPI and PETSc.
+  /// finalisation of various sub systems, such as MPI, PETSc and the
+  /// thread pool used within each process.
 
   class SubSystemsManager
   {
@@ -76,6 +80,13 @@ namespace dolfin
     /// finalised)
     static bool mpi_finalized();
 
+    /// Return thread pool of this process, with the number of threads
+    /// given by the global parameter "num_threads". The pool is
+    /// created on first use and recreated when the parameter has
+    /// changed. Called from a task of the pool, the pool itself is
+    /// returned.
+    static ThreadPool& thread_pool();
+
 #ifdef HAS_PETSC
     /// PETSc error handler. Logs everything known to DOLFIN logging
     /// system (with level TRACE) and stores the error message into
@@ -102,10 +113,16 @@ namespace dolfin
     // Finalize PETSc
     static void finalize_petsc();
 
+    // Stop thread pool
+    static void finalize_thread_pool();
+
     // State variables
     bool petsc_initialized;
     bool control_mpi;
 
+    // Thread pool (null until first used)
+    std::unique_ptr<ThreadPool> _thread_pool;
+
   };
 
 }
@@ -0,0 +1,180 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include "ThreadPool.h"
+
+using namespace dolfin;
+
+namespace
+{
+  // Pool and queue of the calling worker thread
+  thread_local ThreadPool* worker_pool = nullptr;
+  thread_local std::size_t worker_queue = 0;
+}
+
+//-----------------------------------------------------------------------------
+ThreadPool::ThreadPool(std::size_t num_threads) : _num_queued(0), _stop(false)
+{
+  num_threads = std::max<std::size_t>(1, num_threads);
+  for (std::size_t q = 0; q < num_threads; ++q)
+    _queues.emplace_back(new Queue);
+
+  _workers.reserve(num_threads - 1);
+  for (std::size_t q = 1; q < num_threads; ++q)
+    _workers.emplace_back(&ThreadPool::work, this, q);
+}
+//-----------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _wake.notify_all();
+  for (auto& worker : _workers)
+    worker.join();
+}
+//-----------------------------------------------------------------------------
+void ThreadPool::run(std::size_t num_tasks,
+                     const std::function<void(std::size_t)>& task)
+{
+  if (num_tasks == 0)
+    return;
+
+  // Run tasks directly if there are no workers
+  if (_workers.empty())
+  {
+    for (std::size_t i = 0; i < num_tasks; ++i)
+      task(i);
+    return;
+  }
+
+  Batch batch;
+  batch.task = &task;
+  batch.remaining = num_tasks;
+
+  // Spread tasks over the queues, starting with the queue of the
+  // calling thread
+  const std::size_t q0 = (worker_pool == this) ? worker_queue : 0;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _num_queued += num_tasks;
+  }
+  const std::size_t num_queues = _queues.size();
+  for (std::size_t k = 0; k < std::min(num_tasks, num_queues); ++k)
+  {
+    Queue& queue = *_queues[(q0 + k) % num_queues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    for (std::size_t i = k; i < num_tasks; i += num_queues)
+      queue.tasks.push_back({&batch, i});
+  }
+  _wake.notify_all();
+
+  // Run tasks until the batch is complete
+  Task t;
+  while (batch.remaining.load(std::memory_order_acquire) > 0)
+  {
+    if (take(q0, t))
+      execute(t);
+    else
+      std::this_thread::yield();
+  }
+
+  if (batch.error)
+    std::rethrow_exception(batch.error);
+}
+//-----------------------------------------------------------------------------
+ThreadPool* ThreadPool::current()
+{
+  return worker_pool;
+}
+//-----------------------------------------------------------------------------
+bool ThreadPool::take(std::size_t q, Task& task)
+{
+  // Own queue first, newest task
+  {
+    Queue& queue = *_queues[q];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      --_num_queued;
+      return true;
+    }
+  }
+
+  // Steal oldest task from another queue
+  const std::size_t num_queues = _queues.size();
+  for (std::size_t k = 1; k < num_queues; ++k)
+  {
+    Queue& queue = *_queues[(q + k) % num_queues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+      --_num_queued;
+      return true;
+    }
+  }
+
+  return false;
+}
+//-----------------------------------------------------------------------------
+void ThreadPool::execute(const Task& task)
+{
+  Batch& batch = *task.batch;
+  try
+  {
+    (*batch.task)(task.i);
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(batch.error_mutex);
+    if (!batch.error)
+      batch.error = std::current_exception();
+  }
+
+  // The batch may be destroyed by the submitting thread once all its
+  // tasks are marked as completed
+  batch.remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+//-----------------------------------------------------------------------------
+void ThreadPool::work(std::size_t q)
+{
+  worker_pool = this;
+  worker_queue = q;
+
+  Task task;
+  while (true)
+  {
+    if (take(q, task))
+    {
+      execute(task);
+      continue;
+    }
+
+    // Sleep until tasks are queued or the pool is stopped
+    std::unique_lock<std::mutex> lock(_mutex);
+    _wake.wait(lock, [this] { return _stop or _num_queued > 0; });
+    if (_stop)
+      return;
+  }
+}
+//-----------------------------------------------------------------------------
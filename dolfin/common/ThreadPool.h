@@ -0,0 +1,122 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __DOLFIN_THREAD_POOL_H
+#define __DOLFIN_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dolfin
+{
+
+  /// A pool of threads for shared-memory parallelism within a
+  /// process. Tasks are spread over one queue per thread, and threads
+  /// that run out of tasks steal tasks from the other queues. The
+  /// thread that submits tasks runs tasks too while it waits for
+  /// them to complete, so tasks may themselves submit tasks.
+  ///
+  /// Tasks should not call MPI, since the order in which tasks run,
+  /// and hence of their MPI calls, differs between processes. The
+  /// pool of each process is owned by SubSystemsManager (see
+  /// SubSystemsManager::thread_pool()).
+
+  class ThreadPool
+  {
+  public:
+
+    /// Create pool of num_threads threads, including the threads
+    /// that submit tasks (num_threads - 1 worker threads are started)
+    explicit ThreadPool(std::size_t num_threads);
+
+    /// Destructor (stops worker threads)
+    ~ThreadPool();
+
+    /// Return number of threads, including the submitting thread
+    std::size_t size() const
+    { return _queues.size(); }
+
+    /// Call task(i) for i = 0, ..., num_tasks - 1 concurrently and
+    /// wait for the calls to complete. If a call throws, the first
+    /// exception is rethrown after all calls have completed.
+    void run(std::size_t num_tasks,
+             const std::function<void(std::size_t)>& task);
+
+    /// Return the pool that the calling thread is a worker of, or
+    /// null if the calling thread is not a worker thread
+    static ThreadPool* current();
+
+  private:
+
+    // Tasks submitted by one call to run()
+    struct Batch
+    {
+      const std::function<void(std::size_t)>* task;
+      std::atomic<std::size_t> remaining;
+      std::mutex error_mutex;
+      std::exception_ptr error;
+    };
+
+    // Task i of a batch
+    struct Task
+    {
+      Batch* batch;
+      std::size_t i;
+    };
+
+    // Queue of tasks, owned by one thread
+    struct Queue
+    {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    // Take a task from queue q (back), or steal one from another
+    // queue (front). Returns false if all queues are empty.
+    bool take(std::size_t q, Task& task);
+
+    // Run task and mark it as completed
+    static void execute(const Task& task);
+
+    // Worker thread loop for queue q
+    void work(std::size_t q);
+
+    // Queues of the submitting threads (0) and worker threads
+    std::vector<std::unique_ptr<Queue>> _queues;
+
+    // Worker threads
+    std::vector<std::thread> _workers;
+
+    // Number of queued tasks, and wake-up of idle workers
+    std::atomic<std::ptrdiff_t> _num_queued;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _stop;
+
+  };
+
+}
+
+#endif
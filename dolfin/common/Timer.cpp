@@ -18,12 +18,29 @@
 // First added:  2013-09-08
 // Last changed:
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
 #include <dolfin/parameter/GlobalParameters.h>
 #include <dolfin/log/LogManager.h>
 #include "Timer.h"
 
 using namespace dolfin;
 
+namespace
+{
+  // Running logging timers on this thread, innermost last
+  thread_local std::vector<const Timer*> running_timers;
+
+  // Remove timer from the running timers (if present)
+  void remove_running_timer(const Timer* timer)
+  {
+    auto it = std::find(running_timers.rbegin(), running_timers.rend(), timer);
+    if (it != running_timers.rend())
+      running_timers.erase(std::next(it).base());
+  }
+}
+
 //-----------------------------------------------------------------------------
 Timer::Timer() : _task("")
 {
@@ -34,17 +51,26 @@ Timer::Timer(std::string task) : _task("")
 {
   const std::string prefix = parameters["timer_prefix"];
   _task = prefix + task;
+  if (_task.size() > 0)
+    running_timers.push_back(this);
 }
 //-----------------------------------------------------------------------------
 Timer::~Timer()
 {
  if (!_timer.is_stopped())
    stop();
+ if (_task.size() > 0)
+   remove_running_timer(this);
 }
 //-----------------------------------------------------------------------------
 void Timer::start()
 {
   _timer.start();
+  if (_task.size() > 0)
+  {
+    remove_running_timer(this);
+    running_timers.push_back(this);
+  }
 }
 //-----------------------------------------------------------------------------
 void Timer::resume()
@@ -62,7 +88,10 @@ double Timer::stop()
   _timer.stop();
   const auto elapsed = this->elapsed();
   if (_task.size() > 0)
+  {
+    remove_running_timer(this);
     LogManager::logger().register_timing(_task, elapsed);
+  }
   return std::get<0>(elapsed);
 }
 //-----------------------------------------------------------------------------
@@ -75,3 +104,8 @@ std::tuple<double, double, double> Timer::elapsed() const
   return std::make_tuple(wall, user, system);
 }
 //-----------------------------------------------------------------------------
+std::string Timer::current_task()
+{
+  return running_timers.empty() ? std::string() : running_timers.back()->_task;
+}
+//-----------------------------------------------------------------------------
@@ -57,6 +57,11 @@ namespace dolfin
     /// Destructor
     ~Timer();
 
+    // Not copyable or movable, since running logging timers are
+    // tracked by address
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
     /// Zero and start timer
     void start();
 
@@ -72,6 +77,10 @@ namespace dolfin
     /// 10 millisecond.
     std::tuple<double, double, double> elapsed() const;
 
+    /// Return task of the innermost running logging timer on the
+    /// calling thread (empty if no logging timer is running)
+    static std::string current_task();
+
   private:
 
     // Name of task
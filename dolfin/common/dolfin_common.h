@@ -13,10 +13,12 @@
 #include <dolfin/common/ArrayView.h>
 #include <dolfin/common/IndexSet.h>
 #include <dolfin/common/Set.h>
+#include <dolfin/common/FlatMap.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/Variable.h>
 #include <dolfin/common/Hierarchical.h>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/SubSystemsManager.h>
+#include <dolfin/common/ThreadPool.h>
 
 #endif
@@ -0,0 +1,57 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __DOLFIN_THREADS_H
+#define __DOLFIN_THREADS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "SubSystemsManager.h"
+#include "ThreadPool.h"
+
+namespace dolfin
+{
+
+  /// Split the range [0, n) into num_threads contiguous chunks and
+  /// call f(thread, begin, end) for each chunk as a task of the
+  /// thread pool of the process (SubSystemsManager::thread_pool()).
+  /// Chunk t is always [t*n/num_threads, (t + 1)*n/num_threads), so
+  /// that results computed per chunk can be combined in a
+  /// deterministic order, whatever the number of threads in the
+  /// pool. With a single chunk, f is called directly. Calls may be
+  /// nested. The function f must not call MPI.
+  template<typename F>
+  void parallel_for(std::size_t num_threads, std::size_t n, F f)
+  {
+    num_threads = std::max<std::size_t>(1, std::min(num_threads, n));
+    auto begin = [num_threads, n](std::size_t t) -> std::size_t
+      { return (std::uint64_t) t*n/num_threads; };
+
+    if (num_threads == 1)
+    {
+      f(0, 0, n);
+      return;
+    }
+
+    SubSystemsManager::thread_pool().run(num_threads,
+      [&f, &begin](std::size_t t) { f(t, begin(t), begin(t + 1)); });
+  }
+
+}
+
+#endif
@@ -26,10 +26,15 @@
 #include <dolfin/log/Progress.h>
 #include <dolfin/common/ArrayView.h>
 #include <dolfin/common/Timer.h>
+#include <dolfin/common/threads.h>
 #include <dolfin/parameter/GlobalParameters.h>
+#include <dolfin/la/EigenMatrix.h>
+#include <dolfin/la/EigenVector.h>
 #include <dolfin/la/GenericTensor.h>
+#include <dolfin/la/LinearAlgebraObject.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/EntityRange.h>
 #include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/Vertex.h>
 #include <dolfin/mesh/MeshData.h>
@@ -116,6 +121,14 @@ void Assembler::assemble_cells(
   // Set timer
   Timer timer("Assemble cells");
 
+  // Assemble one cell color at a time if using several threads
+  const std::size_t num_threads = (int) parameters["num_threads"];
+  if (num_threads > 1)
+  {
+    assemble_cells_threaded(A, a, ufc, domains, values, num_threads);
+    return;
+  }
+
   // Extract mesh
   dolfin_assert(a.mesh());
   const Mesh& mesh = *(a.mesh());
@@ -140,35 +153,37 @@ void Assembler::assemble_cells(
   // Check whether integral is domain-dependent
   bool use_domains = domains && !domains->empty();
 
+  // Regular (non-ghost) cells
+  const EntityRange cells(mesh, mesh.topology().dim());
+  const MeshConnectivity& cell_vertices = cells.connectivity(0);
+
   // Assemble over cells
   ufc::cell ufc_cell;
   std::vector<double> coordinate_dofs;
   Progress p(AssemblerBase::progress_message(A.rank(), "cells"),
              mesh.num_cells());
-  for (CellIterator cell(mesh); !cell.end(); ++cell)
+  for (std::size_t c : cells)
   {
     // Get integral for sub domain (if any)
     if (use_domains)
-      integral = ufc.get_cell_integral((*domains)[*cell]);
+      integral = ufc.get_cell_integral((*domains)[c]);
 
     // Skip if no integral on current domain
     if (!integral)
       continue;
 
-    // Check that cell is not a ghost
-    dolfin_assert(!cell->is_ghost());
-
     // Update to current cell
-    cell->get_cell_data(ufc_cell);
-    cell->get_coordinate_dofs(coordinate_dofs);
-    ufc.update(*cell, coordinate_dofs, ufc_cell,
+    const Cell cell(mesh, c);
+    cells.get_cell_data(c, ufc_cell);
+    cells.get_coordinate_dofs(c, cell_vertices, coordinate_dofs);
+    ufc.update(cell, coordinate_dofs, ufc_cell,
                integral->enabled_coefficients());
 
     // Get local-to-global dof maps for cell
     bool empty_dofmap = false;
     for (std::size_t i = 0; i < form_rank; ++i)
     {
-      auto dmap = dofmaps[i]->cell_dofs(cell->index());
+      auto dmap = dofmaps[i]->cell_dofs(c);
       dofs[i] = ArrayView<const dolfin::la_index>(dmap.size(), dmap.data());
       empty_dofmap = empty_dofmap || dofs[i].size() == 0;
     }
@@ -185,7 +200,7 @@ void Assembler::assemble_cells(
     // Add entries to global tensor. Either store values cell-by-cell
     // (currently only available for functionals)
     if (is_cell_functional)
-      (*values)[cell->index()] = ufc.A[0];
+      (*values)[c] = ufc.A[0];
     else
       A.add_local(ufc.A.data(), dofs);
 
@@ -193,6 +208,166 @@ void Assembler::assemble_cells(
   }
 }
 //-----------------------------------------------------------------------------
+void Assembler::assemble_cells_threaded(
+  GenericTensor& A,
+  const Form& a,
+  UFC& ufc,
+  std::shared_ptr<const MeshFunction<std::size_t>> domains,
+  std::vector<double>* values,
+  std::size_t num_threads)
+{
+  // Extract mesh
+  dolfin_assert(a.mesh());
+  const Mesh& mesh = *(a.mesh());
+  const std::size_t D = mesh.topology().dim();
+
+  // Form rank
+  const std::size_t form_rank = ufc.form.rank();
+
+  // Check if form is a functional
+  const bool is_cell_functional = (values && form_rank == 0) ? true : false;
+
+  // Collect pointers to dof maps
+  std::vector<const GenericDofMap*> dofmaps;
+  for (std::size_t i = 0; i < form_rank; ++i)
+    dofmaps.push_back(a.function_space(i)->dofmap().get());
+
+  // Cells of the same color share no vertex, and hence no dofs
+  // unless a dof map has globally supported dofs (e.g. Real
+  // spaces). Their tensors can then be added concurrently to the
+  // Eigen backends, which only write to the rows of the cell
+  // dofs. Other backends are not thread-safe, so the tensors are
+  // added by this thread after each color.
+  bool concurrent_add = form_rank > 0
+    && (has_type<EigenMatrix>(A) || has_type<EigenVector>(A));
+  for (auto dofmap : dofmaps)
+  {
+    std::vector<std::size_t> global_dofs;
+    dofmap->tabulate_global_dofs(global_dofs);
+    concurrent_add = concurrent_add && global_dofs.empty();
+  }
+
+  // Check whether integral is domain-dependent
+  const bool use_domains = domains && !domains->empty();
+
+  // Color cells such that cells sharing a vertex have different
+  // colors
+  const std::vector<std::size_t> coloring_type = {{D, 0, D}};
+  mesh.color(coloring_type);
+  dolfin_assert(mesh.topology().coloring.find(coloring_type)
+                != mesh.topology().coloring.end());
+  const std::vector<std::vector<std::size_t>>& cells_of_color
+    = mesh.topology().coloring.find(coloring_type)->second.second;
+
+  // Regular (non-ghost) cells. The coloring also covers ghost cells,
+  // which come last.
+  const EntityRange cells(mesh, D);
+  const MeshConnectivity& cell_vertices = cells.connectivity(0);
+  const std::size_t num_regular_cells = cells.size();
+
+  // Local assembly data for each thread, and the cells and tensors
+  // tabulated by each thread if not added concurrently
+  std::vector<UFC> thread_ufc(num_threads, ufc);
+  std::vector<std::vector<std::size_t>> tabulated_cells(num_threads);
+  std::vector<std::vector<double>> tabulated_tensors(num_threads);
+  const std::size_t tensor_size = ufc.A.size();
+
+  // Assemble over cells, one color at a time
+  std::vector<ArrayView<const dolfin::la_index>> dofs(form_rank);
+  Progress p(AssemblerBase::progress_message(A.rank(), "cells"),
+             cells_of_color.size());
+  for (const std::vector<std::size_t>& color_cells : cells_of_color)
+  {
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+      tabulated_cells[t].clear();
+      tabulated_tensors[t].clear();
+    }
+
+    parallel_for(num_threads, color_cells.size(),
+      [&](std::size_t t, std::size_t begin, std::size_t end)
+      {
+        UFC& _ufc = thread_ufc[t];
+        ufc::cell ufc_cell;
+        std::vector<double> coordinate_dofs;
+        std::vector<ArrayView<const dolfin::la_index>> _dofs(form_rank);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          const std::size_t c = color_cells[i];
+          if (c >= num_regular_cells)
+            continue;
+
+          // Get integral for sub domain (if any)
+          ufc::cell_integral* integral = use_domains
+            ? _ufc.get_cell_integral((*domains)[c])
+            : _ufc.default_cell_integral.get();
+
+          // Skip if no integral on current domain
+          if (!integral)
+            continue;
+
+          // Update to current cell
+          const Cell cell(mesh, c);
+          cells.get_cell_data(c, ufc_cell);
+          cells.get_coordinate_dofs(c, cell_vertices, coordinate_dofs);
+          _ufc.update(cell, coordinate_dofs, ufc_cell,
+                      integral->enabled_coefficients());
+
+          // Get local-to-global dof maps for cell
+          bool empty_dofmap = false;
+          for (std::size_t j = 0; j < form_rank; ++j)
+          {
+            auto dmap = dofmaps[j]->cell_dofs(c);
+            _dofs[j] = ArrayView<const dolfin::la_index>(dmap.size(),
+                                                         dmap.data());
+            empty_dofmap = empty_dofmap || _dofs[j].size() == 0;
+          }
+
+          // Skip if at least one dofmap is empty
+          if (empty_dofmap)
+            continue;
+
+          // Tabulate cell tensor
+          integral->tabulate_tensor(_ufc.A.data(), _ufc.w(),
+                                   coordinate_dofs.data(),
+                                   ufc_cell.orientation);
+
+          // Store values cell-by-cell (functionals), add to global
+          // tensor or keep for adding after this color
+          if (is_cell_functional)
+            (*values)[c] = _ufc.A[0];
+          else if (concurrent_add)
+            A.add_local(_ufc.A.data(), _dofs);
+          else
+          {
+            tabulated_cells[t].push_back(c);
+            tabulated_tensors[t].insert(tabulated_tensors[t].end(),
+                                        _ufc.A.begin(), _ufc.A.end());
+          }
+        }
+      });
+
+    // Add tabulated tensors to global tensor, in the order of the
+    // cells of the color
+    for (std::size_t t = 0; t < num_threads; ++t)
+    {
+      for (std::size_t k = 0; k < tabulated_cells[t].size(); ++k)
+      {
+        const std::size_t c = tabulated_cells[t][k];
+        for (std::size_t j = 0; j < form_rank; ++j)
+        {
+          auto dmap = dofmaps[j]->cell_dofs(c);
+          dofs[j] = ArrayView<const dolfin::la_index>(dmap.size(),
+                                                      dmap.data());
+        }
+        A.add_local(tabulated_tensors[t].data() + k*tensor_size, dofs);
+      }
+    }
+
+    p++;
+  }
+}
+//-----------------------------------------------------------------------------
 void Assembler::assemble_exterior_facets(
   GenericTensor& A,
   const Form& a,
@@ -231,8 +406,11 @@ void Assembler::assemble_exterior_facets(
 
   // Compute facets and facet - cell connectivity if not already computed
   const std::size_t D = mesh.topology().dim();
-  mesh.init(D - 1);
-  mesh.init(D - 1, D);
+  const EntityRange facets(mesh, D - 1);
+  const EntityRange cells(mesh, D, "all");
+  const MeshConnectivity& cell_vertices = cells.connectivity(0);
+  const MeshConnectivity& cell_facets = cells.connectivity(D - 1);
+  const MeshConnectivity& facet_cells = facets.connectivity(D);
   dolfin_assert(mesh.ordered());
 
   // Assemble over exterior facets (the cells of the boundary)
@@ -240,10 +418,10 @@ void Assembler::assemble_exterior_facets(
   std::vector<double> coordinate_dofs;
   Progress p(AssemblerBase::progress_message(A.rank(), "exterior facets"),
              mesh.num_facets());
-  for (FacetIterator facet(mesh); !facet.end(); ++facet)
+  for (std::size_t f : facets)
   {
     // Only consider exterior facets
-    if (!facet->exterior())
+    if (facet_cells.size_global(f) != 1)
     {
       p++;
       continue;
@@ -251,7 +429,7 @@ void Assembler::assemble_exterior_facets(
 
     // Get integral for sub domain (if any)
     if (use_domains)
-      integral = ufc.get_exterior_facet_integral((*domains)[*facet]);
+      integral = ufc.get_exterior_facet_integral((*domains)[f]);
 
     // Skip integral if zero
     if (!integral)
@@ -259,18 +437,22 @@ void Assembler::assemble_exterior_facets(
 
     // Get mesh cell to which mesh facet belongs (pick first, there is
     // only one)
-    dolfin_assert(facet->num_entities(D) == 1);
-    Cell mesh_cell(mesh, facet->entities(D)[0]);
+    dolfin_assert(facet_cells.size(f) == 1);
+    const std::size_t c = facet_cells(f)[0];
+    const Cell mesh_cell(mesh, c);
 
     // Check that cell is not a ghost
     dolfin_assert(!mesh_cell.is_ghost());
 
     // Get local index of facet with respect to the cell
-    const std::size_t local_facet = mesh_cell.index(*facet);
+    const unsigned int* local_facets = cell_facets(c);
+    const std::size_t local_facet
+      = std::find(local_facets, local_facets + cell_facets.size(c), f)
+      - local_facets;
 
     // Update UFC cell
-    mesh_cell.get_cell_data(ufc_cell, local_facet);
-    mesh_cell.get_coordinate_dofs(coordinate_dofs);
+    cells.get_cell_data(c, ufc_cell, local_facet);
+    cells.get_coordinate_dofs(c, cell_vertices, coordinate_dofs);
 
     // Update UFC object
     ufc.update(mesh_cell, coordinate_dofs, ufc_cell,
@@ -279,7 +461,7 @@ void Assembler::assemble_exterior_facets(
     // Get local-to-global dof maps for cell
     for (std::size_t i = 0; i < form_rank; ++i)
     {
-      auto dmap = dofmaps[i]->cell_dofs(mesh_cell.index());
+      auto dmap = dofmaps[i]->cell_dofs(c);
       dofs[i].set(dmap.size(), dmap.data());
     }
 
@@ -346,8 +528,11 @@ void Assembler::assemble_interior_facets(
 
   // Compute facets and facet - cell connectivity if not already computed
   const std::size_t D = mesh.topology().dim();
-  mesh.init(D - 1);
-  mesh.init(D - 1, D);
+  const EntityRange facets(mesh, D - 1);
+  const EntityRange cells(mesh, D, "all");
+  const MeshConnectivity& cell_vertices = cells.connectivity(0);
+  const MeshConnectivity& cell_facets = cells.connectivity(D - 1);
+  const MeshConnectivity& facet_cells = facets.connectivity(D);
   dolfin_assert(mesh.ordered());
 
   // Assemble over interior facets (the facets of the mesh)
@@ -355,26 +540,23 @@ void Assembler::assemble_interior_facets(
   std::vector<double> coordinate_dofs[2];
   Progress p(AssemblerBase::progress_message(A.rank(), "interior facets"),
              mesh.num_facets());
-  for (FacetIterator facet(mesh); !facet.end(); ++facet)
+  for (std::size_t f : facets)
   {
-    if (facet->num_entities(D) == 1)
+    if (facet_cells.size(f) == 1)
       continue;
 
-    // Check that facet is not a ghost
-    dolfin_assert(!facet->is_ghost());
-
     // Get integral for sub domain (if any)
     if (use_domains)
-      integral = ufc.get_interior_facet_integral((*domains)[*facet]);
+      integral = ufc.get_interior_facet_integral((*domains)[f]);
 
     // Skip integral if zero
     if (!integral)
       continue;
 
     // Get cells incident with facet (which is 0 and 1 here is arbitrary)
-    dolfin_assert(facet->num_entities(D) == 2);
-    std::size_t cell_index_plus = facet->entities(D)[0];
-    std::size_t cell_index_minus = facet->entities(D)[1];
+    dolfin_assert(facet_cells.size(f) == 2);
+    std::size_t cell_index_plus = facet_cells(f)[0];
+    std::size_t cell_index_minus = facet_cells(f)[1];
 
     if (use_cell_domains && (*cell_domains)[cell_index_plus]
         < (*cell_domains)[cell_index_minus])
@@ -387,14 +569,22 @@ void Assembler::assemble_interior_facets(
     const Cell cell1(mesh, cell_index_minus);
 
     // Get local index of facet with respect to each cell
-    std::size_t local_facet0 = cell0.index(*facet);
-    std::size_t local_facet1 = cell1.index(*facet);
+    const unsigned int* local_facets0 = cell_facets(cell_index_plus);
+    const unsigned int* local_facets1 = cell_facets(cell_index_minus);
+    const std::size_t local_facet0
+      = std::find(local_facets0, local_facets0
+                  + cell_facets.size(cell_index_plus), f) - local_facets0;
+    const std::size_t local_facet1
+      = std::find(local_facets1, local_facets1
+                  + cell_facets.size(cell_index_minus), f) - local_facets1;
 
     // Update to current pair of cells
-    cell0.get_cell_data(ufc_cell[0], local_facet0);
-    cell0.get_coordinate_dofs(coordinate_dofs[0]);
-    cell1.get_cell_data(ufc_cell[1], local_facet1);
-    cell1.get_coordinate_dofs(coordinate_dofs[1]);
+    cells.get_cell_data(cell_index_plus, ufc_cell[0], local_facet0);
+    cells.get_coordinate_dofs(cell_index_plus, cell_vertices,
+                              coordinate_dofs[0]);
+    cells.get_cell_data(cell_index_minus, ufc_cell[1], local_facet1);
+    cells.get_coordinate_dofs(cell_index_minus, cell_vertices,
+                              coordinate_dofs[1]);
 
     ufc.update(cell0, coordinate_dofs[0], ufc_cell[0],
                cell1, coordinate_dofs[1], ufc_cell[1],
@@ -68,6 +68,14 @@ namespace dolfin
     /// Assemble tensor from given form over cells. This function is
     /// provided for users who wish to build a customized assembler.
     ///
+    /// With parameters["num_threads"] greater than one, the cells
+    /// are colored so that cells of the same color share no vertex
+    /// (using parameters["graph_coloring_library"]), and the cells
+    /// of each color are assembled concurrently on the thread pool
+    /// of the process. Coefficients must then be safe to evaluate
+    /// from several threads, which excludes Expressions implemented
+    /// in Python.
+    ///
     /// @param[out] A (GenericTensor&)
     ///         The tensor to assemble.
     /// @param[in] a (Form&)
@@ -125,6 +133,15 @@ namespace dolfin
     void assemble_vertices(GenericTensor& A, const Form& a, UFC& ufc,
                            std::shared_ptr<const MeshFunction<std::size_t>> domains);
 
+  private:
+
+    // Assemble over cells with num_threads threads, one color of a
+    // vertex coloring of the cells at a time
+    void assemble_cells_threaded(GenericTensor& A, const Form& a, UFC& ufc,
+                                 std::shared_ptr<const MeshFunction<std::size_t>> domains,
+                                 std::vector<double>* values,
+                                 std::size_t num_threads);
+
   };
 
 }
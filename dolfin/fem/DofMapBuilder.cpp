@@ -35,6 +35,7 @@
 #include <dolfin/graph/SCOTCH.h>
 #include <dolfin/log/log.h>
 #include <dolfin/mesh/DistributedMeshTools.h>
+#include <dolfin/mesh/EntityRange.h>
 #include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshEntityIterator.h>
@@ -622,17 +623,19 @@ void DofMapBuilder::build_local_ufc_dofmap(
   dofmap.resize(mesh.num_cells(),
                 std::vector<la_index>(ufc_dofmap.num_element_dofs()));
   std::vector<std::size_t> dof_holder(ufc_dofmap.num_element_dofs());
-  for (CellIterator cell(mesh, "all"); !cell.end(); ++cell)
+  const EntityRange cells(mesh, D, "all");
+  const std::vector<const MeshConnectivity*> cell_entities
+    = get_cell_connectivity(cells, needs_entities);
+  for (std::size_t c : cells)
   {
     // Fill entity indices array
-    get_cell_entities_local(*cell, entity_indices, needs_entities);
+    get_cell_entities_local(c, cell_entities, entity_indices, needs_entities);
 
     // Tabulate dofs for cell
     ufc_dofmap.tabulate_dofs(dof_holder.data(),
                              num_mesh_entities,
                              entity_indices);
-    std::copy(dof_holder.begin(), dof_holder.end(),
-              dofmap[cell->index()].begin());
+    std::copy(dof_holder.begin(), dof_holder.end(), dofmap[c].begin());
   }
 }
 //-----------------------------------------------------------------------------
@@ -1128,14 +1131,17 @@ std::shared_ptr<const ufc::dofmap> DofMapBuilder::build_ufc_node_graph(
   node_local_to_global.resize(offset_local[1]);
 
   // Build dofmaps from ufc::dofmap
-  for (CellIterator cell(mesh, "all"); !cell.end(); ++cell)
+  const EntityRange cells(mesh, D, "all");
+  const std::vector<const MeshConnectivity*> cell_entities
+    = get_cell_connectivity(cells, needs_entities);
+  for (std::size_t c : cells)
   {
     // Get reference to container for cell dofs
-    std::vector<la_index>& cell_nodes = node_dofmap[cell->index()];
+    std::vector<la_index>& cell_nodes = node_dofmap[c];
     cell_nodes.resize(local_dim);
 
     // Tabulate standard UFC dof map for first space (local)
-    get_cell_entities_local(*cell, entity_indices, needs_entities);
+    get_cell_entities_local(c, cell_entities, entity_indices, needs_entities);
     dofmaps[0]->tabulate_dofs(ufc_nodes_local.data(),
                               num_mesh_entities_local,
                               entity_indices);
@@ -1143,7 +1149,8 @@ std::shared_ptr<const ufc::dofmap> DofMapBuilder::build_ufc_node_graph(
               cell_nodes.begin());
 
     // Tabulate standard UFC dof map for first space (global)
-    get_cell_entities_global(*cell, entity_indices, needs_entities);
+    get_cell_entities_global(mesh, c, cell_entities, entity_indices,
+                             needs_entities);
     dofmaps[0]->tabulate_dofs(ufc_nodes_global.data(),
                               num_mesh_entities_global_unconstrained,
                               entity_indices);
@@ -1264,14 +1271,17 @@ DofMapBuilder::build_ufc_node_graph_constrained(
   node_local_to_global.resize(offset_local[1]);
 
   // Build dofmaps from ufc::dofmap
-  for (CellIterator cell(mesh, "all"); !cell.end(); ++cell)
+  const EntityRange cells(mesh, D, "all");
+  const std::vector<const MeshConnectivity*> cell_entities
+    = get_cell_connectivity(cells, needs_entities);
+  for (std::size_t c : cells)
   {
     // Get reference to container for cell dofs
-    std::vector<la_index>& cell_nodes = node_dofmap[cell->index()];
+    std::vector<la_index>& cell_nodes = node_dofmap[c];
     cell_nodes.resize(local_dim);
 
     // Tabulate standard UFC dof map for first space (local)
-    get_cell_entities_local(*cell, entity_indices, needs_entities);
+    get_cell_entities_local(c, cell_entities, entity_indices, needs_entities);
     dofmaps[0]->tabulate_dofs(ufc_nodes_local.data(),
                               num_mesh_entities_local,
                               entity_indices);
@@ -1279,7 +1289,7 @@ DofMapBuilder::build_ufc_node_graph_constrained(
               cell_nodes.begin());
 
     // Tabulate standard UFC dof map for first space (global, constrained)
-    get_cell_entities_global_constrained(*cell, entity_indices,
+    get_cell_entities_global_constrained(c, cell_entities, entity_indices,
                                          global_entity_indices, needs_entities);
     dofmaps[0]->tabulate_dofs(ufc_nodes_global_constrained.data(),
                               num_mesh_entities_global,
@@ -1536,10 +1546,6 @@ void DofMapBuilder::compute_node_reordering(
     global_to_local_nodes_unowned(node_pairs.begin(), node_pairs.end());
   std::vector<std::pair<std::size_t, int>>().swap(node_pairs);
 
-  // Build graph for re-ordering. Below block is scoped to clear
-  // working data structures once graph is constructed.
-  Graph graph(owned_local_size);
-
   // Create contiguous local numbering for locally owned dofs
   std::size_t my_counter = 0;
   std::vector<int> old_to_contiguous_node_index(node_ownership.size(), -1);
@@ -1549,15 +1555,14 @@ void DofMapBuilder::compute_node_reordering(
       old_to_contiguous_node_index[i] = my_counter++;
   }
 
-  // Build local graph, based on old dof map, with contiguous
-  // numbering
+  // Collect the owned nodes of each cell, with contiguous numbering,
+  // skipping global nodes
+  std::vector<int> cell_offsets(1, 0), cell_nodes;
+  cell_offsets.reserve(node_dofmap.size() + 1);
   for (std::size_t cell = 0; cell < node_dofmap.size(); ++cell)
   {
     // Cell dofmaps with old local indices
     const std::vector<la_index>& nodes = node_dofmap[cell];
-    std::vector<int> local_old;
-
-    // Loop over nodes collecting valid local nodes
     for (std::size_t i = 0; i < nodes.size(); ++i)
     {
       if (global_nodes.find(nodes[i]) != global_nodes.end())
@@ -1573,17 +1578,21 @@ void DofMapBuilder::compute_node_reordering(
       // Add to graph if node n0_local is owned
       if (n0_local != -1)
       {
-        dolfin_assert(n0_local < (int) graph.size());
-        local_old.push_back(n0_local);
+        dolfin_assert(n0_local < (int) owned_local_size);
+        cell_nodes.push_back(n0_local);
       }
     }
-
-    for (std::size_t i = 0; i < local_old.size(); ++i)
-      for (std::size_t j = 0; j < local_old.size(); ++j)
-        if (i != j)
-          graph[local_old[i]].insert(local_old[j]);
+    cell_offsets.push_back(cell_nodes.size());
   }
 
+  // Build graph for re-ordering, based on old dof map, with
+  // contiguous numbering
+  const CSRGraph<int> graph
+    = GraphBuilder::local_csr_graph(owned_local_size, cell_offsets,
+                                    cell_nodes);
+  std::vector<int>().swap(cell_offsets);
+  std::vector<int>().swap(cell_nodes);
+
   // Reorder nodes
   const std::string ordering_library
     = dolfin::parameters["dof_ordering_library"];
@@ -1718,40 +1727,62 @@ void DofMapBuilder::build_dofmap(
   }
 }
 //-----------------------------------------------------------------------------
-void DofMapBuilder::get_cell_entities_local(const Cell& cell,
+std::vector<const MeshConnectivity*> DofMapBuilder::get_cell_connectivity(
+  const EntityRange& cells, const std::vector<bool>& needs_mesh_entities)
+{
+  const std::size_t D = cells.dim();
+  std::vector<const MeshConnectivity*> cell_entities(D + 1, nullptr);
+  for (std::size_t d = 0; d < D; ++d)
+    if (needs_mesh_entities[d])
+      cell_entities[d] = &cells.connectivity(d);
+  return cell_entities;
+}
+//-----------------------------------------------------------------------------
+void DofMapBuilder::get_cell_entities_local(std::size_t cell,
+  const std::vector<const MeshConnectivity*>& cell_entities,
   std::vector<std::vector<std::size_t>>& entity_indices,
   const std::vector<bool>& needs_mesh_entities)
 {
-  const std::size_t D = cell.mesh().topology().dim();
+  const std::size_t D = cell_entities.size() - 1;
   for (std::size_t d = 0; d < D; ++d)
+  {
     if (needs_mesh_entities[d])
-      for (std::size_t i = 0; i < cell.num_entities(d); ++i)
-        entity_indices[d][i] = cell.entities(d)[i];
+    {
+      const MeshConnectivity& connectivity = *cell_entities[d];
+      const unsigned int* entities = connectivity(cell);
+      for (std::size_t i = 0; i < connectivity.size(cell); ++i)
+        entity_indices[d][i] = entities[i];
+    }
+  }
   // Handle cell index separately because cell.entities(D) doesn't work.
   if (needs_mesh_entities[D])
-    entity_indices[D][0] = cell.index();
+    entity_indices[D][0] = cell;
 }
 //-----------------------------------------------------------------------------
-void DofMapBuilder::get_cell_entities_global(const Cell& cell,
+void DofMapBuilder::get_cell_entities_global(const Mesh& mesh,
+  std::size_t cell,
+  const std::vector<const MeshConnectivity*>& cell_entities,
   std::vector<std::vector<std::size_t>>& entity_indices,
   const std::vector<bool>& needs_mesh_entities)
 {
-  const MeshTopology& topology = cell.mesh().topology();
+  const MeshTopology& topology = mesh.topology();
   const std::size_t D = topology.dim();
   for (std::size_t d = 0; d < D; ++d)
   {
     if (needs_mesh_entities[d])
     {
+      const MeshConnectivity& connectivity = *cell_entities[d];
+      const unsigned int* entities = connectivity(cell);
       if (topology.have_global_indices(d)) // TODO: Check if this ever will be false in here
       {
         const auto& global_indices = topology.global_indices(d);
-        for (std::size_t i = 0; i < cell.num_entities(d); ++i)
-          entity_indices[d][i] = global_indices[cell.entities(d)[i]];
+        for (std::size_t i = 0; i < connectivity.size(cell); ++i)
+          entity_indices[d][i] = global_indices[entities[i]];
       }
       else
       {
-        for (std::size_t i = 0; i < cell.num_entities(d); ++i)
-          entity_indices[d][i] = cell.entities(d)[i];
+        for (std::size_t i = 0; i < connectivity.size(cell); ++i)
+          entity_indices[d][i] = entities[i];
       }
     }
   }
@@ -1759,19 +1790,20 @@ void DofMapBuilder::get_cell_entities_global(const Cell& cell,
   if (needs_mesh_entities[D])
   {
     if (topology.have_global_indices(D))
-      entity_indices[D][0] = cell.global_index();
+      entity_indices[D][0] = topology.global_indices(D)[cell];
     else
-      entity_indices[D][0] = cell.index();
+      entity_indices[D][0] = cell;
   }
 }
 // TODO: The above and below functions are _very_ similar, can they be combined?
 //-----------------------------------------------------------------------------
-void DofMapBuilder::get_cell_entities_global_constrained(const Cell& cell,
+void DofMapBuilder::get_cell_entities_global_constrained(std::size_t cell,
+  const std::vector<const MeshConnectivity*>& cell_entities,
   std::vector<std::vector<std::size_t>>& entity_indices,
   const std::vector<std::vector<std::int64_t>>& global_entity_indices,
   const std::vector<bool>& needs_mesh_entities)
 {
-  const std::size_t D = cell.mesh().topology().dim();
+  const std::size_t D = cell_entities.size() - 1;
   for (std::size_t d = 0; d < D; ++d)
   {
     if (needs_mesh_entities[d])
@@ -1785,8 +1817,10 @@ void DofMapBuilder::get_cell_entities_global_constrained(const Cell& cell,
       if (!global_entity_indices[d].empty()) // TODO: Can this be false? If so the entity_indices array will contain garbage
       {
         const auto& global_indices = global_entity_indices[d];
-        for (std::size_t i = 0; i < cell.num_entities(d); ++i)
-          entity_indices[d][i] = global_indices[cell.entities(d)[i]];
+        const MeshConnectivity& connectivity = *cell_entities[d];
+        const unsigned int* entities = connectivity(cell);
+        for (std::size_t i = 0; i < connectivity.size(cell); ++i)
+          entity_indices[d][i] = global_indices[entities[i]];
       }
     }
   }
@@ -1800,7 +1834,7 @@ void DofMapBuilder::get_cell_entities_global_constrained(const Cell& cell,
                    "Missing global cell index needed for cell index tabulation.");
     }
     //entity_indices[D][0] = cell.index(); // This was the line here before, don't understand how that didn't fail miserably.
-    entity_indices[D][0] = global_entity_indices[D][cell.index()];
+    entity_indices[D][0] = global_entity_indices[D][cell];
   }
 }
 //-----------------------------------------------------------------------------
@@ -43,7 +43,8 @@ namespace dolfin
   class IndexMap;
   class SubDomain;
   class UFC;
-  class Cell;
+  class EntityRange;
+  class MeshConnectivity;
 
   /// Builds a DofMap on a Mesh
 
@@ -194,15 +195,23 @@ namespace dolfin
       const std::set<std::size_t>& global_nodes,
       const MPI_Comm mpi_comm);
 
-    static void get_cell_entities_local(const Cell& cell,
+    // Get cell-entity connectivity for the entities of each
+    // dimension required by dofmap (null if not required)
+    static std::vector<const MeshConnectivity*> get_cell_connectivity(
+      const EntityRange& cells, const std::vector<bool>& needs_mesh_entities);
+
+    static void get_cell_entities_local(std::size_t cell,
+      const std::vector<const MeshConnectivity*>& cell_entities,
       std::vector<std::vector<std::size_t>>& entity_indices,
       const std::vector<bool>& needs_mesh_entities);
 
-    static void get_cell_entities_global(const Cell& cell,
+    static void get_cell_entities_global(const Mesh& mesh, std::size_t cell,
+      const std::vector<const MeshConnectivity*>& cell_entities,
       std::vector<std::vector<std::size_t>>& entity_indices,
       const std::vector<bool>& needs_mesh_entities);
 
-    static void get_cell_entities_global_constrained(const Cell& cell,
+    static void get_cell_entities_global_constrained(std::size_t cell,
+      const std::vector<const MeshConnectivity*>& cell_entities,
       std::vector<std::vector<std::size_t>>& entity_indices,
       const std::vector<std::vector<std::int64_t>>& global_entity_indices,
       const std::vector<bool>& needs_mesh_entities);
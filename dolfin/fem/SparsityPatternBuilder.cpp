@@ -23,15 +23,19 @@
 
 #include <dolfin/common/ArrayView.h>
 #include <dolfin/common/MPI.h>
+#include <dolfin/common/threads.h>
+#include <dolfin/la/IndexMap.h>
 #include <dolfin/la/SparsityPattern.h>
 #include <dolfin/log/log.h>
 #include <dolfin/log/Progress.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/EntityRange.h>
 #include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MultiMesh.h>
 #include <dolfin/mesh/Vertex.h>
 #include <dolfin/function/FunctionSpace.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include <dolfin/function/MultiMeshFunctionSpace.h>
 #include "MultiMeshDofMap.h"
 #include "MultiMeshForm.h"
@@ -39,6 +43,95 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Entities (cells or facets) of a mesh sorted by the ranges of
+  // rows (or columns, according to primary dimension) that they
+  // insert into. The ranges are the chunks of
+  // parallel_for(num_threads, num_owned_rows), with the non-local
+  // rows in the last range, so that the thread that inserts into a
+  // range visits only the entities with rows in that range. Entities
+  // are sorted in one parallel pass. With a single range nothing is
+  // stored and all entities are visited.
+  class RowRangeEntities
+  {
+  public:
+
+    // Sort entities [0, num_entities), where entity_rows(e, rows)
+    // sets rows to the local rows of entity e. Entities without rows
+    // are not visited.
+    template <typename F>
+    RowRangeEntities(std::size_t num_threads, std::size_t num_owned_rows,
+                     std::size_t num_entities, F entity_rows)
+      : _num_ranges(std::max<std::size_t>(1, std::min(num_threads,
+                                                      num_owned_rows))),
+        _num_entities(num_entities)
+    {
+      if (_num_ranges == 1)
+        return;
+
+      const std::size_t num_ranges = _num_ranges;
+      _entities.resize(std::max<std::size_t>(1, std::min(num_threads,
+                                                         num_entities)));
+      parallel_for(num_threads, num_entities,
+        [&](std::size_t s, std::size_t begin, std::size_t end)
+        {
+          std::vector<std::vector<std::size_t>>& entities = _entities[s];
+          entities.resize(num_ranges);
+
+          // Last entity added to each range
+          std::vector<std::size_t> last(num_ranges, end);
+          std::vector<dolfin::la_index> rows;
+          for (std::size_t e = begin; e < end; ++e)
+          {
+            entity_rows(e, rows);
+            for (auto row : rows)
+            {
+              // Range t such that t*n/T <= row < (t + 1)*n/T
+              const std::size_t t = (std::size_t) row < num_owned_rows
+                ? (((std::uint64_t) row + 1)*num_ranges - 1)/num_owned_rows
+                : num_ranges - 1;
+              if (last[t] != e)
+              {
+                entities[t].push_back(e);
+                last[t] = e;
+              }
+            }
+          }
+        });
+    }
+
+    // Call f(e) for the entities with rows in range t, in increasing
+    // order
+    template <typename F>
+    void for_each(std::size_t t, F f) const
+    {
+      if (_num_ranges == 1)
+      {
+        for (std::size_t e = 0; e < _num_entities; ++e)
+          f(e);
+        return;
+      }
+
+      for (const auto& entities : _entities)
+      {
+        for (std::size_t e : entities[t])
+          f(e);
+      }
+    }
+
+  private:
+
+    // Number of row ranges and of entities
+    std::size_t _num_ranges, _num_entities;
+
+    // Entities of chunk s of the entities with rows in range t
+    // (_entities[s][t])
+    std::vector<std::vector<std::vector<std::size_t>>> _entities;
+
+  };
+}
+
 //-----------------------------------------------------------------------------
 void
 SparsityPatternBuilder::build(SparsityPattern& sparsity_pattern,
@@ -92,9 +185,6 @@ SparsityPatternBuilder::build_mixed(SparsityPattern& sparsity_pattern,
   if (rank < 2)
     return;
 
-  // Vector to store macro-dofs, if required (for interior facets)
-  std::vector<std::vector<dolfin::la_index>> macro_dofs(rank);
-
   // Create vector to point to dofs
   std::vector<ArrayView<const dolfin::la_index>> dofs(rank);
   std::vector<std::vector<dolfin::la_index>> dmaps(rank);
@@ -110,6 +200,25 @@ SparsityPatternBuilder::build_mixed(SparsityPattern& sparsity_pattern,
   dofmaps[sparsity_pattern.primary_dim()]->tabulate_global_dofs(global_dofs0);
   sparsity_pattern.insert_full_rows_local(global_dofs0);
 
+  // Rows (or columns, according to primary dimension) are split into
+  // one range per thread, and each thread inserts entries in its own
+  // rows only, from the cells or facets with rows in its range, so
+  // that threads do not share rows. The last range includes the
+  // non-local rows.
+  const std::size_t num_threads = (int) parameters["num_threads"];
+  const GenericDofMap& primary_dofmap
+    = *dofmaps[sparsity_pattern.primary_dim()];
+  const IndexMap& primary_index_map
+    = *index_maps[sparsity_pattern.primary_dim()];
+  const std::size_t num_owned_rows
+    = primary_index_map.size(IndexMap::MapSize::OWNED);
+  const std::size_t num_rows = primary_index_map.size(IndexMap::MapSize::ALL);
+  auto row_range = [num_owned_rows, num_rows](std::size_t begin,
+                                              std::size_t end)
+    {
+      return std::make_pair(begin, end == num_owned_rows ? num_rows : end);
+    };
+
   // FIXME: We iterate over the entire mesh even if the function space
   // is restricted. This works out fine since the local dofmap
   // returned on each cell will be an empty vector, but we might think
@@ -118,63 +227,103 @@ SparsityPatternBuilder::build_mixed(SparsityPattern& sparsity_pattern,
   // Build sparsity pattern for cell integrals
   if (cells)
   {
-    Progress p("Building sparsity pattern over cells", mesh.num_cells());
     auto mapping_map = mesh.topology().mapping();
 
-    for (CellIterator cell(mesh); !cell.end(); ++cell)
+    // Check if any of the dofmaps lives on a mesh view of the mesh
+    bool has_mapping = false;
+    for (std::size_t i = 0; i < rank; ++i)
+      has_mapping = has_mapping
+        || (mesh_ids[i] != mesh.id() && mapping_map[mesh_ids[i]]);
+
+    const EntityRange mesh_cells(mesh, mesh.topology().dim());
+
+    // Insert cell dofs directly if all dofmaps live on this mesh
+    if (!has_mapping)
     {
-      std::vector<std::vector<std::size_t>> cell_index(rank);
-      std::vector<std::size_t> codim(rank);
-      for (std::size_t i = 0; i < rank; ++i)
+      Progress p("Building sparsity pattern over cells");
+      const RowRangeEntities range_cells(num_threads, num_owned_rows,
+                                         mesh_cells.size(),
+        [&](std::size_t e, std::vector<dolfin::la_index>& rows)
+        {
+          auto dmap = primary_dofmap.cell_dofs(mesh_cells.begin()[e]);
+          rows.assign(dmap.data(), dmap.data() + dmap.size());
+        });
+      parallel_for(num_threads, num_owned_rows,
+        [&](std::size_t t, std::size_t begin, std::size_t end)
+        {
+          const auto rows = row_range(begin, end);
+          std::vector<ArrayView<const dolfin::la_index>> cell_dofs(rank);
+          range_cells.for_each(t, [&](std::size_t e)
+          {
+            const std::size_t c = mesh_cells.begin()[e];
+            for (std::size_t i = 0; i < rank; ++i)
+            {
+              auto dmap = dofmaps[i]->cell_dofs(c);
+              cell_dofs[i].set(dmap.size(), dmap.data());
+            }
+            sparsity_pattern.insert_local(cell_dofs, rows);
+          });
+        });
+      p = 1.0;
+    }
+    else
+    {
+      Progress p("Building sparsity pattern over cells", mesh.num_cells());
+      for (std::size_t c : mesh_cells)
       {
-	cell_index[i].push_back(cell->index());
-
-	if(mesh_ids[i] != mesh.id() && mapping_map[mesh_ids[i]])
-	{
-	  auto mapping = mapping_map[mesh_ids[i]];
-	  dolfin_assert(mapping->mesh()->id() == mesh_ids[i]);
-
-	  codim[i] = mapping->mesh()->topology().dim() - mesh.topology().dim();
-	  if(codim[i] == 0)
-	    cell_index[i][0] = mapping->cell_map()[cell->index()];
-	  else if(codim[i] == 1)
-	  {
-	    const std::size_t D = mapping->mesh()->topology().dim();
-	    mapping->mesh()->init(D);
-	    mapping->mesh()->init(D - 1, D);
-
-	    Facet mesh_facet(*(mapping->mesh()), mapping->cell_map()[cell->index()]);
-	    for(std::size_t j=0; j<mesh_facet.num_entities(D);j++)
-	    {
-	      Cell mesh_cell(*(mapping->mesh()), mesh_facet.entities(D)[j]);
-	      if(j==0)
-		cell_index[i][0] = mesh_cell.index();
-	      else
-		cell_index[i].push_back(mesh_cell.index());
-	    }
-	  }
+        std::vector<std::vector<std::size_t>> cell_index(rank);
+        std::vector<std::size_t> codim(rank);
+        for (std::size_t i = 0; i < rank; ++i)
+        {
+          cell_index[i].push_back(c);
+
+          if(mesh_ids[i] != mesh.id() && mapping_map[mesh_ids[i]])
+          {
+            auto mapping = mapping_map[mesh_ids[i]];
+            dolfin_assert(mapping->mesh()->id() == mesh_ids[i]);
+
+            codim[i] = mapping->mesh()->topology().dim() - mesh.topology().dim();
+            if(codim[i] == 0)
+              cell_index[i][0] = mapping->cell_map()[c];
+            else if(codim[i] == 1)
+            {
+              const std::size_t D = mapping->mesh()->topology().dim();
+              mapping->mesh()->init(D);
+              mapping->mesh()->init(D - 1, D);
+
+              Facet mesh_facet(*(mapping->mesh()), mapping->cell_map()[c]);
+              for(std::size_t j=0; j<mesh_facet.num_entities(D);j++)
+              {
+                Cell mesh_cell(*(mapping->mesh()), mesh_facet.entities(D)[j]);
+                if(j==0)
+                  cell_index[i][0] = mesh_cell.index();
+                else
+                  cell_index[i].push_back(mesh_cell.index());
+              }
+            }
 #if 0 // Confusing when we are considering 3D-1D uncoupled problem
-	  else if(codim[i] == 2)
-	    std::cout << "[SparsityBuilder] codim 2 - Not implemented" << std::endl;
+            else if(codim[i] == 2)
+              std::cout << "[SparsityBuilder] codim 2 - Not implemented" << std::endl;
 #endif
-	}
-      }
+          }
+        }
 
-      std::size_t nlocal_facets = cell_index[0].size();
-      if(rank > 1)
-	nlocal_facets = std::max(cell_index[0].size(), cell_index[1].size());
+        std::size_t nlocal_facets = cell_index[0].size();
+        if(rank > 1)
+          nlocal_facets = std::max(cell_index[0].size(), cell_index[1].size());
 
-      for(std::size_t j=0; j<nlocal_facets; ++j)
-      {
-	for(std::size_t i=0; i<rank; ++i)
-	{
-	  std::size_t jidx  = (codim[i] != 0) ? j:0;
-	  auto dmap = dofmaps[i]->cell_dofs(cell_index[i][jidx]);
-	  dofs[i].set(dmap.size(), dmap.data());
-	}
-	sparsity_pattern.insert_local(dofs);
+        for(std::size_t j=0; j<nlocal_facets; ++j)
+        {
+          for(std::size_t i=0; i<rank; ++i)
+          {
+            std::size_t jidx  = (codim[i] != 0) ? j:0;
+            auto dmap = dofmaps[i]->cell_dofs(cell_index[i][jidx]);
+            dofs[i].set(dmap.size(), dmap.data());
+          }
+          sparsity_pattern.insert_local(dofs);
+        }
+        p++;
       }
-      p++;
     }
   }
 
@@ -235,8 +384,8 @@ SparsityPatternBuilder::build_mixed(SparsityPattern& sparsity_pattern,
   {
     // Compute facets and facet - cell connectivity if not already
     // computed
-    mesh.init(D - 1);
-    mesh.init(D - 1, D);
+    const EntityRange facets(mesh, D - 1);
+    const MeshConnectivity& facet_cells = facets.connectivity(D);
     if (!mesh.ordered())
     {
       dolfin_error("SparsityPatternBuilder.cpp",
@@ -245,69 +394,98 @@ SparsityPatternBuilder::build_mixed(SparsityPattern& sparsity_pattern,
                    "Consider calling mesh.order()");
     }
 
-    Progress p("Building sparsity pattern over interior facets",
-               mesh.num_facets());
-    for (FacetIterator facet(mesh); !facet.end(); ++facet)
-    {
-      bool this_exterior_facet = false;
-      if (facet->num_global_entities(D) == 1)
-        this_exterior_facet = true;
+    Progress p("Building sparsity pattern over interior facets");
 
-      // Check facet type
-      if (exterior_facets && this_exterior_facet && !cells)
+    // Rows of the facets that insert entries: exterior facets when
+    // cells are not inserted, and interior facets with both cells on
+    // this process
+    const RowRangeEntities range_facets(num_threads, num_owned_rows,
+                                        facets.size(),
+      [&](std::size_t e, std::vector<dolfin::la_index>& rows)
       {
-        // Get cells incident with facet
-        dolfin_assert(facet->num_entities(D) == 1);
-        Cell cell(mesh, facet->entities(D)[0]);
-
-        // Tabulate dofs for each dimension and get local dimensions
-        for (std::size_t i = 0; i < rank; ++i)
+        rows.clear();
+        const std::size_t f = facets.begin()[e];
+        const bool this_exterior_facet = facet_cells.size_global(f) == 1;
+        if ((exterior_facets && this_exterior_facet && !cells)
+            || (interior_facets && !this_exterior_facet
+                && facet_cells.size(f) == 2))
         {
-          auto dmap = dofmaps[i]->cell_dofs(cell.index());
-          dofs[i].set(dmap.size(), dmap.data());
+          for (std::size_t j = 0; j < facet_cells.size(f); ++j)
+          {
+            auto dmap = primary_dofmap.cell_dofs(facet_cells(f)[j]);
+            rows.insert(rows.end(), dmap.data(), dmap.data() + dmap.size());
+          }
         }
-
-        // Insert dofs
-        sparsity_pattern.insert_local(dofs);
-      }
-      else if (interior_facets && !this_exterior_facet)
+      });
+    parallel_for(num_threads, num_owned_rows,
+      [&](std::size_t t, std::size_t begin, std::size_t end)
       {
-        if (facet->num_entities(D) == 1)
+        const auto rows = row_range(begin, end);
+        std::vector<ArrayView<const dolfin::la_index>> facet_dofs(rank);
+        std::vector<std::vector<dolfin::la_index>> macro_dofs(rank);
+        range_facets.for_each(t, [&](std::size_t e)
         {
-          dolfin_assert(facet->is_ghost());
-          continue;
-        }
-
-        // Get cells incident with facet
-        dolfin_assert(facet->num_entities(D) == 2);
-        Cell cell0(mesh, facet->entities(D)[0]);
-        Cell cell1(mesh, facet->entities(D)[1]);
-
-        // Tabulate dofs for each dimension on macro element
-        for (std::size_t i = 0; i < rank; i++)
-        {
-          // Get dofs for each cell
-          auto cell_dofs0 = dofmaps[i]->cell_dofs(cell0.index());
-          auto cell_dofs1 = dofmaps[i]->cell_dofs(cell1.index());
-
-          // Create space in macro dof vector
-          macro_dofs[i].resize(cell_dofs0.size() + cell_dofs1.size());
-
-          // Copy cell dofs into macro dof vector
-          std::copy(cell_dofs0.data(), cell_dofs0.data() + cell_dofs0.size(),
-                    macro_dofs[i].begin());
-          std::copy(cell_dofs1.data(), cell_dofs1.data() + cell_dofs1.size(),
-                    macro_dofs[i].begin() + cell_dofs0.size());
-
-          // Store pointer to macro dofs
-          dofs[i].set(macro_dofs[i]);
-        }
-
-        // Insert dofs
-        sparsity_pattern.insert_local(dofs);
-      }
-      p++;
-    }
+          const std::size_t f = facets.begin()[e];
+          bool this_exterior_facet = false;
+          if (facet_cells.size_global(f) == 1)
+            this_exterior_facet = true;
+
+          // Check facet type
+          if (exterior_facets && this_exterior_facet && !cells)
+          {
+            // Get cells incident with facet
+            dolfin_assert(facet_cells.size(f) == 1);
+            const std::size_t cell = facet_cells(f)[0];
+
+            // Tabulate facet_dofs for each dimension and get local dimensions
+            for (std::size_t i = 0; i < rank; ++i)
+            {
+              auto dmap = dofmaps[i]->cell_dofs(cell);
+              facet_dofs[i].set(dmap.size(), dmap.data());
+            }
+
+            // Insert facet_dofs
+            sparsity_pattern.insert_local(facet_dofs, rows);
+          }
+          else if (interior_facets && !this_exterior_facet)
+          {
+            if (facet_cells.size(f) == 1)
+            {
+              dolfin_assert(f >= mesh.topology().ghost_offset(D - 1));
+              return;
+            }
+
+            // Get cells incident with facet
+            dolfin_assert(facet_cells.size(f) == 2);
+            const std::size_t cell0 = facet_cells(f)[0];
+            const std::size_t cell1 = facet_cells(f)[1];
+
+            // Tabulate facet_dofs for each dimension on macro element
+            for (std::size_t i = 0; i < rank; i++)
+            {
+              // Get facet_dofs for each cell
+              auto cell_dofs0 = dofmaps[i]->cell_dofs(cell0);
+              auto cell_dofs1 = dofmaps[i]->cell_dofs(cell1);
+
+              // Create space in macro dof vector
+              macro_dofs[i].resize(cell_dofs0.size() + cell_dofs1.size());
+
+              // Copy cell facet_dofs into macro dof vector
+              std::copy(cell_dofs0.data(), cell_dofs0.data() + cell_dofs0.size(),
+                        macro_dofs[i].begin());
+              std::copy(cell_dofs1.data(), cell_dofs1.data() + cell_dofs1.size(),
+                        macro_dofs[i].begin() + cell_dofs0.size());
+
+              // Store pointer to macro facet_dofs
+              facet_dofs[i].set(macro_dofs[i]);
+            }
+
+            // Insert facet_dofs
+            sparsity_pattern.insert_local(facet_dofs, rows);
+          }
+        });
+      });
+    p = 1.0;
   }
 
   if (diagonal)
@@ -234,15 +234,22 @@ void Function::operator=(const FunctionAXPY& axpy)
   if (axpy.pairs()[0].first != 1.0)
     *_vector *= axpy.pairs()[0].first;
 
-  // Start from item 2 and axpy
+  // Start from item 2 and add the remaining terms in one fused
+  // multiple-axpy operation
+  std::vector<double> a;
+  std::vector<const GenericVector*> x;
   std::vector<std::pair<double, std::shared_ptr<const Function>>>
     ::const_iterator it;
   for (it = axpy.pairs().begin()+1; it != axpy.pairs().end(); it++)
   {
     dolfin_assert(it->second);
     dolfin_assert(it->second->vector());
-    _vector->axpy(it->first, *(it->second->vector()));
+    a.push_back(it->first);
+    x.push_back(it->second->vector().get());
   }
+
+  if (!x.empty())
+    _vector->maxpy(a, x);
 }
 //-----------------------------------------------------------------------------
 std::shared_ptr<GenericVector> Function::vector()
@@ -0,0 +1,86 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+#include <dolfin/common/Timer.h>
+#include <dolfin/fem/FiniteElement.h>
+#include <dolfin/fem/GenericDofMap.h>
+#include <dolfin/la/GenericVector.h>
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/DistributedMeshTools.h>
+#include <dolfin/mesh/Mesh.h>
+#include "Function.h"
+#include "FunctionSpace.h"
+#include "migrate.h"
+
+//-----------------------------------------------------------------------------
+void dolfin::migrate(const Function& u0, Function& u1)
+{
+  Timer timer("Migrate function");
+
+  // Check that the function spaces match
+  dolfin_assert(u0.function_space());
+  dolfin_assert(u1.function_space());
+  const FunctionSpace& V0 = *u0.function_space();
+  const FunctionSpace& V1 = *u1.function_space();
+  dolfin_assert(V0.element());
+  dolfin_assert(V1.element());
+  if (V0.element()->signature() != V1.element()->signature())
+  {
+    dolfin_error("migrate.cpp",
+                 "migrate function",
+                 "The functions must be in the same type of FunctionSpace");
+  }
+
+  dolfin_assert(V0.mesh());
+  dolfin_assert(V1.mesh());
+  const Mesh& mesh0 = *V0.mesh();
+  const Mesh& mesh1 = *V1.mesh();
+  const std::size_t D = mesh0.topology().dim();
+
+  dolfin_assert(V0.dofmap());
+  dolfin_assert(V1.dofmap());
+  const GenericDofMap& dofmap0 = *V0.dofmap();
+  const GenericDofMap& dofmap1 = *V1.dofmap();
+  const std::size_t width = dofmap0.max_element_dofs();
+
+  // Collect the cell-wise dof values of the regular cells
+  const std::size_t num_cells0 = mesh0.topology().ghost_offset(D);
+  const GenericVector& x0 = *u0.vector();
+  std::vector<double> data0(num_cells0*width);
+  for (std::size_t c = 0; c < num_cells0; ++c)
+  {
+    auto dofs = dofmap0.cell_dofs(c);
+    dolfin_assert((std::size_t) dofs.size() == width);
+    x0.get_local(data0.data() + c*width, dofs.size(), dofs.data());
+  }
+
+  // Send to the cells of the new mesh
+  const std::vector<double> data1
+    = DistributedMeshTools::migrate_cell_data(mesh0, data0, width, mesh1);
+
+  // Set dof values
+  GenericVector& x1 = *u1.vector();
+  for (std::size_t c = 0; c < mesh1.num_cells(); ++c)
+  {
+    auto dofs = dofmap1.cell_dofs(c);
+    dolfin_assert((std::size_t) dofs.size() == width);
+    x1.set_local(data1.data() + c*width, dofs.size(), dofs.data());
+  }
+  x1.apply("insert");
+}
+//-----------------------------------------------------------------------------
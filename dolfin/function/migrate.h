@@ -0,0 +1,40 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __DOLFIN_MIGRATE_H
+#define __DOLFIN_MIGRATE_H
+
+namespace dolfin
+{
+
+  class Function;
+
+  /// Transfer the degrees of freedom of a function to a function on
+  /// another distribution of the same mesh, e.g. a mesh returned by
+  /// MeshPartitioning::repartition. The functions must reside in the
+  /// same type of FunctionSpace. The values are copied exactly, cell
+  /// by cell.
+  ///
+  /// @param    u0 (_Function_)
+  ///         The function on the old mesh
+  /// @param    u1 (_Function_)
+  ///         The receiving function on the new mesh
+  void migrate(const Function& u0, Function& u1);
+
+}
+
+#endif
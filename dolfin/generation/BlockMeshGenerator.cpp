@@ -0,0 +1,457 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/multi_array.hpp>
+
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/Timer.h>
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/DistributedMeshTools.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshEditor.h>
+#include <dolfin/mesh/MeshRenumbering.h>
+#include <dolfin/parameter/GlobalParameters.h>
+#include "BlockMeshGenerator.h"
+
+using namespace dolfin;
+
+namespace
+{
+  // Range of boxes [begin[d], end[d]) in each direction
+  struct BoxRange
+  {
+    std::array<std::size_t, 3> begin, end;
+
+    bool empty() const
+    {
+      return begin[0] >= end[0] || begin[1] >= end[1] || begin[2] >= end[2];
+    }
+
+    std::size_t size() const
+    {
+      return empty() ? 0
+        : (end[0] - begin[0])*(end[1] - begin[1])*(end[2] - begin[2]);
+    }
+
+    bool contains(std::size_t ix, std::size_t iy, std::size_t iz) const
+    {
+      return ix >= begin[0] && ix < end[0] && iy >= begin[1] && iy < end[1]
+        && iz >= begin[2] && iz < end[2];
+    }
+
+    // Range grown by w boxes on each side, within the grid n
+    BoxRange grow(std::size_t w, const std::array<std::size_t, 3>& n) const
+    {
+      BoxRange r = *this;
+      if (empty())
+        return r;
+      for (std::size_t d = 0; d < 3; ++d)
+      {
+        r.begin[d] = begin[d] > w ? begin[d] - w : 0;
+        r.end[d] = std::min(end[d] + w, n[d]);
+      }
+      return r;
+    }
+
+    BoxRange intersect(const BoxRange& other) const
+    {
+      BoxRange r;
+      for (std::size_t d = 0; d < 3; ++d)
+      {
+        r.begin[d] = std::max(begin[d], other.begin[d]);
+        r.end[d] = std::min(end[d], other.end[d]);
+      }
+      return r;
+    }
+
+    // Call f(ix, iy, iz) for each box in the range, with x running
+    // fastest
+    template<typename F>
+    void for_each(F f) const
+    {
+      if (empty())
+        return;
+      for (std::size_t iz = begin[2]; iz < end[2]; ++iz)
+        for (std::size_t iy = begin[1]; iy < end[1]; ++iy)
+          for (std::size_t ix = begin[0]; ix < end[0]; ++ix)
+            f(ix, iy, iz);
+    }
+  };
+
+  // Decomposition of a grid of boxes into blocks, one per process,
+  // by recursive bisection of the grid: the longest direction of a
+  // range of boxes is cut in proportion to the number of processes
+  // on each side
+  class Decomposition
+  {
+  public:
+
+    Decomposition(const std::array<std::size_t, 3>& n, std::size_t num_blocks)
+      : _blocks(num_blocks)
+    {
+      BoxRange grid;
+      grid.begin = {{0, 0, 0}};
+      grid.end = n;
+      bisect(grid, 0, num_blocks);
+    }
+
+    // Boxes of the block of a process
+    const BoxRange& block(std::size_t rank) const
+    { return _blocks[rank]; }
+
+    // Process owning box (ix, iy, iz)
+    std::size_t owner(std::size_t ix, std::size_t iy, std::size_t iz) const
+    {
+      const std::array<std::size_t, 3> i = {{ix, iy, iz}};
+      std::size_t lo = 0, hi = _blocks.size();
+      while (hi - lo > 1)
+      {
+        std::size_t mid = (lo + hi)/2;
+        std::size_t d = _cuts[mid].first;
+        if (i[d] < _cuts[mid].second)
+          hi = mid;
+        else
+          lo = mid;
+      }
+      return lo;
+    }
+
+    // True if every process has at least one box
+    bool complete() const
+    {
+      for (auto& block : _blocks)
+      {
+        if (block.empty())
+          return false;
+      }
+      return true;
+    }
+
+  private:
+
+    // Assign the boxes of range r to processes [p0, p1), recording
+    // at the first process of the upper half the direction and
+    // position of the cut
+    void bisect(const BoxRange& r, std::size_t p0, std::size_t p1)
+    {
+      if (p1 - p0 == 1)
+      {
+        _blocks[p0] = r;
+        return;
+      }
+
+      std::size_t d = 0;
+      for (std::size_t e = 1; e < 3; ++e)
+      {
+        if (r.end[e] - r.begin[e] > r.end[d] - r.begin[d])
+          d = e;
+      }
+      const std::size_t mid = (p0 + p1)/2;
+      const std::size_t extent = r.end[d] - r.begin[d];
+      std::size_t cut = r.begin[d]
+        + (extent*(mid - p0) + (p1 - p0)/2)/(p1 - p0);
+      if (extent > 1)
+        cut = std::max(r.begin[d] + 1, std::min(cut, r.end[d] - 1));
+      _cuts.resize(_blocks.size());
+      _cuts[mid] = {d, cut};
+
+      BoxRange lower = r, upper = r;
+      lower.end[d] = cut;
+      upper.begin[d] = cut;
+      bisect(lower, p0, mid);
+      bisect(upper, mid, p1);
+    }
+
+    std::vector<BoxRange> _blocks;
+    std::vector<std::pair<std::size_t, std::size_t>> _cuts;
+
+  };
+}
+
+//-----------------------------------------------------------------------------
+bool BlockMeshGenerator::build(Mesh& mesh, CellType::Type cell_type,
+                               std::size_t gdim, std::array<std::size_t, 3> n,
+                               std::size_t cells_per_box,
+                               std::int64_t num_global_vertices,
+                               const BoxCells& box_cells,
+                               const VertexCoordinates& vertex_coordinates)
+{
+  log(PROGRESS, "Build distributed mesh from blocks of a structured grid");
+  Timer timer("Build distributed mesh from blocks");
+
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
+  const std::size_t mpi_size = MPI::size(mpi_comm);
+  const std::size_t mpi_rank = MPI::rank(mpi_comm);
+  const std::string ghost_mode = parameters["ghost_mode"];
+
+  std::unique_ptr<CellType> _cell_type(CellType::create(cell_type));
+  const std::size_t tdim = _cell_type->dim();
+  const std::size_t num_cell_vertices = _cell_type->num_vertices();
+  const std::size_t k = cells_per_box;
+  const std::int64_t num_global_cells = n[0]*n[1]*n[2]*k;
+
+  // Block of this process, and the boxes that may hold its ghost
+  // cells
+  const Decomposition decomposition(n, mpi_size);
+  if (!decomposition.complete())
+    return false;
+  const BoxRange& block = decomposition.block(mpi_rank);
+  const BoxRange layer = block.grow(ghost_mode == "none" ? 0 : 1, n);
+
+  // Global index of a box, and local index of a box in the block
+  auto global_box = [&n](std::size_t ix, std::size_t iy, std::size_t iz)
+    { return (std::int64_t) ((iz*n[1] + iy)*n[0] + ix); };
+  auto local_box = [&block](std::size_t ix, std::size_t iy, std::size_t iz)
+    {
+      return ((iz - block.begin[2])*(block.end[1] - block.begin[1])
+              + iy - block.begin[1])*(block.end[0] - block.begin[0])
+        + ix - block.begin[0];
+    };
+
+  // Regular cells
+  const std::size_t num_regular_cells = block.size()*k;
+  std::vector<std::int64_t> cell_vertices(num_regular_cells*num_cell_vertices);
+  std::vector<std::int64_t> global_cell_indices(num_regular_cells);
+  block.for_each([&](std::size_t ix, std::size_t iy, std::size_t iz)
+    {
+      const std::size_t c = local_box(ix, iy, iz)*k;
+      box_cells(ix, iy, iz, cell_vertices.data() + c*num_cell_vertices);
+      for (std::size_t j = 0; j < k; ++j)
+        global_cell_indices[c + j] = global_box(ix, iy, iz)*k + j;
+    });
+
+  // Number the vertices of the regular cells
+  std::unordered_map<std::int64_t, std::int32_t> vertex_global_to_local;
+  std::vector<std::int64_t> vertex_indices;
+  for (auto v : cell_vertices)
+  {
+    if (vertex_global_to_local.insert({v, vertex_indices.size()}).second)
+      vertex_indices.push_back(v);
+  }
+  const std::size_t num_regular_vertices = vertex_indices.size();
+
+  // Ghost cells are the cells in neighbouring boxes that share a
+  // vertex (or facet) with the regular cells
+  std::vector<std::size_t> facet_vertices;
+  if (ghost_mode == "shared_facet")
+  {
+    std::vector<unsigned int> v(num_cell_vertices);
+    for (std::size_t i = 0; i < num_cell_vertices; ++i)
+      v[i] = i;
+    boost::multi_array<unsigned int, 2> facets;
+    _cell_type->create_entities(facets, tdim - 1, v.data());
+    facet_vertices.assign(facets.data(), facets.data() + facets.num_elements());
+  }
+  const std::size_t num_facet_vertices = _cell_type->num_vertices(tdim - 1);
+  auto is_regular_vertex = [&](std::int64_t v)
+    {
+      auto it = vertex_global_to_local.find(v);
+      return it != vertex_global_to_local.end()
+        && (std::size_t) it->second < num_regular_vertices;
+    };
+
+  std::vector<std::int64_t> box_vertices(k*num_cell_vertices);
+  std::vector<unsigned int> cell_owner;
+  std::unordered_map<std::int64_t, std::int32_t> ghost_global_to_local;
+  layer.for_each([&](std::size_t ix, std::size_t iy, std::size_t iz)
+    {
+      if (block.contains(ix, iy, iz))
+        return;
+      box_cells(ix, iy, iz, box_vertices.data());
+      for (std::size_t j = 0; j < k; ++j)
+      {
+        const std::int64_t* v = box_vertices.data() + j*num_cell_vertices;
+        bool ghost = false;
+        if (ghost_mode == "shared_facet")
+        {
+          for (std::size_t f = 0; f < facet_vertices.size() && !ghost;
+               f += num_facet_vertices)
+          {
+            ghost = true;
+            for (std::size_t i = 0; i < num_facet_vertices; ++i)
+              ghost = ghost && is_regular_vertex(v[facet_vertices[f + i]]);
+          }
+        }
+        else
+        {
+          for (std::size_t i = 0; i < num_cell_vertices && !ghost; ++i)
+            ghost = is_regular_vertex(v[i]);
+        }
+
+        if (ghost)
+        {
+          const std::int64_t g = global_box(ix, iy, iz)*k + j;
+          ghost_global_to_local[g] = global_cell_indices.size();
+          global_cell_indices.push_back(g);
+          cell_vertices.insert(cell_vertices.end(), v, v + num_cell_vertices);
+          cell_owner.push_back(decomposition.owner(ix, iy, iz));
+        }
+      }
+    });
+
+  // Number the vertices of the ghost cells
+  for (std::size_t i = num_regular_cells*num_cell_vertices;
+       i < cell_vertices.size(); ++i)
+  {
+    if (vertex_global_to_local.insert({cell_vertices[i],
+                                       vertex_indices.size()}).second)
+    {
+      vertex_indices.push_back(cell_vertices[i]);
+    }
+  }
+
+  // Build local mesh
+  MeshEditor editor;
+  editor.open(mesh, cell_type, tdim, gdim);
+  editor.init_vertices_global(vertex_indices.size(), num_global_vertices);
+  std::vector<double> x(gdim);
+  for (std::size_t i = 0; i < vertex_indices.size(); ++i)
+  {
+    vertex_coordinates(vertex_indices[i], x.data());
+    editor.add_vertex_global(i, vertex_indices[i], x);
+  }
+  const std::size_t num_cells = global_cell_indices.size();
+  editor.init_cells_global(num_cells, num_global_cells);
+  std::vector<std::size_t> cell(num_cell_vertices);
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    for (std::size_t i = 0; i < num_cell_vertices; ++i)
+      cell[i] = vertex_global_to_local[cell_vertices[c*num_cell_vertices + i]];
+    editor.add_cell(c, global_cell_indices[c], cell);
+  }
+  editor.close();
+
+  // Local index of a global cell, or -1 if the cell is not on this
+  // process
+  auto local_cell = [&](std::int64_t g) -> std::int64_t
+    {
+      const std::size_t box = g/k;
+      const std::size_t ix = box % n[0];
+      const std::size_t iy = (box/n[0]) % n[1];
+      const std::size_t iz = box/(n[0]*n[1]);
+      if (block.contains(ix, iy, iz))
+        return local_box(ix, iy, iz)*k + g % k;
+      auto it = ghost_global_to_local.find(g);
+      return it == ghost_global_to_local.end() ? -1 : it->second;
+    };
+
+  // Processes that may share vertices or cells with this process:
+  // those whose ghost layer lies next to the ghost layer of this
+  // process
+  const BoxRange reach = layer.grow(1, n);
+  std::vector<std::size_t> neighbours;
+  if (!block.empty())
+  {
+    const std::size_t w = ghost_mode == "none" ? 0 : 1;
+    for (std::size_t q = 0; q < mpi_size; ++q)
+    {
+      const BoxRange other
+        = decomposition.block(q);
+      if (q != mpi_rank && !other.empty()
+          && !other.grow(w, n).intersect(reach).empty())
+      {
+        neighbours.push_back(q);
+      }
+    }
+  }
+
+  // Send to each neighbour the vertices of the local cells that it
+  // may also hold, and the ghost cells of this process
+  std::vector<std::vector<std::int64_t>> send_vertices(mpi_size);
+  std::vector<std::vector<std::int64_t>> send_ghosts(mpi_size);
+  const MeshConnectivity& connectivity = mesh.topology()(tdim, 0);
+  for (auto q : neighbours)
+  {
+    const BoxRange other = decomposition.block(q).grow(ghost_mode == "none" ? 1 : 2, n);
+    std::vector<std::int64_t>& vertices = send_vertices[q];
+    layer.intersect(other).for_each(
+      [&](std::size_t ix, std::size_t iy, std::size_t iz)
+      {
+        for (std::size_t j = 0; j < k; ++j)
+        {
+          const std::int64_t c = local_cell(global_box(ix, iy, iz)*k + j);
+          if (c < 0)
+            continue;
+          for (std::size_t i = 0; i < num_cell_vertices; ++i)
+            vertices.push_back(vertex_indices[connectivity(c)[i]]);
+        }
+      });
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                   vertices.end());
+
+    send_ghosts[q].assign(global_cell_indices.begin() + num_regular_cells,
+                          global_cell_indices.end());
+  }
+  std::vector<std::vector<std::int64_t>> received_vertices, received_ghosts;
+  MPI::all_to_all(mpi_comm, send_vertices, received_vertices);
+  MPI::all_to_all(mpi_comm, send_ghosts, received_ghosts);
+
+  // Shared vertices: local vertices that neighbours also hold
+  std::map<std::int32_t, std::set<unsigned int>> shared_vertices;
+  for (std::size_t q = 0; q < mpi_size; ++q)
+  {
+    for (auto v : received_vertices[q])
+    {
+      auto it = vertex_global_to_local.find(v);
+      if (it != vertex_global_to_local.end())
+        shared_vertices[it->second].insert(q);
+    }
+  }
+
+  // Shared cells: ghost cells are shared with their owner, and cells
+  // are shared with the processes that hold them as ghosts
+  std::map<std::int32_t, std::set<unsigned int>> shared_cells;
+  for (std::size_t c = num_regular_cells; c < num_cells; ++c)
+    shared_cells[c].insert(cell_owner[c - num_regular_cells]);
+  for (std::size_t q = 0; q < mpi_size; ++q)
+  {
+    for (auto g : received_ghosts[q])
+    {
+      const std::int64_t c = local_cell(g);
+      if (c >= 0)
+        shared_cells[c].insert(q);
+    }
+  }
+
+  // Set ghost and sharing data (as MeshPartitioning::build)
+  mesh.topology().cell_owner() = cell_owner;
+  mesh.topology().init_ghost(tdim, num_regular_cells);
+  mesh.topology().init_ghost(0, num_regular_vertices);
+  mesh.topology().shared_entities(tdim) = shared_cells;
+  mesh.topology().shared_entities(0) = shared_vertices;
+  mesh._ghost_mode = ghost_mode;
+
+  // Renumber cells and vertices within each block along a
+  // space-filling curve
+  const std::string locality_ordering = parameters["reorder_mesh_locality"];
+  if (locality_ordering != "none")
+    MeshRenumbering::renumber_by_locality(mesh, locality_ordering);
+
+  // Initialise number of globally connected cells to each facet
+  DistributedMeshTools::init_facet_cell_connections(mesh);
+
+  return true;
+}
+//-----------------------------------------------------------------------------
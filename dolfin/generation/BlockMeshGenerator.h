@@ -0,0 +1,90 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __BLOCK_MESH_GENERATOR_H
+#define __BLOCK_MESH_GENERATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <dolfin/mesh/CellType.h>
+
+namespace dolfin
+{
+
+  class Mesh;
+
+  /// This class builds distributed meshes of structured grids of
+  /// nx x ny x nz boxes, in which each process generates only its
+  /// own block of boxes, together with a layer of ghost cells (as
+  /// given by the parameter "ghost_mode") and the information about
+  /// shared vertices and cells. The blocks follow from a recursive
+  /// bisection of the grid that every process computes, so the
+  /// global mesh is never built and the mesh is not partitioned.
+  /// Global cell and vertex indices are the same as for the mesh
+  /// built in serial.
+  ///
+  /// The grid generators (BoxMesh, RectangleMesh) use this class
+  /// when the parameter "mesh_generation" is "block".
+
+  class BlockMeshGenerator
+  {
+  public:
+
+    /// Function that computes the global vertex indices of the
+    /// cells of grid box (ix, iy, iz), stored cell by cell
+    typedef std::function<void(std::size_t, std::size_t, std::size_t,
+                               std::int64_t*)> BoxCells;
+
+    /// Function that computes the coordinates of a global vertex
+    typedef std::function<void(std::int64_t, double*)> VertexCoordinates;
+
+    /// Build the local part of a distributed mesh of a grid of boxes
+    ///
+    /// @param    mesh (_Mesh_)
+    ///         Mesh to build.
+    /// @param    cell_type (CellType::Type)
+    ///         Cell type.
+    /// @param    gdim (std::size_t)
+    ///         Geometric dimension.
+    /// @param    n (std::array<std::size_t, 3>)
+    ///         Number of boxes in each direction (1 in unused
+    ///         directions).
+    /// @param    cells_per_box (std::size_t)
+    ///         Number of cells in each box.
+    /// @param    num_global_vertices (std::int64_t)
+    ///         Number of vertices of the global mesh.
+    /// @param    box_cells (BoxCells)
+    ///         Cells of a box.
+    /// @param    vertex_coordinates (VertexCoordinates)
+    ///         Coordinates of a vertex.
+    ///
+    /// @return     bool
+    ///         False if the grid has too few boxes to give each
+    ///         process a block, in which case the mesh is not built.
+    static bool build(Mesh& mesh, CellType::Type cell_type, std::size_t gdim,
+                      std::array<std::size_t, 3> n, std::size_t cells_per_box,
+                      std::int64_t num_global_vertices,
+                      const BoxCells& box_cells,
+                      const VertexCoordinates& vertex_coordinates);
+
+  };
+
+}
+
+#endif
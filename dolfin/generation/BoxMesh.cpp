@@ -21,7 +21,9 @@
 // First added:  2005-12-02
 // Last changed: 2015-06-15
 
+#include <algorithm>
 #include <cmath>
+#include <string>
 #include <boost/multi_array.hpp>
 
 #include <dolfin/common/constants.h>
@@ -29,10 +31,88 @@
 #include <dolfin/common/Timer.h>
 #include <dolfin/mesh/MeshPartitioning.h>
 #include <dolfin/mesh/MeshEditor.h>
+#include <dolfin/parameter/GlobalParameters.h>
+#include "BlockMeshGenerator.h"
 #include "BoxMesh.h"
 
 using namespace dolfin;
 
+namespace
+{
+  // Vertices of the six tetrahedra of box (ix, iy, iz)
+  template<typename T>
+  void box_tetrahedra(std::size_t nx, std::size_t ny, std::size_t ix,
+                      std::size_t iy, std::size_t iz, T* cells)
+  {
+    const T v0 = iz*(nx + 1)*(ny + 1) + iy*(nx + 1) + ix;
+    const T v1 = v0 + 1;
+    const T v2 = v0 + (nx + 1);
+    const T v3 = v1 + (nx + 1);
+    const T v4 = v0 + (nx + 1)*(ny + 1);
+    const T v5 = v1 + (nx + 1)*(ny + 1);
+    const T v6 = v2 + (nx + 1)*(ny + 1);
+    const T v7 = v3 + (nx + 1)*(ny + 1);
+
+    // Note that v0 < v1 < v2 < v3 < vmid.
+    const T c[24] = {v0, v1, v3, v7,
+                     v0, v1, v7, v5,
+                     v0, v5, v7, v4,
+                     v0, v3, v2, v7,
+                     v0, v6, v4, v7,
+                     v0, v2, v6, v7};
+    std::copy(c, c + 24, cells);
+  }
+
+  // Vertices of the hexahedron of box (ix, iy, iz)
+  template<typename T>
+  void box_hexahedron(std::size_t nx, std::size_t ny, std::size_t ix,
+                      std::size_t iy, std::size_t iz, T* v)
+  {
+    v[0] = (iz*(ny + 1) + iy)*(nx + 1) + ix;
+    v[1] = v[0] + 1;
+    v[2] = v[0] + (nx + 1);
+    v[3] = v[1] + (nx + 1);
+    v[4] = v[0] + (nx + 1)*(ny + 1);
+    v[5] = v[1] + (nx + 1)*(ny + 1);
+    v[6] = v[2] + (nx + 1)*(ny + 1);
+    v[7] = v[3] + (nx + 1)*(ny + 1);
+  }
+
+  // Build the local block of a distributed box mesh without building
+  // the global mesh (returns false if the grid is too small)
+  bool build_blocks(Mesh& mesh, CellType::Type cell_type,
+                    const std::array<double, 6>& bounds,
+                    std::array<std::size_t, 3> n)
+  {
+    const std::size_t nx = n[0];
+    const std::size_t ny = n[1];
+    const std::size_t nz = n[2];
+    const bool tet = cell_type == CellType::Type::tetrahedron;
+    auto box_cells = [nx, ny, tet](std::size_t ix, std::size_t iy,
+                                   std::size_t iz, std::int64_t* cells)
+      {
+        if (tet)
+          box_tetrahedra(nx, ny, ix, iy, iz, cells);
+        else
+          box_hexahedron(nx, ny, ix, iy, iz, cells);
+      };
+    auto vertex_coordinates = [nx, ny, nz, bounds](std::int64_t v, double* x)
+      {
+        const std::size_t ix = v % (nx + 1);
+        const std::size_t iy = (v/(nx + 1)) % (ny + 1);
+        const std::size_t iz = v/((nx + 1)*(ny + 1));
+        const double a = bounds[0], b = bounds[1], c = bounds[2];
+        const double d = bounds[3], e = bounds[4], f = bounds[5];
+        x[0] = a + (static_cast<double>(ix))*(b - a)/static_cast<double>(nx);
+        x[1] = c + (static_cast<double>(iy))*(d - c)/static_cast<double>(ny);
+        x[2] = e + (static_cast<double>(iz))*(f - e)/static_cast<double>(nz);
+      };
+    return BlockMeshGenerator::build(mesh, cell_type, 3, n, tet ? 6 : 1,
+                                     (nx + 1)*(ny + 1)*(nz + 1), box_cells,
+                                     vertex_coordinates);
+  }
+}
+
 //-----------------------------------------------------------------------------
 BoxMesh::BoxMesh(const Point& p0, const Point& p1,
                  std::size_t nx, std::size_t ny, std::size_t nz)
@@ -52,13 +132,6 @@ void BoxMesh::build_tet(Mesh& mesh, const std::array<Point,2 >& p,
 {
   Timer timer("Build BoxMesh");
 
-  // Receive mesh according to parallel policy
-  if (MPI::is_receiver(mesh.mpi_comm()))
-  {
-    MeshPartitioning::build_distributed_mesh(mesh);
-    return;
-  }
-
   // Extract data
   const Point& p0 = p[0];
   const Point& p1 = p[1];
@@ -98,6 +171,22 @@ void BoxMesh::build_tet(Mesh& mesh, const std::array<Point,2 >& p,
 
   mesh.rename("mesh", "Mesh of the cuboid (a,b) x (c,d) x (e,f)");
 
+  // Build local block of distributed mesh
+  if (MPI::size(mesh.mpi_comm()) > 1
+      && std::string(dolfin::parameters["mesh_generation"]) == "block"
+      && build_blocks(mesh, CellType::Type::tetrahedron,
+                      {{a, b, c, d, e, f}}, n))
+  {
+    return;
+  }
+
+  // Receive mesh according to parallel policy
+  if (MPI::is_receiver(mesh.mpi_comm()))
+  {
+    MeshPartitioning::build_distributed_mesh(mesh);
+    return;
+  }
+
   // Open mesh for editing
   MeshEditor editor;
   editor.open(mesh, CellType::Type::tetrahedron, 3, 3);
@@ -134,22 +223,7 @@ void BoxMesh::build_tet(Mesh& mesh, const std::array<Point,2 >& p,
     {
       for (std::size_t ix = 0; ix < nx; ix++)
       {
-        const std::size_t v0 = iz*(nx + 1)*(ny + 1) + iy*(nx + 1) + ix;
-        const std::size_t v1 = v0 + 1;
-        const std::size_t v2 = v0 + (nx + 1);
-        const std::size_t v3 = v1 + (nx + 1);
-        const std::size_t v4 = v0 + (nx + 1)*(ny + 1);
-        const std::size_t v5 = v1 + (nx + 1)*(ny + 1);
-        const std::size_t v6 = v2 + (nx + 1)*(ny + 1);
-        const std::size_t v7 = v3 + (nx + 1)*(ny + 1);
-
-        // Note that v0 < v1 < v2 < v3 < vmid.
-        cells[0][0] = v0; cells[0][1] = v1; cells[0][2] = v3; cells[0][3] = v7;
-        cells[1][0] = v0; cells[1][1] = v1; cells[1][2] = v7; cells[1][3] = v5;
-        cells[2][0] = v0; cells[2][1] = v5; cells[2][2] = v7; cells[2][3] = v4;
-        cells[3][0] = v0; cells[3][1] = v3; cells[3][2] = v2; cells[3][3] = v7;
-        cells[4][0] = v0; cells[4][1] = v6; cells[4][2] = v4; cells[4][3] = v7;
-        cells[5][0] = v0; cells[5][1] = v2; cells[5][2] = v6; cells[5][3] = v7;
+        box_tetrahedra(nx, ny, ix, iy, iz, cells.data());
 
         // Add cells
         for (auto _cell = cells.begin(); _cell != cells.end(); ++_cell)
@@ -172,13 +246,6 @@ void BoxMesh::build_tet(Mesh& mesh, const std::array<Point,2 >& p,
 void BoxMesh::build_hex(Mesh& mesh, const std::array<Point, 2>& p,
                         std::array<std::size_t, 3> n)
 {
-  // Receive mesh according to parallel policy
-  if (MPI::is_receiver(mesh.mpi_comm()))
-  {
-    MeshPartitioning::build_distributed_mesh(mesh);
-    return;
-  }
-
   // Extract data
   const Point& p0 = p[0];
   const Point& p1 = p[1];
@@ -194,6 +261,22 @@ void BoxMesh::build_hex(Mesh& mesh, const std::array<Point, 2>& p,
   const double z0 = std::min(p0.z(), p1.z());
   const double z1 = std::max(p0.z(), p1.z());
 
+  // Build local block of distributed mesh
+  if (MPI::size(mesh.mpi_comm()) > 1
+      && std::string(dolfin::parameters["mesh_generation"]) == "block"
+      && build_blocks(mesh, CellType::Type::hexahedron,
+                      {{x0, x1, y0, y1, z0, z1}}, n))
+  {
+    return;
+  }
+
+  // Receive mesh according to parallel policy
+  if (MPI::is_receiver(mesh.mpi_comm()))
+  {
+    MeshPartitioning::build_distributed_mesh(mesh);
+    return;
+  }
+
   MeshEditor editor;
   editor.open(mesh, CellType::Type::hexahedron, 3, 3);
 
@@ -238,14 +321,7 @@ void BoxMesh::build_hex(Mesh& mesh, const std::array<Point, 2>& p,
     {
       for (std::size_t ix = 0; ix < nx; ix++)
       {
-        v[0] = (iz*(ny + 1) + iy)*(nx + 1) + ix;
-        v[1] = v[0] + 1;
-        v[2] = v[0] + (nx + 1);
-        v[3] = v[1] + (nx + 1);
-        v[4] = v[0] + (nx + 1)*(ny + 1);
-        v[5] = v[1] + (nx + 1)*(ny + 1);
-        v[6] = v[2] + (nx + 1)*(ny + 1);
-        v[7] = v[3] + (nx + 1)*(ny + 1);
+        box_hexahedron(nx, ny, ix, iy, iz, v.data());
         editor.add_cell(cell, v);
         ++cell;
       }
@@ -15,17 +15,123 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <cmath>
+#include <string>
 #include <boost/multi_array.hpp>
 
 #include <dolfin/common/constants.h>
 #include <dolfin/common/MPI.h>
 #include <dolfin/mesh/MeshEditor.h>
 #include <dolfin/mesh/MeshPartitioning.h>
+#include <dolfin/parameter/GlobalParameters.h>
+#include "BlockMeshGenerator.h"
 #include "RectangleMesh.h"
 
 using namespace dolfin;
 
+namespace
+{
+  // Vertices of the triangles of box (ix, iy) for the given diagonal
+  // option
+  template<typename T>
+  void box_triangles(std::size_t nx, std::size_t ny, std::size_t ix,
+                     std::size_t iy, const std::string& diagonal, T* cells)
+  {
+    const T v0 = iy*(nx + 1) + ix;
+    const T v1 = v0 + 1;
+    const T v2 = v0 + (nx + 1);
+    const T v3 = v1 + (nx + 1);
+
+    if (diagonal == "crossed")
+    {
+      const T vmid = (nx + 1)*(ny + 1) + iy*nx + ix;
+
+      // Note that v0 < v1 < v2 < v3 < vmid.
+      const T c[12] = {v0, v1, vmid,
+                       v0, v2, vmid,
+                       v1, v3, vmid,
+                       v2, v3, vmid};
+      std::copy(c, c + 12, cells);
+      return;
+    }
+
+    // Alternating diagonals start with "left" on even rows for
+    // "right/left" and on odd rows for "left/right", and switch from
+    // box to box
+    bool left = diagonal == "left";
+    if (diagonal == "right/left" || diagonal == "left/right")
+      left = ((diagonal == "right/left") == (iy % 2 == 0)) == (ix % 2 == 0);
+
+    if (left)
+    {
+      const T c[6] = {v0, v1, v2, v1, v2, v3};
+      std::copy(c, c + 6, cells);
+    }
+    else
+    {
+      const T c[6] = {v0, v1, v3, v0, v2, v3};
+      std::copy(c, c + 6, cells);
+    }
+  }
+
+  // Vertices of the quadrilateral of box (ix, iy)
+  template<typename T>
+  void box_quadrilateral(std::size_t nx, std::size_t ix, std::size_t iy, T* v)
+  {
+    v[0] = iy*(nx + 1) + ix;
+    v[1] = v[0] + 1;
+    v[2] = v[0] + (nx + 1);
+    v[3] = v[1] + (nx + 1);
+  }
+
+  // Build the local block of a distributed rectangle mesh without
+  // building the global mesh (returns false if the grid is too small)
+  bool build_blocks(Mesh& mesh, CellType::Type cell_type,
+                    std::string diagonal, const std::array<double, 4>& bounds,
+                    std::array<std::size_t, 2> n)
+  {
+    const std::size_t nx = n[0];
+    const std::size_t ny = n[1];
+    const bool quad = cell_type == CellType::Type::quadrilateral;
+    const bool crossed = diagonal == "crossed";
+    auto box_cells = [nx, ny, quad, diagonal](std::size_t ix, std::size_t iy,
+                                              std::size_t iz,
+                                              std::int64_t* cells)
+      {
+        if (quad)
+          box_quadrilateral(nx, ix, iy, cells);
+        else
+          box_triangles(nx, ny, ix, iy, diagonal, cells);
+      };
+    auto vertex_coordinates = [nx, ny, bounds](std::int64_t v, double* x)
+      {
+        const double a = bounds[0], b = bounds[1];
+        const double c = bounds[2], d = bounds[3];
+        const std::int64_t num_grid_vertices = (nx + 1)*(ny + 1);
+        if (v < num_grid_vertices)
+        {
+          const std::size_t ix = v % (nx + 1);
+          const std::size_t iy = v/(nx + 1);
+          x[0] = a + ((static_cast<double>(ix))*(b - a)/static_cast<double>(nx));
+          x[1] = c + ((static_cast<double>(iy))*(d - c)/static_cast<double>(ny));
+        }
+        else
+        {
+          // Midpoint vertex of crossed box
+          const std::size_t ix = (v - num_grid_vertices) % nx;
+          const std::size_t iy = (v - num_grid_vertices)/nx;
+          x[0] = a + (static_cast<double>(ix) + 0.5)*(b - a)/static_cast<double>(nx);
+          x[1] = c +(static_cast<double>(iy) + 0.5)*(d - c)/static_cast<double>(ny);
+        }
+      };
+    return BlockMeshGenerator::build(mesh, cell_type, 2, {{nx, ny, 1}},
+                                     quad ? 1 : (crossed ? 4 : 2),
+                                     (nx + 1)*(ny + 1) + (crossed ? nx*ny : 0),
+                                     box_cells, vertex_coordinates);
+  }
+}
+
 //-----------------------------------------------------------------------------
 RectangleMesh::RectangleMesh(const Point& p0, const Point& p1,
                              std::size_t nx, std::size_t ny,
@@ -47,13 +153,6 @@ void RectangleMesh::build_tri(Mesh& mesh, const std::array<Point, 2>& p,
                               std::array<std::size_t, 2> n,
                               std::string diagonal)
 {
-  // Receive mesh according to parallel policy
-  if (MPI::is_receiver(mesh.mpi_comm()))
-  {
-    MeshPartitioning::build_distributed_mesh(mesh);
-    return;
-  }
-
   // Check options
   if (diagonal != "left" && diagonal != "right" && diagonal != "right/left"
           && diagonal != "left/right" && diagonal != "crossed")
@@ -96,6 +195,22 @@ void RectangleMesh::build_tri(Mesh& mesh, const std::array<Point, 2>& p,
 
   mesh.rename("mesh", "Mesh of the unit square (a,b) x (c,d)");
 
+  // Build local block of distributed mesh
+  if (MPI::size(mesh.mpi_comm()) > 1
+      && std::string(dolfin::parameters["mesh_generation"]) == "block"
+      && build_blocks(mesh, CellType::Type::triangle,
+                      diagonal, {{a, b, c, d}}, n))
+  {
+    return;
+  }
+
+  // Receive mesh according to parallel policy
+  if (MPI::is_receiver(mesh.mpi_comm()))
+  {
+    MeshPartitioning::build_distributed_mesh(mesh);
+    return;
+  }
+
   // Open mesh for editing
   MeshEditor editor;
   editor.open(mesh, CellType::Type::triangle, 2, 2);
@@ -146,78 +261,17 @@ void RectangleMesh::build_tri(Mesh& mesh, const std::array<Point, 2>& p,
 
   // Create triangles
   std::size_t cell = 0;
-  if (diagonal == "crossed")
-  {
-    boost::multi_array<std::size_t, 2> cells(boost::extents[4][3]);
-    for (std::size_t iy = 0; iy < ny; iy++)
-    {
-      for (std::size_t ix = 0; ix < nx; ix++)
-      {
-        const std::size_t v0 = iy*(nx + 1) + ix;
-        const std::size_t v1 = v0 + 1;
-        const std::size_t v2 = v0 + (nx + 1);
-        const std::size_t v3 = v1 + (nx + 1);
-        const std::size_t vmid = (nx + 1)*(ny + 1) + iy*nx + ix;
-
-        // Note that v0 < v1 < v2 < v3 < vmid.
-        cells[0][0] = v0; cells[0][1] = v1; cells[0][2] = vmid;
-        cells[1][0] = v0; cells[1][1] = v2; cells[1][2] = vmid;
-        cells[2][0] = v1; cells[2][1] = v3; cells[2][2] = vmid;
-        cells[3][0] = v2; cells[3][1] = v3; cells[3][2] = vmid;
-
-        // Add cells
-        for (auto _cell = cells.begin(); _cell != cells.end(); ++_cell)
-          editor.add_cell(cell++, *_cell);
-      }
-    }
-  }
-  else if (diagonal == "left" || diagonal == "right" || diagonal == "right/left" || diagonal == "left/right")
+  const std::size_t cells_per_box = diagonal == "crossed" ? 4 : 2;
+  boost::multi_array<std::size_t, 2> cells(boost::extents[cells_per_box][3]);
+  for (std::size_t iy = 0; iy < ny; iy++)
   {
-    std::string local_diagonal = diagonal;
-    boost::multi_array<std::size_t, 2> cells(boost::extents[2][3]);
-    for (std::size_t iy = 0; iy < ny; iy++)
+    for (std::size_t ix = 0; ix < nx; ix++)
     {
-      // Set up alternating diagonal
-      if (diagonal == "right/left")
-      {
-        if (iy % 2)
-          local_diagonal = "right";
-        else
-          local_diagonal = "left";
-      }
-      if (diagonal == "left/right")
-      {
-        if (iy % 2)
-          local_diagonal = "left";
-        else
-          local_diagonal = "right";
-      }
+      box_triangles(nx, ny, ix, iy, diagonal, cells.data());
 
-      for (std::size_t ix = 0; ix < nx; ix++)
-      {
-        const std::size_t v0 = iy*(nx + 1) + ix;
-        const std::size_t v1 = v0 + 1;
-        const std::size_t v2 = v0 + (nx + 1);
-        const std::size_t v3 = v1 + (nx + 1);
-        std::vector<std::size_t> cell_data;
-
-        if(local_diagonal == "left")
-        {
-          cells[0][0] = v0; cells[0][1] = v1; cells[0][2] = v2;
-          cells[1][0] = v1; cells[1][1] = v2; cells[1][2] = v3;
-          if (diagonal == "right/left" || diagonal == "left/right")
-            local_diagonal = "right";
-        }
-        else
-        {
-          cells[0][0] = v0; cells[0][1] = v1; cells[0][2] = v3;
-          cells[1][0] = v0; cells[1][1] = v2; cells[1][2] = v3;
-          if (diagonal == "right/left" || diagonal == "left/right")
-            local_diagonal = "left";
-        }
-        editor.add_cell(cell++, cells[0]);
-        editor.add_cell(cell++, cells[1]);
-      }
+      // Add cells
+      for (auto _cell = cells.begin(); _cell != cells.end(); ++_cell)
+        editor.add_cell(cell++, *_cell);
     }
   }
 
@@ -235,6 +289,32 @@ void RectangleMesh::build_tri(Mesh& mesh, const std::array<Point, 2>& p,
 void RectangleMesh::build_quad(Mesh& mesh, const std::array<Point, 2>& p,
                                std::array<std::size_t, 2> n)
 {
+  const std::size_t nx = n[0];
+  const std::size_t ny = n[1];
+
+  const Point& p0 = p[0];
+  const Point& p1 = p[1];
+
+  // Extract minimum and maximum coordinates
+  const double x0 = std::min(p0.x(), p1.x());
+  const double x1 = std::max(p0.x(), p1.x());
+  const double y0 = std::min(p0.y(), p1.y());
+  const double y1 = std::max(p0.y(), p1.y());
+
+  const double a = x0;
+  const double b = x1;
+  const double c = y0;
+  const double d = y1;
+
+  // Build local block of distributed mesh
+  if (MPI::size(mesh.mpi_comm()) > 1
+      && std::string(dolfin::parameters["mesh_generation"]) == "block"
+      && build_blocks(mesh, CellType::Type::quadrilateral,
+                      "", {{a, b, c, d}}, n))
+  {
+    return;
+  }
+
   // Receive mesh according to parallel policy
   if (MPI::is_receiver(mesh.mpi_comm()))
   {
@@ -242,9 +322,6 @@ void RectangleMesh::build_quad(Mesh& mesh, const std::array<Point, 2>& p,
     return;
   }
 
-  const std::size_t nx = n[0];
-  const std::size_t ny = n[1];
-
   MeshEditor editor;
   editor.open(mesh, CellType::Type::quadrilateral, 2, 2);
 
@@ -255,20 +332,6 @@ void RectangleMesh::build_quad(Mesh& mesh, const std::array<Point, 2>& p,
   // Storage for vertices
   std::vector<double> x(2);
 
-  const Point& p0 = p[0];
-  const Point& p1 = p[1];
-  
-  // Extract minimum and maximum coordinates
-  const double x0 = std::min(p0.x(), p1.x());
-  const double x1 = std::max(p0.x(), p1.x());
-  const double y0 = std::min(p0.y(), p1.y());
-  const double y1 = std::max(p0.y(), p1.y());
-
-  const double a = x0;
-  const double b = x1;
-  const double c = y0;
-  const double d = y1;
-
   // Create main vertices:
   std::size_t vertex = 0;
   for (std::size_t iy = 0; iy <= ny; iy++)
@@ -288,10 +351,7 @@ void RectangleMesh::build_quad(Mesh& mesh, const std::array<Point, 2>& p,
   for (std::size_t iy = 0; iy < ny; iy++)
     for (std::size_t ix = 0; ix < nx; ix++)
     {
-      v[0] = iy*(nx + 1) + ix;
-      v[1] = v[0] + 1;
-      v[2] = v[0] + (nx + 1);
-      v[3] = v[1] + (nx + 1);
+      box_quadrilateral(nx, ix, iy, v.data());
       editor.add_cell(cell, v);
       ++cell;
     }
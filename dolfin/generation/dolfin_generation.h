@@ -3,6 +3,7 @@
 
 // DOLFIN mesh generation interface
 
+#include <dolfin/generation/BlockMeshGenerator.h>
 #include <dolfin/generation/BoxMesh.h>
 #include <dolfin/generation/IntervalMesh.h>
 #include <dolfin/generation/RectangleMesh.h>
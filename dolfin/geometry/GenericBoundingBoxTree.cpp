@@ -24,11 +24,13 @@
 #define MAX_DIM 6
 
 #include <dolfin/common/MPI.h>
+#include <dolfin/common/threads.h>
 #include <dolfin/geometry/Point.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/MeshEntity.h>
 #include <dolfin/mesh/MeshEntityIterator.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "BoundingBoxTree1D.h" // used for internal point search tree
 #include "BoundingBoxTree2D.h" // used for internal point search tree
 #include "BoundingBoxTree3D.h" // used for internal point search tree
@@ -91,17 +93,34 @@ void GenericBoundingBoxTree::build(const Mesh& mesh, std::size_t tdim)
   // Create bounding boxes for all entities (leaves)
   const std::size_t _gdim = gdim();
   const unsigned int num_leaves = mesh.num_entities(tdim);
+  const std::size_t num_regular = mesh.topology().ghost_offset(tdim);
+  const std::size_t num_threads = (int) parameters["num_threads"];
+  const MeshConnectivity& entity_vertices = mesh.topology()(tdim, 0);
+  const MeshGeometry& geometry = mesh.geometry();
   std::vector<double> leaf_bboxes(2*_gdim*num_leaves);
-  for (MeshEntityIterator it(mesh, tdim); !it.end(); ++it)
-    compute_bbox_of_entity(leaf_bboxes.data() + 2*_gdim*it->index(), *it, _gdim);
+  parallel_for(num_threads, num_regular,
+    [&](std::size_t, std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        compute_bbox_of_vertices(leaf_bboxes.data() + 2*_gdim*i, geometry,
+                                 entity_vertices(i), entity_vertices.size(i),
+                                 _gdim);
+      }
+    });
 
   // Create leaf partition (to be sorted)
   std::vector<unsigned int> leaf_partition(num_leaves);
   for (unsigned int i = 0; i < num_leaves; ++i)
     leaf_partition[i] = i;
 
-  // Recursively build the bounding box tree from the leaves
-  _build(leaf_bboxes, leaf_partition.begin(), leaf_partition.end(), _gdim);
+  // Recursively build the bounding box tree from the leaves, with
+  // about two subtrees per thread built concurrently
+  std::size_t depth = 0;
+  while (num_threads > 1 and (std::size_t(1) << depth) < 2*num_threads)
+    ++depth;
+  _build_parallel(leaf_bboxes, leaf_partition.begin(), leaf_partition.end(),
+                  _gdim, depth);
 
   log(PROGRESS,
       "Computed bounding box tree with %d nodes for %d entities.",
@@ -371,6 +390,61 @@ GenericBoundingBoxTree::_build(const std::vector<double>& leaf_bboxes,
 }
 //-----------------------------------------------------------------------------
 unsigned int
+GenericBoundingBoxTree::_build_parallel(const std::vector<double>& leaf_bboxes,
+                               const std::vector<unsigned int>::iterator& begin,
+                               const std::vector<unsigned int>::iterator& end,
+                               std::size_t gdim, std::size_t depth)
+{
+  // Build small subtrees serially
+  if (depth == 0 or end - begin < 1024)
+    return _build(leaf_bboxes, begin, end, gdim);
+
+  // Compute bounding box of all bounding boxes
+  BBox bbox;
+  double b[MAX_DIM];
+  std::size_t axis;
+  compute_bbox_of_bboxes(b, axis, leaf_bboxes, begin, end);
+
+  // Sort bounding boxes along longest axis
+  std::vector<unsigned int>::iterator middle = begin + (end - begin) / 2;
+  sort_bboxes(axis, leaf_bboxes, begin, middle, end);
+
+  // Build the two subtrees concurrently, as separate trees
+  const std::vector<unsigned int>::iterator ranges[3] = {begin, middle, end};
+  std::shared_ptr<GenericBoundingBoxTree> subtrees[2]
+    = {create(gdim), create(gdim)};
+  parallel_for(2, 2, [&](std::size_t t, std::size_t, std::size_t)
+               {
+                 subtrees[t]->_build_parallel(leaf_bboxes, ranges[t],
+                                              ranges[t + 1], gdim,
+                                              depth - 1);
+               });
+
+  // Add subtrees and root in the order of _build
+  bbox.child_0 = add_tree(*subtrees[0]);
+  bbox.child_1 = add_tree(*subtrees[1]);
+  return add_bbox(bbox, b, gdim);
+}
+//-----------------------------------------------------------------------------
+unsigned int GenericBoundingBoxTree::add_tree(const GenericBoundingBoxTree& tree)
+{
+  // Shift child indices, except the entity indices of leaves
+  const unsigned int offset = num_bboxes();
+  for (unsigned int i = 0; i < tree.num_bboxes(); ++i)
+  {
+    BBox bbox = tree._bboxes[i];
+    if (!tree.is_leaf(bbox, i))
+      bbox.child_1 += offset;
+    bbox.child_0 += offset;
+    _bboxes.push_back(bbox);
+  }
+  _bbox_coordinates.insert(_bbox_coordinates.end(),
+                           tree._bbox_coordinates.begin(),
+                           tree._bbox_coordinates.end());
+  return _bboxes.size() - 1;
+}
+//-----------------------------------------------------------------------------
+unsigned int
 GenericBoundingBoxTree::_build(const std::vector<Point>& points,
                                const std::vector<unsigned int>::iterator& begin,
                                const std::vector<unsigned int>::iterator& end,
@@ -727,15 +801,21 @@ void GenericBoundingBoxTree::build_point_search_tree(const Mesh& mesh) const
 void GenericBoundingBoxTree::compute_bbox_of_entity(double* b,
                                                     const MeshEntity& entity,
                                                     std::size_t gdim) const
+{
+  compute_bbox_of_vertices(b, entity.mesh().geometry(), entity.entities(0),
+                           entity.num_entities(0), gdim);
+}
+//-----------------------------------------------------------------------------
+void
+GenericBoundingBoxTree::compute_bbox_of_vertices(double* b,
+                                                 const MeshGeometry& geometry,
+                                                 const unsigned int* vertices,
+                                                 std::size_t num_vertices,
+                                                 std::size_t gdim)
 {
   // Get bounding box coordinates
   double* xmin = b;
   double* xmax = b + gdim;
-
-  // Get mesh entity data
-  const MeshGeometry& geometry = entity.mesh().geometry();
-  const size_t num_vertices = entity.num_entities(0);
-  const unsigned int* vertices = entity.entities(0);
   dolfin_assert(num_vertices >= 2);
 
   // Get coordinates for first vertex
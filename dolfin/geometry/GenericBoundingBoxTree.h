@@ -33,6 +33,7 @@ namespace dolfin
   // Forward declarations
   class Mesh;
   class MeshEntity;
+  class MeshGeometry;
 
   /// Base class for bounding box implementations (envelope-letter
   /// design)
@@ -134,6 +135,14 @@ namespace dolfin
                         const std::vector<unsigned int>::iterator& end,
                         std::size_t gdim);
 
+    /// Build bounding box tree for entities, building the two
+    /// subtrees of each node above the given depth concurrently
+    /// (recursive). The tree is the same as the one built by _build.
+    unsigned int _build_parallel(const std::vector<double>& leaf_bboxes,
+                                 const std::vector<unsigned int>::iterator& begin,
+                                 const std::vector<unsigned int>::iterator& end,
+                                 std::size_t gdim, std::size_t depth);
+
     /// Build bounding box tree for points (recursive)
     unsigned int _build(const std::vector<Point>& points,
                         const std::vector<unsigned int>::iterator& begin,
@@ -203,6 +212,13 @@ namespace dolfin
                                 const MeshEntity& entity,
                                 std::size_t gdim) const;
 
+    /// Compute bounding box of vertices (of a mesh entity)
+    static void compute_bbox_of_vertices(double* b,
+                                         const MeshGeometry& geometry,
+                                         const unsigned int* vertices,
+                                         std::size_t num_vertices,
+                                         std::size_t gdim);
+
     /// Sort points along given axis
     void sort_points(std::size_t axis,
                      const std::vector<Point>& points,
@@ -225,6 +241,9 @@ namespace dolfin
       return _bboxes.size() - 1;
     }
 
+    /// Add bounding boxes of tree, and return index of its root
+    unsigned int add_tree(const GenericBoundingBoxTree& tree);
+
     /// Return bounding box for given node
     inline const BBox& get_bbox(unsigned int node) const
     {
@@ -0,0 +1,125 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <array>
+#include <dolfin/log/log.h>
+#include "SpaceFillingCurve.h"
+
+using namespace dolfin;
+
+namespace
+{
+  // Interleave the bits of the integer coordinates X[0], ..., X[n - 1]
+  // (b bits each), starting from the most significant bit
+  std::uint64_t morton_key(const std::array<std::uint32_t, 3>& X,
+                           std::size_t n, std::size_t b)
+  {
+    std::uint64_t key = 0;
+    for (std::size_t j = b; j-- > 0; )
+      for (std::size_t i = 0; i < n; ++i)
+        key = (key << 1) | ((X[i] >> j) & 1);
+    return key;
+  }
+
+  // Compute the index of a point on the Hilbert curve by transforming
+  // its integer coordinates to the 'transposed' Hilbert index and
+  // interleaving the bits (J. Skilling, Programming the Hilbert
+  // curve, AIP Conference Proceedings 707, 2004)
+  std::uint64_t hilbert_key(std::array<std::uint32_t, 3> X,
+                            std::size_t n, std::size_t b)
+  {
+    const std::uint32_t M = 1u << (b - 1);
+
+    // Inverse undo
+    for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+      const std::uint32_t P = Q - 1;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        if (X[i] & Q)
+          X[0] ^= P;
+        else
+        {
+          const std::uint32_t t = (X[0] ^ X[i]) & P;
+          X[0] ^= t;
+          X[i] ^= t;
+        }
+      }
+    }
+
+    // Gray encode
+    for (std::size_t i = 1; i < n; ++i)
+      X[i] ^= X[i - 1];
+    std::uint32_t t = 0;
+    for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+      if (X[n - 1] & Q)
+        t ^= Q - 1;
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      X[i] ^= t;
+
+    return morton_key(X, n, b);
+  }
+}
+
+//-----------------------------------------------------------------------------
+SpaceFillingCurve::SpaceFillingCurve(const std::vector<double>& xmin,
+                                     const std::vector<double>& xmax,
+                                     std::string curve)
+  : _gdim(xmin.size()),
+    _bits(std::min<std::size_t>(32, 63/std::max<std::size_t>(1, xmin.size()))),
+    _max_int((double) ((std::uint64_t(1) << _bits) - 1)),
+    _hilbert(curve == "hilbert"), _xmin(xmin), _scale(xmin.size(), 0.0)
+{
+  if (curve != "hilbert" && curve != "morton")
+  {
+    dolfin_error("SpaceFillingCurve.cpp",
+                 "create space-filling curve",
+                 "Unknown space-filling curve \"%s\" (use \"hilbert\" or \"morton\")",
+                 curve.c_str());
+  }
+  if (_gdim < 1 || _gdim > 3 || xmax.size() != _gdim)
+  {
+    dolfin_error("SpaceFillingCurve.cpp",
+                 "create space-filling curve",
+                 "Box corners must have the same dimension (1, 2 or 3)");
+  }
+
+  for (std::size_t i = 0; i < _gdim; ++i)
+  {
+    if (xmax[i] > _xmin[i])
+      _scale[i] = _max_int/(xmax[i] - _xmin[i]);
+  }
+}
+//-----------------------------------------------------------------------------
+std::uint64_t SpaceFillingCurve::operator() (const double* x) const
+{
+  std::array<std::uint32_t, 3> X = {{0, 0, 0}};
+  for (std::size_t i = 0; i < _gdim; ++i)
+  {
+    // Clamp to [0, 2^bits - 1] before converting, since the
+    // conversion is undefined for points outside the box (and for
+    // rounding up at the upper corner when bits is 32)
+    const double y = (x[i] - _xmin[i])*_scale[i];
+    X[i] = !(y > 0.0) ? 0 : (std::uint32_t) std::min(y, _max_int);
+  }
+  return _hilbert ? hilbert_key(X, _gdim, _bits)
+    : morton_key(X, _gdim, _bits);
+}
+//-----------------------------------------------------------------------------
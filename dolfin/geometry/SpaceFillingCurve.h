@@ -0,0 +1,73 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __SPACE_FILLING_CURVE_H
+#define __SPACE_FILLING_CURVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dolfin
+{
+
+  /// This class computes the position of points along a Hilbert or
+  /// Morton (Z-order) space-filling curve through a box. Points that
+  /// are close along the curve are close in space, so sorting by the
+  /// position gives an ordering with good spatial locality.
+
+  class SpaceFillingCurve
+  {
+  public:
+
+    /// Create curve through the box [xmin, xmax]. The geometric
+    /// dimension (at most 3) is the size of xmin
+    ///
+    /// @param    xmin (std::vector<double>)
+    ///         Lower corner of box.
+    /// @param    xmax (std::vector<double>)
+    ///         Upper corner of box.
+    /// @param    curve (std::string)
+    ///         Type of curve ("hilbert" or "morton").
+    SpaceFillingCurve(const std::vector<double>& xmin,
+                      const std::vector<double>& xmax,
+                      std::string curve="hilbert");
+
+    /// Return position of point x along the curve. Points outside
+    /// the box are projected onto its boundary.
+    std::uint64_t operator() (const double* x) const;
+
+    /// Number of bits of the integer coordinates in each direction
+    std::size_t bits() const
+    { return _bits; }
+
+  private:
+
+    const std::size_t _gdim, _bits;
+
+    // Largest integer coordinate, 2^bits - 1
+    const double _max_int;
+
+    bool _hilbert;
+    std::vector<double> _xmin, _scale;
+
+  };
+
+}
+
+#endif
@@ -10,5 +10,6 @@
 #include <dolfin/geometry/MeshPointIntersection.h>
 #include <dolfin/geometry/CollisionPredicates.h>
 #include <dolfin/geometry/intersect.h>
+#include <dolfin/geometry/SpaceFillingCurve.h>
 
 #endif
@@ -28,6 +28,7 @@
 #include <boost/graph/compressed_sparse_row_graph.hpp>
 #include <boost/graph/sequential_vertex_coloring.hpp>
 #include <dolfin/common/Timer.h>
+#include "CSRGraph.h"
 #include "Graph.h"
 
 namespace dolfin
@@ -86,6 +87,44 @@ namespace dolfin
       return compute_local_vertex_coloring(g, colors);
     }
 
+    /// Compute vertex colors
+    template<typename T, typename ColorType>
+      static std::size_t
+      compute_local_vertex_coloring(const CSRGraph<T>& graph,
+                                    std::vector<ColorType>& colors)
+    {
+      Timer timer("Boost graph coloring (from dolfin::CSRGraph)");
+
+      // Typedef for Boost compressed sparse row graph
+      typedef boost::compressed_sparse_row_graph<boost::directedS,
+        boost::property<boost::vertex_color_t, ColorType> > BoostGraph;
+
+      // Number of vertices
+      const std::size_t n = graph.size();
+
+      // Build list of graph edges, which are sorted by source
+      std::vector<std::pair<std::size_t, std::size_t> > edges;
+      edges.reserve(graph.num_edges());
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        for (auto edge : graph[i])
+        {
+          if (i != (std::size_t) edge)
+            edges.push_back(std::make_pair(i, edge));
+        }
+      }
+
+      // Build Boost graph
+      const BoostGraph g(boost::edges_are_sorted, edges.begin(), edges.end(),
+                         n);
+
+      // Resize vector to hold colors
+      colors.resize(n);
+
+      // Perform coloring
+      return compute_local_vertex_coloring(g, colors);
+    }
+
     /// Compute vertex colors
     template<typename T, typename ColorType>
     static std::size_t compute_local_vertex_coloring(const T& graph,
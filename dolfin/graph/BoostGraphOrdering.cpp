@@ -74,6 +74,59 @@ std::vector<int>
   return map;
 }
 //-----------------------------------------------------------------------------
+std::vector<int>
+  BoostGraphOrdering::compute_cuthill_mckee(const CSRGraph<int>& graph,
+                                            bool reverse)
+{
+  Timer timer("Boost Cuthill-McKee graph ordering (from dolfin::CSRGraph)");
+
+  // Number of vertices
+  const std::size_t n = graph.size();
+
+  // Typedef for Boost compressed sparse row graph
+  typedef boost::compressed_sparse_row_graph<boost::directedS> BoostGraph;
+
+  // Build Boost graph from edges, which are sorted by source
+  std::vector<std::pair<std::size_t, std::size_t>> edges;
+  edges.reserve(graph.num_edges());
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    for (auto edge : graph[i])
+      edges.push_back(std::make_pair(i, edge));
+  }
+  const BoostGraph boost_graph(boost::edges_are_sorted, edges.begin(),
+                               edges.end(), n);
+  std::vector<std::pair<std::size_t, std::size_t>>().swap(edges);
+
+  // Check if graph has no edges
+  std::vector<int> map(n);
+  if (boost::num_edges(boost_graph) == 0)
+  {
+    // Graph has no edges, so no need to re-order
+    for (std::size_t i = 0; i < map.size(); ++i)
+      map[i] = i;
+  }
+  else
+  {
+    // Boost vertex -> index map
+    const boost::property_map<BoostGraph, boost::vertex_index_t>::type
+      boost_index_map = get(boost::vertex_index, boost_graph);
+
+    // Compute graph re-ordering
+    std::vector<int> inv_perm(n);
+    if (!reverse)
+      boost::cuthill_mckee_ordering(boost_graph, inv_perm.begin());
+    else
+      boost::cuthill_mckee_ordering(boost_graph, inv_perm.rbegin());
+
+    // Build old-to-new vertex map
+    for (std::size_t i = 0; i < map.size(); ++i)
+      map[boost_index_map[inv_perm[i]]] = i;
+  }
+
+  return map;
+}
+//-----------------------------------------------------------------------------
 std::vector<int> BoostGraphOrdering::compute_cuthill_mckee(
   const std::set<std::pair<std::size_t, std::size_t>>& edges,
   std::size_t size, bool reverse)
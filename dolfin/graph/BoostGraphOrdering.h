@@ -24,6 +24,7 @@
 #include <set>
 #include <utility>
 #include <vector>
+#include "CSRGraph.h"
 #include "Graph.h"
 
 namespace dolfin
@@ -41,6 +42,11 @@ namespace dolfin
     static std::vector<int> compute_cuthill_mckee(const Graph& graph,
                                                   bool reverse=false);
 
+    /// Compute re-ordering (map[old] -> new) using Cuthill-McKee
+    /// algorithm
+    static std::vector<int> compute_cuthill_mckee(const CSRGraph<int>& graph,
+                                                  bool reverse=false);
+
     /// Compute re-ordering (map[old] -> new) using Cuthill-McKee
     /// algorithm
     static std::vector<int>
@@ -21,6 +21,7 @@
 #ifndef __CSRGRAPH_H
 #define __CSRGRAPH_H
 
+#include <utility>
 #include <vector>
 #include <dolfin/common/MPI.h>
 
@@ -120,6 +121,17 @@ namespace dolfin
       calculate_node_distribution();
     }
 
+    /// Create a CSR Graph from vectors of node offsets and edges,
+    /// which are moved into the graph
+    CSRGraph(MPI_Comm mpi_comm, std::vector<T>&& node_offsets,
+             std::vector<T>&& edges)
+      : _edges(std::move(edges)), _node_offsets(std::move(node_offsets)),
+        _mpi_comm(mpi_comm)
+    {
+      // Compute node offsets
+      calculate_node_distribution();
+    }
+
     /// Destructor
     ~CSRGraph() {}
 
@@ -0,0 +1,758 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <set>
+
+#include <dolfin/common/Timer.h>
+#include <dolfin/geometry/SpaceFillingCurve.h>
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/CellType.h>
+#include <dolfin/mesh/LocalMeshData.h>
+#include "GeometricPartitioner.h"
+#include "GraphBuilder.h"
+
+using namespace dolfin;
+
+namespace
+{
+  // Element-wise sum of a vector over all processes
+  std::vector<double> sum(MPI_Comm mpi_comm, std::vector<double> x)
+  {
+    #ifdef HAS_MPI
+    if (!x.empty())
+      x = dolfin::MPI::all_reduce(mpi_comm, x, MPI_SUM);
+    #endif
+    return x;
+  }
+
+  // Element-wise exclusive prefix sum of a vector over the processes
+  std::vector<double> exclusive_sum(MPI_Comm mpi_comm,
+                                    const std::vector<double>& x)
+  {
+    std::vector<double> y(x.size(), 0.0);
+    #ifdef HAS_MPI
+    if (!x.empty())
+    {
+      MPI_Exscan(const_cast<double*>(x.data()), y.data(), x.size(),
+                 MPI_DOUBLE, MPI_SUM, mpi_comm);
+      if (dolfin::MPI::rank(mpi_comm) == 0)
+        std::fill(y.begin(), y.end(), 0.0);
+    }
+    #endif
+    return y;
+  }
+
+  // Element-wise minimum and maximum of vectors over all processes
+  void min_max(MPI_Comm mpi_comm, std::vector<double>& xmin,
+               std::vector<double>& xmax)
+  {
+    #ifdef HAS_MPI
+    if (!xmin.empty())
+    {
+      xmin = dolfin::MPI::all_reduce(mpi_comm, xmin, MPI_MIN);
+      xmax = dolfin::MPI::all_reduce(mpi_comm, xmax, MPI_MAX);
+    }
+    #endif
+  }
+
+  // Compute the midpoints of the local cells. The vertex coordinates
+  // are distributed in blocks by global vertex index, so each
+  // process fetches the coordinates of the vertices of its cells
+  // from the processes that hold them.
+  std::vector<double> compute_cell_midpoints(MPI_Comm mpi_comm,
+                                             const LocalMeshData& mesh_data)
+  {
+    const std::size_t gdim = mesh_data.geometry.dim;
+    const boost::multi_array<std::int64_t, 2>& cell_vertices
+      = mesh_data.topology.cell_vertices;
+    const std::size_t num_cells = cell_vertices.shape()[0];
+    const std::size_t num_cell_vertices = cell_vertices.shape()[1];
+    const std::size_t mpi_size = dolfin::MPI::size(mpi_comm);
+    const std::size_t mpi_rank = dolfin::MPI::rank(mpi_comm);
+
+    // Range of vertices held by each process
+    std::vector<std::size_t> ranges;
+    dolfin::MPI::all_gather(mpi_comm,
+                            mesh_data.geometry.vertex_indices.size(), ranges);
+    ranges.insert(ranges.begin(), 0);
+    std::partial_sum(ranges.begin(), ranges.end(), ranges.begin());
+
+    // Coordinates are looked up by offset into the local block, so
+    // check that the block holds the vertices of its range in order
+    const std::vector<std::int64_t>& vertex_indices
+      = mesh_data.geometry.vertex_indices;
+    std::size_t non_contiguous = 0;
+    for (std::size_t i = 0; i < vertex_indices.size(); ++i)
+    {
+      if (vertex_indices[i] != (std::int64_t) (ranges[mpi_rank] + i))
+      {
+        non_contiguous = 1;
+        break;
+      }
+    }
+    if (dolfin::MPI::max(mpi_comm, non_contiguous) != 0)
+    {
+      dolfin_error("GeometricPartitioner.cpp",
+                   "compute cell midpoints",
+                   "Vertices must be distributed in contiguous blocks of "
+                   "increasing global index");
+    }
+
+    // Request the coordinates of each vertex of the local cells once,
+    // in order of increasing global index
+    std::vector<std::int64_t> vertices(cell_vertices.data(),
+                                       cell_vertices.data()
+                                       + num_cells*num_cell_vertices);
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                   vertices.end());
+    std::vector<std::vector<std::int64_t>> send_vertices(mpi_size);
+    for (auto v : vertices)
+    {
+      const std::size_t owner
+        = std::upper_bound(ranges.begin(), ranges.end(), (std::size_t) v)
+        - ranges.begin() - 1;
+      send_vertices[owner].push_back(v);
+    }
+    std::vector<std::vector<std::int64_t>> received_vertices;
+    dolfin::MPI::all_to_all(mpi_comm, send_vertices, received_vertices);
+
+    // Send back the requested coordinates
+    const boost::multi_array<double, 2>& x
+      = mesh_data.geometry.vertex_coordinates;
+    std::vector<std::vector<double>> send_x(mpi_size);
+    for (std::size_t p = 0; p < mpi_size; ++p)
+    {
+      send_x[p].reserve(received_vertices[p].size()*gdim);
+      for (auto v : received_vertices[p])
+      {
+        const std::size_t i = v - ranges[mpi_rank];
+        for (std::size_t j = 0; j < gdim; ++j)
+          send_x[p].push_back(x[i][j]);
+      }
+    }
+
+    // Vertex coordinates arrive in order of increasing owner, and so
+    // in the order of the sorted vertex list
+    std::vector<double> vertex_x;
+    dolfin::MPI::all_to_all(mpi_comm, send_x, vertex_x);
+    dolfin_assert(vertex_x.size() == vertices.size()*gdim);
+
+    // Average the vertex coordinates of each cell
+    std::vector<double> midpoints(num_cells*gdim, 0.0);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      for (std::size_t i = 0; i < num_cell_vertices; ++i)
+      {
+        const std::size_t k
+          = std::lower_bound(vertices.begin(), vertices.end(),
+                             cell_vertices[c][i]) - vertices.begin();
+        for (std::size_t j = 0; j < gdim; ++j)
+          midpoints[c*gdim + j] += vertex_x[k*gdim + j]/num_cell_vertices;
+      }
+    }
+
+    return midpoints;
+  }
+
+  // Split weighted cells at target weights along integer keys. The
+  // cells are grouped in segments, and the targets of each segment
+  // (given in increasing order, as cumulative weights of the
+  // segment's cells when sorted by key) are stored consecutively,
+  // segment by segment. Returns for each cell the number of targets
+  // of its segment that lie before the cell. The split point for
+  // each target is found by bisection over the key range with one
+  // reduction for all targets per step, and cells with the same key
+  // as a split point are divided between the parts in process order.
+  std::vector<int> split(MPI_Comm mpi_comm, std::size_t num_segments,
+                         const std::vector<std::size_t>& segment,
+                         const std::vector<std::uint64_t>& key,
+                         std::size_t key_bits,
+                         const std::vector<double>& weight,
+                         const std::vector<std::size_t>& target_segment,
+                         const std::vector<double>& target)
+  {
+    const std::size_t n = key.size();
+    const std::size_t num_targets = target.size();
+
+    // Sort local cells by segment and key, and compute prefix sums of
+    // the weights
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&segment, &key](std::size_t a, std::size_t b)
+              { return segment[a] < segment[b]
+                  || (segment[a] == segment[b] && key[a] < key[b]); });
+    std::vector<std::uint64_t> sorted_key(n);
+    std::vector<double> prefix(n + 1, 0.0);
+    std::vector<std::size_t> segment_offset(num_segments + 1, 0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      sorted_key[i] = key[order[i]];
+      prefix[i + 1] = prefix[i] + weight[order[i]];
+      ++segment_offset[segment[i] + 1];
+    }
+    std::partial_sum(segment_offset.begin(), segment_offset.end(),
+                     segment_offset.begin());
+
+    // Local weight of the cells in a segment with key less than k
+    auto weight_below = [&](std::size_t s, std::uint64_t k)
+    {
+      const auto begin = sorted_key.begin() + segment_offset[s];
+      const auto end = sorted_key.begin() + segment_offset[s + 1];
+      const std::size_t i = std::lower_bound(begin, end, k)
+        - sorted_key.begin();
+      return prefix[i] - prefix[segment_offset[s]];
+    };
+
+    // Find the smallest key c for each target such that the weight
+    // of the cells with key not larger than c reaches the target
+    std::vector<std::uint64_t> lo(num_targets, 0);
+    std::vector<std::uint64_t> hi(num_targets,
+                                  (std::uint64_t(1) << key_bits) - 1);
+    std::vector<double> w(num_targets);
+    for (std::size_t step = 0; step < key_bits; ++step)
+    {
+      for (std::size_t q = 0; q < num_targets; ++q)
+      {
+        const std::uint64_t mid = lo[q] + (hi[q] - lo[q])/2;
+        w[q] = weight_below(target_segment[q], mid + 1);
+      }
+      w = sum(mpi_comm, w);
+      for (std::size_t q = 0; q < num_targets; ++q)
+      {
+        const std::uint64_t mid = lo[q] + (hi[q] - lo[q])/2;
+        if (w[q] >= target[q])
+          hi[q] = mid;
+        else
+          lo[q] = mid + 1;
+      }
+    }
+    const std::vector<std::uint64_t>& c = lo;
+
+    // Weight of the cells before each split key, and the offset of
+    // this process into the cells with the split key
+    std::vector<double> tie(num_targets);
+    for (std::size_t q = 0; q < num_targets; ++q)
+    {
+      w[q] = weight_below(target_segment[q], c[q]);
+      tie[q] = weight_below(target_segment[q], c[q] + 1) - w[q];
+    }
+    w = sum(mpi_comm, w);
+    tie = exclusive_sum(mpi_comm, tie);
+
+    // First target of each segment
+    std::vector<std::size_t> target_offset(num_segments + 1, 0);
+    for (std::size_t q = 0; q < num_targets; ++q)
+      ++target_offset[target_segment[q] + 1];
+    std::partial_sum(target_offset.begin(), target_offset.end(),
+                     target_offset.begin());
+
+    // Count the targets before each cell
+    std::vector<int> bucket(n, 0);
+    std::vector<double> tie_position(num_targets, 0.0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const std::size_t s = segment[i];
+      const auto begin = c.begin() + target_offset[s];
+      const auto end = c.begin() + target_offset[s + 1];
+      const auto it = std::lower_bound(begin, end, key[i]);
+      bucket[i] = it - begin;
+      if (it == end || *it != key[i])
+        continue;
+
+      // The cell has the same key as a split point. Place it by its
+      // position among the cells of the segment.
+      const std::size_t q = it - c.begin();
+      const double position = w[q] + tie[q] + tie_position[q]
+        + 0.5*weight[i];
+      tie_position[q] += weight[i];
+      for (std::size_t r = q; r < target_offset[s + 1] && c[r] == key[i]; ++r)
+      {
+        if (target[r] <= position)
+          ++bucket[i];
+      }
+    }
+
+    return bucket;
+  }
+
+  // Partition cells by recursive coordinate bisection. The range of
+  // processes of each cell is halved at each level, cutting the
+  // cells of the range across the longest side of their bounding
+  // box into parts with weights proportional to the numbers of
+  // processes.
+  std::vector<int> partition_rcb(MPI_Comm mpi_comm,
+                                 const std::vector<double>& midpoints,
+                                 std::size_t gdim,
+                                 const std::vector<double>& weight)
+  {
+    const std::size_t key_bits = 32;
+    const double max_key = (double) ((std::uint64_t(1) << key_bits) - 1);
+    const int mpi_size = dolfin::MPI::size(mpi_comm);
+    const std::size_t num_cells = weight.size();
+
+    // Range of processes [begin, end) of each cell
+    std::vector<int> part_begin(num_cells, 0);
+    std::vector<int> part_end(num_cells, mpi_size);
+
+    // Process ranges to bisect (the same on all processes)
+    std::vector<std::pair<int, int>> ranges = {{0, mpi_size}};
+    while (true)
+    {
+      std::vector<std::pair<int, int>> active;
+      for (const auto& r : ranges)
+      {
+        if (r.second - r.first > 1)
+          active.push_back(r);
+      }
+      if (active.empty())
+        break;
+
+      // Segment of each cell that has more than one process left
+      std::vector<int> segment_of(mpi_size, -1);
+      for (std::size_t s = 0; s < active.size(); ++s)
+        segment_of[active[s].first] = s;
+      std::vector<std::size_t> cells, segment;
+      for (std::size_t i = 0; i < num_cells; ++i)
+      {
+        if (part_end[i] - part_begin[i] > 1)
+        {
+          cells.push_back(i);
+          segment.push_back(segment_of[part_begin[i]]);
+        }
+      }
+
+      // Bounding box and weight of each segment
+      const std::size_t num_segments = active.size();
+      std::vector<double> xmin(num_segments*gdim,
+                               std::numeric_limits<double>::max());
+      std::vector<double> xmax(num_segments*gdim,
+                               std::numeric_limits<double>::lowest());
+      std::vector<double> segment_weight(num_segments, 0.0);
+      for (std::size_t k = 0; k < cells.size(); ++k)
+      {
+        const std::size_t s = segment[k];
+        for (std::size_t j = 0; j < gdim; ++j)
+        {
+          const double x = midpoints[cells[k]*gdim + j];
+          xmin[s*gdim + j] = std::min(xmin[s*gdim + j], x);
+          xmax[s*gdim + j] = std::max(xmax[s*gdim + j], x);
+        }
+        segment_weight[s] += weight[cells[k]];
+      }
+      min_max(mpi_comm, xmin, xmax);
+      segment_weight = sum(mpi_comm, segment_weight);
+
+      // Cut each segment across its longest side
+      std::vector<std::size_t> axis(num_segments, 0);
+      std::vector<double> target(num_segments);
+      std::vector<std::size_t> target_segment(num_segments);
+      for (std::size_t s = 0; s < num_segments; ++s)
+      {
+        for (std::size_t j = 1; j < gdim; ++j)
+        {
+          if (xmax[s*gdim + j] - xmin[s*gdim + j]
+              > xmax[s*gdim + axis[s]] - xmin[s*gdim + axis[s]])
+          {
+            axis[s] = j;
+          }
+        }
+        const int n = active[s].second - active[s].first;
+        target[s] = segment_weight[s]*(n/2)/n;
+        target_segment[s] = s;
+      }
+
+      std::vector<std::uint64_t> key(cells.size(), 0);
+      std::vector<double> cell_weight(cells.size());
+      for (std::size_t k = 0; k < cells.size(); ++k)
+      {
+        const std::size_t s = segment[k];
+        const double x0 = xmin[s*gdim + axis[s]];
+        const double dx = xmax[s*gdim + axis[s]] - x0;
+        if (dx > 0.0)
+        {
+          const double x = midpoints[cells[k]*gdim + axis[s]];
+          key[k] = (std::uint64_t) ((x - x0)/dx*max_key);
+        }
+        cell_weight[k] = weight[cells[k]];
+      }
+
+      const std::vector<int> side
+        = split(mpi_comm, num_segments, segment, key, key_bits, cell_weight,
+                target_segment, target);
+
+      // Bisect the process ranges
+      ranges.clear();
+      for (const auto& r : active)
+      {
+        const int mid = r.first + (r.second - r.first)/2;
+        ranges.push_back({r.first, mid});
+        ranges.push_back({mid, r.second});
+      }
+      for (std::size_t k = 0; k < cells.size(); ++k)
+      {
+        const std::size_t i = cells[k];
+        const int mid = part_begin[i] + (part_end[i] - part_begin[i])/2;
+        if (side[k] == 0)
+          part_end[i] = mid;
+        else
+          part_begin[i] = mid;
+      }
+    }
+
+    return part_begin;
+  }
+
+  // Partition cells by cutting a Hilbert curve through the cell
+  // midpoints into pieces of equal weight
+  std::vector<int> partition_hilbert(MPI_Comm mpi_comm,
+                                     const std::vector<double>& midpoints,
+                                     std::size_t gdim,
+                                     const std::vector<double>& weight)
+  {
+    const int mpi_size = dolfin::MPI::size(mpi_comm);
+    const std::size_t num_cells = weight.size();
+
+    std::vector<double> xmin(gdim, std::numeric_limits<double>::max());
+    std::vector<double> xmax(gdim, std::numeric_limits<double>::lowest());
+    for (std::size_t i = 0; i < midpoints.size(); ++i)
+    {
+      xmin[i % gdim] = std::min(xmin[i % gdim], midpoints[i]);
+      xmax[i % gdim] = std::max(xmax[i % gdim], midpoints[i]);
+    }
+    min_max(mpi_comm, xmin, xmax);
+    const SpaceFillingCurve curve(xmin, xmax, "hilbert");
+
+    std::vector<std::uint64_t> key(num_cells);
+    for (std::size_t i = 0; i < num_cells; ++i)
+      key[i] = curve(midpoints.data() + i*gdim);
+
+    const double total_weight
+      = sum(mpi_comm, {std::accumulate(weight.begin(), weight.end(), 0.0)})[0];
+    std::vector<double> target(mpi_size - 1);
+    for (int p = 1; p < mpi_size; ++p)
+      target[p - 1] = total_weight*p/mpi_size;
+    const std::vector<std::size_t> target_segment(mpi_size - 1, 0);
+
+    return split(mpi_comm, 1, std::vector<std::size_t>(num_cells, 0), key,
+                 curve.bits()*gdim, weight, target_segment, target);
+  }
+
+  // Distributed dual graph of the local cells, with the neighbours
+  // of each cell stored as local indices, followed by the off-process
+  // neighbours (ghosts). The partition of the ghosts is exchanged by
+  // update_ghosts().
+  class DualGraph
+  {
+  public:
+
+    DualGraph(MPI_Comm mpi_comm, const LocalMeshData& mesh_data)
+      : _mpi_comm(mpi_comm)
+    {
+      const std::size_t num_cells = mesh_data.topology.cell_vertices.shape()[0];
+      const std::size_t mpi_size = dolfin::MPI::size(mpi_comm);
+
+      std::unique_ptr<CellType>
+        cell_type(CellType::create(mesh_data.topology.cell_type));
+      std::vector<std::vector<std::size_t>> graph;
+      std::set<std::int64_t> ghosts;
+      GraphBuilder::compute_dual_graph(mpi_comm,
+                                       mesh_data.topology.cell_vertices,
+                                       *cell_type,
+                                       mesh_data.geometry.num_global_vertices,
+                                       graph, ghosts);
+      _ghosts.assign(ghosts.begin(), ghosts.end());
+
+      // Cell offset of each process
+      std::vector<std::size_t> ranges;
+      dolfin::MPI::all_gather(mpi_comm, num_cells, ranges);
+      ranges.insert(ranges.begin(), 0);
+      std::partial_sum(ranges.begin(), ranges.end(), ranges.begin());
+      const std::size_t offset = ranges[dolfin::MPI::rank(mpi_comm)];
+
+      // Neighbours in local numbering
+      _offsets.assign(1, 0);
+      for (std::size_t i = 0; i < num_cells; ++i)
+      {
+        for (auto e : graph[i])
+        {
+          if (e >= offset && e < offset + num_cells)
+            _edges.push_back(e - offset);
+          else
+          {
+            _edges.push_back(num_cells
+                             + std::lower_bound(_ghosts.begin(), _ghosts.end(),
+                                                (std::int64_t) e)
+                             - _ghosts.begin());
+          }
+        }
+        _offsets.push_back(_edges.size());
+      }
+
+      // Tell the owners which of their cells are needed here. The
+      // ghosts are sorted, so their owners are in increasing order.
+      std::vector<std::vector<std::int64_t>> send_ghosts(mpi_size);
+      for (auto g : _ghosts)
+      {
+        const std::size_t owner
+          = std::upper_bound(ranges.begin(), ranges.end(), (std::size_t) g)
+          - ranges.begin() - 1;
+        send_ghosts[owner].push_back(g - ranges[owner]);
+      }
+      dolfin::MPI::all_to_all(mpi_comm, send_ghosts, _shared);
+    }
+
+    // Number of local cells
+    std::size_t size() const
+    { return _offsets.size() - 1; }
+
+    // Neighbours of local cell i, as indices into the partition
+    // vector extended by update_ghosts()
+    const std::size_t* begin(std::size_t i) const
+    { return _edges.data() + _offsets[i]; }
+    const std::size_t* end(std::size_t i) const
+    { return _edges.data() + _offsets[i + 1]; }
+
+    // Extend the partition of the local cells by the partition of
+    // the ghosts
+    void update_ghosts(std::vector<int>& partition) const
+    {
+      partition.resize(size());
+      std::vector<std::vector<int>> send(_shared.size());
+      for (std::size_t p = 0; p < _shared.size(); ++p)
+        for (auto i : _shared[p])
+          send[p].push_back(partition[i]);
+      std::vector<int> received;
+      dolfin::MPI::all_to_all(_mpi_comm, send, received);
+      dolfin_assert(received.size() == _ghosts.size());
+      partition.insert(partition.end(), received.begin(), received.end());
+    }
+
+  private:
+
+    MPI_Comm _mpi_comm;
+    std::vector<std::size_t> _offsets, _edges;
+    std::vector<std::int64_t> _ghosts;
+    std::vector<std::vector<std::int64_t>> _shared;
+
+  };
+
+  // Improve a partition by moving cells on partition boundaries to
+  // the neighbouring partition that holds most of their neighbours.
+  // Moves are only made towards higher numbered partitions in even
+  // passes and towards lower numbered partitions in odd passes, so
+  // that neighbouring cells are not swapped, and each process may
+  // only fill its share of the capacity left in the target partition.
+  void refine(MPI_Comm mpi_comm, const DualGraph& graph,
+              const std::vector<double>& weight, std::vector<int>& partition,
+              std::size_t num_passes)
+  {
+    const std::size_t mpi_size = dolfin::MPI::size(mpi_comm);
+    const std::size_t num_cells = graph.size();
+    const double tolerance = 0.05;
+
+    std::size_t idle_passes = 0;
+    for (std::size_t pass = 0; pass < num_passes && idle_passes < 2; ++pass)
+    {
+      graph.update_ghosts(partition);
+
+      // Partition weights
+      std::vector<double> part_weight(mpi_size, 0.0);
+      for (std::size_t i = 0; i < num_cells; ++i)
+        part_weight[partition[i]] += weight[i];
+      part_weight = sum(mpi_comm, part_weight);
+      const double max_weight = (1.0 + tolerance)
+        *std::accumulate(part_weight.begin(), part_weight.end(), 0.0)/mpi_size;
+
+      // Find cells that gain from moving
+      std::vector<std::pair<int, std::size_t>> moves;
+      std::vector<int> target(num_cells, -1);
+      std::vector<double> candidates(mpi_size, 0.0);
+      std::vector<std::pair<int, int>> count;
+      for (std::size_t i = 0; i < num_cells; ++i)
+      {
+        const int a = partition[i];
+        count.clear();
+        for (auto e = graph.begin(i); e != graph.end(i); ++e)
+        {
+          const int b = partition[*e];
+          auto it = std::find_if(count.begin(), count.end(),
+                                 [b](const std::pair<int, int>& x)
+                                 { return x.first == b; });
+          if (it == count.end())
+            count.push_back({b, 1});
+          else
+            ++it->second;
+        }
+
+        int own = 0, best = -1, best_count = 0;
+        for (const auto& x : count)
+        {
+          if (x.first == a)
+            own = x.second;
+          else if ((pass % 2 == 0) == (x.first > a)
+                   && (x.second > best_count
+                       || (x.second == best_count && x.first < best)))
+          {
+            best = x.first;
+            best_count = x.second;
+          }
+        }
+        if (best >= 0 && best_count > own)
+        {
+          target[i] = best;
+          moves.push_back({best_count - own, i});
+          candidates[best] += weight[i];
+        }
+      }
+
+      // Share the free capacity of each partition between the
+      // processes by the weight of their candidates
+      const std::vector<double> total_candidates = sum(mpi_comm, candidates);
+      std::vector<double> budget(mpi_size, 0.0);
+      for (std::size_t p = 0; p < mpi_size; ++p)
+      {
+        if (candidates[p] > 0.0)
+        {
+          budget[p] = std::max(0.0, max_weight - part_weight[p])
+            *candidates[p]/total_candidates[p];
+        }
+      }
+
+      // Make the moves with the largest gain first
+      std::stable_sort(moves.begin(), moves.end(),
+                       [](const std::pair<int, std::size_t>& x,
+                          const std::pair<int, std::size_t>& y)
+                       { return x.first > y.first; });
+      std::size_t num_moved = 0;
+      for (const auto& move : moves)
+      {
+        const std::size_t i = move.second;
+        if (weight[i] <= budget[target[i]])
+        {
+          budget[target[i]] -= weight[i];
+          partition[i] = target[i];
+          ++num_moved;
+        }
+      }
+      partition.resize(num_cells);
+
+      if (dolfin::MPI::sum(mpi_comm, num_moved) == 0)
+        ++idle_passes;
+      else
+        idle_passes = 0;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::pair<std::int64_t, double>
+GeometricPartitioner::compute_partition(
+  const MPI_Comm mpi_comm,
+  std::vector<int>& cell_partition,
+  std::map<std::int64_t, std::vector<int>>& ghost_procs,
+  const LocalMeshData& mesh_data,
+  std::string method,
+  std::size_t refinement_passes)
+{
+  log(PROGRESS, "Compute graph partition using geometric partitioner");
+  Timer timer("Compute graph partition (geometric)");
+
+  if (method != "rcb" && method != "hilbert")
+  {
+    dolfin_error("GeometricPartitioner.cpp",
+                 "compute cell partition",
+                 "Unknown method \"%s\" (use \"rcb\" or \"hilbert\")",
+                 method.c_str());
+  }
+
+  const std::size_t num_cells = mesh_data.topology.cell_vertices.shape()[0];
+  const std::size_t mpi_size = dolfin::MPI::size(mpi_comm);
+  const std::size_t gdim = mesh_data.geometry.dim;
+
+  // Cell weights
+  const std::vector<std::size_t>& cell_weight = mesh_data.topology.cell_weight;
+  if (!cell_weight.empty() && cell_weight.size() != num_cells)
+  {
+    dolfin_error("GeometricPartitioner.cpp",
+                 "compute cell partition",
+                 "Number of cell weights (%d) does not match number of cells (%d)",
+                 (int) cell_weight.size(), (int) num_cells);
+  }
+  std::vector<double> weight(num_cells, 1.0);
+  if (!cell_weight.empty())
+    std::copy(cell_weight.begin(), cell_weight.end(), weight.begin());
+
+  // Initial partition from the cell midpoints
+  const std::vector<double> midpoints
+    = compute_cell_midpoints(mpi_comm, mesh_data);
+  if (method == "rcb")
+    cell_partition = partition_rcb(mpi_comm, midpoints, gdim, weight);
+  else
+    cell_partition = partition_hilbert(mpi_comm, midpoints, gdim, weight);
+
+  // Refine partition on the dual graph
+  const DualGraph graph(mpi_comm, mesh_data);
+  refine(mpi_comm, graph, weight, cell_partition, refinement_passes);
+
+  // Cells with neighbours in other partitions are shared with those
+  // partitions, with the owning process first
+  std::vector<int> partition = cell_partition;
+  graph.update_ghosts(partition);
+  ghost_procs.clear();
+  std::int64_t edge_cut = 0;
+  for (std::size_t i = 0; i < num_cells; ++i)
+  {
+    for (auto e = graph.begin(i); e != graph.end(i); ++e)
+    {
+      const int p = partition[*e];
+      if (p == partition[i])
+        continue;
+
+      ++edge_cut;
+      std::vector<int>& sharing_processes = ghost_procs[i];
+      if (sharing_processes.empty())
+        sharing_processes.push_back(partition[i]);
+      if (std::find(sharing_processes.begin(), sharing_processes.end(), p)
+          == sharing_processes.end())
+      {
+        sharing_processes.push_back(p);
+      }
+    }
+  }
+
+  // Report partition quality. Each cut edge is seen from both sides.
+  edge_cut = dolfin::MPI::sum(mpi_comm, edge_cut)/2;
+  std::vector<double> part_weight(mpi_size, 0.0);
+  for (std::size_t i = 0; i < num_cells; ++i)
+    part_weight[cell_partition[i]] += weight[i];
+  part_weight = sum(mpi_comm, part_weight);
+  const double average
+    = std::accumulate(part_weight.begin(), part_weight.end(), 0.0)/mpi_size;
+  const double imbalance = average > 0.0
+    ? *std::max_element(part_weight.begin(), part_weight.end())/average : 1.0;
+  log(PROGRESS, "Geometric partition (%s): edge cut %ld, imbalance %.3f",
+      method.c_str(), (long) edge_cut, imbalance);
+
+  return {edge_cut, imbalance};
+}
+//-----------------------------------------------------------------------------
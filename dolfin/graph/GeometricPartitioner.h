@@ -0,0 +1,78 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __GEOMETRIC_PARTITIONER_H
+#define __GEOMETRIC_PARTITIONER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dolfin/common/MPI.h>
+
+namespace dolfin
+{
+  // Forward declarations
+  class LocalMeshData;
+
+  /// This class provides a mesh partitioner that does not depend on
+  /// external libraries. Cells are first partitioned by the position
+  /// of their midpoints, either by recursive coordinate bisection
+  /// ("rcb") or by cutting a Hilbert curve through the cell
+  /// midpoints into pieces of equal weight ("hilbert"). The
+  /// partition is then optionally improved by passes of greedy
+  /// refinement over the distributed dual graph, which move cells on
+  /// partition boundaries to reduce the edge cut while keeping the
+  /// partition balanced.
+
+  class GeometricPartitioner
+  {
+  public:
+
+    /// Compute cell partition from local mesh data. The vector
+    /// cell_partition contains the desired destination process
+    /// numbers for each cell. Cells shared on multiple processes
+    /// have an entry in ghost_procs pointing to the set of sharing
+    /// process numbers.
+    /// @param mpi_comm (MPI_Comm)
+    /// @param cell_partition (std::vector<int>)
+    /// @param ghost_procs (std::map<std::int64_t, std::vector<int>>)
+    /// @param mesh_data (LocalMeshData)
+    /// @param method (std::string)
+    ///   Initial partitioning method ("rcb" or "hilbert")
+    /// @param refinement_passes (std::size_t)
+    ///   Maximum number of refinement passes over the dual graph
+    /// @return std::pair<std::int64_t, double>
+    ///   Edge cut (number of dual graph edges between partitions)
+    ///   and imbalance (largest partition weight relative to the
+    ///   average) of the computed partition
+    static std::pair<std::int64_t, double>
+      compute_partition(const MPI_Comm mpi_comm,
+                        std::vector<int>& cell_partition,
+                        std::map<std::int64_t, std::vector<int>>& ghost_procs,
+                        const LocalMeshData& mesh_data,
+                        std::string method="rcb",
+                        std::size_t refinement_passes=4);
+
+  };
+
+}
+
+#endif
@@ -33,14 +33,156 @@
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/ArrayView.h>
 #include <dolfin/common/types.h>
+#include <dolfin/common/threads.h>
 #include <dolfin/fem/GenericDofMap.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/MeshConnectivity.h>
 #include <dolfin/mesh/MeshEntityIterator.h>
 #include <dolfin/mesh/Vertex.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "GraphBuilder.h"
 
 using namespace dolfin;
 
+namespace
+{
+  // Build local CSR graph of n nodes, with an edge from node v to
+  // each node u != v for which neighbours(v, f) calls f(u), where
+  // u < m. Nodes may be visited more than once. Edges are counted in
+  // a first pass and filled in a second pass, removing repeated
+  // nodes with a marker array, so that no containers are allocated
+  // per node. Nodes are processed by parameters["num_threads"]
+  // threads.
+  template<typename Neighbours>
+  CSRGraph<int> build_csr_graph(std::size_t n, std::size_t m,
+                                Neighbours neighbours)
+  {
+    const std::size_t num_threads = (int) parameters["num_threads"];
+
+    // Marker of each thread, allocated once and used in both passes.
+    // The passes split the nodes into the same chunks, and a node v
+    // marks its neighbours with v in the first pass and with n + v in
+    // the second pass.
+    std::vector<std::vector<std::size_t>>
+      markers(std::max<std::size_t>(1, std::min(num_threads, n)));
+
+    // Count edges of each node
+    std::vector<int> offsets(n + 1, 0);
+    parallel_for(num_threads, n,
+                 [&](std::size_t t, std::size_t begin, std::size_t end)
+      {
+        std::vector<std::size_t>& marker = markers[t];
+        marker.assign(m, 2*n);
+        for (std::size_t v = begin; v < end; ++v)
+        {
+          int num_edges = 0;
+          neighbours(v, [&](std::size_t u)
+            {
+              dolfin_assert(u < m);
+              if (u != v and marker[u] != v)
+              {
+                marker[u] = v;
+                ++num_edges;
+              }
+            });
+          offsets[v + 1] = num_edges;
+        }
+      });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // Fill and sort edges of each node
+    std::vector<int> edges(offsets.back());
+    parallel_for(num_threads, n,
+                 [&](std::size_t t, std::size_t begin, std::size_t end)
+      {
+        std::vector<std::size_t>& marker = markers[t];
+        for (std::size_t v = begin; v < end; ++v)
+        {
+          int pos = offsets[v];
+          neighbours(v, [&](std::size_t u)
+            {
+              if (u != v and marker[u] != n + v)
+              {
+                marker[u] = n + v;
+                edges[pos++] = u;
+              }
+            });
+          std::sort(edges.begin() + offsets[v], edges.begin() + pos);
+        }
+      });
+
+    return CSRGraph<int>(MPI_COMM_SELF, std::move(offsets), std::move(edges));
+  }
+
+  // Neighbours of a node through the cells containing it, where the
+  // cells of node i are node_cells[node_offsets[i]:node_offsets[i +
+  // 1]] and the nodes of cell c are
+  // cell_nodes[cell_offsets[c]:cell_offsets[c + 1]]
+  struct CellNeighbours
+  {
+    const std::vector<int>& node_offsets;
+    const std::vector<int>& node_cells;
+    const std::vector<int>& cell_offsets;
+    const std::vector<int>& cell_nodes;
+
+    template<typename F>
+    void operator()(std::size_t node, F f) const
+    {
+      for (int i = node_offsets[node]; i < node_offsets[node + 1]; ++i)
+      {
+        const int c = node_cells[i];
+        for (int j = cell_offsets[c]; j < cell_offsets[c + 1]; ++j)
+          f(cell_nodes[j]);
+      }
+    }
+  };
+
+  // Neighbours of a mesh entity through the connected entities of
+  // another dimension
+  struct EntityNeighbours
+  {
+    const MeshConnectivity& connectivity01;
+    const MeshConnectivity& connectivity10;
+
+    template<typename F>
+    void operator()(std::size_t e0, F f) const
+    {
+      const unsigned int* entities1 = connectivity01(e0);
+      for (std::size_t i = 0; i < connectivity01.size(e0); ++i)
+      {
+        const unsigned int* entities0 = connectivity10(entities1[i]);
+        for (std::size_t j = 0; j < connectivity10.size(entities1[i]); ++j)
+          f(entities0[j]);
+      }
+    }
+  };
+
+  // Compute the cells of each node, cells[offsets[i]:offsets[i + 1]]
+  // for node i, from the nodes of each cell in compressed form
+  void compute_node_cells(std::size_t num_nodes,
+                          const std::vector<int>& cell_offsets,
+                          const std::vector<int>& cell_nodes,
+                          std::vector<int>& offsets,
+                          std::vector<int>& cells)
+  {
+    offsets.assign(num_nodes + 1, 0);
+    for (auto node : cell_nodes)
+    {
+      dolfin_assert(node >= 0 and node < (int) num_nodes);
+      ++offsets[node + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    cells.resize(cell_nodes.size());
+    std::vector<int> pos(offsets.begin(), offsets.end() - 1);
+    for (std::size_t c = 0; c + 1 < cell_offsets.size(); ++c)
+    {
+      for (int i = cell_offsets[c]; i < cell_offsets[c + 1]; ++i)
+        cells[pos[cell_nodes[i]]++] = c;
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 Graph GraphBuilder::local_graph(const Mesh& mesh, const GenericDofMap& dofmap0,
                                                   const GenericDofMap& dofmap1)
@@ -153,6 +295,90 @@ Graph GraphBuilder::local_graph(const Mesh& mesh,
   return graph;
 }
 //-----------------------------------------------------------------------------
+CSRGraph<int> GraphBuilder::local_csr_graph(const Mesh& mesh,
+                                            std::size_t dim0,
+                                            std::size_t dim1)
+{
+  mesh.init(dim0);
+  mesh.init(dim1);
+  mesh.init(dim0, dim1);
+  mesh.init(dim1, dim0);
+
+  Timer timer("Build local CSR graph from mesh");
+
+  // Connect entities of dimension dim0 through entities of
+  // dimension dim1
+  const EntityNeighbours neighbours = {mesh.topology()(dim0, dim1),
+                                       mesh.topology()(dim1, dim0)};
+  const std::size_t n = mesh.num_entities(dim0);
+  return build_csr_graph(n, n, neighbours);
+}
+//-----------------------------------------------------------------------------
+CSRGraph<int>
+GraphBuilder::local_csr_graph(std::size_t num_nodes,
+                              const std::vector<int>& cell_offsets,
+                              const std::vector<int>& cell_nodes)
+{
+  Timer timer("Build local CSR graph from cell nodes");
+
+  // Get cells of each node
+  std::vector<int> node_offsets, node_cells;
+  compute_node_cells(num_nodes, cell_offsets, cell_nodes, node_offsets,
+                     node_cells);
+
+  // Connect each node to the nodes of its cells
+  const CellNeighbours neighbours = {node_offsets, node_cells, cell_offsets,
+                                     cell_nodes};
+  return build_csr_graph(num_nodes, num_nodes, neighbours);
+}
+//-----------------------------------------------------------------------------
+CSRGraph<int> GraphBuilder::local_csr_dual_graph(const Mesh& mesh)
+{
+  const std::size_t tdim = mesh.topology().dim();
+  dolfin_assert(tdim > 0);
+  mesh.init(tdim - 1);
+  mesh.init(tdim - 1, tdim);
+  mesh.init(tdim, tdim - 1);
+
+  Timer timer("Build local CSR dual graph from mesh");
+
+  // Two cells share at most one facet, and a facet belongs to at
+  // most two cells, so each facet with two cells adds one edge to
+  // each cell
+  const MeshConnectivity& cell_facets = mesh.topology()(tdim, tdim - 1);
+  const MeshConnectivity& facet_cells = mesh.topology()(tdim - 1, tdim);
+  const std::size_t num_cells = mesh.num_cells();
+  std::vector<int> offsets(num_cells + 1, 0);
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    const unsigned int* facets = cell_facets(c);
+    for (std::size_t i = 0; i < cell_facets.size(c); ++i)
+    {
+      if (facet_cells.size(facets[i]) == 2)
+        ++offsets[c + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<int> edges(offsets.back());
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    const unsigned int* facets = cell_facets(c);
+    int pos = offsets[c];
+    for (std::size_t i = 0; i < cell_facets.size(c); ++i)
+    {
+      if (facet_cells.size(facets[i]) == 2)
+      {
+        const unsigned int* cells = facet_cells(facets[i]);
+        edges[pos++] = (cells[0] == c) ? cells[1] : cells[0];
+      }
+    }
+    std::sort(edges.begin() + offsets[c], edges.begin() + pos);
+  }
+
+  return CSRGraph<int>(MPI_COMM_SELF, std::move(offsets), std::move(edges));
+}
+//-----------------------------------------------------------------------------
 std::pair<std::int32_t, std::int32_t>
 GraphBuilder::compute_dual_graph(const MPI_Comm mpi_comm,
                                  const boost::multi_array<std::int64_t, 2>& cell_vertices,
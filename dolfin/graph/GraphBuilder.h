@@ -28,6 +28,7 @@
 #include <vector>
 #include <boost/multi_array.hpp>
 #include <dolfin/common/MPI.h>
+#include "CSRGraph.h"
 #include "Graph.h"
 
 namespace dolfin
@@ -57,6 +58,24 @@ namespace dolfin
     static Graph local_graph(const Mesh& mesh, std::size_t dim0,
                              std::size_t dim1);
 
+    /// Build local CSR graph of the mesh entities of dimension dim0,
+    /// with an edge between entities connected by an entity of
+    /// dimension dim1. Edges of each node are sorted.
+    static CSRGraph<int> local_csr_graph(const Mesh& mesh, std::size_t dim0,
+                                         std::size_t dim1);
+
+    /// Build local CSR graph of num_nodes nodes, with an edge
+    /// between distinct nodes in the same cell. The nodes of cell i
+    /// are cell_nodes[cell_offsets[i]:cell_offsets[i + 1]]. Edges of
+    /// each node are sorted.
+    static CSRGraph<int> local_csr_graph(std::size_t num_nodes,
+                                         const std::vector<int>& cell_offsets,
+                                         const std::vector<int>& cell_nodes);
+
+    /// Build local CSR dual graph of mesh (cells connected by a
+    /// facet). Edges of each node are sorted.
+    static CSRGraph<int> local_csr_dual_graph(const Mesh& mesh);
+
     /// Build distributed dual graph (cell-cell connections) from
     /// minimal mesh data, and return (num local edges, num
     /// non-local edges)
@@ -24,8 +24,15 @@
 // Included here to avoid a C++ problem with some MPI implementations
 #include <dolfin/common/MPI.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <string>
 #include <dolfin/common/Array.h>
+#include <dolfin/common/Timer.h>
+#include <dolfin/common/threads.h>
 #include <dolfin/log/log.h>
 #include <dolfin/parameter/GlobalParameters.h>
 #include "BoostGraphColoring.h"
@@ -35,6 +42,129 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Local graph in compressed form
+  template<typename T>
+  struct Adjacency
+  {
+    const T* offsets;
+    const T* edges;
+    std::size_t distance;
+
+    // Call f(u) for each vertex u != v within the distance of v,
+    // until f returns false. Vertices may be visited more than once.
+    template<typename F>
+    void for_each(std::size_t v, F f) const
+    {
+      for (T i = offsets[v]; i < offsets[v + 1]; ++i)
+      {
+        const std::size_t u = edges[i];
+        if (u != v and !f(u))
+          return;
+        if (distance == 2)
+        {
+          for (T j = offsets[u]; j < offsets[u + 1]; ++j)
+          {
+            if ((std::size_t) edges[j] != v and !f(edges[j]))
+              return;
+          }
+        }
+      }
+    }
+  };
+
+  typedef std::vector<std::atomic<int>> ColorVector;
+
+  // Color the vertices in work concurrently, with the color of
+  // vertex v given by choose(v, forbidden), where forbidden[c] == v
+  // if c is the color of a vertex within the distance of v. Colors
+  // of other vertices may change while v is colored, so the vertices
+  // that end up with the same color as a lower numbered vertex
+  // within the distance are returned to be recolored.
+  template<typename T, typename Choose>
+  std::vector<std::size_t> color_round(const Adjacency<T>& graph,
+                                       ColorVector& colors,
+                                       const std::vector<std::size_t>& work,
+                                       std::size_t num_threads,
+                                       Choose choose)
+  {
+    // Tentative coloring
+    parallel_for(num_threads, work.size(),
+                 [&](std::size_t, std::size_t begin, std::size_t end)
+      {
+        std::vector<std::size_t>
+          forbidden(64, std::numeric_limits<std::size_t>::max());
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          const std::size_t v = work[i];
+          graph.for_each(v, [&](std::size_t u)
+            {
+              const int c = colors[u].load(std::memory_order_relaxed);
+              if (c < 0)
+                return true;
+              if ((std::size_t) c >= forbidden.size())
+              {
+                forbidden.resize(2*c + 1,
+                                 std::numeric_limits<std::size_t>::max());
+              }
+              forbidden[c] = v;
+              return true;
+            });
+          colors[v].store(choose(v, forbidden), std::memory_order_relaxed);
+        }
+      });
+
+    // Detect conflicts, keeping the color of the lowest numbered
+    // vertex of each conflict
+    std::vector<std::vector<std::size_t>> conflicts(num_threads);
+    parallel_for(num_threads, work.size(),
+                 [&](std::size_t t, std::size_t begin, std::size_t end)
+      {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          const std::size_t v = work[i];
+          const int c = colors[v].load(std::memory_order_relaxed);
+          bool conflict = false;
+          graph.for_each(v, [&](std::size_t u)
+            {
+              conflict = u < v
+                and colors[u].load(std::memory_order_relaxed) == c;
+              return !conflict;
+            });
+          if (conflict)
+            conflicts[t].push_back(v);
+        }
+      });
+
+    std::vector<std::size_t> recolor;
+    for (auto& c : conflicts)
+      recolor.insert(recolor.end(), c.begin(), c.end());
+    return recolor;
+  }
+
+  // Smallest color that is not forbidden for vertex v
+  int first_fit(std::size_t v, const std::vector<std::size_t>& forbidden)
+  {
+    std::size_t c = 0;
+    while (c < forbidden.size() and forbidden[c] == v)
+      ++c;
+    return c;
+  }
+
+  // Recolor the vertices in work with the smallest allowed color
+  // until there are no conflicts. The lowest numbered vertex in work
+  // always keeps its color, so this terminates.
+  template<typename T>
+  void resolve_conflicts(const Adjacency<T>& graph, ColorVector& colors,
+                         std::vector<std::size_t> work,
+                         std::size_t num_threads)
+  {
+    while (!work.empty())
+      work = color_round(graph, colors, work, num_threads, first_fit);
+  }
+}
+
 //-----------------------------------------------------------------------------
 std::size_t GraphColoring::compute_local_vertex_coloring(const Graph& graph,
                                               std::vector<std::size_t>& colors)
@@ -47,12 +177,182 @@ std::size_t GraphColoring::compute_local_vertex_coloring(const Graph& graph,
     return BoostGraphColoring::compute_local_vertex_coloring(graph, colors);
   else if (colorer == "Zoltan")
     return ZoltanInterface::compute_local_vertex_coloring(graph, colors);
+  else if (colorer == "DOLFIN")
+    return compute_speculative_vertex_coloring(graph, colors, 1, true);
+  else
+  {
+    dolfin_error("GraphColoring.cpp",
+                 "compute mesh coloring",
+                 "Unknown coloring type. Known types are \"Boost\", \"DOLFIN\" and \"Zoltan\"");
+    return 0;
+  }
+}
+//-----------------------------------------------------------------------------
+std::size_t
+GraphColoring::compute_local_vertex_coloring(const CSRGraph<int>& graph,
+                                             std::vector<std::size_t>& colors)
+{
+  // Get coloring library from parameter system
+  const std::string colorer = parameters["graph_coloring_library"];
+
+  // Color graph
+  if (colorer == "Boost")
+    return BoostGraphColoring::compute_local_vertex_coloring(graph, colors);
+  else if (colorer == "Zoltan")
+  {
+    // Zoltan interface takes a dolfin::Graph
+    Graph _graph(graph.size());
+    for (std::size_t i = 0; i < graph.size(); ++i)
+      _graph[i].insert(graph[i].begin(), graph[i].end());
+    return ZoltanInterface::compute_local_vertex_coloring(_graph, colors);
+  }
+  else if (colorer == "DOLFIN")
+    return compute_speculative_vertex_coloring(graph, colors, 1, true);
   else
   {
     dolfin_error("GraphColoring.cpp",
                  "compute mesh coloring",
-                 "Unknown coloring type. Known types are \"Boost\" and \"Zoltan\"");
+                 "Unknown coloring type. Known types are \"Boost\", \"DOLFIN\" and \"Zoltan\"");
     return 0;
   }
 }
-//----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+std::size_t GraphColoring::compute_speculative_vertex_coloring(
+  const Graph& graph, std::vector<std::size_t>& colors,
+  std::size_t distance, bool balance)
+{
+  // Copy graph to compressed form
+  std::vector<int> offsets(1, 0), edges;
+  offsets.reserve(graph.size() + 1);
+  for (auto const &vertex_edges : graph)
+    offsets.push_back(offsets.back() + vertex_edges.size());
+  edges.reserve(offsets.back());
+  for (auto const &vertex_edges : graph)
+    edges.insert(edges.end(), vertex_edges.begin(), vertex_edges.end());
+
+  return compute_speculative_vertex_coloring(graph.size(), offsets.data(),
+                                             edges.data(), colors, distance,
+                                             balance);
+}
+//-----------------------------------------------------------------------------
+template<typename T>
+std::size_t GraphColoring::compute_speculative_vertex_coloring(
+  std::size_t n, const T* offsets, const T* edges,
+  std::vector<std::size_t>& colors, std::size_t distance, bool balance)
+{
+  Timer timer("Speculative graph coloring");
+
+  if (distance != 1 and distance != 2)
+  {
+    dolfin_error("GraphColoring.cpp",
+                 "compute graph coloring",
+                 "Coloring distance must be 1 or 2 (got %d)", distance);
+  }
+
+  const Adjacency<T> graph = {offsets, edges, distance};
+  const std::size_t num_threads = (int) parameters["num_threads"];
+
+  // Color all vertices, initially uncolored
+  ColorVector _colors(n);
+  for (auto& c : _colors)
+    c.store(-1, std::memory_order_relaxed);
+  std::vector<std::size_t> work(n);
+  std::iota(work.begin(), work.end(), 0);
+  resolve_conflicts(graph, _colors, work, num_threads);
+
+  // Count vertices of each color
+  std::size_t num_colors = 0;
+  for (auto& c : _colors)
+  {
+    num_colors = std::max<std::size_t>(num_colors,
+                                       c.load(std::memory_order_relaxed) + 1);
+  }
+  std::vector<std::atomic<std::size_t>> counts(num_colors);
+  for (auto& count : counts)
+    count.store(0, std::memory_order_relaxed);
+  for (auto& c : _colors)
+    counts[c.load(std::memory_order_relaxed)].fetch_add(1, std::memory_order_relaxed);
+
+  // Move vertices of classes larger than the average to the smallest
+  // allowed class that is smaller than the average (guided
+  // shuffling), without adding colors
+  if (balance and num_colors > 1)
+  {
+    const std::size_t target = (n + num_colors - 1)/num_colors;
+    work.clear();
+    for (std::size_t v = 0; v < n; ++v)
+    {
+      if (counts[_colors[v].load(std::memory_order_relaxed)] > target)
+        work.push_back(v);
+    }
+
+    auto shuffle = [&counts, &_colors, num_colors, target]
+      (std::size_t v, const std::vector<std::size_t>& forbidden)
+      {
+        const int c0 = _colors[v].load(std::memory_order_relaxed);
+        if (counts[c0].load(std::memory_order_relaxed) <= target)
+          return c0;
+
+        int c1 = -1;
+        std::size_t min_count = target;
+        for (std::size_t c = 0; c < num_colors; ++c)
+        {
+          if (c < forbidden.size() and forbidden[c] == v)
+            continue;
+          const std::size_t count = counts[c].load(std::memory_order_relaxed);
+          if (count < min_count)
+          {
+            c1 = c;
+            min_count = count;
+          }
+        }
+        if (c1 < 0)
+          return c0;
+
+        counts[c0].fetch_sub(1, std::memory_order_relaxed);
+        counts[c1].fetch_add(1, std::memory_order_relaxed);
+        return c1;
+      };
+    resolve_conflicts(graph, _colors,
+                      color_round(graph, _colors, work, num_threads, shuffle),
+                      num_threads);
+  }
+
+  // Copy colors, numbering the nonempty classes contiguously
+  std::vector<std::size_t> counts_all(num_colors, 0);
+  for (auto& c : _colors)
+  {
+    const std::size_t color = c.load(std::memory_order_relaxed);
+    if (color >= counts_all.size())
+      counts_all.resize(color + 1, 0);
+    ++counts_all[color];
+  }
+  std::vector<std::size_t> new_color(counts_all.size());
+  num_colors = 0;
+  for (std::size_t c = 0; c < counts_all.size(); ++c)
+  {
+    new_color[c] = num_colors;
+    if (counts_all[c] > 0)
+      ++num_colors;
+  }
+  colors.resize(n);
+  for (std::size_t v = 0; v < n; ++v)
+    colors[v] = new_color[_colors[v].load(std::memory_order_relaxed)];
+
+  return num_colors;
+}
+//-----------------------------------------------------------------------------
+// Explicit instantiations for the index types of CSR graphs
+template std::size_t GraphColoring::compute_speculative_vertex_coloring(
+  std::size_t, const std::int32_t*, const std::int32_t*,
+  std::vector<std::size_t>&, std::size_t, bool);
+template std::size_t GraphColoring::compute_speculative_vertex_coloring(
+  std::size_t, const std::int64_t*, const std::int64_t*,
+  std::vector<std::size_t>&, std::size_t, bool);
+template std::size_t GraphColoring::compute_speculative_vertex_coloring(
+  std::size_t, const std::uint32_t*, const std::uint32_t*,
+  std::vector<std::size_t>&, std::size_t, bool);
+template std::size_t GraphColoring::compute_speculative_vertex_coloring(
+  std::size_t, const std::uint64_t*, const std::uint64_t*,
+  std::vector<std::size_t>&, std::size_t, bool);
+//-----------------------------------------------------------------------------
@@ -24,6 +24,7 @@
 
 #include <cstddef>
 #include <vector>
+#include "CSRGraph.h"
 #include "Graph.h"
 
 namespace dolfin
@@ -41,6 +42,58 @@ namespace dolfin
       compute_local_vertex_coloring(const Graph& graph,
                                     std::vector<std::size_t>& colors);
 
+    /// Compute vertex colors of a local CSR graph
+    static std::size_t
+      compute_local_vertex_coloring(const CSRGraph<int>& graph,
+                                    std::vector<std::size_t>& colors);
+
+    /// Compute vertex colors of a local graph using the threads of
+    /// the process (parameters["num_threads"]). Vertices are colored
+    /// speculatively in parallel and vertices that receive the same
+    /// color as a lower numbered vertex are recolored, until no
+    /// conflicts remain (Gebremedhin-Manne). With distance 1,
+    /// adjacent vertices have different colors. With distance 2,
+    /// vertices that share a neighbour also have different colors,
+    /// without forming the square of the graph. If balance is true,
+    /// vertices are moved from large to small color classes
+    /// afterwards, so that the classes have similar sizes. The graph
+    /// must be symmetric. Each color class is an independent set, so
+    /// that e.g. the cells of one class of a cell coloring can be
+    /// assembled concurrently. Returns the number of colors.
+    static std::size_t
+      compute_speculative_vertex_coloring(const Graph& graph,
+                                          std::vector<std::size_t>& colors,
+                                          std::size_t distance=1,
+                                          bool balance=false);
+
+    /// Compute vertex colors of a local CSR graph using the threads
+    /// of the process (see above)
+    template<typename T>
+      static std::size_t
+      compute_speculative_vertex_coloring(const CSRGraph<T>& graph,
+                                          std::vector<std::size_t>& colors,
+                                          std::size_t distance=1,
+                                          bool balance=false)
+    {
+      return compute_speculative_vertex_coloring(graph.size(),
+                                                 graph.nodes().data(),
+                                                 graph.edges().data(),
+                                                 colors, distance, balance);
+    }
+
+  private:
+
+    // Compute vertex colors of a local graph of n vertices in
+    // compressed form, where the neighbours of vertex i are
+    // edges[offsets[i]:offsets[i + 1]]
+    template<typename T>
+      static std::size_t
+      compute_speculative_vertex_coloring(std::size_t n, const T* offsets,
+                                          const T* edges,
+                                          std::vector<std::size_t>& colors,
+                                          std::size_t distance,
+                                          bool balance);
+
   };
 }
 
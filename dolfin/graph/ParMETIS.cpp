@@ -111,6 +111,137 @@ namespace
 
     return csr_graph;
   }
+
+  // ParMETIS rejects NULL arrays, also on processes that own no
+  // graph vertices, so point to a dummy entry for empty vectors
+  template <typename T>
+  T* nonempty_data(std::vector<T>& x, T& dummy)
+  {
+    return x.empty() ? &dummy : x.data();
+  }
+
+  // Get the vertex weight array and weight flag for ParMETIS. All
+  // processes must pass the same flag, including those without
+  // vertices (and hence without weights)
+  template <typename T>
+  T* vertex_weights(MPI_Comm mpi_comm, std::vector<T>& vwgt, T& dummy,
+                    T& wgtflag)
+  {
+    const bool has_weights
+      = dolfin::MPI::max(mpi_comm, (int) !vwgt.empty()) == 1;
+    wgtflag = has_weights ? 2 : 0;
+    return has_weights ? nonempty_data(vwgt, dummy) : NULL;
+  }
+
+  // Compute the processes that will need a ghost copy of each cell,
+  // i.e. the processes of the cell and of its neighbours in the dual
+  // graph when they differ
+  template <typename T>
+  void compute_ghost_procs(MPI_Comm mpi_comm, const CSRGraph<T>& csr_graph,
+                           const std::vector<int>& cell_partition,
+                           std::map<std::int64_t, std::vector<int>>& ghost_procs)
+  {
+    Timer timer("Compute graph halo data (ParMETIS)");
+
+    // Work out halo cells for current division of dual graph
+    const auto& elmdist = csr_graph.node_distribution();
+    const auto& xadj = csr_graph.nodes();
+    const auto& adjncy = csr_graph.edges();
+    const std::int32_t num_processes = dolfin::MPI::size(mpi_comm);
+    const std::int32_t process_number = dolfin::MPI::rank(mpi_comm);
+    const idx_t elm_begin = elmdist[process_number];
+    const idx_t elm_end = elmdist[process_number + 1];
+    const std::int32_t ncells = elm_end - elm_begin;
+
+    std::map<idx_t, std::set<std::int32_t>> halo_cell_to_remotes;
+    // local indexing "i"
+    for(int i = 0; i < ncells; i++)
+    {
+      for(auto other_cell : csr_graph[i]) //idx_t j = xadj[i]; j != xadj[i + 1]; ++j)
+      {
+        //      const idx_t other_cell = adjncy[j];
+        if (other_cell < elm_begin || other_cell >= elm_end)
+        {
+          const int remote
+            = std::upper_bound(elmdist.begin(), elmdist.end(), other_cell)
+            - elmdist.begin() - 1;
+
+          dolfin_assert(remote < num_processes);
+          if (halo_cell_to_remotes.find(i) == halo_cell_to_remotes.end())
+            halo_cell_to_remotes[i] = std::set<std::int32_t>();
+          halo_cell_to_remotes[i].insert(remote);
+        }
+      }
+    }
+
+    // Do halo exchange of cell partition data
+    std::vector<std::vector<std::int64_t>> send_cell_partition(num_processes);
+    std::vector<std::int64_t> recv_cell_partition;
+    for(const auto& hcell : halo_cell_to_remotes)
+    {
+      for(auto proc : hcell.second)
+      {
+        dolfin_assert(proc < num_processes);
+
+        // global cell number
+        send_cell_partition[proc].push_back(hcell.first + elm_begin);
+
+        //partitioning
+        send_cell_partition[proc].push_back(cell_partition[hcell.first]);
+      }
+    }
+
+    // Actual halo exchange
+    dolfin::MPI::all_to_all(mpi_comm, send_cell_partition, recv_cell_partition);
+
+    // Construct a map from all currently foreign cells to their new
+    // partition number
+    std::map<std::int64_t, std::int32_t> cell_ownership;
+    for (auto p = recv_cell_partition.begin(); p != recv_cell_partition.end(); p += 2)
+    {
+      cell_ownership[*p] = *(p + 1);
+    }
+
+    // Generate mapping for where new boundary cells need to be sent
+    for(std::int32_t i = 0; i < ncells; i++)
+    {
+      const std::size_t proc_this = cell_partition[i];
+      for (idx_t j = xadj[i]; j < xadj[i + 1]; ++j)
+      {
+        const idx_t other_cell = adjncy[j];
+        std::size_t proc_other;
+
+        if (other_cell < elm_begin || other_cell >= elm_end)
+        { // remote cell - should be in map
+          const auto find_other_proc = cell_ownership.find(other_cell);
+          dolfin_assert(find_other_proc != cell_ownership.end());
+          proc_other = find_other_proc->second;
+        }
+        else
+          proc_other = cell_partition[other_cell - elm_begin];
+
+        if (proc_this != proc_other)
+        {
+          auto map_it = ghost_procs.find(i);
+          if (map_it == ghost_procs.end())
+          {
+            std::vector<std::int32_t> sharing_processes;
+            sharing_processes.push_back(proc_this);
+            sharing_processes.push_back(proc_other);
+            ghost_procs.insert({i, sharing_processes});
+          }
+          else
+          {
+            // Add to vector if not already there
+            auto it = std::find(map_it->second.begin(), map_it->second.end(), proc_other);
+            if (it == map_it->second.end())
+              map_it->second.push_back(proc_other);
+          }
+
+        }
+      }
+    }
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -118,6 +249,7 @@ void ParMETIS::compute_partition(const MPI_Comm mpi_comm,
                                  std::vector<int>& cell_partition,
                                  std::map<std::int64_t, std::vector<int>>& ghost_procs,
                                  const boost::multi_array<std::int64_t, 2>& cell_vertices,
+                                 const std::vector<std::size_t>& cell_weight,
                                  const std::size_t num_global_vertices,
                                  const CellType& cell_type,
                                  const std::string mode)
@@ -156,14 +288,33 @@ void ParMETIS::compute_partition(const MPI_Comm mpi_comm,
 
   }
 
+  // Cell weights. ParMETIS requires all processes to agree on
+  // whether weights are used.
+  const std::size_t num_local_cells = cell_vertices.shape()[0];
+  std::vector<idx_t> vwgt;
+  const bool has_weights
+    = dolfin::MPI::max(mpi_comm, (int) !cell_weight.empty()) == 1;
+  if (has_weights)
+  {
+    if (!cell_weight.empty() && cell_weight.size() != num_local_cells)
+    {
+      dolfin_error("ParMETIS.cpp",
+                   "compute mesh partitioning using ParMETIS",
+                   "Number of cell weights (%d) does not match number of cells (%d)",
+                   cell_weight.size(), num_local_cells);
+    }
+    vwgt.assign(num_local_cells, 1);
+    std::copy(cell_weight.begin(), cell_weight.end(), vwgt.begin());
+  }
+
   // Partition graph
   dolfin_assert(csr_graph);
   if (mode == "partition")
-    partition(comm.comm(), *csr_graph, cell_partition, ghost_procs);
+    partition(comm.comm(), *csr_graph, vwgt, cell_partition);
   else if (mode == "adaptive_repartition")
-    adaptive_repartition(comm.comm(), *csr_graph, cell_partition);
+    adaptive_repartition(comm.comm(), *csr_graph, vwgt, cell_partition);
   else if (mode == "refine")
-    refine(comm.comm(), *csr_graph, cell_partition);
+    refine(comm.comm(), *csr_graph, vwgt, cell_partition);
   else
   {
     dolfin_error("ParMETIS.cpp",
@@ -171,12 +322,15 @@ void ParMETIS::compute_partition(const MPI_Comm mpi_comm,
                  "partition model %s is unknown. Must be \"partition\", \"adactive_partition\" or \"refine\"",
                  mode.c_str());
   }
+
+  // Compute processes that need a ghost copy of each cell
+  compute_ghost_procs(comm.comm(), *csr_graph, cell_partition, ghost_procs);
 }
 //-----------------------------------------------------------------------------
 template <typename T>
 void ParMETIS::partition(MPI_Comm mpi_comm, CSRGraph<T>& csr_graph,
-                         std::vector<int>& cell_partition,
-                         std::map<std::int64_t, std::vector<int>>& ghost_procs)
+                         std::vector<T>& vwgt,
+                         std::vector<int>& cell_partition)
 {
   Timer timer("Compute graph partition (ParMETIS)");
 
@@ -193,8 +347,9 @@ void ParMETIS::partition(MPI_Comm mpi_comm, CSRGraph<T>& csr_graph,
   idx_t ncon = 1;
 
   // Prepare remaining arguments for ParMETIS
-  idx_t* elmwgt = NULL;
+  idx_t dummy = 0;
   idx_t wgtflag = 0;
+  idx_t* elmwgt = vertex_weights(mpi_comm, vwgt, dummy, wgtflag);
   idx_t edgecut = 0;
   idx_t numflag = 0;
   std::vector<real_t> tpwgts(ncon*nparts, 1.0/static_cast<real_t>(nparts));
@@ -204,120 +359,16 @@ void ParMETIS::partition(MPI_Comm mpi_comm, CSRGraph<T>& csr_graph,
   Timer timer1("ParMETIS: call ParMETIS_V3_PartKway");
   const std::int32_t num_local_cells = csr_graph.size();
   std::vector<idx_t> part(num_local_cells);
-  dolfin_assert(!part.empty());
   int err
     = ParMETIS_V3_PartKway(csr_graph.node_distribution().data(),
                            csr_graph.nodes().data(),
-                           csr_graph.edges().data(), elmwgt,
+                           nonempty_data(csr_graph.edges(), dummy), elmwgt,
                            NULL, &wgtflag, &numflag, &ncon, &nparts,
                            tpwgts.data(), ubvec.data(), options,
-                           &edgecut, part.data(), &mpi_comm);
+                           &edgecut, nonempty_data(part, dummy), &mpi_comm);
   dolfin_assert(err == METIS_OK);
   timer1.stop();
 
-  Timer timer2("Compute graph halo data (ParMETIS)");
-
-  // Work out halo cells for current division of dual graph
-  const auto& elmdist = csr_graph.node_distribution();
-  const auto& xadj = csr_graph.nodes();
-  const auto& adjncy = csr_graph.edges();
-  const std::int32_t num_processes = dolfin::MPI::size(mpi_comm);
-  const std::int32_t process_number = dolfin::MPI::rank(mpi_comm);
-  const idx_t elm_begin = elmdist[process_number];
-  const idx_t elm_end = elmdist[process_number + 1];
-  const std::int32_t ncells = elm_end - elm_begin;
-
-  std::map<idx_t, std::set<std::int32_t>> halo_cell_to_remotes;
-  // local indexing "i"
-  for(int i = 0; i < ncells; i++)
-  {
-    for(auto other_cell : csr_graph[i]) //idx_t j = xadj[i]; j != xadj[i + 1]; ++j)
-    {
-      //      const idx_t other_cell = adjncy[j];
-      if (other_cell < elm_begin || other_cell >= elm_end)
-      {
-        const int remote
-          = std::upper_bound(elmdist.begin(), elmdist.end(), other_cell)
-          - elmdist.begin() - 1;
-
-        dolfin_assert(remote < num_processes);
-        if (halo_cell_to_remotes.find(i) == halo_cell_to_remotes.end())
-          halo_cell_to_remotes[i] = std::set<std::int32_t>();
-        halo_cell_to_remotes[i].insert(remote);
-      }
-    }
-  }
-
-  // Do halo exchange of cell partition data
-  std::vector<std::vector<std::int64_t>> send_cell_partition(num_processes);
-  std::vector<std::int64_t> recv_cell_partition;
-  for(const auto& hcell : halo_cell_to_remotes)
-  {
-    for(auto proc : hcell.second)
-    {
-      dolfin_assert(proc < num_processes);
-
-      // global cell number
-      send_cell_partition[proc].push_back(hcell.first + elm_begin);
-
-      //partitioning
-      send_cell_partition[proc].push_back(part[hcell.first]);
-    }
-  }
-
-  // Actual halo exchange
-  dolfin::MPI::all_to_all(mpi_comm, send_cell_partition, recv_cell_partition);
-
-  // Construct a map from all currently foreign cells to their new
-  // partition number
-  std::map<std::int64_t, std::int32_t> cell_ownership;
-  for (auto p = recv_cell_partition.begin(); p != recv_cell_partition.end(); p += 2)
-  {
-    cell_ownership[*p] = *(p + 1);
-  }
-
-  // Generate mapping for where new boundary cells need to be sent
-  for(std::int32_t i = 0; i < ncells; i++)
-  {
-    const std::size_t proc_this = part[i];
-    for (idx_t j = xadj[i]; j < xadj[i + 1]; ++j)
-    {
-      const idx_t other_cell = adjncy[j];
-      std::size_t proc_other;
-
-      if (other_cell < elm_begin || other_cell >= elm_end)
-      { // remote cell - should be in map
-        const auto find_other_proc = cell_ownership.find(other_cell);
-        dolfin_assert(find_other_proc != cell_ownership.end());
-        proc_other = find_other_proc->second;
-      }
-      else
-        proc_other = part[other_cell - elm_begin];
-
-      if (proc_this != proc_other)
-      {
-        auto map_it = ghost_procs.find(i);
-        if (map_it == ghost_procs.end())
-        {
-          std::vector<std::int32_t> sharing_processes;
-          sharing_processes.push_back(proc_this);
-          sharing_processes.push_back(proc_other);
-          ghost_procs.insert({i, sharing_processes});
-        }
-        else
-        {
-          // Add to vector if not already there
-          auto it = std::find(map_it->second.begin(), map_it->second.end(), proc_other);
-          if (it == map_it->second.end())
-            map_it->second.push_back(proc_other);
-        }
-
-      }
-    }
-  }
-
-  timer2.stop();
-
   // Copy cell partition data
   cell_partition.assign(part.begin(), part.end());
 }
@@ -325,6 +376,7 @@ void ParMETIS::partition(MPI_Comm mpi_comm, CSRGraph<T>& csr_graph,
 template <typename T>
 void ParMETIS::adaptive_repartition(MPI_Comm mpi_comm,
                                     CSRGraph<T>& csr_graph,
+                                    std::vector<T>& vwgt,
                                     std::vector<int>& cell_partition)
 {
   Timer timer("Compute graph partition (ParMETIS Adaptive Repartition)");
@@ -342,17 +394,20 @@ void ParMETIS::adaptive_repartition(MPI_Comm mpi_comm,
   Timer timer1("ParMETIS: call ParMETIS_V3_AdaptiveRepart");
   const double itr = parameters["ParMETIS_repartitioning_weight"];
   real_t _itr = itr;
-  std::vector<idx_t> part(csr_graph.size());
+  // The current partition (the cells of this process) is input to
+  // ParMETIS
+  const std::int32_t process_number = dolfin::MPI::rank(mpi_comm);
+  std::vector<idx_t> part(csr_graph.size(), process_number);
   std::vector<idx_t> vsize(part.size(), 1);
-  dolfin_assert(!part.empty());
 
   // Number of partitions (one for each process)
   idx_t nparts = dolfin::MPI::size(mpi_comm);
 
   // Remaining ParMETIS parameters
   idx_t ncon = 1;
-  idx_t* elmwgt = NULL;
+  idx_t dummy = 0;
   idx_t wgtflag = 0;
+  idx_t* elmwgt = vertex_weights(mpi_comm, vwgt, dummy, wgtflag);
   idx_t edgecut = 0;
   idx_t numflag = 0;
   std::vector<real_t> tpwgts(ncon*nparts, 1.0/static_cast<real_t>(nparts));
@@ -361,11 +416,12 @@ void ParMETIS::adaptive_repartition(MPI_Comm mpi_comm,
   // Call ParMETIS to repartition graph
   int err = ParMETIS_V3_AdaptiveRepart(csr_graph.node_distribution().data(),
                                        csr_graph.nodes().data(),
-                                       csr_graph.edges().data(),
-                                       elmwgt, NULL, vsize.data(), &wgtflag,
+                                       nonempty_data(csr_graph.edges(), dummy),
+                                       elmwgt, NULL,
+                                       nonempty_data(vsize, dummy), &wgtflag,
                                        &numflag, &ncon, &nparts,
                                        tpwgts.data(), ubvec.data(), &_itr,
-                                       options, &edgecut, part.data(),
+                                       options, &edgecut, nonempty_data(part, dummy),
                                        &mpi_comm);
   dolfin_assert(err == METIS_OK);
   timer1.stop();
@@ -377,6 +433,7 @@ void ParMETIS::adaptive_repartition(MPI_Comm mpi_comm,
 template<typename T>
 void ParMETIS::refine(MPI_Comm mpi_comm,
                       CSRGraph<T>& csr_graph,
+                      std::vector<T>& vwgt,
                       std::vector<int>& cell_partition)
 {
   Timer timer("Compute graph partition (ParMETIS Refine)");
@@ -399,14 +456,14 @@ void ParMETIS::refine(MPI_Comm mpi_comm,
   // process_number.
   const std::int32_t num_local_cells = csr_graph.size();
   std::vector<idx_t> part(num_local_cells, process_number);
-  dolfin_assert(!part.empty());
 
   // Number of partitions (one for each process)
   idx_t nparts = dolfin::MPI::size(mpi_comm);
   // Remaining ParMETIS parameters
   idx_t ncon = 1;
-  idx_t* elmwgt = NULL;
+  idx_t dummy = 0;
   idx_t wgtflag = 0;
+  idx_t* elmwgt = vertex_weights(mpi_comm, vwgt, dummy, wgtflag);
   idx_t edgecut = 0;
   idx_t numflag = 0;
   std::vector<real_t> tpwgts(ncon*nparts, 1.0/static_cast<real_t>(nparts));
@@ -416,11 +473,11 @@ void ParMETIS::refine(MPI_Comm mpi_comm,
   Timer timer1("ParMETIS: call ParMETIS_V3_RefineKway");
   int err =  ParMETIS_V3_RefineKway(csr_graph.node_distribution().data(),
                                     csr_graph.nodes().data(),
-                                    csr_graph.edges().data(),
+                                    nonempty_data(csr_graph.edges(), dummy),
                                     elmwgt, NULL, &wgtflag, &numflag, &ncon,
                                     &nparts,
                                     tpwgts.data(), ubvec.data(), options,
-                                    &edgecut, part.data(), &mpi_comm);
+                                    &edgecut, nonempty_data(part, dummy), &mpi_comm);
   dolfin_assert(err == METIS_OK);
   timer1.stop();
 
@@ -434,6 +491,7 @@ void ParMETIS::compute_partition(const MPI_Comm mpi_comm,
                                  std::vector<int>& cell_partition,
                                  std::map<std::int64_t, std::vector<int>>& ghost_procs,
                                  const boost::multi_array<std::int64_t, 2>& cell_vertices,
+                                 const std::vector<std::size_t>& cell_weight,
                                  const std::size_t num_global_vertices,
                                  const CellType& cell_type,
                                  const std::string mode)
@@ -48,11 +48,14 @@ namespace dolfin
     /// "adaptive_repartition" or "refine". For meshes that have
     /// already been partitioned or are already well partitioned, it
     /// can be advantageous to use "adaptive_repartition" or "refine".
+    /// If cell_weight is not empty, it holds the weight of each cell,
+    /// and the sum of the weights is balanced across processes.
     static void
       compute_partition(const MPI_Comm mpi_comm,
                         std::vector<int>& cell_partition,
                         std::map<std::int64_t, std::vector<int>>& ghost_procs,
                         const boost::multi_array<std::int64_t, 2>& cell_vertices,
+                        const std::vector<std::size_t>& cell_weight,
                         const std::size_t num_global_vertices,
                         const CellType& cell_type,
                         const std::string mode="partition");
@@ -66,20 +69,22 @@ namespace dolfin
     template <typename T>
       static void partition(MPI_Comm mpi_comm,
                             CSRGraph<T>& csr_graph,
-                            std::vector<int>& cell_partition,
-                            std::map<std::int64_t, std::vector<int>>& ghost_procs);
+                            std::vector<T>& vwgt,
+                            std::vector<int>& cell_partition);
 
     // ParMETIS adaptive repartition. CSRGraph should be const, but
     // ParMETIS accesses it non-const, so has to be non-const here
     template <typename T>
       static void adaptive_repartition(MPI_Comm mpi_comm,
                                        CSRGraph<T>& csr_graph,
+                                       std::vector<T>& vwgt,
                                        std::vector<int>& cell_partition);
 
     // ParMETIS refine repartition. CSRGraph should be const, but
     // ParMETIS accesses it non-const, so has to be non-const here
     template <typename T>
       static void refine(MPI_Comm mpi_comm, CSRGraph<T>& csr_graph,
+                         std::vector<T>& vwgt,
                          std::vector<int>& cell_partition);
 #endif
 
@@ -101,35 +101,43 @@ void SCOTCH::compute_reordering(const Graph& graph,
                                 std::vector<int>& permutation,
                                 std::vector<int>& inverse_permutation,
                                 std::string scotch_strategy)
+{
+  const CSRGraph<int> csr_graph(MPI_COMM_SELF, graph);
+  compute_reordering(csr_graph, permutation, inverse_permutation,
+                     scotch_strategy);
+}
+//-----------------------------------------------------------------------------
+std::vector<int> SCOTCH::compute_gps(const CSRGraph<int>& graph,
+                                     std::size_t num_passes)
+{
+  // Create strategy string for Gibbs-Poole-Stockmeyer ordering
+  std::string strategy = "g{pass= " + std::to_string(num_passes) + "}";
+
+  std::vector<int> permutation, inverse_permutation;
+  compute_reordering(graph, permutation, inverse_permutation, strategy);
+  return permutation;
+}
+//-----------------------------------------------------------------------------
+void SCOTCH::compute_reordering(const CSRGraph<int>& graph,
+                                std::vector<int>& permutation,
+                                std::vector<int>& inverse_permutation,
+                                std::string scotch_strategy)
 {
   Timer timer("Compute SCOTCH graph re-ordering");
 
   // Number of local graph vertices (cells)
   const SCOTCH_Num vertnbr = graph.size();
 
-  // Data structures for graph input to SCOTCH (add 1 for case that
-  // graph size is zero)
-  std::vector<SCOTCH_Num> verttab;
-  verttab.reserve(vertnbr + 1);
-  std::vector<SCOTCH_Num> edgetab;
-  edgetab.reserve(20*vertnbr);
-
-  // Build local graph input for SCOTCH
-  // (number of local + ghost graph vertices (cells),
-  // number of local edges + edges connecting to ghost vertices)
-  SCOTCH_Num edgenbr = 0;
-  verttab.push_back(0);
-  Graph::const_iterator vertex;
-  for (vertex = graph.begin(); vertex != graph.end(); ++vertex)
-  {
-    edgenbr += vertex->size();
-    verttab.push_back(verttab.back() + vertex->size());
-    edgetab.insert(edgetab.end(), vertex->begin(), vertex->end());
-  }
+  // Data structures for graph input to SCOTCH
+  std::vector<SCOTCH_Num> verttab(graph.nodes().begin(),
+                                  graph.nodes().end());
+  std::vector<SCOTCH_Num> edgetab(graph.edges().begin(),
+                                  graph.edges().end());
+  const SCOTCH_Num edgenbr = edgetab.size();
 
-  // Shrink vectors to hopefully recover an unused memory
-  verttab.shrink_to_fit();
-  edgetab.shrink_to_fit();
+  // Add entry for case that graph has no edges
+  if (edgetab.empty())
+    edgetab.push_back(0);
 
   // Create SCOTCH graph
   SCOTCH_Graph scotch_graph;
@@ -471,6 +479,25 @@ void SCOTCH::compute_reordering(const Graph& graph,
                "DOLFIN has been configured without support for SCOTCH");
 }
 //-----------------------------------------------------------------------------
+std::vector<int> SCOTCH::compute_gps(const CSRGraph<int>& graph,
+                                     std::size_t num_passes)
+{
+  dolfin_error("SCOTCH.cpp",
+               "re-order graph using SCOTCH",
+               "DOLFIN has been configured without support for SCOTCH");
+  return std::vector<int>();
+}
+//-----------------------------------------------------------------------------
+void SCOTCH::compute_reordering(const CSRGraph<int>& graph,
+                                std::vector<int>& permutation,
+                                std::vector<int>& inverse_permutation,
+                                std::string scotch_strategy)
+{
+  dolfin_error("SCOTCH.cpp",
+               "re-order graph using SCOTCH",
+               "DOLFIN has been configured without support for SCOTCH");
+}
+//-----------------------------------------------------------------------------
 template<typename T>
 void SCOTCH::partition(const MPI_Comm mpi_comm,
                        CSRGraph<T>& local_graph,
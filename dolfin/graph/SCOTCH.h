@@ -103,6 +103,28 @@ namespace dolfin
                               std::vector<int>& inverse_permutation,
                               std::string scotch_strategy="");
 
+    /// Compute reordering (map[old] -> new) using
+    /// Gibbs-Poole-Stockmeyer (GPS) re-ordering
+    /// @param graph (CSRGraph<int>)
+    ///   Input graph
+    /// @param num_passes (std::size_t)
+    ///   Number of passes to use in GPS algorithm
+    /// @return std::vector<int>
+    ///   Mapping from old to new nodes
+    static std::vector<int> compute_gps(const CSRGraph<int>& graph,
+                                        std::size_t num_passes=5);
+
+    /// Compute graph re-ordering
+    /// @param graph (CSRGraph<int>)
+    /// @param permutation (std::vector<int>)
+    /// @param inverse_permutation (std::vector<int>)
+    /// @param scotch_strategy (std::string)
+    static
+      void compute_reordering(const CSRGraph<int>& graph,
+                              std::vector<int>& permutation,
+                              std::vector<int>& inverse_permutation,
+                              std::string scotch_strategy="");
+
   private:
 
     // Compute cell partitions from distributed dual graph. Note that
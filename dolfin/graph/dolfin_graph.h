@@ -5,7 +5,9 @@
 
 #include <dolfin/graph/Graph.h>
 #include <dolfin/graph/GraphBuilder.h>
+#include <dolfin/graph/GraphColoring.h>
 #include <dolfin/graph/BoostGraphOrdering.h>
 #include <dolfin/graph/SCOTCH.h>
+#include <dolfin/graph/GeometricPartitioner.h>
 
 #endif
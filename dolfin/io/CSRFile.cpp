@@ -0,0 +1,538 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <dolfin/common/ArrayView.h>
+#include <dolfin/common/Timer.h>
+#include <dolfin/la/GenericMatrix.h>
+#include <dolfin/la/GenericVector.h>
+#include <dolfin/la/IndexMap.h>
+#include <dolfin/la/SparsityPattern.h>
+#include <dolfin/la/TensorLayout.h>
+#include <dolfin/log/log.h>
+#include "CSRFile.h"
+
+using namespace dolfin;
+
+namespace
+{
+  // File header (64 bytes). Arrays follow the header in the order
+  // row offsets, column indices, values; all are 8 byte aligned.
+  struct Header
+  {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t rank;
+    std::uint64_t num_rows;
+    std::uint64_t num_cols;
+    std::uint64_t num_nonzeros;
+    std::uint64_t reserved[2];
+  };
+  static_assert(sizeof(Header) == 64, "Unexpected size of CSRFile header");
+
+  const char magic[8] = {'D', 'O', 'L', 'F', 'I', 'N', 'L', 'A'};
+  const std::uint64_t version = 1;
+
+  // Byte offsets of arrays in file
+  std::size_t row_ptr_offset()
+  { return sizeof(Header); }
+
+  std::size_t cols_offset(std::size_t rank, std::size_t num_rows)
+  { return rank == 1 ? sizeof(Header)
+      : sizeof(Header) + sizeof(std::int64_t)*(num_rows + 1); }
+
+  std::size_t values_offset(std::size_t rank, std::size_t num_rows,
+                            std::size_t num_nonzeros)
+  { return rank == 1 ? sizeof(Header)
+      : cols_offset(rank, num_rows) + sizeof(std::int64_t)*num_nonzeros; }
+
+  // File descriptor, which is closed when it goes out of scope
+  class FileDescriptor
+  {
+  public:
+
+    FileDescriptor(const std::string& filename, int flags, mode_t mode=0)
+      : fd(open(filename.c_str(), flags, mode)) {}
+
+    ~FileDescriptor()
+    {
+      if (fd >= 0)
+        close(fd);
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    const int fd;
+  };
+
+  // Write buffer at given offset, retrying on partial writes
+  void write_at(int fd, const void* buffer, std::size_t size,
+                std::size_t offset, const std::string& filename)
+  {
+    const char* p = static_cast<const char*>(buffer);
+    while (size > 0)
+    {
+      const ssize_t n = pwrite(fd, p, size, offset);
+      if (n < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        dolfin_error("CSRFile.cpp",
+                     "write to file",
+                     "Unable to write to file \"%s\" (%s)",
+                     filename.c_str(), std::strerror(errno));
+      }
+      p += n;
+      offset += n;
+      size -= n;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+CSRFile::Mapping::Mapping(const std::string filename)
+  : rank(0), num_rows(0), num_cols(0), num_nonzeros(0), row_ptr(nullptr),
+    cols(nullptr), values(nullptr), _data(nullptr), _size(0)
+{
+  const FileDescriptor file(filename, O_RDONLY);
+  if (file.fd < 0)
+  {
+    dolfin_error("CSRFile.cpp",
+                 "map file",
+                 "Unable to open file \"%s\" (%s)",
+                 filename.c_str(), std::strerror(errno));
+  }
+
+  struct stat st;
+  if (fstat(file.fd, &st) != 0 or (std::size_t) st.st_size < sizeof(Header))
+  {
+    dolfin_error("CSRFile.cpp",
+                 "map file",
+                 "File \"%s\" is not a valid CSR file", filename.c_str());
+  }
+
+  _size = st.st_size;
+  _data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, file.fd, 0);
+  if (_data == MAP_FAILED)
+  {
+    _data = nullptr;
+    dolfin_error("CSRFile.cpp",
+                 "map file",
+                 "Call to mmap failed for file \"%s\" (%s)",
+                 filename.c_str(), std::strerror(errno));
+  }
+
+  // Unmap again if the file turns out to be invalid, since the
+  // destructor is not called when the constructor throws
+  try
+  {
+    // Check header
+    const char* base = static_cast<const char*>(_data);
+    const Header& header = *reinterpret_cast<const Header*>(base);
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0
+        or header.version != version
+        or (header.rank != 1 and header.rank != 2))
+    {
+      dolfin_error("CSRFile.cpp",
+                   "map file",
+                   "File \"%s\" is not a valid CSR file", filename.c_str());
+    }
+
+    rank = header.rank;
+    num_rows = header.num_rows;
+    num_cols = header.num_cols;
+    num_nonzeros = header.num_nonzeros;
+
+    // Check sizes in the header before they are used to compute
+    // offsets, which could otherwise overflow
+    const std::size_t max_size = _size/sizeof(std::int64_t);
+    if (num_rows >= max_size or num_nonzeros >= max_size
+        or (rank == 1 and (num_cols != 0 or num_nonzeros != num_rows)))
+    {
+      dolfin_error("CSRFile.cpp",
+                   "map file",
+                   "File \"%s\" has an invalid header", filename.c_str());
+    }
+
+    const std::size_t expected_size
+      = values_offset(rank, num_rows, num_nonzeros)
+      + sizeof(double)*num_nonzeros;
+    if (_size != expected_size)
+    {
+      dolfin_error("CSRFile.cpp",
+                   "map file",
+                   "Size of file \"%s\" (%ld bytes) does not match its header (%ld bytes)",
+                   filename.c_str(), (long) _size, (long) expected_size);
+    }
+
+    if (rank == 2)
+    {
+      row_ptr = reinterpret_cast<const std::int64_t*>
+        (base + row_ptr_offset());
+      cols = reinterpret_cast<const std::int64_t*>
+        (base + cols_offset(rank, num_rows));
+
+      // Check that rows are stored consecutively and that column
+      // indices are in range, so that the arrays can be used without
+      // bounds checks
+      if (row_ptr[0] != 0 or row_ptr[num_rows] != (std::int64_t) num_nonzeros)
+      {
+        dolfin_error("CSRFile.cpp",
+                     "map file",
+                     "File \"%s\" has invalid row offsets", filename.c_str());
+      }
+      for (std::size_t i = 0; i < num_rows; ++i)
+      {
+        if (row_ptr[i + 1] < row_ptr[i])
+        {
+          dolfin_error("CSRFile.cpp",
+                       "map file",
+                       "File \"%s\" has decreasing row offsets (row %ld)",
+                       filename.c_str(), (long) i);
+        }
+      }
+      for (std::size_t k = 0; k < num_nonzeros; ++k)
+      {
+        if (cols[k] < 0 or (std::size_t) cols[k] >= num_cols)
+        {
+          dolfin_error("CSRFile.cpp",
+                       "map file",
+                       "File \"%s\" has a column index (%ld) out of range",
+                       filename.c_str(), (long) cols[k]);
+        }
+      }
+    }
+    values = reinterpret_cast<const double*>
+      (base + values_offset(rank, num_rows, num_nonzeros));
+  }
+  catch (...)
+  {
+    munmap(_data, _size);
+    _data = nullptr;
+    throw;
+  }
+}
+//-----------------------------------------------------------------------------
+CSRFile::Mapping::Mapping(Mapping&& mapping)
+  : rank(mapping.rank), num_rows(mapping.num_rows),
+    num_cols(mapping.num_cols), num_nonzeros(mapping.num_nonzeros),
+    row_ptr(mapping.row_ptr), cols(mapping.cols), values(mapping.values),
+    _data(mapping._data), _size(mapping._size)
+{
+  mapping.row_ptr = nullptr;
+  mapping.cols = nullptr;
+  mapping.values = nullptr;
+  mapping._data = nullptr;
+  mapping._size = 0;
+}
+//-----------------------------------------------------------------------------
+CSRFile::Mapping::~Mapping()
+{
+  if (_data)
+    munmap(_data, _size);
+}
+//-----------------------------------------------------------------------------
+CSRFile::Mapping& CSRFile::Mapping::operator=(Mapping&& mapping)
+{
+  if (this != &mapping)
+  {
+    if (_data)
+      munmap(_data, _size);
+
+    rank = mapping.rank;
+    num_rows = mapping.num_rows;
+    num_cols = mapping.num_cols;
+    num_nonzeros = mapping.num_nonzeros;
+    row_ptr = mapping.row_ptr;
+    cols = mapping.cols;
+    values = mapping.values;
+    _data = mapping._data;
+    _size = mapping._size;
+
+    mapping.row_ptr = nullptr;
+    mapping.cols = nullptr;
+    mapping.values = nullptr;
+    mapping._data = nullptr;
+    mapping._size = 0;
+  }
+  return *this;
+}
+//-----------------------------------------------------------------------------
+CSRFile::CSRFile(MPI_Comm comm, const std::string filename)
+  : _mpi_comm(comm), _filename(filename)
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+CSRFile::~CSRFile()
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+void CSRFile::write(const GenericMatrix& A)
+{
+  Timer timer("Write matrix to CSR file");
+
+  const std::size_t M = A.size(0);
+  const std::size_t N = A.size(1);
+  const std::pair<std::int64_t, std::int64_t> range = A.local_range(0);
+  const std::size_t num_local_rows = range.second - range.first;
+
+  // Extract local rows
+  std::vector<std::int64_t> row_ptr(1, 0);
+  std::vector<std::int64_t> cols;
+  std::vector<double> values;
+  std::vector<std::size_t> row_cols;
+  std::vector<double> row_values;
+  row_ptr.reserve(num_local_rows + 1);
+  for (std::int64_t row = range.first; row < range.second; ++row)
+  {
+    A.getrow(row, row_cols, row_values);
+    cols.insert(cols.end(), row_cols.begin(), row_cols.end());
+    values.insert(values.end(), row_values.begin(), row_values.end());
+    row_ptr.push_back(cols.size());
+  }
+
+  // Compute global offsets of local nonzeros
+  const MPI_Comm comm = _mpi_comm.comm();
+  const std::size_t nnz_offset
+    = dolfin::MPI::global_offset(comm, cols.size(), true);
+  const std::size_t nnz = dolfin::MPI::sum(comm, cols.size());
+  for (auto& offset : row_ptr)
+    offset += nnz_offset;
+
+  write_data(2, M, N, nnz, range.first, num_local_rows, row_ptr.data(),
+             nnz_offset, cols.size(), cols.data(), values.data());
+}
+//-----------------------------------------------------------------------------
+void CSRFile::write(const GenericVector& x)
+{
+  Timer timer("Write vector to CSR file");
+
+  std::vector<double> values;
+  x.get_local(values);
+  const std::pair<std::int64_t, std::int64_t> range = x.local_range();
+  dolfin_assert(values.size() == (std::size_t) (range.second - range.first));
+
+  write_data(1, x.size(), 0, x.size(), range.first, values.size(), nullptr,
+             range.first, values.size(), nullptr, values.data());
+}
+//-----------------------------------------------------------------------------
+void CSRFile::read(GenericMatrix& A)
+{
+  Timer timer("Read matrix from CSR file");
+
+  if (!A.empty())
+  {
+    dolfin_error("CSRFile.cpp",
+                 "read matrix from CSR file",
+                 "Matrix must be empty");
+  }
+
+  std::shared_ptr<const Mapping> data = map();
+  if (data->rank != 2)
+  {
+    dolfin_error("CSRFile.cpp",
+                 "read matrix from CSR file",
+                 "File \"%s\" does not contain a matrix", _filename.c_str());
+  }
+
+  // Distribute rows and columns evenly
+  const MPI_Comm comm = _mpi_comm.comm();
+  const std::pair<std::int64_t, std::int64_t> row_range
+    = dolfin::MPI::local_range(comm, data->num_rows);
+  const std::pair<std::int64_t, std::int64_t> col_range
+    = dolfin::MPI::local_range(comm, data->num_cols);
+
+  std::vector<std::shared_ptr<const IndexMap>> index_maps
+    = {std::make_shared<IndexMap>(comm, row_range.second - row_range.first, 1),
+       std::make_shared<IndexMap>(comm, col_range.second - col_range.first, 1)};
+  TensorLayout layout(comm, 0, TensorLayout::Sparsity::SPARSE);
+  layout.init(index_maps, TensorLayout::Ghosts::UNGHOSTED);
+
+  // Build sparsity pattern from local rows of the mapped arrays
+  std::vector<dolfin::la_index> cols;
+  SparsityPattern& pattern = *layout.sparsity_pattern();
+  pattern.init(index_maps);
+  for (dolfin::la_index row = row_range.first; row < row_range.second; ++row)
+  {
+    const std::int64_t* c0 = data->cols + data->row_ptr[row];
+    const std::int64_t* c1 = data->cols + data->row_ptr[row + 1];
+    cols.assign(c0, c1);
+    pattern.insert_global({ArrayView<const dolfin::la_index>(1, &row),
+          ArrayView<const dolfin::la_index>(cols.size(), cols.data())});
+  }
+  pattern.apply();
+
+  // Initialise matrix and set values row by row
+  A.init(layout);
+  for (dolfin::la_index row = row_range.first; row < row_range.second; ++row)
+  {
+    const std::int64_t begin = data->row_ptr[row];
+    const std::int64_t end = data->row_ptr[row + 1];
+    cols.assign(data->cols + begin, data->cols + end);
+    A.set(data->values + begin, 1, &row, cols.size(), cols.data());
+  }
+  A.apply("insert");
+}
+//-----------------------------------------------------------------------------
+void CSRFile::read(GenericVector& x)
+{
+  Timer timer("Read vector from CSR file");
+
+  std::shared_ptr<const Mapping> data = map();
+  if (data->rank != 1)
+  {
+    dolfin_error("CSRFile.cpp",
+                 "read vector from CSR file",
+                 "File \"%s\" does not contain a vector", _filename.c_str());
+  }
+
+  if (x.empty())
+    x.init(dolfin::MPI::local_range(_mpi_comm.comm(), data->num_rows));
+  else if (x.size() != data->num_rows)
+  {
+    dolfin_error("CSRFile.cpp",
+                 "read vector from CSR file",
+                 "Size mismatch between vector (%d) and file (%d)",
+                 x.size(), data->num_rows);
+  }
+
+  const std::pair<std::int64_t, std::int64_t> range = x.local_range();
+  const std::vector<double> values(data->values + range.first,
+                                   data->values + range.second);
+  x.set_local(values);
+  x.apply("insert");
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const CSRFile::Mapping> CSRFile::map() const
+{
+  return std::make_shared<const Mapping>(_filename);
+}
+//-----------------------------------------------------------------------------
+void CSRFile::write_data(std::size_t rank, std::size_t num_rows,
+                         std::size_t num_cols, std::size_t num_nonzeros,
+                         std::size_t row_offset, std::size_t num_local_rows,
+                         const std::int64_t* row_ptr, std::size_t nnz_offset,
+                         std::size_t num_local_nonzeros,
+                         const std::int64_t* cols, const double* values)
+{
+  const MPI_Comm comm = _mpi_comm.comm();
+  const std::size_t file_size = values_offset(rank, num_rows, num_nonzeros)
+    + sizeof(double)*num_nonzeros;
+
+  // Errors are raised on all processes once each step is complete,
+  // so that no process is left waiting for a process that failed
+  std::exception_ptr error;
+  auto check_error = [&comm, &error, this]()
+    {
+      if (dolfin::MPI::max(comm, error ? 1 : 0) != 0)
+      {
+        if (error)
+          std::rethrow_exception(error);
+        dolfin_error("CSRFile.cpp",
+                     "write to file",
+                     "Unable to write file \"%s\" on another process",
+                     _filename.c_str());
+      }
+    };
+
+  // Process 0 creates the file, writes the header and sets the file
+  // size
+  if (dolfin::MPI::rank(comm) == 0)
+  {
+    try
+    {
+      const FileDescriptor file(_filename, O_WRONLY | O_CREAT | O_TRUNC,
+                                0644);
+      if (file.fd < 0)
+      {
+        dolfin_error("CSRFile.cpp",
+                     "write to file",
+                     "Unable to create file \"%s\" (%s)",
+                     _filename.c_str(), std::strerror(errno));
+      }
+
+      Header header;
+      std::memset(&header, 0, sizeof(header));
+      std::memcpy(header.magic, magic, sizeof(magic));
+      header.version = version;
+      header.rank = rank;
+      header.num_rows = num_rows;
+      header.num_cols = num_cols;
+      header.num_nonzeros = num_nonzeros;
+      write_at(file.fd, &header, sizeof(header), 0, _filename);
+
+      if (ftruncate(file.fd, file_size) != 0)
+      {
+        dolfin_error("CSRFile.cpp",
+                     "write to file",
+                     "Unable to resize file \"%s\" (%s)",
+                     _filename.c_str(), std::strerror(errno));
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+  }
+  check_error();
+
+  // Each process writes its own segments
+  try
+  {
+    const FileDescriptor file(_filename, O_WRONLY);
+    if (file.fd < 0)
+    {
+      dolfin_error("CSRFile.cpp",
+                   "write to file",
+                   "Unable to open file \"%s\" (%s)",
+                   _filename.c_str(), std::strerror(errno));
+    }
+
+    if (rank == 2)
+    {
+      // Row offsets, including the final offset on the process that
+      // owns the last row
+      const std::size_t n = (row_offset + num_local_rows == num_rows)
+        ? num_local_rows + 1 : num_local_rows;
+      write_at(file.fd, row_ptr, sizeof(std::int64_t)*n,
+               row_ptr_offset() + sizeof(std::int64_t)*row_offset, _filename);
+      write_at(file.fd, cols, sizeof(std::int64_t)*num_local_nonzeros,
+               cols_offset(rank, num_rows) + sizeof(std::int64_t)*nnz_offset,
+               _filename);
+    }
+    write_at(file.fd, values, sizeof(double)*num_local_nonzeros,
+             values_offset(rank, num_rows, num_nonzeros)
+             + sizeof(double)*nnz_offset, _filename);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+  check_error();
+}
+//-----------------------------------------------------------------------------
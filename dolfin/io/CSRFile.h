@@ -0,0 +1,151 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __DOLFIN_CSR_FILE_H
+#define __DOLFIN_CSR_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/Variable.h>
+
+namespace dolfin
+{
+
+  class GenericMatrix;
+  class GenericVector;
+
+  /// This class supports reading and writing assembled matrices and
+  /// vectors in a raw binary format, intended for dumping linear
+  /// systems and replaying them offline.
+  ///
+  /// A file consists of a 64 byte header followed by raw arrays. For
+  /// a matrix these are the global compressed row storage arrays
+  /// (row offsets and column indices as 64 bit integers, values as
+  /// doubles); for a vector the values. Each process writes the rows
+  /// it owns directly at its offset in the file. Files are read by
+  /// mapping them into memory (mmap), so that the arrays can be
+  /// accessed without copying via map().
+
+  class CSRFile : public Variable
+  {
+  public:
+
+    /// Memory-mapped view of the arrays stored in a file. The
+    /// pointers remain valid for the lifetime of the object. A
+    /// Mapping owns the mapped memory, so it can be moved but not
+    /// copied.
+    class Mapping
+    {
+    public:
+
+      /// Map file into memory (read-only). The file size, row
+      /// offsets and column indices are checked against the header.
+      explicit Mapping(const std::string filename);
+
+      /// Move constructor
+      Mapping(Mapping&& mapping);
+
+      /// Copy constructor (deleted)
+      Mapping(const Mapping& mapping) = delete;
+
+      /// Unmap file
+      ~Mapping();
+
+      /// Move assignment
+      Mapping& operator=(Mapping&& mapping);
+
+      /// Assignment (deleted)
+      Mapping& operator=(const Mapping& mapping) = delete;
+
+      /// Tensor rank (1 for vectors, 2 for matrices)
+      std::size_t rank;
+
+      /// Global number of rows
+      std::size_t num_rows;
+
+      /// Global number of columns (zero for vectors)
+      std::size_t num_cols;
+
+      /// Global number of stored values
+      std::size_t num_nonzeros;
+
+      /// Row offsets (size num_rows + 1), null for vectors
+      const std::int64_t* row_ptr;
+
+      /// Column indices (size num_nonzeros), null for vectors
+      const std::int64_t* cols;
+
+      /// Values (size num_nonzeros)
+      const double* values;
+
+    private:
+
+      // Mapped memory and its size
+      void* _data;
+      std::size_t _size;
+
+    };
+
+    /// Constructor
+    CSRFile(MPI_Comm comm, const std::string filename);
+
+    /// Destructor
+    ~CSRFile();
+
+    /// Write matrix (collective)
+    void write(const GenericMatrix& A);
+
+    /// Write vector (collective)
+    void write(const GenericVector& x);
+
+    /// Read matrix. The matrix must be empty; it is initialised with
+    /// rows (and columns) distributed evenly over processes
+    void read(GenericMatrix& A);
+
+    /// Read vector. An empty vector is initialised with entries
+    /// distributed evenly over processes, otherwise the global size
+    /// must match the file.
+    void read(GenericVector& x);
+
+    /// Map the file into memory and return a view of its arrays
+    std::shared_ptr<const Mapping> map() const;
+
+  private:
+
+    // Write header and raw arrays of local data at the given global
+    // offsets (collective)
+    void write_data(std::size_t rank, std::size_t num_rows,
+                    std::size_t num_cols, std::size_t num_nonzeros,
+                    std::size_t row_offset, std::size_t num_local_rows,
+                    const std::int64_t* row_ptr, std::size_t nnz_offset,
+                    std::size_t num_local_nonzeros, const std::int64_t* cols,
+                    const double* values);
+
+    // MPI communicator
+    dolfin::MPI::Comm _mpi_comm;
+
+    // Filename
+    const std::string _filename;
+
+  };
+
+}
+
+#endif
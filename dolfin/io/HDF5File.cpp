@@ -451,15 +451,7 @@ void HDF5File::write(const Mesh& mesh, std::size_t cell_dim,
 
     // For cells, write the global cell index
     if (cell_dim == mesh.topology().dim())
-    {
-      const std::string cell_index_dataset = name + "/cell_indices";
-      global_size.pop_back();
-      const auto& cell_index_ref = mesh.topology().global_indices(cell_dim);
-      const std::vector<std::int64_t> cells(cell_index_ref.begin(),
-            cell_index_ref.begin() + mesh.topology().ghost_offset(cell_dim));
-      const bool mpi_io = _mpi_comm.size() > 1 ? true : false;
-      write_data(cell_index_dataset, cells, global_size, mpi_io);
-    }
+      write_cell_indices(mesh, name);
 
     // Add cell type attribute
     HDF5Interface::add_attribute(_hdf5_file_id, topology_dataset, "celltype",
@@ -478,6 +470,160 @@ void HDF5File::write(const Mesh& mesh, std::size_t cell_dim,
     HDF5Interface::add_attribute(_hdf5_file_id, topology_dataset,
                                  "partition", partitions);
 
+    // Store ghost cells and cell sharing, so that the partition can
+    // be restored when reading on the same number of processes
+    if (cell_dim == tdim and mpi_io)
+      write_mesh_partition(mesh, name);
+  }
+}
+//-----------------------------------------------------------------------------
+void HDF5File::write_cell_indices(const Mesh& mesh, const std::string name)
+{
+  // Global indices of the cells owned by this process (in the order
+  // of the topology, which excludes ghost cells)
+  const std::size_t tdim = mesh.topology().dim();
+  const auto& cell_index_ref = mesh.topology().global_indices(tdim);
+  const std::vector<std::int64_t> cells(cell_index_ref.begin(),
+        cell_index_ref.begin() + mesh.topology().ghost_offset(tdim));
+
+  const std::vector<std::int64_t> global_size(1, MPI::sum(_mpi_comm.comm(),
+                                                          cells.size()));
+  const bool mpi_io = _mpi_comm.size() > 1 ? true : false;
+  write_data(name + "/cell_indices", cells, global_size, mpi_io);
+}
+//-----------------------------------------------------------------------------
+void HDF5File::write_mesh_partition(const Mesh& mesh, const std::string name)
+{
+  dolfin_assert(_hdf5_file_id > 0);
+  const MPI_Comm comm = _mpi_comm.comm();
+  const std::size_t tdim = mesh.topology().dim();
+
+  // Record the ghost mode the mesh was built with
+  HDF5Interface::add_attribute(_hdf5_file_id, name + "/topology",
+                               "ghost_mode", mesh.ghost_mode());
+
+  // Ghost cells, with vertices given by global index in VTK ordering
+  const std::vector<std::int8_t> perm = mesh.type().vtk_mapping();
+  const std::size_t num_cell_vertices = mesh.type().num_vertices();
+  const auto& global_vertices = mesh.topology().global_indices(0);
+  std::vector<std::int64_t> ghost_topology;
+  std::vector<std::int64_t> ghost_cell_indices;
+  std::vector<std::int64_t> ghost_cell_owners;
+  for (MeshEntityIterator c(mesh, tdim, "ghost"); !c.end(); ++c)
+  {
+    const unsigned int* vertices = c->entities(0);
+    for (std::size_t i = 0; i < num_cell_vertices; ++i)
+      ghost_topology.push_back(global_vertices[vertices[perm[i]]]);
+    ghost_cell_indices.push_back(c->global_index());
+    ghost_cell_owners.push_back(c->owner());
+  }
+
+  // Processes sharing each shared cell, stored as (local cell index,
+  // number of processes, processes)
+  std::vector<std::int64_t> shared_cells;
+  if (mesh.topology().have_shared_entities(tdim))
+  {
+    for (const auto& cell : mesh.topology().shared_entities(tdim))
+    {
+      shared_cells.push_back(cell.first);
+      shared_cells.push_back(cell.second.size());
+      shared_cells.insert(shared_cells.end(), cell.second.begin(),
+                          cell.second.end());
+    }
+  }
+
+  // Write blocks of data from each process, with the offset of each
+  // block as 'partition' attribute. Empty datasets are not written.
+  auto write_blocks = [this, comm](const std::string dataset_name,
+                                   const std::vector<std::int64_t>& data,
+                                   const std::size_t block_size)
+  {
+    const std::size_t num_blocks = data.size()/block_size;
+    std::vector<std::int64_t> global_size(1, MPI::sum(comm, num_blocks));
+    if (global_size[0] == 0)
+      return;
+    if (block_size > 1)
+      global_size.push_back(block_size);
+    write_data(dataset_name, data, global_size, true);
+
+    std::vector<std::size_t> partitions;
+    MPI::all_gather(comm, MPI::global_offset(comm, num_blocks, true),
+                    partitions);
+    HDF5Interface::add_attribute(_hdf5_file_id, dataset_name, "partition",
+                                 partitions);
+  };
+  write_blocks(name + "/ghost_topology", ghost_topology, num_cell_vertices);
+  write_blocks(name + "/ghost_cell_indices", ghost_cell_indices, 1);
+  write_blocks(name + "/ghost_cell_owners", ghost_cell_owners, 1);
+  write_blocks(name + "/shared_cells", shared_cells, 1);
+}
+//-----------------------------------------------------------------------------
+void HDF5File::read_mesh_partition(const std::string name,
+  std::vector<std::int64_t>& topology_data,
+  std::vector<std::int64_t>& global_cell_indices,
+  std::vector<int>& cell_owners,
+  std::map<std::int32_t, std::set<unsigned int>>& shared_cells) const
+{
+  dolfin_assert(_hdf5_file_id > 0);
+  const std::size_t proc = _mpi_comm.rank();
+
+  // Read the block of this process from a dataset written by
+  // write_mesh_partition (empty datasets are not written)
+  auto read_block = [this, proc](const std::string dataset_name,
+                                 std::vector<std::int64_t>& data)
+  {
+    data.clear();
+    if (!HDF5Interface::has_dataset(_hdf5_file_id, dataset_name))
+      return;
+
+    std::vector<std::size_t> partitions;
+    HDF5Interface::get_attribute(_hdf5_file_id, dataset_name, "partition",
+                                 partitions);
+    if (partitions.size() != _mpi_comm.size())
+    {
+      dolfin_error("HDF5File.cpp",
+                   "read mesh partition",
+                   "Dataset \"%s\" was written by %d processes",
+                   dataset_name.c_str(), partitions.size());
+    }
+    const std::vector<std::int64_t> shape
+      = HDF5Interface::get_dataset_shape(_hdf5_file_id, dataset_name);
+    partitions.push_back(shape[0]);
+    if (partitions[proc + 1] > partitions[proc])
+    {
+      HDF5Interface::read_dataset(_hdf5_file_id, dataset_name,
+                                  {partitions[proc], partitions[proc + 1]},
+                                  data);
+    }
+  };
+
+  // Append ghost cells
+  std::vector<std::int64_t> data;
+  read_block(name + "/ghost_topology", data);
+  topology_data.insert(topology_data.end(), data.begin(), data.end());
+  read_block(name + "/ghost_cell_indices", data);
+  global_cell_indices.insert(global_cell_indices.end(), data.begin(),
+                             data.end());
+  read_block(name + "/ghost_cell_owners", data);
+  cell_owners.insert(cell_owners.end(), data.begin(), data.end());
+  if (global_cell_indices.size() != cell_owners.size())
+  {
+    dolfin_error("HDF5File.cpp",
+                 "read mesh partition",
+                 "Number of ghost cell owners does not match number of ghost cells");
+  }
+
+  // Unpack (local cell index, number of processes, processes)
+  shared_cells.clear();
+  read_block(name + "/shared_cells", data);
+  for (std::size_t i = 0; i < data.size(); i += data[i + 1] + 2)
+  {
+    dolfin_assert(i + 1 < data.size());
+    shared_cells.insert(shared_cells.end(),
+                        {(std::int32_t) data[i],
+                         std::set<unsigned int>(data.begin() + i + 2,
+                                                data.begin() + i + 2
+                                                + data[i + 1])});
   }
 }
 //-----------------------------------------------------------------------------
@@ -780,8 +926,8 @@ void HDF5File::write_mesh_function(const MeshFunction<T>& meshfunction,
   if (cell_dim == mesh.topology().dim() || _mpi_comm.size() == 1)
   {
     // No duplicates - ignore ghost cells if present
-    data_values.assign(meshfunction.values(),
-       meshfunction.values() + mesh.topology().ghost_offset(cell_dim));
+    meshfunction.get_values(data_values);
+    data_values.resize(mesh.topology().ghost_offset(cell_dim));
   }
   else
   {
@@ -1110,8 +1256,7 @@ void HDF5File::write(const MeshValueCollection<bool>& mesh_values,
   // HDF5 does not implement bool, use int and copy
 
   MeshValueCollection<int> mvc_int(mesh_values.mesh(), mesh_values.dim());
-  const std::map<std::pair<std::size_t, std::size_t>, bool>& values
-    = mesh_values.values();
+  const auto& values = mesh_values.values();
   for (auto mesh_value_it = values.begin(); mesh_value_it != values.end();
        ++mesh_value_it)
   {
@@ -1130,8 +1275,7 @@ void HDF5File::read(MeshValueCollection<bool>& mesh_values,
   MeshValueCollection<int> mvc_int(mesh_values.mesh(), mesh_values.dim());
   read_mesh_value_collection(mvc_int, name);
 
-  const std::map<std::pair<std::size_t, std::size_t>, int>& values
-    = mvc_int.values();
+  const auto& values = mvc_int.values();
   for (auto mesh_value_it = values.begin(); mesh_value_it != values.end();
        ++mesh_value_it)
   {
@@ -1151,8 +1295,7 @@ void HDF5File::write_mesh_value_collection(const MeshValueCollection<T>& mesh_va
   const std::size_t dim = mesh_values.dim();
   std::shared_ptr<const Mesh> mesh = mesh_values.mesh();
 
-  const std::map<std::pair<std::size_t, std::size_t>, T>& values
-    = mesh_values.values();
+  const auto& values = mesh_values.values();
 
   std::unique_ptr<CellType>
     entity_type(CellType::create(mesh->type().entity_type(dim)));
@@ -1200,8 +1343,7 @@ void HDF5File::write_mesh_value_collection_old(
 {
   dolfin_assert(_hdf5_file_id > 0);
 
-  const std::map<std::pair<std::size_t, std::size_t>, T>& values
-    = mesh_values.values();
+  const auto& values = mesh_values.values();
 
   const Mesh& mesh = *mesh_values.mesh();
   const std::vector<std::int64_t>& global_cell_index
@@ -1420,14 +1562,16 @@ void HDF5File::read_mesh_value_collection(MeshValueCollection<T>& mesh_vc,
   MPI::all_to_all(_mpi_comm.comm(), send_entities, recv_entities);
   MPI::all_to_all(_mpi_comm.comm(), send_data, recv_data);
 
+  std::vector<std::size_t> entity_indices;
+  std::vector<T> values;
   for (std::size_t i = 0; i != num_processes; ++i)
   {
     dolfin_assert(recv_entities[i].size() == recv_data[i].size());
-    for (std::size_t j = 0; j != recv_data[i].size(); ++j)
-    {
-      mesh_vc.set_value(recv_entities[i][j], recv_data[i][j]);
-    }
+    entity_indices.insert(entity_indices.end(), recv_entities[i].begin(),
+                          recv_entities[i].end());
+    values.insert(values.end(), recv_data[i].begin(), recv_data[i].end());
   }
+  mesh_vc.set_values(entity_indices, values);
 
 }
 //-----------------------------------------------------------------------------
@@ -1513,8 +1657,7 @@ void HDF5File::read_mesh_value_collection_old(MeshValueCollection<T>& mesh_vc,
       mesh.topology().global_indices(mesh.topology().dim());
 
     // Reference to actual map of MeshValueCollection
-    std::map<std::pair<std::size_t, std::size_t>, T>& mvc_map
-      = mesh_vc.values();
+    auto& mvc_map = mesh_vc.values();
 
     // Find cells which are on this process,
     // under the assumption that global_cell_index is ordered.
@@ -1599,10 +1742,8 @@ void HDF5File::read_mesh_value_collection_old(MeshValueCollection<T>& mesh_vc,
     MPI::all_to_all(_mpi_comm.comm(), send_local, recv_local);
     MPI::all_to_all(_mpi_comm.comm(), send_values, recv_values);
 
-    // Reference to actual map of MeshValueCollection
-    std::map<std::pair<std::size_t, std::size_t>, T>& mvc_map
-      = mesh_vc.values();
-
+    // Collect received values and set them in bulk
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>, T>> values;
     for (std::size_t i = 0; i < num_processes; ++i)
     {
       const std::vector<std::size_t>& local_index = recv_local[i];
@@ -1613,10 +1754,11 @@ void HDF5File::read_mesh_value_collection_old(MeshValueCollection<T>& mesh_vc,
 
       for (std::size_t j = 0; j < local_index.size(); ++j)
       {
-        mvc_map[std::make_pair(local_index[j], local_entities[j])]
-          = local_values[j];
+        values.push_back({{local_index[j], local_entities[j]},
+              local_values[j]});
       }
     }
+    mesh_vc.set_values(std::move(values));
   }
 }
 //-----------------------------------------------------------------------------
@@ -1782,17 +1924,33 @@ void HDF5File::read(Mesh& input_mesh,
 
   // Check whether number of MPI processes matches partitioning, and
   // restore if possible
+  const std::string ghost_mode = dolfin::parameters["ghost_mode"];
+  bool restore_partition = false;
   if (_mpi_comm.size() == cell_partitions.size())
   {
     cell_partitions.push_back(num_global_cells);
     const std::size_t proc = _mpi_comm.rank();
     cell_range = std::make_pair(cell_partitions[proc], cell_partitions[proc + 1]);
 
-    // Restore partitioning if requested
-    if (use_partition_from_file)
+    // Restore partitioning if requested. Ghost cells are only
+    // available if the mesh was written with the same ghost mode.
+    if (use_partition_from_file and _mpi_comm.size() > 1)
     {
-      local_mesh_data.topology.cell_partition
-        = std::vector<int>(cell_range.second - cell_range.first, proc);
+      std::string file_ghost_mode = "none";
+      if (HDF5Interface::has_attribute(_hdf5_file_id, topology_path,
+                                       "ghost_mode"))
+      {
+        HDF5Interface::get_attribute(_hdf5_file_id, topology_path,
+                                     "ghost_mode", file_ghost_mode);
+      }
+
+      if (ghost_mode == "none" or ghost_mode == file_ghost_mode)
+        restore_partition = true;
+      else
+      {
+        warning("Could not use partition from file: mesh was written with ghost mode \"%s\"",
+                file_ghost_mode.c_str());
+      }
     }
   }
   else
@@ -1844,17 +2002,34 @@ void HDF5File::read(Mesh& input_mesh,
               cell_range.first);
   }
 
+  // Restore ownership of cells, and append ghost cells and read
+  // sharing of cells if ghosting
+  std::map<std::int32_t, std::set<unsigned int>> shared_cells;
+  if (restore_partition)
+  {
+    local_mesh_data.topology.cell_partition
+      = std::vector<int>(num_local_cells, _mpi_comm.rank());
+    if (ghost_mode != "none")
+    {
+      read_mesh_partition(mesh_name, topology_data, global_cell_indices,
+                          local_mesh_data.topology.cell_partition,
+                          shared_cells);
+    }
+  }
+  const int num_cells = global_cell_indices.size();
+  dolfin_assert((int) topology_data.size() == num_cells*num_vertices_per_cell);
+
   // FIXME: allocate multi_array data and pass to HDFr read function
   // to avoid copy
   // Copy to boost::multi_array
-  local_mesh_data.topology.cell_vertices.resize(boost::extents[num_local_cells][num_vertices_per_cell]);
+  local_mesh_data.topology.cell_vertices.resize(boost::extents[num_cells][num_vertices_per_cell]);
   boost::multi_array_ref<std::int64_t, 2>
     topology_data_array(topology_data.data(),
-                        boost::extents[num_local_cells][num_vertices_per_cell]);
+                        boost::extents[num_cells][num_vertices_per_cell]);
 
   // Remap vertices to DOLFIN ordering from VTK/XDMF ordering
   const std::vector<std::int8_t> perm = cell_type.vtk_mapping();
-  for (int i = 0; i != num_local_cells; ++i)
+  for (int i = 0; i != num_cells; ++i)
   {
     for (int j = 0; j != num_vertices_per_cell; ++j)
       local_mesh_data.topology.cell_vertices[i][j] = topology_data_array[i][perm[j]];
@@ -1938,11 +2113,15 @@ void HDF5File::read(Mesh& input_mesh,
   // FIXME: Why is the mesh built into HDF5Utility? This should be in the mesh code.
   if (_mpi_comm.size() == 1)
     HDF5Utility::build_local_mesh(input_mesh, local_mesh_data);
-  else
+  else if (restore_partition)
   {
-    const std::string ghost_mode = dolfin::parameters["ghost_mode"];
-    MeshPartitioning::build_distributed_mesh(input_mesh, local_mesh_data, ghost_mode);
+    // Build from the cells of this process, without partitioning
+    MeshPartitioning::build_distributed_mesh(input_mesh, local_mesh_data,
+                                             num_local_cells, shared_cells,
+                                             ghost_mode);
   }
+  else
+    MeshPartitioning::build_distributed_mesh(input_mesh, local_mesh_data, ghost_mode);
 
 }
 //-----------------------------------------------------------------------------
@@ -22,6 +22,9 @@
 
 #ifdef HAS_HDF5
 
+#include <cstdint>
+#include <map>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -229,6 +232,27 @@ namespace dolfin
       void read_mesh_value_collection_old(MeshValueCollection<T>& mesh_values,
                                           const std::string name) const;
 
+    // Write the global indices of the cells owned by this process to
+    // data set 'name/cell_indices', in the order of the cells in the
+    // topology data set
+    void write_cell_indices(const Mesh& mesh, const std::string name);
+
+    // Write the ghost cells of a distributed mesh and the processes
+    // sharing each cell to group 'name', next to the mesh topology,
+    // so that the partition can be restored when the mesh is read on
+    // the same number of processes
+    void write_mesh_partition(const Mesh& mesh, const std::string name);
+
+    // Read the ghost cells held by this process from group 'name', as
+    // written by write_mesh_partition, appending their topology (VTK
+    // ordering), global indices and owners, and read the processes
+    // sharing each cell of this process
+    void read_mesh_partition(const std::string name,
+                             std::vector<std::int64_t>& topology_data,
+                             std::vector<std::int64_t>& global_cell_indices,
+                             std::vector<int>& cell_owners,
+                             std::map<std::int32_t, std::set<unsigned int>>& shared_cells) const;
+
     // Write contiguous data to HDF5 data set. Data is flattened into
     // a 1D array, e.g. [x0, y0, z0, x1, y1, z1] for a vector in 3D
     template <typename T>
@@ -172,13 +172,14 @@ void X3DFile::write_meshfunction(const MeshFunction<std::size_t>& meshfunction)
                  "X3D will only output 2D or 3D meshes");
   }
 
-  // Pointer to MeshFunction data
-  const std::size_t* values = meshfunction.values();
+  // MeshFunction data
+  std::vector<std::size_t> values;
+  meshfunction.get_values(values);
 
   // Get min/max values of MeshFunction
-  std::size_t minval = *std::min_element(values, values + meshfunction.size());
+  std::size_t minval = *std::min_element(values.begin(), values.end());
   minval = MPI::min(mesh.mpi_comm(), minval);
-  std::size_t maxval = *std::max_element(values, values + meshfunction.size());
+  std::size_t maxval = *std::max_element(values.begin(), values.end());
   maxval = MPI::max(mesh.mpi_comm(), maxval);
   double dval;
   if (maxval == minval)
@@ -125,6 +125,19 @@ void XDMFFile::write(const Mesh& mesh, const Encoding encoding)
   // Add the mesh Grid to the domain
   add_mesh(_mpi_comm.comm(), domain_node, h5_id, mesh, "/Mesh");
 
+#ifdef HAS_HDF5
+  // Store ghost cells and cell sharing, so that the partition can be
+  // restored when reading on the same number of processes. Ghost
+  // cells are stored by global index, so the global indices of the
+  // owned cells are stored too.
+  if (h5_file and _mpi_comm.size() > 1 and mesh.geometry().degree() == 1)
+  {
+    const std::string name = "/Mesh/" + mesh.name();
+    h5_file->write_cell_indices(mesh, name);
+    h5_file->write_mesh_partition(mesh, name);
+  }
+#endif
+
   // Save XML file (on process 0 only)
   if (_mpi_comm.rank() == 0)
     _xml_doc->save_file(_filename.c_str(), "  ");
@@ -710,8 +723,7 @@ void XDMFFile::write_mesh_value_collection(const MeshValueCollection<T>& mvc,
     = vtk_cell_type_str(mesh->type().entity_type(cell_dim), mesh->geometry().degree());
   const std::int64_t num_vertices_per_cell = mesh->type().num_vertices(cell_dim);
 
-  const std::map<std::pair<std::size_t, std::size_t>, T>& values
-    = mvc.values();
+  const auto& values = mvc.values();
   const std::int64_t num_cells = values.size();
   const std::int64_t num_cells_global = MPI::sum(mesh->mpi_comm(), num_cells);
 
@@ -968,14 +980,16 @@ void XDMFFile::read_mesh_value_collection
   MPI::all_to_all(_mpi_comm.comm(), send_entities, recv_entities);
   MPI::all_to_all(_mpi_comm.comm(), send_data, recv_data);
 
+  std::vector<std::size_t> entity_indices;
+  std::vector<T> values;
   for (std::int32_t i = 0; i != num_processes; ++i)
   {
     dolfin_assert(recv_entities[i].size() == recv_data[i].size());
-    for (std::size_t j = 0; j != recv_data[i].size(); ++j)
-    {
-      mvc.set_value(recv_entities[i][j], recv_data[i][j]);
-    }
+    entity_indices.insert(entity_indices.end(), recv_entities[i].begin(),
+                          recv_entities[i].end());
+    values.insert(values.end(), recv_data[i].begin(), recv_data[i].end());
   }
+  mvc.set_values(entity_indices, values);
 
 }
 //-----------------------------------------------------------------------------
@@ -1403,6 +1417,41 @@ void XDMFFile::read(Mesh& mesh) const
   }
   else
   {
+#ifdef HAS_HDF5
+    // If the mesh was written by the same number of processes with
+    // its partition, restore the partition through the HDF5 reader
+    pugi::xml_attribute format_attr = topology_data_node.attribute("Format");
+    if (degree == 1 and format_attr
+        and std::string(format_attr.as_string()) == "HDF")
+    {
+      const auto topology_paths = get_hdf5_paths(topology_data_node);
+      const auto geometry_paths = get_hdf5_paths(geometry_data_node);
+      boost::filesystem::path h5_filepath(topology_paths[0]);
+      if (!h5_filepath.is_absolute())
+        h5_filepath = parent_path / h5_filepath;
+
+      HDF5File h5_file(_mpi_comm.comm(), h5_filepath.string(), "r");
+      const hid_t h5_id = h5_file.h5_id();
+      std::vector<std::size_t> partitions;
+      if (topology_paths[0] == geometry_paths[0]
+          and HDF5Interface::has_attribute(h5_id, topology_paths[1],
+                                           "ghost_mode")
+          and HDF5Interface::has_attribute(h5_id, topology_paths[1],
+                                           "partition"))
+      {
+        HDF5Interface::get_attribute(h5_id, topology_paths[1], "partition",
+                                     partitions);
+      }
+
+      if (partitions.size() == _mpi_comm.size())
+      {
+        h5_file.read(mesh, topology_paths[1], geometry_paths[1], gdim,
+                     *cell_type, num_cells_global, num_points_global, true);
+        return;
+      }
+    }
+#endif
+
     // Build local mesh data structure
     LocalMeshData local_mesh_data(_mpi_comm.comm());
     build_local_mesh_data(local_mesh_data, *cell_type, num_points_global,
@@ -2135,10 +2184,7 @@ std::vector<T> XDMFFile::compute_value_data(const MeshFunction<T>& meshfunction)
   if (MPI::size(comm) == 1 or cell_dim == tdim)
   {
     // FIXME: fail with ghosts?
-    value_data.resize(meshfunction.size());
-    std::copy(meshfunction.values(),
-              meshfunction.values() + meshfunction.size(),
-              value_data.begin());
+    meshfunction.get_values(value_data);
   }
   else
   {
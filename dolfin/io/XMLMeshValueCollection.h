@@ -160,11 +160,8 @@ namespace dolfin
       = (unsigned int) mesh_value_collection.size();
 
     // Add data
-    const std::map<std::pair<std::size_t, std::size_t>, T>&
-      values = mesh_value_collection.values();
-    typename std::map<std::pair<std::size_t,
-      std::size_t>, T>::const_iterator it;
-    for (it = values.begin(); it != values.end(); ++it)
+    const auto& values = mesh_value_collection.values();
+    for (auto it = values.begin(); it != values.end(); ++it)
     {
       pugi::xml_node entity_node = mf_node.append_child("value");
       entity_node.append_attribute("cell_index")
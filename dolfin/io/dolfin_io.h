@@ -9,5 +9,6 @@
 #include <dolfin/io/HDF5File.h>
 #include <dolfin/io/HDF5Attribute.h>
 #include <dolfin/io/X3DOM.h>
+#include <dolfin/io/CSRFile.h>
 
 #endif
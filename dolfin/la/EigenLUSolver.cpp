@@ -15,6 +15,7 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <dolfin/common/types.h>
 #include <Eigen/SparseLU>
 #ifdef HAS_CHOLMOD
@@ -61,6 +62,7 @@ class EigenLUSolver::EigenLUImplBase
 {
 public:
   virtual void solve(EigenVector &x, const EigenVector &b) = 0;
+  virtual bool factorize(const EigenMatrix& A) = 0;
   virtual ~EigenLUImplBase() {}
 };
 
@@ -80,15 +82,29 @@ public:
     // Most solvers require a compressed matrix
     _A.makeCompressed();
 
-    // Factorize matrix
-    _solver->compute(_A);
-
-    if (_solver->info() != Eigen::Success)
+    // Compute fill-reducing ordering and symbolic factorisation
     {
-      dolfin_error("EigenLUSolver.cpp",
-                   "compute matrix factorisation",
-                   "The provided data did not satisfy the prerequisites");
+      Timer timer("Eigen LU solver symbolic factorisation");
+      _solver->analyzePattern(_A);
     }
+
+    // Factorize matrix
+    numeric_factorize();
+  }
+
+  // Recompute the numeric factorisation of A, reusing the ordering
+  // and symbolic factorisation. Returns false if the nonzero pattern
+  // of A differs from the analysed pattern.
+  bool factorize(const EigenMatrix& A) override
+  {
+    typename Solver::MatrixType A_new(A.mat());
+    A_new.makeCompressed();
+    if (!same_pattern(A_new))
+      return false;
+
+    _A.swap(A_new);
+    numeric_factorize();
+    return true;
   }
 
   void solve(EigenVector &x, const EigenVector &b) override
@@ -106,6 +122,35 @@ public:
   }
 
 private:
+
+  void numeric_factorize()
+  {
+    Timer timer("Eigen LU solver numeric factorisation");
+    _solver->factorize(_A);
+
+    if (_solver->info() != Eigen::Success)
+    {
+      dolfin_error("EigenLUSolver.cpp",
+                   "compute matrix factorisation",
+                   "The provided data did not satisfy the prerequisites");
+    }
+  }
+
+  // Check that A has the same (compressed) nonzero pattern as _A
+  bool same_pattern(const typename Solver::MatrixType& A) const
+  {
+    if (A.rows() != _A.rows() or A.cols() != _A.cols()
+        or A.nonZeros() != _A.nonZeros())
+    {
+      return false;
+    }
+
+    return std::equal(A.outerIndexPtr(), A.outerIndexPtr() + A.outerSize() + 1,
+                      _A.outerIndexPtr())
+      and std::equal(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros(),
+                     _A.innerIndexPtr());
+  }
+
   std::shared_ptr<Solver> _solver;
   typename Solver::MatrixType _A;
 };
@@ -146,7 +191,7 @@ Parameters EigenLUSolver::default_parameters()
   return p;
 }
 //-----------------------------------------------------------------------------
-EigenLUSolver::EigenLUSolver(std::string method)
+EigenLUSolver::EigenLUSolver(std::string method) : _refactorize(false)
 {
   // Set parameter values
   parameters = default_parameters();
@@ -155,7 +200,8 @@ EigenLUSolver::EigenLUSolver(std::string method)
 }
 //-----------------------------------------------------------------------------
 EigenLUSolver::EigenLUSolver(std::shared_ptr<const EigenMatrix> A,
-                             std::string method) : _matA(A)
+                             std::string method)
+  : _refactorize(false), _matA(A)
 {
   // Check dimensions
   if (A->size(0) != A->size(1))
@@ -193,7 +239,14 @@ void EigenLUSolver::set_operator(std::shared_ptr<const EigenMatrix> A)
   dolfin_assert(_matA);
   dolfin_assert(!_matA->empty());
 
-  _impl.reset(nullptr);
+  // Keep the symbolic factorisation if the nonzero pattern is known
+  // to be unchanged, and only recompute the numeric factorisation
+  // in the next solve
+  const bool same_nonzero_pattern = parameters["same_nonzero_pattern"];
+  if (same_nonzero_pattern and _impl)
+    _refactorize = true;
+  else
+    _impl.reset(nullptr);
 }
 //-----------------------------------------------------------------------------
 const GenericLinearOperator& EigenLUSolver::get_operator() const
@@ -230,6 +283,18 @@ std::size_t EigenLUSolver::solve(GenericVector& x, const GenericVector& b)
   if (x.empty())
     _matA->init_vector(x, 1);
 
+  // Recompute numeric factorization only, if requested. Fall back to
+  // a full factorization if the pattern has changed.
+  if (_impl and _refactorize)
+  {
+    if (!_impl->factorize(*_matA))
+    {
+      warning("Nonzero pattern of matrix has changed, recomputing symbolic LU factorization");
+      _impl.reset(nullptr);
+    }
+  }
+  _refactorize = false;
+
   // Initialize Eigen LU solver and compute factorization
   if (!_impl) {
     if (_method == "sparselu")
@@ -98,6 +98,10 @@ namespace dolfin
     // Select LU solver type
     std::string select_solver(const std::string method) const;
 
+    // True if only the numeric factorization must be recomputed
+    // before the next solve
+    bool _refactorize;
+
     // Operator (the matrix)
     std::shared_ptr<const EigenMatrix> _matA;
 
@@ -16,6 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -257,6 +258,118 @@ double EigenVector::inner(const GenericVector& y) const
   return _x->dot(*_y);
 }
 //-----------------------------------------------------------------------------
+void EigenVector::axpby(double a, const GenericVector& y, double b)
+{
+  if (size() != y.size())
+  {
+    dolfin_error("EigenVector.cpp",
+                 "perform axpby operation with Eigen vector",
+                 "Vectors are not of the same size");
+  }
+
+  dolfin_assert(_x);
+  auto _y = as_type<const EigenVector>(y).vec();
+  dolfin_assert(_y);
+  (*_x) = a*_y->array() + b*_x->array();
+}
+//-----------------------------------------------------------------------------
+void EigenVector::maxpy(const std::vector<double>& a,
+                        const std::vector<const GenericVector*>& y)
+{
+  if (a.size() != y.size())
+  {
+    dolfin_error("EigenVector.cpp",
+                 "perform multiple axpy operation with Eigen vector",
+                 "Number of coefficients (%d) does not match number of vectors (%d)",
+                 a.size(), y.size());
+  }
+
+  dolfin_assert(_x);
+  const std::size_t n = _x->size();
+  const std::size_t m = y.size();
+  std::vector<const double*> _y(m);
+  for (std::size_t k = 0; k < m; ++k)
+  {
+    dolfin_assert(y[k]);
+    if (y[k]->size() != n)
+    {
+      dolfin_error("EigenVector.cpp",
+                   "perform multiple axpy operation with Eigen vector",
+                   "Vectors are not of the same size");
+    }
+    _y[k] = as_type<const EigenVector>(*y[k]).data();
+  }
+
+  // Single sweep over this vector, accumulating all contributions
+  double* x = _x->data();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    double xi = x[i];
+    for (std::size_t k = 0; k < m; ++k)
+      xi += a[k]*_y[k][i];
+    x[i] = xi;
+  }
+}
+//-----------------------------------------------------------------------------
+std::vector<double>
+EigenVector::mdot(const std::vector<const GenericVector*>& y) const
+{
+  dolfin_assert(_x);
+  const std::size_t n = _x->size();
+  const std::size_t m = y.size();
+  std::vector<const double*> _y(m);
+  for (std::size_t k = 0; k < m; ++k)
+  {
+    dolfin_assert(y[k]);
+    if (y[k]->size() != n)
+    {
+      dolfin_error("EigenVector.cpp",
+                   "compute multiple inner products with Eigen vector",
+                   "Vectors are not of the same size");
+    }
+    _y[k] = as_type<const EigenVector>(*y[k]).data();
+  }
+
+  // Single sweep over this vector, accumulating all inner products
+  std::vector<double> values(m, 0.0);
+  const double* x = _x->data();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const double xi = x[i];
+    for (std::size_t k = 0; k < m; ++k)
+      values[k] += xi*_y[k][i];
+  }
+
+  return values;
+}
+//-----------------------------------------------------------------------------
+std::pair<double, double>
+EigenVector::inner_and_norm(const GenericVector& y) const
+{
+  dolfin_assert(_x);
+  auto _y = as_type<const EigenVector>(y).vec();
+  dolfin_assert(_y);
+  if (_x->size() != _y->size())
+  {
+    dolfin_error("EigenVector.cpp",
+                 "compute inner product and norm of Eigen vector",
+                 "Vectors are not of the same size");
+  }
+
+  double dot = 0.0;
+  double norm_sq = 0.0;
+  const double* x = _x->data();
+  const double* yy = _y->data();
+  const std::size_t n = _x->size();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    dot += x[i]*yy[i];
+    norm_sq += x[i]*x[i];
+  }
+
+  return std::make_pair(dot, std::sqrt(norm_sq));
+}
+//-----------------------------------------------------------------------------
 const GenericVector& EigenVector::operator= (const GenericVector& v)
 {
   *this = as_type<const EigenVector>(v);
@@ -213,6 +213,22 @@ namespace dolfin
     /// Compute norm of vector
     virtual double norm(std::string norm_type) const;
 
+    /// Compute this = a*x + b*this (AXPBY operation)
+    virtual void axpby(double a, const GenericVector& x, double b);
+
+    /// Compute this = this + sum_i a[i]*x[i] in a single sweep
+    virtual void maxpy(const std::vector<double>& a,
+                       const std::vector<const GenericVector*>& x);
+
+    /// Return inner products with each of the given vectors,
+    /// computed in a single sweep
+    virtual std::vector<double>
+      mdot(const std::vector<const GenericVector*>& x) const;
+
+    /// Return inner product with given vector and l2 norm of this
+    /// vector, computed in a single sweep
+    virtual std::pair<double, double> inner_and_norm(const GenericVector& x) const;
+
     /// Return minimum value of vector
     virtual double min() const;
 
@@ -242,6 +242,61 @@ namespace dolfin
     /// Return norm of vector
     virtual double norm(std::string norm_type) const = 0;
 
+    //--- Fused operations ---
+    //
+    // The default implementations below are expressed in terms of
+    // the basic operations above. Backends should override them to
+    // perform a single sweep over memory and, for reductions, a
+    // single global reduction.
+
+    /// Compute this = a*x + b*this (AXPBY operation)
+    virtual void axpby(double a, const GenericVector& x, double b)
+    {
+      if (b != 1.0)
+        *this *= b;
+      axpy(a, x);
+    }
+
+    /// Compute this = this + sum_i a[i]*x[i] (multiple AXPY
+    /// operation)
+    virtual void maxpy(const std::vector<double>& a,
+                       const std::vector<const GenericVector*>& x)
+    {
+      if (a.size() != x.size())
+      {
+        dolfin_error("GenericVector.h",
+                     "perform multiple axpy operation",
+                     "Number of coefficients (%d) does not match number of vectors (%d)",
+                     a.size(), x.size());
+      }
+
+      for (std::size_t i = 0; i < x.size(); ++i)
+      {
+        dolfin_assert(x[i]);
+        axpy(a[i], *x[i]);
+      }
+    }
+
+    /// Return inner products of this vector with each of the given
+    /// vectors (multiple dot operation)
+    virtual std::vector<double>
+      mdot(const std::vector<const GenericVector*>& x) const
+    {
+      std::vector<double> values(x.size());
+      for (std::size_t i = 0; i < x.size(); ++i)
+      {
+        dolfin_assert(x[i]);
+        values[i] = inner(*x[i]);
+      }
+      return values;
+    }
+
+    /// Return the inner product with given vector and the l2 norm of
+    /// this vector, (x.this, |this|), computed with a single global
+    /// reduction when supported by the backend
+    virtual std::pair<double, double> inner_and_norm(const GenericVector& x) const
+    { return std::make_pair(inner(x), norm("l2")); }
+
     /// Return minimum value of vector
     virtual double min() const = 0;
 
@@ -71,6 +71,14 @@ namespace dolfin
       p.add("report", true);
       p.add("verbose", false);
       p.add("symmetric", false);
+
+      // Operator keeps the same nonzero pattern between calls to
+      // set_operator (e.g. Jacobians in Newton iterations). The
+      // fill-reducing ordering and symbolic factorization are then
+      // reused and only the numeric factorization is recomputed.
+      // PETScLUSolver copies the values of new operators into a copy
+      // of the first one, which PETSc then refactorizes numerically.
+      p.add("same_nonzero_pattern", false);
       return p;
     }
 
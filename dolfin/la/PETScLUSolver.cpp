@@ -218,12 +218,62 @@ PETScLUSolver::~PETScLUSolver()
 void
 PETScLUSolver::set_operator(std::shared_ptr<const GenericLinearOperator> A)
 {
-  _solver.set_operator(A);
+  set_operator(as_type<const PETScMatrix>(*require_matrix(A)));
 }
 //-----------------------------------------------------------------------------
 void PETScLUSolver::set_operator(const PETScMatrix& A)
 {
-  _solver.set_operator(A);
+  dolfin_assert(A.mat());
+  PetscErrorCode ierr;
+
+  const bool same_nonzero_pattern = parameters["same_nonzero_pattern"];
+  if (!same_nonzero_pattern)
+  {
+    _operator_copy.reset();
+    _solver.set_operator(A);
+    return;
+  }
+
+  // PETSc redoes only the numeric factorization if the operator is
+  // the Mat that was factorized before, with unchanged nonzero
+  // state. The values of a new operator are therefore copied into a
+  // copy of the first operator, which remains the KSP operator.
+  if (_operator_copy)
+  {
+    if (A.mat() != _operator_copy->mat())
+    {
+      ierr = MatCopy(A.mat(), _operator_copy->mat(), SAME_NONZERO_PATTERN);
+      if (ierr != 0) PETScObject::petsc_error(ierr, __FILE__, "MatCopy");
+    }
+    return;
+  }
+
+  // Re-assembled operator that is already set
+  KSP ksp = _solver.ksp();
+  PetscBool operator_set = PETSC_FALSE;
+  ierr = KSPGetOperatorsSet(ksp, NULL, &operator_set);
+  if (ierr != 0) PETScObject::petsc_error(ierr, __FILE__, "KSPGetOperatorsSet");
+  if (operator_set)
+  {
+    Mat P;
+    ierr = KSPGetOperators(ksp, NULL, &P);
+    if (ierr != 0) PETScObject::petsc_error(ierr, __FILE__, "KSPGetOperators");
+    if (P == A.mat())
+    {
+      _solver.set_operator(A);
+      return;
+    }
+  }
+
+  // New operator, which is copied so that the values of later
+  // operators can be copied into it without modifying A
+  Mat A_copy;
+  ierr = MatDuplicate(A.mat(), MAT_COPY_VALUES, &A_copy);
+  if (ierr != 0) PETScObject::petsc_error(ierr, __FILE__, "MatDuplicate");
+  _operator_copy = std::make_shared<PETScMatrix>(A_copy);
+  ierr = MatDestroy(&A_copy);
+  if (ierr != 0) PETScObject::petsc_error(ierr, __FILE__, "MatDestroy");
+  _solver.set_operator(*_operator_copy);
 }
 //-----------------------------------------------------------------------------
 std::size_t PETScLUSolver::solve(GenericVector& x, const GenericVector& b)
@@ -265,7 +315,7 @@ std::size_t PETScLUSolver::solve(const GenericLinearOperator& A,
 std::size_t PETScLUSolver::solve(const PETScMatrix& A, PETScVector& x,
                                  const PETScVector& b)
 {
-  _solver.set_operators(A, A);
+  set_operator(A);
   return solve(x, b);
 }
 //-----------------------------------------------------------------------------
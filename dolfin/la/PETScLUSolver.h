@@ -137,6 +137,10 @@ namespace dolfin
 
     PETScKrylovSolver _solver;
 
+    // Copy of the operator into which the values of later operators
+    // are copied if the parameter same_nonzero_pattern is set
+    std::shared_ptr<PETScMatrix> _operator_copy;
+
   };
 
 }
@@ -27,6 +27,7 @@
 
 #ifdef HAS_PETSC
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
@@ -35,6 +36,7 @@
 #include <dolfin/log/log.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/MPI.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "PETScFactory.h"
 #include "PETScVector.h"
 #include "SparsityPattern.h"
@@ -129,11 +131,6 @@ void PETScMatrix::init(const TensorLayout& tensor_layout)
   if (block_size != tensor_layout.index_map(1)->block_size())
     block_size = 1;
 
-  // Get number of nonzeros for each row from sparsity pattern
-  std::vector<std::size_t> num_nonzeros_diagonal, num_nonzeros_off_diagonal;
-  sparsity_pattern->num_nonzeros_diagonal(num_nonzeros_diagonal);
-  sparsity_pattern->num_nonzeros_off_diagonal(num_nonzeros_off_diagonal);
-
   // Set matrix size
   ierr = MatSetSizes(_matA, m, n, M, N);
   if (ierr != 0) petsc_error(ierr, __FILE__, "MatSetSizes");
@@ -143,26 +140,50 @@ void PETScMatrix::init(const TensorLayout& tensor_layout)
   ierr = MatSetFromOptions(_matA);
   if (ierr != 0) petsc_error(ierr, __FILE__, "MatSetFromOptions");
 
-  // Build data to initialixe sparsity pattern (modify for block size)
-  std::vector<PetscInt> _num_nonzeros_diagonal(num_nonzeros_diagonal.size()/block_size),
-    _num_nonzeros_off_diagonal(num_nonzeros_off_diagonal.size()/block_size);
-
-  for (std::size_t i = 0; i < _num_nonzeros_diagonal.size(); ++i)
+  // Preallocate from the compressed row arrays of the sparsity
+  // pattern when requested and the matrix is of AIJ type
+  bool csr_init = dolfin::parameters["petsc_matrix_csr_init"];
+  if (csr_init)
   {
-    _num_nonzeros_diagonal[i]
-      = dolfin_ceil_div(num_nonzeros_diagonal[block_size*i], block_size);
+    PetscBool is_aij = PETSC_FALSE;
+    ierr = PetscObjectTypeCompareAny((PetscObject)_matA, &is_aij,
+                                     MATSEQAIJ, MATMPIAIJ, "");
+    if (ierr != 0) petsc_error(ierr, __FILE__, "PetscObjectTypeCompareAny");
+    csr_init = (is_aij and block_size == 1
+                and sparsity_pattern->primary_dim() == 0);
   }
-  for (std::size_t i = 0; i < _num_nonzeros_off_diagonal.size(); ++i)
+
+  std::vector<PetscInt> _num_nonzeros_diagonal, _num_nonzeros_off_diagonal;
+  if (csr_init)
+    init_csr(*sparsity_pattern, m);
+  else
   {
-    _num_nonzeros_off_diagonal[i]
-      = dolfin_ceil_div(num_nonzeros_off_diagonal[block_size*i], block_size);
-  }
+    // Get number of nonzeros for each row from sparsity pattern
+    std::vector<std::size_t> num_nonzeros_diagonal, num_nonzeros_off_diagonal;
+    sparsity_pattern->num_nonzeros_diagonal(num_nonzeros_diagonal);
+    sparsity_pattern->num_nonzeros_off_diagonal(num_nonzeros_off_diagonal);
+
+    // Build data to initialixe sparsity pattern (modify for block size)
+    _num_nonzeros_diagonal.resize(num_nonzeros_diagonal.size()/block_size);
+    _num_nonzeros_off_diagonal.resize(num_nonzeros_off_diagonal.size()/block_size);
 
-  // Allocate space (using data from sparsity pattern)
-  ierr = MatXAIJSetPreallocation(_matA, block_size,
-                                 _num_nonzeros_diagonal.data(),
-                                 _num_nonzeros_off_diagonal.data(), NULL, NULL);
-  if (ierr != 0) petsc_error(ierr, __FILE__, "MatXIJSetPreallocation");
+    for (std::size_t i = 0; i < _num_nonzeros_diagonal.size(); ++i)
+    {
+      _num_nonzeros_diagonal[i]
+        = dolfin_ceil_div(num_nonzeros_diagonal[block_size*i], block_size);
+    }
+    for (std::size_t i = 0; i < _num_nonzeros_off_diagonal.size(); ++i)
+    {
+      _num_nonzeros_off_diagonal[i]
+        = dolfin_ceil_div(num_nonzeros_off_diagonal[block_size*i], block_size);
+    }
+
+    // Allocate space (using data from sparsity pattern)
+    ierr = MatXAIJSetPreallocation(_matA, block_size,
+                                   _num_nonzeros_diagonal.data(),
+                                   _num_nonzeros_off_diagonal.data(), NULL, NULL);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatXIJSetPreallocation");
+  }
 
 
   // Create pointers to PETSc IndexSet for local-to-globa map
@@ -197,9 +218,12 @@ void PETScMatrix::init(const TensorLayout& tensor_layout)
   // Note: This should be called after having set the local-to-global
   // map for MATIS (this is a dummy call if _matA is not of type
   // MATIS)
-  ierr = MatISSetPreallocation(_matA, 0, _num_nonzeros_diagonal.data(),
-                               0, _num_nonzeros_off_diagonal.data());
-  if (ierr != 0) petsc_error(ierr, __FILE__, "MatISSetPreallocation");
+  if (!csr_init)
+  {
+    ierr = MatISSetPreallocation(_matA, 0, _num_nonzeros_diagonal.data(),
+                                 0, _num_nonzeros_off_diagonal.data());
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatISSetPreallocation");
+  }
 
   // Clean up local-to-global maps
   ISLocalToGlobalMappingDestroy(&petsc_local_to_global0);
@@ -218,6 +242,44 @@ void PETScMatrix::init(const TensorLayout& tensor_layout)
   if (ierr != 0) petsc_error(ierr, __FILE__, "MatSetOption");
 }
 //-----------------------------------------------------------------------------
+void PETScMatrix::init_csr(const SparsityPattern& sparsity_pattern,
+                           std::size_t m)
+{
+  Timer timer("Init PETSc matrix from CSR arrays");
+
+  // Global column indices of each local row, merged from the sorted
+  // diagonal and off-diagonal blocks of the pattern
+  std::vector<std::vector<std::size_t>> diagonal
+    = sparsity_pattern.diagonal_pattern(SparsityPattern::Type::sorted);
+  std::vector<std::vector<std::size_t>> off_diagonal;
+  if (dolfin::MPI::size(sparsity_pattern.mpi_comm()) > 1)
+  {
+    off_diagonal
+      = sparsity_pattern.off_diagonal_pattern(SparsityPattern::Type::sorted);
+  }
+  diagonal.resize(m);
+  off_diagonal.resize(m);
+
+  std::vector<PetscInt> row_ptr(m + 1, 0);
+  for (std::size_t i = 0; i < m; ++i)
+    row_ptr[i + 1] = row_ptr[i] + diagonal[i].size() + off_diagonal[i].size();
+  std::vector<PetscInt> cols(row_ptr[m]);
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    std::merge(diagonal[i].begin(), diagonal[i].end(),
+               off_diagonal[i].begin(), off_diagonal[i].end(),
+               cols.begin() + row_ptr[i]);
+  }
+
+  // Allocate and insert the nonzero structure (with zero values) in
+  // one pass. Only the call matching the matrix type has an effect.
+  PetscErrorCode ierr;
+  ierr = MatSeqAIJSetPreallocationCSR(_matA, row_ptr.data(), cols.data(), NULL);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatSeqAIJSetPreallocationCSR");
+  ierr = MatMPIAIJSetPreallocationCSR(_matA, row_ptr.data(), cols.data(), NULL);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatMPIAIJSetPreallocationCSR");
+}
+//-----------------------------------------------------------------------------
 bool PETScMatrix::is_nest()
 {
   PetscErrorCode ierr;
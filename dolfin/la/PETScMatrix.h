@@ -44,6 +44,7 @@ namespace dolfin
 {
 
   class PETScVector;
+  class SparsityPattern;
   class TensorLayout;
   class VectorSpaceBasis;
 
@@ -248,6 +249,13 @@ namespace dolfin
 
   private:
 
+    // Preallocate AIJ matrix with m local rows from the compressed
+    // row arrays of the sparsity pattern
+    // (Mat{Seq,MPI}AIJSetPreallocationCSR), which also inserts the
+    // nonzero structure. Only preallocation is affected; values are
+    // still inserted with MatSetValuesLocal during assembly.
+    void init_csr(const SparsityPattern& sparsity_pattern, std::size_t m);
+
     // Create PETSc nullspace object
     MatNullSpace create_petsc_nullspace(const VectorSpaceBasis& nullspace) const;
 
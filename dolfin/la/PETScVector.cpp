@@ -576,6 +576,108 @@ double PETScVector::norm(std::string norm_type) const
   return value;
 }
 //-----------------------------------------------------------------------------
+void PETScVector::axpby(double a, const GenericVector& y, double b)
+{
+  dolfin_assert(_x);
+
+  const PETScVector& _y = as_type<const PETScVector>(y);
+  dolfin_assert(_y._x);
+  if (size() != _y.size())
+  {
+    dolfin_error("PETScVector.cpp",
+                 "perform axpby operation with PETSc vector",
+                 "Vectors are not of the same size");
+  }
+
+  PetscErrorCode ierr = VecAXPBY(_x, a, b, _y._x);
+  CHECK_ERROR("VecAXPBY");
+
+  // Update ghost values
+  update_ghost_values();
+}
+//-----------------------------------------------------------------------------
+void PETScVector::maxpy(const std::vector<double>& a,
+                        const std::vector<const GenericVector*>& y)
+{
+  dolfin_assert(_x);
+  if (a.size() != y.size())
+  {
+    dolfin_error("PETScVector.cpp",
+                 "perform multiple axpy operation with PETSc vector",
+                 "Number of coefficients (%d) does not match number of vectors (%d)",
+                 a.size(), y.size());
+  }
+
+  if (y.empty())
+    return;
+
+  std::vector<Vec> _y(y.size());
+  for (std::size_t i = 0; i < y.size(); ++i)
+  {
+    dolfin_assert(y[i]);
+    const PETScVector& yi = as_type<const PETScVector>(*y[i]);
+    dolfin_assert(yi._x);
+    if (size() != yi.size())
+    {
+      dolfin_error("PETScVector.cpp",
+                   "perform multiple axpy operation with PETSc vector",
+                   "Vectors are not of the same size");
+    }
+    _y[i] = yi._x;
+  }
+
+  PetscErrorCode ierr = VecMAXPY(_x, _y.size(), a.data(), _y.data());
+  CHECK_ERROR("VecMAXPY");
+
+  // Update ghost values
+  update_ghost_values();
+}
+//-----------------------------------------------------------------------------
+std::vector<double>
+PETScVector::mdot(const std::vector<const GenericVector*>& y) const
+{
+  dolfin_assert(_x);
+  std::vector<double> values(y.size(), 0.0);
+  if (y.empty())
+    return values;
+
+  std::vector<Vec> _y(y.size());
+  for (std::size_t i = 0; i < y.size(); ++i)
+  {
+    dolfin_assert(y[i]);
+    const PETScVector& yi = as_type<const PETScVector>(*y[i]);
+    dolfin_assert(yi._x);
+    _y[i] = yi._x;
+  }
+
+  PetscErrorCode ierr = VecMDot(_x, _y.size(), _y.data(), values.data());
+  CHECK_ERROR("VecMDot");
+  return values;
+}
+//-----------------------------------------------------------------------------
+std::pair<double, double>
+PETScVector::inner_and_norm(const GenericVector& y) const
+{
+  dolfin_assert(_x);
+  const PETScVector& _y = as_type<const PETScVector>(y);
+  dolfin_assert(_y._x);
+
+  // Begin/End pairs are merged by PETSc into a single reduction
+  double dot = 0.0;
+  double norm = 0.0;
+  PetscErrorCode ierr;
+  ierr = VecDotBegin(_y._x, _x, &dot);
+  CHECK_ERROR("VecDotBegin");
+  ierr = VecNormBegin(_x, NORM_2, &norm);
+  CHECK_ERROR("VecNormBegin");
+  ierr = VecDotEnd(_y._x, _x, &dot);
+  CHECK_ERROR("VecDotEnd");
+  ierr = VecNormEnd(_x, NORM_2, &norm);
+  CHECK_ERROR("VecNormEnd");
+
+  return std::make_pair(dot, norm);
+}
+//-----------------------------------------------------------------------------
 double PETScVector::min() const
 {
   dolfin_assert(_x);
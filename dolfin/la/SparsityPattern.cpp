@@ -33,7 +33,8 @@ using namespace dolfin;
 
 //-----------------------------------------------------------------------------
 SparsityPattern::SparsityPattern(MPI_Comm comm, std::size_t primary_dim)
-  : _primary_dim(primary_dim), _mpi_comm(comm)
+  : _primary_dim(primary_dim), _mpi_comm(comm),
+    _num_processes(_mpi_comm.size())
 {
   // Do nothing
 }
@@ -41,7 +42,8 @@ SparsityPattern::SparsityPattern(MPI_Comm comm, std::size_t primary_dim)
 SparsityPattern::SparsityPattern(MPI_Comm comm,
   const std::vector<std::shared_ptr<const IndexMap>> index_maps,
   std::size_t primary_dim)
-  : _primary_dim(primary_dim), _mpi_comm(comm)
+  : _primary_dim(primary_dim), _mpi_comm(comm),
+    _num_processes(_mpi_comm.size())
 {
   init(index_maps);
 }
@@ -146,6 +148,26 @@ void SparsityPattern::insert_local(
   insert_entries(entries, primary_dim_map, primary_codim_map);
 }
 //-----------------------------------------------------------------------------
+void SparsityPattern::insert_local(
+  const std::vector<ArrayView<const dolfin::la_index>>& entries,
+  std::pair<std::size_t, std::size_t> rows)
+{
+  dolfin_assert(entries.size() == 2);
+
+  // The primary_dim is local and stays the same
+  const auto primary_dim_map
+    = [](const dolfin::la_index i_index, const IndexMap& index_map0)
+    { return i_index; };
+
+  // The primary_codim must be mapped to global entries
+  const auto primary_codim_map
+    = [](const dolfin::la_index j_index,
+         const IndexMap& index_map1) -> dolfin::la_index
+    { return index_map1.local_to_global((std::size_t) j_index); };
+
+  insert_entries(entries, primary_dim_map, primary_codim_map, rows);
+}
+//-----------------------------------------------------------------------------
 void SparsityPattern::insert_local_global(
     const std::vector<ArrayView<const dolfin::la_index>>& entries)
 {
@@ -167,7 +189,8 @@ void SparsityPattern::insert_local_global(
 void SparsityPattern::insert_entries(
     const std::vector<ArrayView<const dolfin::la_index>>& entries,
     const std::function<dolfin::la_index(const dolfin::la_index, const IndexMap&)>& primary_dim_map,
-    const std::function<dolfin::la_index(const dolfin::la_index, const IndexMap&)>& primary_codim_map)
+    const std::function<dolfin::la_index(const dolfin::la_index, const IndexMap&)>& primary_codim_map,
+    std::pair<std::size_t, std::size_t> rows)
 {
   dolfin_assert(entries.size() == 2);
   const std::size_t _primary_dim = primary_dim();
@@ -193,15 +216,18 @@ void SparsityPattern::insert_entries(
   // (using primary_dim_map/primary_codim_map) to be inserted into
   // the SparsityPattern data structure.
   //
-  // In serial (_mpi_comm.size() == 1) we have the special case
+  // In serial (_num_processes == 1) we have the special case
   // where i == I and j == J.
 
   // Check local range
-  if (_mpi_comm.size() == 1)
+  if (_num_processes == 1)
   {
     // Sequential mode, do simple insertion if not full row
     for (const auto &i_index : map_i)
     {
+      if ((std::size_t) i_index < rows.first
+          || (std::size_t) i_index >= rows.second)
+        continue;
       dolfin_assert(i_index < (dolfin::la_index) diagonal.size());
       if (!has_full_rows || full_rows.find(i_index) == full_rows_end)
         diagonal[i_index].insert(map_j.begin(), map_j.end());
@@ -213,6 +239,9 @@ void SparsityPattern::insert_entries(
     // full_rows
     for (const auto &i_index : map_i)
     {
+      if ((std::size_t) i_index < rows.first
+          || (std::size_t) i_index >= rows.second)
+        continue;
       const auto I = primary_dim_map(i_index, index_map0);
       // Full rows are stored separately
       if (has_full_rows && full_rows.find(I) != full_rows_end)
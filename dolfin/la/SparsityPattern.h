@@ -23,6 +23,7 @@
 #ifndef __SPARSITY_PATTERN_H
 #define __SPARSITY_PATTERN_H
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -77,6 +78,16 @@ namespace dolfin
     void insert_local(const std::vector<
                       ArrayView<const dolfin::la_index>>& entries);
 
+    /// Insert non-zero entries using local (process-wise) indices,
+    /// skipping rows (or columns, according to primary dimension)
+    /// with local index outside [rows.first, rows.second). Threads
+    /// may insert concurrently into disjoint ranges of rows, provided
+    /// that the non-local rows (local index not less than the number
+    /// of owned rows) are all in one range.
+    void insert_local(const std::vector<
+                      ArrayView<const dolfin::la_index>>& entries,
+                      std::pair<std::size_t, std::size_t> rows);
+
     /// Insert non-zero entries using local (process-wise) indices for
     /// the primary dimension and global indices for the co-dimension
     void insert_local_global(
@@ -145,10 +156,15 @@ namespace dolfin
     //
     // The primary dim entries must be local
     // The primary_codim entries must be global
+    //
+    // Only entries with primary dim index (before mapping) in rows
+    // are inserted
     void insert_entries(
         const std::vector<ArrayView<const dolfin::la_index>>& entries,
         const std::function<dolfin::la_index(const dolfin::la_index, const IndexMap&)>& primary_dim_map,
-        const std::function<dolfin::la_index(const dolfin::la_index, const IndexMap&)>& primary_codim_map);
+        const std::function<dolfin::la_index(const dolfin::la_index, const IndexMap&)>& primary_codim_map,
+        std::pair<std::size_t, std::size_t> rows
+          = {0, std::numeric_limits<std::size_t>::max()});
 
     // Print some useful information
     void info_statistics() const;
@@ -160,6 +176,10 @@ namespace dolfin
     // MPI communicator
     dolfin::MPI::Comm _mpi_comm;
 
+    // Number of processes in communicator (stored so that threads
+    // inserting entries need not call MPI)
+    std::size_t _num_processes;
+
     // IndexMaps for each dimension
     std::vector<std::shared_ptr<const IndexMap>> _index_maps;
 
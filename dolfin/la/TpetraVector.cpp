@@ -435,6 +435,38 @@ void TpetraVector::axpy(double a, const GenericVector& y)
   _x_ghosted->update(a, *_y._x_ghosted, 1.0);
 }
 //-----------------------------------------------------------------------------
+void TpetraVector::axpby(double a, const GenericVector& y, double b)
+{
+  dolfin_assert(!_x_ghosted.is_null());
+  const TpetraVector& _y = as_type<const TpetraVector>(y);
+  dolfin_assert(!_y._x_ghosted.is_null());
+  _x_ghosted->update(a, *_y._x_ghosted, b);
+}
+//-----------------------------------------------------------------------------
+void TpetraVector::maxpy(const std::vector<double>& a,
+                         const std::vector<const GenericVector*>& y)
+{
+  dolfin_assert(!_x_ghosted.is_null());
+  if (a.size() != y.size())
+  {
+    dolfin_error("TpetraVector.cpp",
+                 "perform multiple axpy operation with Tpetra vector",
+                 "Number of coefficients (%d) does not match number of vectors (%d)",
+                 a.size(), y.size());
+  }
+
+  // Tpetra can combine two vectors per update
+  std::size_t i = 0;
+  for (; i + 1 < y.size(); i += 2)
+  {
+    const TpetraVector& y0 = as_type<const TpetraVector>(*y[i]);
+    const TpetraVector& y1 = as_type<const TpetraVector>(*y[i + 1]);
+    _x_ghosted->update(a[i], *y0._x_ghosted, a[i + 1], *y1._x_ghosted, 1.0);
+  }
+  if (i < y.size())
+    axpy(a[i], *y[i]);
+}
+//-----------------------------------------------------------------------------
 void TpetraVector::abs()
 {
   dolfin_assert(!_x_ghosted.is_null());
@@ -189,6 +189,13 @@ namespace dolfin
     /// Return norm of vector
     virtual double norm(std::string norm_type) const;
 
+    /// Compute this = a*x + b*this (AXPBY operation)
+    virtual void axpby(double a, const GenericVector& x, double b);
+
+    /// Compute this = this + sum_i a[i]*x[i], two vectors per sweep
+    virtual void maxpy(const std::vector<double>& a,
+                       const std::vector<const GenericVector*>& x);
+
     /// Return minimum value of vector
     virtual double min() const;
 
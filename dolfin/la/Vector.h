@@ -201,6 +201,25 @@ namespace dolfin
     virtual double norm(std::string norm_type) const
     { return vector->norm(norm_type); }
 
+    /// Compute this = a*x + b*this (AXPBY operation)
+    virtual void axpby(double a, const GenericVector& x, double b)
+    { vector->axpby(a, x, b); }
+
+    /// Compute this = this + sum_i a[i]*x[i]
+    virtual void maxpy(const std::vector<double>& a,
+                       const std::vector<const GenericVector*>& x)
+    { vector->maxpy(a, x); }
+
+    /// Return inner products with each of the given vectors
+    virtual std::vector<double>
+      mdot(const std::vector<const GenericVector*>& x) const
+    { return vector->mdot(x); }
+
+    /// Return inner product with given vector and l2 norm of this
+    /// vector
+    virtual std::pair<double, double> inner_and_norm(const GenericVector& x) const
+    { return vector->inner_and_norm(x); }
+
     /// Return minimum value of vector
     virtual double min() const
     { return vector->min(); }
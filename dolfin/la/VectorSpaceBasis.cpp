@@ -18,8 +18,10 @@
 // First added:  2013-05-29
 // Last changed: 2013-05-29
 
+#include <algorithm>
 #include <cmath>
 #include <dolfin/common/constants.h>
+#include <dolfin/common/MPI.h>
 #include "GenericVector.h"
 #include "VectorSpaceBasis.h"
 
@@ -34,26 +36,93 @@ VectorSpaceBasis::VectorSpaceBasis(const std::vector<std::shared_ptr<
 //-----------------------------------------------------------------------------
 void VectorSpaceBasis::orthonormalize(double tol)
 {
-  // Loop over each vector in basis
-  for (std::size_t i = 0; i < _basis.size(); ++i)
+  // Blocked classical Gram-Schmidt with reorthogonalisation, computed
+  // as two passes of Cholesky QR (CholQR2). Each pass computes the
+  // Gram matrix of the basis in a single local sweep and a single
+  // global reduction, factorises it and applies the inverse factor
+  // locally.
+
+  const std::size_t m = _basis.size();
+  if (m == 0)
+    return;
+
+  // Copy local (owned) entries of the basis vectors
+  std::vector<std::vector<double>> V(m);
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    dolfin_assert(_basis[i]);
+    _basis[i]->get_local(V[i]);
+    dolfin_assert(V[i].size() == V[0].size());
+  }
+  const std::size_t n = V[0].size();
+  const MPI_Comm mpi_comm = _basis[0]->mpi_comm();
+
+  std::vector<double> L(m*m);
+  for (std::size_t pass = 0; pass < 2; ++pass)
   {
-    // Orthogonalize vector i with respect to previously
-    // orthonormalized vectors
-    for (std::size_t j = 0; j < i; ++j)
+    // Local contributions to lower triangle of Gram matrix
+    std::vector<double> G(m*m, 0.0);
+    for (std::size_t r = 0; r < n; ++r)
     {
-      const double dot_ij = _basis[i]->inner(*_basis[j]);
-      _basis[i]->axpy(-dot_ij, *_basis[j]);
+      for (std::size_t j = 0; j < m; ++j)
+      {
+        const double vj = V[j][r];
+        for (std::size_t k = 0; k <= j; ++k)
+          G[j*m + k] += vj*V[k][r];
+      }
     }
 
-    if (_basis[i]->norm("l2") < tol)
+    // Sum over processes
+    G = dolfin::MPI::sum(mpi_comm, G);
+
+    // Cholesky factorisation G = L L^T. The diagonal entry L_jj is
+    // the norm of vector j after removing components in the
+    // preceding vectors.
+    std::fill(L.begin(), L.end(), 0.0);
+    for (std::size_t j = 0; j < m; ++j)
     {
-      dolfin_error("VectorSpaceBasis.cpp",
-                   "orthonormalize vector basis",
-                   "Vector space has linear dependency");
+      for (std::size_t k = 0; k < j; ++k)
+      {
+        double a = G[j*m + k];
+        for (std::size_t l = 0; l < k; ++l)
+          a -= L[j*m + l]*L[k*m + l];
+        L[j*m + k] = a/L[k*m + k];
+      }
+
+      double d = G[j*m + j];
+      for (std::size_t l = 0; l < j; ++l)
+        d -= L[j*m + l]*L[j*m + l];
+
+      // Relative test: squared norm of the part of vector j that is
+      // not in the span of the preceding vectors against its squared
+      // norm
+      if (d <= tol*G[j*m + j])
+      {
+        dolfin_error("VectorSpaceBasis.cpp",
+                     "orthonormalize vector basis",
+                     "Vector space has linear dependency");
+      }
+      L[j*m + j] = std::sqrt(d);
+    }
+
+    // Apply V <- V L^{-T} by forward substitution, entry by entry
+    for (std::size_t r = 0; r < n; ++r)
+    {
+      for (std::size_t j = 0; j < m; ++j)
+      {
+        double q = V[j][r];
+        for (std::size_t k = 0; k < j; ++k)
+          q -= L[j*m + k]*V[k][r];
+        V[j][r] = q/L[j*m + j];
+      }
     }
+  }
 
-    // Normalise basis function
-    (*_basis[i]) /= _basis[i]->norm("l2");
+  // Copy back
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    _basis[i]->set_local(V[i]);
+    _basis[i]->apply("insert");
   }
 }
 //-----------------------------------------------------------------------------
@@ -61,13 +130,12 @@ bool VectorSpaceBasis::is_orthonormal(double tol) const
 {
   for (std::size_t i = 0; i < _basis.size(); i++)
   {
+    dolfin_assert(_basis[i]);
+    const std::vector<double> dots = _basis[i]->mdot(block(i));
     for (std::size_t j = i; j < _basis.size(); j++)
     {
-      dolfin_assert(_basis[i]);
-      dolfin_assert(_basis[j]);
       const double delta_ij = (i == j) ? 1.0 : 0.0;
-      const double dot_ij = _basis[i]->inner(*_basis[j]);
-      if (std::abs(delta_ij - dot_ij) > tol)
+      if (std::abs(delta_ij - dots[j - i]) > tol)
         return false;
     }
   }
@@ -79,16 +147,12 @@ bool VectorSpaceBasis::is_orthogonal(double tol) const
 {
   for (std::size_t i = 0; i < _basis.size(); i++)
   {
-    for (std::size_t j = i; j < _basis.size(); j++)
+    dolfin_assert(_basis[i]);
+    const std::vector<double> dots = _basis[i]->mdot(block(i + 1));
+    for (std::size_t j = 0; j < dots.size(); j++)
     {
-      dolfin_assert(_basis[i]);
-      dolfin_assert(_basis[j]);
-      if (i != j)
-      {
-        const double dot_ij = _basis[i]->inner(*_basis[j]);
-        if (std::abs(dot_ij) > tol)
-          return false;
-      }
+      if (std::abs(dots[j]) > tol)
+        return false;
     }
   }
 
@@ -97,12 +161,13 @@ bool VectorSpaceBasis::is_orthogonal(double tol) const
 //-----------------------------------------------------------------------------
 void VectorSpaceBasis::orthogonalize(GenericVector& x) const
 {
-  for (std::size_t i = 0; i < _basis.size(); i++)
-  {
-    dolfin_assert(_basis[i]);
-    const double dot = _basis[i]->inner(x);
-    x.axpy(-dot, *_basis[i]);
-  }
+  // Compute all inner products with one reduction, then remove all
+  // components in a single sweep
+  const std::vector<const GenericVector*> basis = block(0);
+  std::vector<double> dots = x.mdot(basis);
+  for (auto& dot : dots)
+    dot = -dot;
+  x.maxpy(dots, basis);
 }
 //-----------------------------------------------------------------------------
 std::size_t VectorSpaceBasis::dim() const
@@ -117,3 +182,15 @@ VectorSpaceBasis::operator[] (std::size_t i) const
   return _basis[i];
 }
 //-----------------------------------------------------------------------------
+std::vector<const GenericVector*>
+VectorSpaceBasis::block(std::size_t first) const
+{
+  std::vector<const GenericVector*> x;
+  for (std::size_t i = first; i < _basis.size(); ++i)
+  {
+    dolfin_assert(_basis[i]);
+    x.push_back(_basis[i].get());
+  }
+  return x;
+}
+//-----------------------------------------------------------------------------
@@ -41,8 +41,12 @@ namespace dolfin
     ~VectorSpaceBasis() {}
 
     /// Apply the Gram-Schmidt process to orthonormalize the
-    /// basis. Throws an error if a (near) linear dependency is
-    /// detected. Error is thrown if <x_i, x_i> < tol.
+    /// basis. The basis is orthonormalized as a block (classical
+    /// Gram-Schmidt with reorthogonalisation), using one global
+    /// reduction per pass. Throws an error if a (near) linear
+    /// dependency is detected. Error is thrown if <y_i, y_i> <=
+    /// tol <x_i, x_i>, where y_i is x_i with its components in
+    /// x_0, ..., x_{i-1} removed.
     void orthonormalize(double tol=1.0e-10);
 
     /// Test if basis is orthonormal
@@ -62,6 +66,9 @@ namespace dolfin
 
   private:
 
+    // Return pointers to basis vectors [first, dim)
+    std::vector<const GenericVector*> block(std::size_t first) const;
+
     // Basis vectors
     const std::vector<std::shared_ptr<GenericVector>> _basis;
 
@@ -296,15 +296,27 @@ void Logger::register_timing(std::string task,
 //-----------------------------------------------------------------------------
 void Logger::list_timings(TimingClear clear, std::set<TimingType> type)
 {
-  // Format and reduce to rank 0
+  // Format and reduce to rank 0, without profiling the reduction
+  const bool profile_mpi = MPI::Profiler::enabled();
+  MPI::Profiler::enable(false);
   Table timings = this->timings(clear, type);
   timings = MPI::avg(_mpi_comm, timings);
+  MPI::Profiler::enable(profile_mpi);
   const std::string str = timings.str(true);
 
   // Print just on rank 0
   if (dolfin::MPI::rank(_mpi_comm) == 0)
     log(str);
 
+  // Print summary of MPI communication if profiled
+  if (MPI::Profiler::enabled())
+  {
+    const Table communication
+      = MPI::Profiler::summary(_mpi_comm, static_cast<bool>(clear));
+    if (dolfin::MPI::rank(_mpi_comm) == 0)
+      log("\n" + communication.str(true));
+  }
+
   // Print maximum memory usage if available
   if (_maximum_memory_usage >= 0)
   {
@@ -218,6 +218,15 @@ double CellType::radius_ratio(const Cell& cell) const
     return dim()*r/circumradius(cell);
 }
 //-----------------------------------------------------------------------------
+void CellType::quality(const double* x, std::size_t num_cells,
+                       std::size_t gdim, Quality measure, double* q) const
+{
+  dolfin_error("CellType.cpp",
+               "compute cell quality",
+               "Quality measures are not implemented for %s",
+               description(true).c_str());
+}
+//-----------------------------------------------------------------------------
 bool CellType::ordered(const Cell& cell, const std::vector<std::int64_t>&
                        local_to_global_vertex_indices) const
 {
@@ -50,6 +50,10 @@ namespace dolfin
     /// Enum for different cell types
     enum class Type : int { point, interval, triangle, quadrilateral, tetrahedron, hexahedron };
 
+    /// Enum for cell quality measures (see quality())
+    enum class Quality : int { volume, circumradius, inradius, radius_ratio,
+                               edge_ratio, min_angle };
+
     /// Constructor
     CellType(Type cell_type, Type facet_type);
 
@@ -122,6 +126,19 @@ namespace dolfin
     /// Compute dim*inradius/circumradius for given cell
     virtual double radius_ratio(const Cell& cell) const;
 
+    /// Compute a quality measure for a block of cells. The vertex
+    /// coordinates are stored one coordinate at a time, x[(i*gdim +
+    /// j)*num_cells + c] being coordinate j of vertex i of cell c, so
+    /// that the loops over the cells can be vectorised. The measures
+    /// are the volume, circumradius, inradius, radius ratio
+    /// dim*inradius/circumradius, ratio of longest to shortest edge,
+    /// and the minimum angle (interior angle of triangles and
+    /// quadrilaterals, dihedral angle of tetrahedra, angle between
+    /// edges at a vertex of hexahedra). An error is raised, also for
+    /// num_cells = 0, if the measure is not defined for the cell type.
+    virtual void quality(const double* x, std::size_t num_cells,
+                         std::size_t gdim, Quality measure, double* q) const;
+
     /// Compute squared distance to given point
     virtual double squared_distance(const Cell& cell,
                                     const Point& point) const = 0;
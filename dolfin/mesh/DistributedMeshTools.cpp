@@ -39,6 +39,139 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Hash of a mesh entity given by its sorted global vertex indices
+  std::uint64_t entity_hash(const std::size_t* vertices, std::size_t n)
+  {
+    std::uint64_t hash = n;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      // Mix with the splitmix64 finaliser
+      std::uint64_t x = hash ^ (vertices[i] + 0x9e3779b97f4a7c15ULL);
+      x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27))*0x94d049bb133111ebULL;
+      hash = x ^ (x >> 31);
+    }
+    return hash;
+  }
+  //---------------------------------------------------------------------------
+  // Position of process p in a sorted list of neighbour processes
+  std::size_t neighbour_index(unsigned int p, const std::vector<int>& neighbours)
+  {
+    auto it = std::lower_bound(neighbours.begin(), neighbours.end(), (int) p);
+    dolfin_assert(it != neighbours.end() and *it == (int) p);
+    return it - neighbours.begin();
+  }
+  //---------------------------------------------------------------------------
+  // Transfer width values per cell between two distributions of the
+  // same mesh. Each value block is sent to a 'rendezvous' process
+  // determined by the global cell index, from which the processes
+  // holding the cell in mesh1 then request it.
+  template<typename T>
+  std::vector<T> migrate_cell_data(const Mesh& mesh0,
+                                   const std::vector<T>& data0,
+                                   std::size_t width, const Mesh& mesh1)
+  {
+    Timer timer("DistributedMeshTools: migrate cell data");
+
+    const MPI_Comm mpi_comm = mesh0.mpi_comm();
+    const std::size_t mpi_size = dolfin::MPI::size(mpi_comm);
+    const std::size_t D = mesh0.topology().dim();
+    dolfin_assert(mesh1.topology().dim() == D);
+
+    const std::size_t num_cells0 = mesh0.topology().ghost_offset(D);
+    const std::size_t num_cells1 = mesh1.num_cells();
+    if (data0.size() != num_cells0*width)
+    {
+      dolfin_error("DistributedMeshTools.cpp",
+                   "migrate cell data",
+                   "Expecting %d values (%d for each regular cell), got %d",
+                   num_cells0*width, width, data0.size());
+    }
+
+    // Global cell indices, or local indices if the mesh has none
+    auto global_index = [D](const Mesh& mesh, std::size_t c) -> std::size_t
+      {
+        const auto& gi = mesh.topology().global_indices(D);
+        return gi.empty() ? c : gi[c];
+      };
+
+    const std::size_t num_global_cells = mesh0.num_entities_global(D);
+    const std::pair<std::int64_t, std::int64_t> range
+      = dolfin::MPI::local_range(mpi_comm, num_global_cells);
+
+    // Send values to rendezvous process
+    std::vector<std::vector<std::size_t>> send_indices(mpi_size);
+    std::vector<std::vector<T>> send_values(mpi_size);
+    for (std::size_t c = 0; c < num_cells0; ++c)
+    {
+      const std::size_t gc = global_index(mesh0, c);
+      const std::size_t p
+        = dolfin::MPI::index_owner(mpi_comm, gc, num_global_cells);
+      send_indices[p].push_back(gc);
+      send_values[p].insert(send_values[p].end(), data0.begin() + c*width,
+                            data0.begin() + (c + 1)*width);
+    }
+    std::vector<std::vector<std::size_t>> recv_indices(mpi_size);
+    std::vector<std::vector<T>> recv_values(mpi_size);
+    dolfin::MPI::all_to_all(mpi_comm, send_indices, recv_indices);
+    dolfin::MPI::all_to_all(mpi_comm, send_values, recv_values);
+
+    // Store values for the cells in the local range
+    std::vector<T> rendezvous((range.second - range.first)*width);
+    for (std::size_t p = 0; p < mpi_size; ++p)
+    {
+      for (std::size_t i = 0; i < recv_indices[p].size(); ++i)
+      {
+        const std::size_t pos = recv_indices[p][i] - range.first;
+        std::copy(recv_values[p].begin() + i*width,
+                  recv_values[p].begin() + (i + 1)*width,
+                  rendezvous.begin() + pos*width);
+      }
+    }
+
+    // Request values for all cells of mesh1 (including ghosts)
+    std::vector<std::vector<std::size_t>> request(mpi_size);
+    std::vector<std::size_t> request_process(num_cells1);
+    for (std::size_t c = 0; c < num_cells1; ++c)
+    {
+      const std::size_t gc = global_index(mesh1, c);
+      request_process[c]
+        = dolfin::MPI::index_owner(mpi_comm, gc, num_global_cells);
+      request[request_process[c]].push_back(gc);
+    }
+    dolfin::MPI::all_to_all(mpi_comm, request, recv_indices);
+
+    for (std::size_t p = 0; p < mpi_size; ++p)
+    {
+      send_values[p].clear();
+      for (std::size_t gc : recv_indices[p])
+      {
+        const std::size_t pos = gc - range.first;
+        send_values[p].insert(send_values[p].end(),
+                              rendezvous.begin() + pos*width,
+                              rendezvous.begin() + (pos + 1)*width);
+      }
+    }
+    dolfin::MPI::all_to_all(mpi_comm, send_values, recv_values);
+
+    // Unpack, in the order of the requests to each process
+    std::vector<T> data1(num_cells1*width);
+    std::vector<std::size_t> pos(mpi_size, 0);
+    for (std::size_t c = 0; c < num_cells1; ++c)
+    {
+      const std::size_t p = request_process[c];
+      std::copy(recv_values[p].begin() + pos[p],
+                recv_values[p].begin() + pos[p] + width,
+                data1.begin() + c*width);
+      pos[p] += width;
+    }
+
+    return data1;
+  }
+}
+
 //-----------------------------------------------------------------------------
 void DistributedMeshTools::number_entities(const Mesh& mesh, std::size_t d)
 {
@@ -140,24 +273,6 @@ std::size_t DistributedMeshTools::number_entities(
   for (s = slave_entities.begin(); s != slave_entities.end(); ++s)
     exclude[s->first] = true;
 
-  // Build entity global [vertex list]-to-[local entity index]
-  // map. Exclude any slave entities.
-  std::map<std::vector<std::size_t>, unsigned int> entities;
-  std::pair<std::vector<std::size_t>, unsigned int> entity;
-  for (MeshEntityIterator e(mesh, d, "all"); !e.end(); ++e)
-  {
-    const std::size_t local_index = e->index();
-    if (!exclude[local_index])
-    {
-      entity.second = local_index;
-      entity.first = std::vector<std::size_t>();
-      for (VertexIterator vertex(*e); !vertex.end(); ++vertex)
-        entity.first.push_back(vertex->global_index());
-      std::sort(entity.first.begin(), entity.first.end());
-      entities.insert(entity);
-    }
-  }
-
   // Get vertex global indices
   const std::vector<std::int64_t>& global_vertex_indices
     = mesh.topology().global_indices(0);
@@ -166,126 +281,121 @@ std::size_t DistributedMeshTools::number_entities(
   const std::map<std::int32_t, std::set<unsigned int>>& shared_vertices_local
     = mesh.topology().shared_entities(0);
 
-  // Compute ownership of entities of dimension d ([entity vertices], data):
-  //  [0]: owned and shared (will be numbered by this process, and number
-  //       communicated to other processes)
-  //  [1]: not owned but shared (will be numbered by another process, and number
-  //       communicated to this processes)
-  std::array<std::map<Entity, EntityData>, 2> entity_ownership;
+  // Compute ownership of entities of dimension d. Entities with
+  // vertices that are not all shared are owned exclusively by this
+  // process. The other entities are exchanged with the neighbour
+  // processes that share all their vertices, and are owned by the
+  // lowest ranked process on which they exist.
   std::vector<std::size_t> owned_entities;
-  compute_entity_ownership(mpi_comm, entities, shared_vertices_local,
-                           global_vertex_indices, d, owned_entities,
-                           entity_ownership);
-
-  // Split shared entities for convenience
-  const std::map<Entity, EntityData>& owned_shared_entities
-    = entity_ownership[0];
-  std::map<Entity, EntityData>& unowned_shared_entities = entity_ownership[1];
+  SharedEntityTable table;
+  std::vector<int> neighbours;
+  compute_preliminary_entity_ownership(mesh, d, exclude,
+                                       global_vertex_indices,
+                                       shared_vertices_local, owned_entities,
+                                       table, neighbours);
+  const MPI::NeighbourComm neighbour_comm(mpi_comm, neighbours);
+  {
+    Timer timer("Compute mesh entity ownership");
+    compute_final_entity_ownership(neighbour_comm, owned_entities, table);
+  }
+  const std::size_t num_shared = table.local_index.size();
+
+  // Mark entities numbered by this process
+  std::vector<bool> owned(mesh.num_entities(d), false);
+  for (auto e : owned_entities)
+    owned[e] = true;
+  std::size_t num_owned_shared = 0;
+  for (std::size_t i = 0; i < num_shared; ++i)
+  {
+    if (table.owner(i, process_number) == process_number)
+    {
+      owned[table.local_index[i]] = true;
+      ++num_owned_shared;
+    }
+  }
 
   // Number of entities 'owned' by this process
   const std::size_t num_local_entities = owned_entities.size()
-    + owned_shared_entities.size();
+    + num_owned_shared;
 
   // Compute global number of entities and local process offset
   const std::pair<std::size_t, std::size_t> num_global_entities
     = compute_num_global_entities(mpi_comm, num_local_entities, num_processes,
                                   process_number);
 
-  // Extract offset
-  std::size_t offset = num_global_entities.second;
-
   // Prepare list of global entity numbers. Check later that nothing
   // is equal to -1
   global_entity_indices
     = std::vector<std::int64_t>(mesh.num_entities(d), -1);
 
-  std::map<Entity, EntityData>::const_iterator it;
-
-  // Number exclusively owned entities
-  for (std::size_t i = 0; i < owned_entities.size(); ++i)
-    global_entity_indices[owned_entities[i]] = offset++;
-
-  // Number shared entities that this process is responsible for
-  // numbering
-  std::map<Entity, EntityData>::const_iterator it1;
-  for (it1 = owned_shared_entities.begin();
-       it1 != owned_shared_entities.end(); ++it1)
+  // Number owned entities in local order
+  std::size_t offset = num_global_entities.second;
+  for (std::size_t e = 0; e < owned.size(); ++e)
   {
-    global_entity_indices[it1->second.local_index] = offset++;
+    if (owned[e])
+      global_entity_indices[e] = offset++;
   }
 
-  // Communicate indices for shared entities (owned by this process)
-  // and get indices for shared but not owned entities
-  std::vector<std::vector<std::size_t>> send_values(num_processes);
-  std::vector<std::size_t> destinations;
-  for (it1 = owned_shared_entities.begin();
-       it1 != owned_shared_entities.end(); ++it1)
+  // Send indices of owned shared entities to the sharing processes,
+  // in table order. Both sides hold the entities they share in the
+  // same order, so only the indices need to be sent.
+  std::vector<std::vector<std::int64_t>> send_indices(neighbours.size());
+  for (std::size_t i = 0; i < num_shared; ++i)
   {
-    // Get entity index
-    const unsigned int local_entity_index = it1->second.local_index;
-    const std::int64_t global_entity_index
-      = global_entity_indices[local_entity_index];
-    dolfin_assert(global_entity_index != -1);
-
-    // Get entity processes (processes sharing the entity)
-    const std::vector<unsigned int>& entity_processes = it1->second.processes;
-
-    // Get entity vertices (global vertex indices)
-    const Entity& e = it1->first;
+    if (table.owner(i, process_number) != process_number)
+      continue;
 
-    // Prepare data for sending
-    for (std::size_t j = 0; j < entity_processes.size(); ++j)
+    const std::int64_t global_index
+      = global_entity_indices[table.local_index[i]];
+    for (std::size_t j = table.process_offsets[i];
+         j < table.process_offsets[i + 1]; ++j)
     {
-      // Store interleaved: entity index, number of vertices, global
-      // vertex indices
-      std::size_t p = entity_processes[j];
-      send_values[p].push_back(global_entity_index);
-      send_values[p].push_back(e.size());
-      send_values[p].insert(send_values[p].end(), e.begin(), e.end());
+      send_indices[neighbour_index(table.processes[j], neighbours)]
+        .push_back(global_index);
     }
   }
-
-  // Send data
-  std::vector<std::vector<std::size_t>> received_values;
-  MPI::all_to_all(mpi_comm, send_values, received_values);
+  std::vector<std::vector<std::int64_t>> recv_indices;
+  neighbour_comm.all_to_all(send_indices, recv_indices);
 
   // Fill in global entity indices received from lower ranked
   // processes
-  for (std::size_t p = 0; p < num_processes; ++p)
+  std::vector<std::size_t> num_received(neighbours.size(), 0);
+  for (std::size_t i = 0; i < num_shared; ++i)
   {
-    for (std::size_t i = 0; i < received_values[p].size();)
+    const unsigned int owner = table.owner(i, process_number);
+    if (owner == process_number)
+      continue;
+
+    const std::size_t n = neighbour_index(owner, neighbours);
+    if (num_received[n] == recv_indices[n].size())
     {
-      const std::size_t global_index = received_values[p][i++];
-      const std::size_t entity_size = received_values[p][i++];
-      Entity e;
-      for (std::size_t j = 0; j < entity_size; ++j)
-        e.push_back(received_values[p][i++]);
-
-      // Access unowned entity data
-      std::map<Entity, EntityData>::const_iterator recv_entity;
-      recv_entity = unowned_shared_entities.find(e);
-
-      // Sanity check, should not receive an entity we don't need
-      if (recv_entity == unowned_shared_entities.end())
-      {
-        std::stringstream msg;
-        msg << "Process " << MPI::rank(mpi_comm)
-            << " received illegal entity given by ";
-        msg << " with global index " << global_index;
-        msg << " from process " << p;
-        dolfin_error("MeshPartitioning.cpp",
-                     "number mesh entities",
-                     msg.str());
-      }
+      dolfin_error("DistributedMeshTools.cpp",
+                   "number mesh entities",
+                   "Process %d did not receive the index of a shared entity from process %d",
+                   process_number, owner);
+    }
 
-      const std::size_t local_entity_index = recv_entity->second.local_index;
-      dolfin_assert(global_entity_indices[local_entity_index] == -1);
+    const std::size_t local_entity_index = table.local_index[i];
+    dolfin_assert(global_entity_indices[local_entity_index] == -1);
+    global_entity_indices[local_entity_index]
+      = recv_indices[n][num_received[n]++];
+  }
 
-      global_entity_indices[local_entity_index] = global_index;
+  // Sanity check, should not receive indices for entities we don't
+  // share
+  for (std::size_t n = 0; n < neighbours.size(); ++n)
+  {
+    if (num_received[n] != recv_indices[n].size())
+    {
+      dolfin_error("DistributedMeshTools.cpp",
+                   "number mesh entities",
+                   "Process %d received indices of entities it does not share from process %d",
+                   process_number, neighbours[n]);
     }
   }
 
-  // Get slave indices from master
+  // Get slave indices from master. Masters of periodic entities need
+  // not be on neighbouring processes.
   {
     std::vector<std::vector<std::size_t>>
       slave_send_buffer(MPI::size(mpi_comm));
@@ -300,7 +410,7 @@ std::size_t DistributedMeshTools::number_entities(
       local_slave_index[s->second.first].push_back(s->first);
     }
     std::vector<std::vector<std::size_t>> slave_receive_buffer;
-    MPI::all_to_all(mpi_comm, slave_send_buffer, slave_receive_buffer);
+    MPI::sparse_all_to_all(mpi_comm, slave_send_buffer, slave_receive_buffer);
 
     // Send back master indices
     for (std::size_t p = 0; p < slave_receive_buffer.size(); ++p)
@@ -312,7 +422,7 @@ std::size_t DistributedMeshTools::number_entities(
         slave_send_buffer[p].push_back(global_entity_indices[local_master]);
       }
     }
-    MPI::all_to_all(mpi_comm, slave_send_buffer, slave_receive_buffer);
+    MPI::sparse_all_to_all(mpi_comm, slave_send_buffer, slave_receive_buffer);
 
     // Set slave indices to received master indices
     for (std::size_t p = 0; p < slave_receive_buffer.size(); ++p)
@@ -331,23 +441,18 @@ std::size_t DistributedMeshTools::number_entities(
     dolfin_assert(global_entity_indices[i] != -1);
   }
 
-  // Build shared_entities (global index, [sharing processes])
+  // Build shared_entities (local index, [sharing processes])
   shared_entities.clear();
-  std::map<Entity, EntityData>::const_iterator e;
-  for (e = owned_shared_entities.begin(); e != owned_shared_entities.end(); ++e)
+  for (std::size_t i = 0; i < num_shared; ++i)
   {
-    const EntityData& ed = e->second;
-    shared_entities[ed.local_index]
-      = std::set<unsigned int>(ed.processes.begin(),
-                               ed.processes.end());
-  }
-  for (e = unowned_shared_entities.begin();
-       e != unowned_shared_entities.end(); ++e)
-  {
-    const EntityData& ed = e->second;
-    shared_entities[ed.local_index]
-      = std::set<unsigned int>(ed.processes.begin(),
-                               ed.processes.end());
+    if (table.process_offsets[i + 1] > table.process_offsets[i])
+    {
+      shared_entities[table.local_index[i]]
+        = std::set<unsigned int>(table.processes.begin()
+                                 + table.process_offsets[i],
+                                 table.processes.begin()
+                                 + table.process_offsets[i + 1]);
+    }
   }
 
   // Return number of global entities
@@ -654,336 +759,217 @@ std::unordered_map<unsigned int,
   return shared_local_indices_map;
 }
 //-----------------------------------------------------------------------------
-void DistributedMeshTools::compute_entity_ownership(
-  const MPI_Comm mpi_comm,
-  const std::map<std::vector<std::size_t>, unsigned int>& entities,
-  const std::map<std::int32_t, std::set<unsigned int>>& shared_vertices_local,
-  const std::vector<std::int64_t>& global_vertex_indices,
-  std::size_t d,
-  std::vector<std::size_t>& owned_entities,
-  std::array<std::map<Entity, EntityData>, 2>& shared_entities)
+int DistributedMeshTools::SharedEntityTable::find(
+  const std::size_t* entity_vertices) const
 {
-  log(PROGRESS, "Compute ownership for mesh entities of dimension %d.", d);
-  Timer timer("Compute mesh entity ownership");
-
-  // Build global-to-local indices map for shared vertices
-  std::map<std::size_t, std::set<unsigned int>> shared_vertices;
-  std::map<std::int32_t, std::set<unsigned int>>::const_iterator v;
-  for (v = shared_vertices_local.begin(); v != shared_vertices_local.end(); ++v)
+  const std::size_t n = num_entity_vertices;
+  const std::uint64_t hash = entity_hash(entity_vertices, n);
+  auto range = std::equal_range(hashes.begin(), hashes.end(), hash);
+  for (auto it = range.first; it != range.second; ++it)
   {
-    dolfin_assert(v->first < (int) global_vertex_indices.size());
-    shared_vertices.insert({global_vertex_indices[v->first], v->second});
+    const std::size_t i = it - hashes.begin();
+    if (std::equal(entity_vertices, entity_vertices + n,
+                   vertices.begin() + i*n))
+    {
+      return i;
+    }
   }
-
-  // Entity ownership list ([entity vertices], data):
-  //  [0]: owned and shared (will be numbered by this process, and number
-  //       communicated to other processes)
-  //  [1]: not owned but shared (will be numbered by another process, and number
-  //       communicated to this processes)
-
-  // Compute preliminary ownership lists (shared_entities) without
-  // communication
-  compute_preliminary_entity_ownership(mpi_comm, shared_vertices, entities,
-                                       owned_entities, shared_entities);
-
-  // Qualify boundary entities. We need to find out if the shared
-  // (shared with lower ranked process) entities are entities of a
-  // lower ranked process.  If not, this process becomes the lower
-  // ranked process for the entity in question, and is therefore
-  // responsible for communicating values to the higher ranked
-  // processes (if any).
-  compute_final_entity_ownership(mpi_comm, owned_entities, shared_entities);
+  return -1;
 }
 //-----------------------------------------------------------------------------
 void DistributedMeshTools::compute_preliminary_entity_ownership(
-  const MPI_Comm mpi_comm,
-  const std::map<std::size_t, std::set<unsigned int>>& shared_vertices,
-  const std::map<Entity, unsigned int>& entities,
+  const Mesh& mesh, std::size_t d, const std::vector<bool>& exclude,
+  const std::vector<std::int64_t>& global_vertex_indices,
+  const std::map<std::int32_t, std::set<unsigned int>>& shared_vertices_local,
   std::vector<std::size_t>& owned_entities,
-  std::array<std::map<Entity, EntityData>, 2>& shared_entities)
+  SharedEntityTable& shared_entities,
+  std::vector<int>& neighbours)
 {
-  // Entities
-  std::map<Entity, EntityData>& owned_shared_entities = shared_entities[0];
-  std::map<Entity, EntityData>& unowned_shared_entities = shared_entities[1];
-
-  // Clear maps
   owned_entities.clear();
-  owned_shared_entities.clear();
-  unowned_shared_entities.clear();
 
-  // Get my process number
-  const std::size_t process_number = MPI::rank(mpi_comm);
-
-  // Iterate over all local entities
-  std::map<std::vector<std::size_t>,  unsigned int>::const_iterator it;
-  for (it = entities.begin(); it != entities.end(); ++it)
+  // Processes sharing each local vertex (null if the vertex is not
+  // shared), and processes sharing any vertex
+  std::vector<const std::set<unsigned int>*>
+    vertex_processes(mesh.num_vertices(), nullptr);
+  std::set<int> neighbour_set;
+  for (auto v = shared_vertices_local.begin();
+       v != shared_vertices_local.end(); ++v)
   {
-    const Entity& entity = it->first;
-    const std::size_t local_entity_index = it->second;
-
-    // Compute which processes entity is shared with
-    std::vector< unsigned int> entity_processes;
-    if (is_shared(entity, shared_vertices))
+    dolfin_assert(v->first < (int) vertex_processes.size());
+    vertex_processes[v->first] = &v->second;
+    neighbour_set.insert(v->second.begin(), v->second.end());
+  }
+  neighbours.assign(neighbour_set.begin(), neighbour_set.end());
+
+  // Collect entities with all vertices shared, in local order
+  const std::size_t n = mesh.type().num_vertices(d);
+  const MeshConnectivity& connectivity = mesh.topology()(d, 0);
+  std::vector<unsigned int> local_index;
+  std::vector<std::size_t> vertices;
+  std::vector<std::size_t> process_offsets(1, 0);
+  std::vector<unsigned int> processes, common;
+  for (std::size_t e = 0; e < exclude.size(); ++e)
+  {
+    if (exclude[e])
+      continue;
+
+    // Compute processes sharing all entity vertices
+    const unsigned int* v = connectivity(e);
+    common.clear();
+    if (std::all_of(v, v + n, [&vertex_processes](unsigned int vertex)
+                    { return vertex_processes[vertex] != nullptr; }))
     {
-      // Processes sharing first vertex of entity
-      std::vector<std::size_t>
-        intersection(shared_vertices.find(entity[0])->second.begin(),
-                     shared_vertices.find(entity[0])->second.end());
-      std::vector<std::size_t>::iterator intersection_end = intersection.end();
-
-      // Loop over entity vertices
-      for (std::size_t i = 1; i < entity.size(); ++i)
+      common.assign(vertex_processes[v[0]]->begin(),
+                    vertex_processes[v[0]]->end());
+      for (std::size_t i = 1; i < n and !common.empty(); ++i)
       {
-        // Global vertex index
-        const std::size_t v = entity[i];
-
-        // Sharing processes
-        const std::set< unsigned int>& shared_vertices_v
-          = shared_vertices.find(v)->second;
-
-        intersection_end
-          = std::set_intersection(intersection.begin(), intersection_end,
-                                  shared_vertices_v.begin(),
-                                  shared_vertices_v.end(),
-                                  intersection.begin());
+        const std::set<unsigned int>& p = *vertex_processes[v[i]];
+        common.erase(std::set_intersection(common.begin(), common.end(),
+                                           p.begin(), p.end(),
+                                           common.begin()),
+                     common.end());
       }
-      entity_processes = std::vector< unsigned int>(intersection.begin(),
-                                                    intersection_end);
     }
 
-    // Check if entity is master, slave or shared but not owned (shared
-    // with lower ranked process)
-    bool shared_but_not_owned = false;
-    for (std::size_t i = 0; i < entity_processes.size(); ++i)
+    if (common.empty())
     {
-      if (entity_processes[i] < process_number)
-      {
-        shared_but_not_owned = true;
-        break;
-      }
+      owned_entities.push_back(e);
+      continue;
     }
 
-    if (entity_processes.empty())
-    {
-      owned_entities.push_back(local_entity_index);
-    }
-    else if (shared_but_not_owned)
-    {
-      unowned_shared_entities[entity] = EntityData(local_entity_index,
-                                                   entity_processes);
-    }
-    else
-    {
-      owned_shared_entities[entity] = EntityData(local_entity_index,
-                                                 entity_processes);
-    }
+    local_index.push_back(e);
+    for (std::size_t i = 0; i < n; ++i)
+      vertices.push_back(global_vertex_indices[v[i]]);
+    std::sort(vertices.end() - n, vertices.end());
+    processes.insert(processes.end(), common.begin(), common.end());
+    process_offsets.push_back(processes.size());
+  }
+
+  // Sort entities by key
+  const std::size_t num_entities = local_index.size();
+  std::vector<std::uint64_t> hashes(num_entities);
+  for (std::size_t i = 0; i < num_entities; ++i)
+    hashes[i] = entity_hash(vertices.data() + i*n, n);
+  std::vector<std::size_t> order(num_entities);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&hashes, &vertices, n](std::size_t i, std::size_t j)
+            {
+              if (hashes[i] != hashes[j])
+                return hashes[i] < hashes[j];
+              return std::lexicographical_compare(
+                vertices.begin() + i*n, vertices.begin() + (i + 1)*n,
+                vertices.begin() + j*n, vertices.begin() + (j + 1)*n);
+            });
+
+  // Store entities in key order
+  SharedEntityTable& table = shared_entities;
+  table.num_entity_vertices = n;
+  table.hashes.resize(num_entities);
+  table.vertices.resize(num_entities*n);
+  table.local_index.resize(num_entities);
+  table.process_offsets.assign(1, 0);
+  table.process_offsets.reserve(num_entities + 1);
+  table.processes.clear();
+  table.processes.reserve(processes.size());
+  for (std::size_t i = 0; i < num_entities; ++i)
+  {
+    const std::size_t j = order[i];
+    table.hashes[i] = hashes[j];
+    std::copy(vertices.begin() + j*n, vertices.begin() + (j + 1)*n,
+              table.vertices.begin() + i*n);
+    table.local_index[i] = local_index[j];
+    table.processes.insert(table.processes.end(),
+                           processes.begin() + process_offsets[j],
+                           processes.begin() + process_offsets[j + 1]);
+    table.process_offsets.push_back(table.processes.size());
   }
 }
 //-----------------------------------------------------------------------------
 void DistributedMeshTools::compute_final_entity_ownership(
-  const MPI_Comm mpi_comm,
+  const MPI::NeighbourComm& neighbour_comm,
   std::vector<std::size_t>& owned_entities,
-  std::array<std::map<Entity, EntityData>, 2>& shared_entities)
+  SharedEntityTable& shared_entities)
 {
-  // Entities ([entity vertices], index) to be numbered
-  std::map<Entity, EntityData>& owned_shared_entities = shared_entities[0];
-  std::map<Entity, EntityData>& unowned_shared_entities = shared_entities[1];
-
-  // Get MPI number of processes and process number
-  const std::size_t num_processes = MPI::size(mpi_comm);
-  const std::size_t process_number = MPI::rank(mpi_comm);
-
-  // Communicate common entities, starting with the entities we think
-  // are shared but not owned
-  std::vector<std::vector<std::size_t>>
-    send_common_entity_values(num_processes);
-  for (std::map<Entity, EntityData>::const_iterator it
-         = unowned_shared_entities.begin(); it != unowned_shared_entities.end();
-       ++it)
-  {
-    // Get entity vertices (global vertex indices)
-    const Entity& entity = it->first;
-
-    // Get entity processes (processes that might share the entity)
-    const std::vector<unsigned int>& entity_processes = it->second.processes;
-
-    // Prepare data for sending
-    for (std::size_t j = 0; j < entity_processes.size(); ++j)
-    {
-      const std::size_t p = entity_processes[j];
-      send_common_entity_values[p].push_back(entity.size());
-      send_common_entity_values[p].insert(send_common_entity_values[p].end(),
-                                          entity.begin(), entity.end());
-    }
-  }
-
-  // Communicate common entities, add the entities we think are owned
-  // and shared
-  for (std::map<Entity, EntityData>::const_iterator it
-         = owned_shared_entities.begin();
-       it != owned_shared_entities.end(); ++it)
+  SharedEntityTable& table = shared_entities;
+  const std::vector<int>& neighbours = neighbour_comm.neighbours();
+  const std::size_t n = table.num_entity_vertices;
+  const std::size_t num_entities = table.local_index.size();
+
+  // Send entities to the processes that share all their vertices
+  std::vector<std::vector<std::size_t>> send_entities(neighbours.size());
+  for (std::size_t i = 0; i < num_entities; ++i)
   {
-    // Get entity vertices (global vertex indices)
-    const Entity& entity = it->first;
-
-    // Get entity processes (processes that might share the entity)
-    const std::vector<unsigned int>& entity_processes = it->second.processes;
-
-    // Prepare data for sending
-    for (std::size_t j = 0; j < entity_processes.size(); ++j)
+    for (std::size_t j = table.process_offsets[i];
+         j < table.process_offsets[i + 1]; ++j)
     {
-      const unsigned int p = entity_processes[j];
-      dolfin_assert(process_number < p);
-      send_common_entity_values[p].push_back(entity.size());
-      send_common_entity_values[p].insert(send_common_entity_values[p].end(),
-                                          entity.begin(), entity.end());
+      std::vector<std::size_t>& send
+        = send_entities[neighbour_index(table.processes[j], neighbours)];
+      send.insert(send.end(), table.vertices.begin() + i*n,
+                  table.vertices.begin() + (i + 1)*n);
     }
   }
-
-  // Communicate common entities
-  std::vector<std::vector<std::size_t>> received_common_entity_values;
-  MPI::all_to_all(mpi_comm, send_common_entity_values,
-                  received_common_entity_values);
-
-  // Check if entities received are really entities
-  std::vector<std::vector<std::size_t>> send_is_entity_values(num_processes);
-  for (std::size_t p = 0; p < num_processes; ++p)
-  {
-    for (std::size_t i = 0; i < received_common_entity_values[p].size();)
-    {
-      // Get entity
-      const std::size_t entity_size = received_common_entity_values[p][i++];
-      Entity entity;
-      for (std::size_t j = 0; j < entity_size; ++j)
-        entity.push_back(received_common_entity_values[p][i++]);
-
-      // Check if received really is an entity on this process (in
-      // which case it will be in owned or unowned entities)
-      bool is_entity = false;
-      if (unowned_shared_entities.find(entity) != unowned_shared_entities.end()
-          || owned_shared_entities.find(entity) != owned_shared_entities.end())
-      {
-        is_entity = true;
-      }
-
-      // Add information about entity (whether it's actually an
-      // entity) to send to other processes
-      send_is_entity_values[p].push_back(entity_size);
-      for (std::size_t j = 0; j < entity_size; ++j)
-        send_is_entity_values[p].push_back(entity[j]);
-      send_is_entity_values[p].push_back(is_entity);
-    }
-  }
-
-  // Send data back (list of requested entities that are really
-  // entities)
-  std::vector<std::vector<std::size_t>> received_is_entity_values;
-  MPI::all_to_all(mpi_comm, send_is_entity_values, received_is_entity_values);
-
-  // Create map from entities to processes where it is an entity
-  std::map<Entity, std::vector<unsigned int>> entity_processes;
-  for (std::size_t p = 0; p < num_processes; ++p)
+  std::vector<std::vector<std::size_t>> recv_entities;
+  neighbour_comm.all_to_all(send_entities, recv_entities);
+
+  // Find received entities that are also entities on this process.
+  // Since the neighbour relation is symmetric, the processes that
+  // sent an entity are the processes that share it.
+  std::vector<std::vector<int>> positions(neighbours.size());
+  std::vector<std::size_t> num_sharing(num_entities, 0);
+  for (std::size_t k = 0; k < neighbours.size(); ++k)
   {
-    for (std::size_t i = 0; i < received_is_entity_values[p].size();)
+    const std::vector<std::size_t>& recv = recv_entities[k];
+    dolfin_assert(recv.size() % n == 0);
+    positions[k].resize(recv.size()/n);
+    for (std::size_t e = 0; e < positions[k].size(); ++e)
     {
-      const std::size_t entity_size = received_is_entity_values[p][i++];
-      Entity entity;
-      for (std::size_t j = 0; j < entity_size; ++j)
-        entity.push_back(received_is_entity_values[p][i++]);
-      const std::size_t is_entity = received_is_entity_values[p][i++];
-      if (is_entity == 1)
-      {
-        // Add entity since it is actually an entity for process p
-        entity_processes[entity].push_back(p);
-      }
+      const int i = table.find(recv.data() + e*n);
+      positions[k][e] = i;
+      if (i >= 0)
+        ++num_sharing[i];
     }
   }
 
-  // Fix the list of entities we do not own (numbered by lower ranked
-  // process)
-  std::vector<std::vector<std::size_t>> unignore_entities;
-  std::map<Entity, EntityData>::iterator entity;
-  for (entity = unowned_shared_entities.begin();
-       entity != unowned_shared_entities.end(); ++entity)
+  // Keep the entities that are shared, with the sharing processes in
+  // rank order, and own the others exclusively
+  std::vector<std::size_t> new_index(num_entities);
+  std::vector<std::size_t> process_offsets(1, 0);
+  std::size_t num_shared = 0;
+  for (std::size_t i = 0; i < num_entities; ++i)
   {
-    const Entity& entity_vertices = entity->first;
-    EntityData& entity_data = entity->second;
-    const unsigned int local_entity_index = entity_data.local_index;
-    if (entity_processes.find(entity_vertices) != entity_processes.end())
+    if (num_sharing[i] == 0)
     {
-      const std::vector<unsigned int>& common_processes
-        = entity_processes[entity_vertices];
-      dolfin_assert(!common_processes.empty());
-      const std::size_t min_proc = *(std::min_element(common_processes.begin(),
-                                                      common_processes.end()));
-
-      if (process_number < min_proc)
-      {
-        // Move from unowned to owned
-        owned_shared_entities[entity_vertices] = EntityData(local_entity_index,
-                                                            common_processes);
-
-        // Add entity to list of entities that should be removed from
-        // the unowned entity list.
-        unignore_entities.push_back(entity_vertices);
-      }
-      else
-        entity_data.processes = common_processes;
+      owned_entities.push_back(table.local_index[i]);
+      continue;
     }
-    else
-    {
-      // Move from unowned to owned exclusively
-      owned_entities.push_back(local_entity_index);
 
-      // Add entity to list of entities that should be removed from the
-      // shared but not owned entity list
-      unignore_entities.push_back(entity_vertices);
-    }
+    new_index[i] = num_shared;
+    table.hashes[num_shared] = table.hashes[i];
+    std::copy(table.vertices.begin() + i*n,
+              table.vertices.begin() + (i + 1)*n,
+              table.vertices.begin() + num_shared*n);
+    table.local_index[num_shared] = table.local_index[i];
+    process_offsets.push_back(process_offsets.back() + num_sharing[i]);
+    ++num_shared;
   }
-
-  // Remove unowned shared entities that should not be shared
-  for (std::size_t i = 0; i < unignore_entities.size(); ++i)
-    unowned_shared_entities.erase(unignore_entities[i]);
-
-  // Fix the list of entities we share
-  std::vector<std::vector<std::size_t>> unshare_entities;
-  for (std::map<Entity, EntityData>::iterator it
-         = owned_shared_entities.begin();
-       it != owned_shared_entities.end(); ++it)
+  table.hashes.resize(num_shared);
+  table.vertices.resize(num_shared*n);
+  table.local_index.resize(num_shared);
+
+  std::vector<unsigned int> processes(process_offsets.back());
+  std::vector<std::size_t> pos(process_offsets.begin(),
+                               process_offsets.end() - 1);
+  for (std::size_t k = 0; k < neighbours.size(); ++k)
   {
-    const Entity& e = it->first;
-    const unsigned int local_entity_index = it->second.local_index;
-    if (entity_processes.find(e) == entity_processes.end())
+    for (auto i : positions[k])
     {
-      // Move from shared to owned elusively
-      owned_entities.push_back(local_entity_index);
-      unshare_entities.push_back(e);
-    }
-    else
-    {
-      // Update processor list of shared entities
-      it->second.processes = entity_processes[e];
+      if (i >= 0)
+        processes[pos[new_index[i]]++] = neighbours[k];
     }
   }
-
-  // Remove shared entities that should not be shared
-  for (std::size_t i = 0; i < unshare_entities.size(); ++i)
-    owned_shared_entities.erase(unshare_entities[i]);
-}
-//-----------------------------------------------------------------------------
-bool DistributedMeshTools::is_shared(const Entity& entity,
-         const std::map<std::size_t, std::set<unsigned int>>& shared_vertices)
-{
-  // Iterate over entity vertices
-  Entity::const_iterator e;
-  for (e = entity.begin(); e != entity.end(); ++e)
-  {
-    // Return false if an entity vertex is not in the list (map) of
-    // shared entities
-    if (shared_vertices.find(*e) == shared_vertices.end())
-      return false;
-  }
-  return true;
+  table.process_offsets = std::move(process_offsets);
+  table.processes = std::move(processes);
 }
 //-----------------------------------------------------------------------------
 std::pair<std::size_t, std::size_t>
@@ -1261,3 +1247,19 @@ void DistributedMeshTools::reorder_values_by_global_indices(MPI_Comm mpi_comm,
   }
 }
 //-----------------------------------------------------------------------------
+std::vector<double>
+DistributedMeshTools::migrate_cell_data(const Mesh& mesh0,
+                                        const std::vector<double>& data0,
+                                        std::size_t width, const Mesh& mesh1)
+{
+  return ::migrate_cell_data(mesh0, data0, width, mesh1);
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int64_t>
+DistributedMeshTools::migrate_cell_data(const Mesh& mesh0,
+                                        const std::vector<std::int64_t>& data0,
+                                        std::size_t width, const Mesh& mesh1)
+{
+  return ::migrate_cell_data(mesh0, data0, width, mesh1);
+}
+//-----------------------------------------------------------------------------
@@ -22,6 +22,7 @@
 #define __MESH_DISTRIBUTED_TOOLS_H
 
 #include <array>
+#include <cstdint>
 #include <map>
 #include <numeric>
 #include <set>
@@ -42,7 +43,9 @@ namespace dolfin
   {
   public:
 
-    /// Create global entity indices for entities of dimension d
+    /// Create global entity indices for entities of dimension d.
+    /// Each process numbers the entities it owns in local order,
+    /// after the entities owned by lower ranks
     static void number_entities(const Mesh& mesh, std::size_t d);
 
     /// Create global entity indices for entities of dimension d for
@@ -95,70 +98,83 @@ namespace dolfin
                           const std::size_t width,
                           const std::vector<std::int64_t>& global_indices);
 
-  private:
+    /// Transfer data attached to cells between two distributions of
+    /// the same mesh, e.g. a mesh and the result of
+    /// MeshPartitioning::repartition. Cells are matched by global
+    /// index. The vector data0 holds width values for each regular
+    /// cell of mesh0, and width values for each cell of mesh1
+    /// (including ghost cells) are returned.
+    static std::vector<double>
+      migrate_cell_data(const Mesh& mesh0, const std::vector<double>& data0,
+                        std::size_t width, const Mesh& mesh1);
 
-    // Data structure for a mesh entity (list of vertices, using
-    // global indices)
-    typedef std::vector<std::size_t> Entity;
+    /// Transfer integer data attached to cells between two
+    /// distributions of the same mesh (see above)
+    static std::vector<std::int64_t>
+      migrate_cell_data(const Mesh& mesh0,
+                        const std::vector<std::int64_t>& data0,
+                        std::size_t width, const Mesh& mesh1);
 
-    // Data structure to mesh entity data
-    struct EntityData
-    {
-      // Constructor
-      EntityData() : local_index(0) {}
-
-      // Constructor  (index is local)
-      explicit EntityData(unsigned int index) : local_index(index) {}
+  private:
 
-      // Constructor (index is local)
-      EntityData(unsigned int index, const std::vector<unsigned int>& procs)
-        : local_index(index), processes(procs) {}
+    // Entities of dimension d whose vertices are all shared with
+    // other processes, in flat arrays sorted by entity key (a hash of
+    // the sorted global vertex indices, then the indices
+    // themselves). Processes that share an entity hold it at the
+    // same position relative to the other entities they share.
+    struct SharedEntityTable
+    {
+      // Number of vertices of each entity
+      std::size_t num_entity_vertices;
 
-      // Constructor  (index is local)
-      EntityData(unsigned int index, unsigned int process)
-        : local_index(index), processes(1, process) {}
+      // Entity keys (hash and sorted global vertex indices)
+      std::vector<std::uint64_t> hashes;
+      std::vector<std::size_t> vertices;
 
-      // Local (this process) entity index
-      unsigned int local_index;
+      // Local (this process) entity indices
+      std::vector<unsigned int> local_index;
 
-      // Processes on which entity resides
+      // Processes (other than this) sharing entity i are
+      // processes[process_offsets[i]:process_offsets[i + 1]], in
+      // increasing rank order
+      std::vector<std::size_t> process_offsets;
       std::vector<unsigned int> processes;
+
+      // Return position of entity with given sorted global vertex
+      // indices, or -1 if it is not in the table
+      int find(const std::size_t* entity_vertices) const;
+
+      // Return owner of entity i, which is the lowest ranked process
+      // sharing the entity
+      unsigned int owner(std::size_t i, unsigned int process_number) const
+      {
+        return (process_offsets[i + 1] > process_offsets[i]
+                and processes[process_offsets[i]] < process_number)
+          ? processes[process_offsets[i]] : process_number;
+      }
     };
 
-    // Compute ownership of entities ([entity vertices], data)
-    //  [0]: owned exclusively (will be numbered by this process)
-    //  [1]: owned and shared (will be numbered by this process, and number
-    //       communicated to other processes)
-    //  [2]: not owned but shared (will be numbered by another process,
-    //       and number communicated to this processes)
-    static void compute_entity_ownership(
-      const MPI_Comm mpi_comm,
-      const std::map<std::vector<std::size_t>, unsigned int>& entities,
-      const std::map<std::int32_t, std::set<unsigned int> >& shared_vertices_local,
+    // Build preliminary 'guess' of shared entities, i.e. entities
+    // whose vertices are all shared, with the processes sharing all
+    // their vertices. Entities with unshared vertices are owned
+    // exclusively. Also returns the neighbour processes (processes
+    // sharing vertices). This function does not involve any
+    // inter-process communication.
+    static void compute_preliminary_entity_ownership(
+      const Mesh& mesh, std::size_t d, const std::vector<bool>& exclude,
       const std::vector<std::int64_t>& global_vertex_indices,
-      std::size_t d,
+      const std::map<std::int32_t, std::set<unsigned int>>& shared_vertices_local,
       std::vector<std::size_t>& owned_entities,
-      std::array<std::map<Entity, EntityData>, 2>& shared_entities);
-
-    // Build preliminary 'guess' of shared entities. This function does
-    // not involve any inter-process communication.
-    static void compute_preliminary_entity_ownership(
-      const MPI_Comm mpi_comm,
-      const std::map<std::size_t, std::set<unsigned int> >& shared_vertices,
-      const std::map<Entity, unsigned int>& entities,
+      SharedEntityTable& shared_entities,
+      std::vector<int>& neighbours);
+
+    // Communicate with neighbour processes to find which processes
+    // really share each entity, moving entities that are not shared
+    // to the exclusively owned entities
+    static void compute_final_entity_ownership(
+      const MPI::NeighbourComm& neighbour_comm,
       std::vector<std::size_t>& owned_entities,
-      std::array<std::map<Entity, EntityData>, 2>& entity_ownership);
-
-    // Communicate with other processes to finalise entity ownership
-    static void
-      compute_final_entity_ownership(const MPI_Comm mpi_comm,
-                                     std::vector<std::size_t>& owned_entities,
-                                     std::array<std::map<Entity,
-                                     EntityData>, 2>& entity_ownership);
-
-    // Check if all entity vertices are the shared vertices in overlap
-    static bool is_shared(const std::vector<std::size_t>& entity_vertices,
-                const std::map<std::size_t, std::set<unsigned int> >& shared_vertices);
+      SharedEntityTable& shared_entities);
 
     // Compute and return (number of global entities, process offset)
     static std::pair<std::size_t, std::size_t>
@@ -0,0 +1,297 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __ENTITY_RANGE_H
+#define __ENTITY_RANGE_H
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <ufc.h>
+#include <dolfin/log/log.h>
+#include "Cell.h"
+#include "Mesh.h"
+#include "MeshConnectivity.h"
+#include "MeshGeometry.h"
+#include "MeshTopology.h"
+
+namespace dolfin
+{
+
+  /// EntityRange represents the mesh entities of a given topological
+  /// dimension as a range of integer indices. It is intended for
+  /// performance critical loops, where it replaces
+  /// MeshEntityIterator: no MeshEntity objects are created, and
+  /// connectivity and coordinates are accessed directly through
+  /// pointers. The basic use is illustrated below.
+  ///
+  /// @code{.cpp}
+  ///
+  ///         EntityRange cells(mesh, mesh.topology().dim());
+  ///         const MeshConnectivity& cell_vertices = cells.connectivity(0);
+  ///         for (std::size_t c : cells)
+  ///         {
+  ///           const unsigned int* v = cell_vertices(c);
+  ///           const double* x0 = cells.x(v[0]);
+  ///         }
+  /// @endcode
+  ///
+  /// Connectivity is computed on demand by connectivity(), so it
+  /// should be fetched before the loop.
+
+  class EntityRange
+  {
+  public:
+
+    /// Iterator over entity indices
+    class iterator : public std::iterator<std::random_access_iterator_tag,
+                                          std::size_t, std::ptrdiff_t,
+                                          const std::size_t*, std::size_t>
+    {
+    public:
+
+      /// Create iterator at given entity index
+      explicit iterator(std::size_t index) : _index(index) {}
+
+      /// Return entity index
+      std::size_t operator*() const
+      { return _index; }
+
+      /// Step to next entity
+      iterator& operator++()
+      { ++_index; return *this; }
+
+      /// Step to next entity (postfix)
+      iterator operator++(int)
+      { iterator it(*this); ++_index; return it; }
+
+      /// Step to previous entity
+      iterator& operator--()
+      { --_index; return *this; }
+
+      /// Step to previous entity (postfix)
+      iterator operator--(int)
+      { iterator it(*this); --_index; return it; }
+
+      /// Advance by n entities
+      iterator& operator+=(std::ptrdiff_t n)
+      { _index += n; return *this; }
+
+      /// Step back by n entities
+      iterator& operator-=(std::ptrdiff_t n)
+      { _index -= n; return *this; }
+
+      /// Return iterator advanced by n entities
+      iterator operator+(std::ptrdiff_t n) const
+      { return iterator(_index + n); }
+
+      /// Return iterator advanced by n entities
+      friend iterator operator+(std::ptrdiff_t n, const iterator& it)
+      { return it + n; }
+
+      /// Return iterator stepped back by n entities
+      iterator operator-(std::ptrdiff_t n) const
+      { return iterator(_index - n); }
+
+      /// Number of entities between iterators
+      std::ptrdiff_t operator-(const iterator& it) const
+      { return (std::ptrdiff_t) _index - (std::ptrdiff_t) it._index; }
+
+      /// Return entity index n entities ahead
+      std::size_t operator[](std::ptrdiff_t n) const
+      { return _index + n; }
+
+      /// Comparison operator
+      bool operator==(const iterator& it) const
+      { return _index == it._index; }
+
+      /// Comparison operator
+      bool operator!=(const iterator& it) const
+      { return _index != it._index; }
+
+      /// Comparison operator
+      bool operator<(const iterator& it) const
+      { return _index < it._index; }
+
+      /// Comparison operator
+      bool operator>(const iterator& it) const
+      { return _index > it._index; }
+
+      /// Comparison operator
+      bool operator<=(const iterator& it) const
+      { return _index <= it._index; }
+
+      /// Comparison operator
+      bool operator>=(const iterator& it) const
+      { return _index >= it._index; }
+
+    private:
+
+      std::size_t _index;
+
+    };
+
+    /// Create range over the entities of dimension dim of a mesh,
+    /// with string option to include "regular", "ghost" or "all"
+    /// entities (as for MeshEntityIterator)
+    EntityRange(const Mesh& mesh, std::size_t dim,
+                std::string opt="regular")
+      : _mesh(&mesh), _dim(dim), _begin(0), _end(0),
+        _x(mesh.geometry().x().data()), _gdim(mesh.geometry().dim())
+    {
+      // Check if mesh is empty
+      if (mesh.num_vertices() == 0)
+        return;
+
+      mesh.init(dim);
+      _end = mesh.topology().size(dim);
+      if (opt == "regular")
+        _end = mesh.topology().ghost_offset(dim);
+      else if (opt == "ghost")
+        _begin = mesh.topology().ghost_offset(dim);
+      else if (opt != "all")
+      {
+        dolfin_error("EntityRange.h",
+                     "create entity range",
+                     "Unknown opt=\"%s\", choose from "
+                     "opt=[\"regular\", \"ghost\", \"all\"]", opt.c_str());
+      }
+    }
+
+    /// Return iterator to first entity
+    iterator begin() const
+    { return iterator(_begin); }
+
+    /// Return iterator past last entity
+    iterator end() const
+    { return iterator(_end); }
+
+    /// Return number of entities in range
+    std::size_t size() const
+    { return _end - _begin; }
+
+    /// Return topological dimension of entities
+    std::size_t dim() const
+    { return _dim; }
+
+    /// Return mesh
+    const Mesh& mesh() const
+    { return *_mesh; }
+
+    /// Return connectivity from the entities to the entities of
+    /// dimension d, computing it if necessary. For d equal to the
+    /// dimension of the range, this is the connectivity from
+    /// entities to themselves, which is only available for d = 0.
+    const MeshConnectivity& connectivity(std::size_t d) const
+    {
+      _mesh->init(_dim, d);
+      return _mesh->topology()(_dim, d);
+    }
+
+    /// Return pointer to coordinates of vertex
+    const double* x(std::size_t vertex) const
+    { return _x + vertex*_gdim; }
+
+    /// Get cell coordinate dofs for cell (see
+    /// Cell::get_coordinate_dofs). The connectivity cell_vertices
+    /// is connectivity(0) of a range of cells.
+    void get_coordinate_dofs(std::size_t cell,
+                             const MeshConnectivity& cell_vertices,
+                             std::vector<double>& coordinate_dofs) const
+    {
+      dolfin_assert(_dim == _mesh->topology().dim());
+      if (_mesh->geometry().degree() != 1)
+      {
+        Cell(*_mesh, cell).get_coordinate_dofs(coordinate_dofs);
+        return;
+      }
+
+      const unsigned int* v = cell_vertices(cell);
+      const std::size_t num_vertices = cell_vertices.size(cell);
+      coordinate_dofs.resize(num_vertices*_gdim);
+      switch (_gdim)
+      {
+      case 1:
+        copy_coordinates<1>(v, num_vertices, coordinate_dofs.data());
+        break;
+      case 2:
+        copy_coordinates<2>(v, num_vertices, coordinate_dofs.data());
+        break;
+      case 3:
+        copy_coordinates<3>(v, num_vertices, coordinate_dofs.data());
+        break;
+      default:
+        for (std::size_t i = 0; i < num_vertices; ++i)
+          for (std::size_t j = 0; j < _gdim; ++j)
+            coordinate_dofs[i*_gdim + j] = _x[v[i]*_gdim + j];
+      }
+    }
+
+    /// Fill UFC cell with miscellaneous data for cell (see
+    /// Cell::get_cell_data)
+    void get_cell_data(std::size_t cell, ufc::cell& ufc_cell,
+                       int local_facet=-1) const
+    {
+      ufc_cell.geometric_dimension = _gdim;
+      ufc_cell.local_facet = local_facet;
+      const std::vector<int>& cell_orientations = _mesh->cell_orientations();
+      if (cell_orientations.empty())
+        ufc_cell.orientation = -1;
+      else
+      {
+        dolfin_assert(cell < cell_orientations.size());
+        ufc_cell.orientation = cell_orientations[cell];
+      }
+      ufc_cell.mesh_identifier = _mesh->id();
+      ufc_cell.index = cell;
+    }
+
+  private:
+
+    // Copy vertex coordinates, with the geometric dimension known at
+    // compile time
+    template<std::size_t GDIM>
+    void copy_coordinates(const unsigned int* v, std::size_t num_vertices,
+                          double* coordinate_dofs) const
+    {
+      for (std::size_t i = 0; i < num_vertices; ++i)
+      {
+        const double* x = _x + v[i]*GDIM;
+        for (std::size_t j = 0; j < GDIM; ++j)
+          coordinate_dofs[i*GDIM + j] = x[j];
+      }
+    }
+
+    // The mesh
+    const Mesh* _mesh;
+
+    // Topological dimension of entities
+    const std::size_t _dim;
+
+    // Range of entity indices
+    std::size_t _begin, _end;
+
+    // Vertex coordinates and geometric dimension
+    const double* _x;
+    const std::size_t _gdim;
+
+  };
+
+}
+
+#endif
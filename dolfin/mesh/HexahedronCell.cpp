@@ -17,6 +17,8 @@
 //
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <dolfin/log/log.h>
 #include "Cell.h"
 #include "MeshEditor.h"
@@ -170,6 +172,126 @@ double HexahedronCell::circumradius(const MeshEntity& cell) const
   return 0.0;
 }
 //-----------------------------------------------------------------------------
+void HexahedronCell::quality(const double* x, std::size_t num_cells,
+                             std::size_t gdim, Quality measure,
+                             double* q) const
+{
+  if (measure != Quality::volume && measure != Quality::edge_ratio
+      && measure != Quality::min_angle)
+  {
+    dolfin_error("HexahedronCell.cpp",
+                 "compute quality of hexahedron cells",
+                 "Only volume, edge ratio and minimum angle are defined for hexahedra");
+  }
+  if (gdim != 3)
+  {
+    dolfin_error("HexahedronCell.cpp",
+                 "compute quality of hexahedron cells",
+                 "Only know how to compute quality in R^3");
+  }
+
+  // Vertex i is at the corner (i & 1, (i >> 1) & 1, i >> 2) of the
+  // reference cube, and vertices i and i ^ bit share an edge for bit
+  // = 1, 2, 4.
+
+  // Two point Gauss rule on [0, 1]
+  const double g[2] = {0.5 - 0.5/std::sqrt(3.0), 0.5 + 0.5/std::sqrt(3.0)};
+
+  // Coordinate j of vertex i of cell c is x[(3*i + j)*n + c]
+  const std::size_t n = num_cells;
+  for (std::size_t c = 0; c < n; ++c)
+  {
+    double v[8][3];
+    for (std::size_t i = 0; i < 8; ++i)
+      for (std::size_t j = 0; j < 3; ++j)
+        v[i][j] = x[(3*i + j)*n + c];
+
+    switch (measure)
+    {
+    case Quality::volume:
+    {
+      // Integrate the Jacobian determinant of the trilinear map,
+      // which is exact with 2x2x2 Gauss points
+      double volume = 0.0;
+      for (std::size_t p = 0; p < 8; ++p)
+      {
+        const double t[3] = {g[p & 1], g[(p >> 1) & 1], g[p >> 2]};
+        double J[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+          const std::size_t b[3] = {i & 1, (i >> 1) & 1, i >> 2};
+          double phi[3], dphi[3];
+          for (std::size_t k = 0; k < 3; ++k)
+          {
+            phi[k] = b[k] ? t[k] : 1.0 - t[k];
+            dphi[k] = b[k] ? 1.0 : -1.0;
+          }
+          const double d[3] = {dphi[0]*phi[1]*phi[2], phi[0]*dphi[1]*phi[2],
+                               phi[0]*phi[1]*dphi[2]};
+          for (std::size_t j = 0; j < 3; ++j)
+            for (std::size_t k = 0; k < 3; ++k)
+              J[j][k] += v[i][j]*d[k];
+        }
+        volume += (J[0][0]*(J[1][1]*J[2][2] - J[1][2]*J[2][1])
+                   - J[0][1]*(J[1][0]*J[2][2] - J[1][2]*J[2][0])
+                   + J[0][2]*(J[1][0]*J[2][1] - J[1][1]*J[2][0]))/8.0;
+      }
+      q[c] = std::abs(volume);
+      break;
+    }
+    case Quality::edge_ratio:
+    {
+      double l2_min = std::numeric_limits<double>::max(), l2_max = 0.0;
+      for (std::size_t i = 0; i < 8; ++i)
+      {
+        for (std::size_t bit = 1; bit < 8; bit <<= 1)
+        {
+          if (i & bit)
+            continue;
+          double l2 = 0.0;
+          for (std::size_t j = 0; j < 3; ++j)
+          {
+            const double d = v[i | bit][j] - v[i][j];
+            l2 += d*d;
+          }
+          l2_min = std::min(l2_min, l2);
+          l2_max = std::max(l2_max, l2);
+        }
+      }
+      q[c] = std::sqrt(l2_max/l2_min);
+      break;
+    }
+    default:
+    {
+      // Minimum angle between two edges at a vertex
+      double cos_max = -1.0;
+      for (std::size_t i = 0; i < 8; ++i)
+      {
+        double e[3][3], l2[3];
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+          l2[k] = 0.0;
+          for (std::size_t j = 0; j < 3; ++j)
+          {
+            e[k][j] = v[i ^ (1 << k)][j] - v[i][j];
+            l2[k] += e[k][j]*e[k][j];
+          }
+        }
+        for (std::size_t k0 = 0; k0 < 3; ++k0)
+        {
+          const std::size_t k1 = (k0 + 1) % 3;
+          const double d = std::sqrt(l2[k0]*l2[k1]);
+          const double ab = e[k0][0]*e[k1][0] + e[k0][1]*e[k1][1]
+            + e[k0][2]*e[k1][2];
+          cos_max = std::max(cos_max, (d == 0.0) ? 1.0 : ab/d);
+        }
+      }
+      q[c] = std::acos(std::min(1.0, cos_max));
+    }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 double HexahedronCell::squared_distance(const Cell& cell,
                                            const Point& point) const
 {
@@ -24,6 +24,7 @@
 // Last changed: 2016-05-05
 
 #include <algorithm>
+#include <cmath>
 #include <dolfin/log/log.h>
 #include <dolfin/geometry/CollisionPredicates.h>
 #include "Cell.h"
@@ -127,6 +128,47 @@ double IntervalCell::circumradius(const MeshEntity& interval) const
   return volume(interval)/2.0;
 }
 //-----------------------------------------------------------------------------
+void IntervalCell::quality(const double* x, std::size_t num_cells,
+                           std::size_t gdim, Quality measure, double* q) const
+{
+  if (measure == Quality::min_angle)
+  {
+    dolfin_error("IntervalCell.cpp",
+                 "compute quality of interval cells",
+                 "Minimum angle is not defined for intervals");
+  }
+
+  // Coordinate j of vertex i of cell c is x[(i*gdim + j)*num_cells + c]
+  const double* x0 = x;
+  const double* x1 = x + gdim*num_cells;
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    double l2 = 0.0;
+    for (std::size_t j = 0; j < gdim; ++j)
+    {
+      const double d = x1[j*num_cells + c] - x0[j*num_cells + c];
+      l2 += d*d;
+    }
+    const double l = std::sqrt(l2);
+
+    switch (measure)
+    {
+    case Quality::volume:
+      q[c] = l;
+      break;
+    case Quality::circumradius:
+    case Quality::inradius:
+      q[c] = 0.5*l;
+      break;
+    case Quality::radius_ratio:
+      q[c] = (l == 0.0) ? 0.0 : 1.0;
+      break;
+    default:
+      q[c] = 1.0;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 double IntervalCell::squared_distance(const Cell& cell,
                                       const Point& point) const
 {
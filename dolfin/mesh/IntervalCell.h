@@ -73,6 +73,11 @@ namespace dolfin
     /// Compute circumradius of interval
     double circumradius(const MeshEntity& interval) const;
 
+    /// Compute a quality measure for a block of intervals (see
+    /// CellType::quality)
+    void quality(const double* x, std::size_t num_cells, std::size_t gdim,
+                 Quality measure, double* q) const;
+
     /// Compute squared distance to given point (3D enabled)
     double squared_distance(const Cell& cell, const Point& point) const;
 
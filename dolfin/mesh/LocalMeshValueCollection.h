@@ -96,14 +96,12 @@ namespace dolfin
       send_indices.resize(num_processes);
       send_v.resize(num_processes);
 
-      const std::map<std::pair<std::size_t, std::size_t>, T>& vals
-        = values.values();
+      const auto& vals = values.values();
       for (std::size_t p = 0; p < num_processes; p++)
       {
         const std::pair<std::size_t, std::size_t> local_range
           = MPI::local_range(_mpi_comm.comm(), p, vals.size());
-        typename std::map<std::pair<std::size_t,
-          std::size_t>, T>::const_iterator it = vals.begin();
+        auto it = vals.begin();
         std::advance(it, local_range.first);
         for (std::size_t i = local_range.first; i < local_range.second; ++i)
         {
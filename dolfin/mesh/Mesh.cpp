@@ -117,6 +117,9 @@ const Mesh& Mesh::operator=(const Mesh& mesh)
   _cell_orientations = mesh._cell_orientations;
   _ghost_mode = mesh._ghost_mode;
 
+  // Periodic pairs may have been computed for the old topology
+  _periodic_pairs.clear();
+
   // Rename
   rename(mesh.name(), mesh.label());
 
@@ -197,6 +200,9 @@ void Mesh::init(std::size_t d0, std::size_t d1) const
     return;
   }
 
+  // Record access for least recently used eviction
+  _topology.record_access(d0, d1);
+
   // Skip if already computed
   if (!_topology(d0, d1).empty())
     return;
@@ -578,5 +584,5 @@ void Mesh::build_mapping(std::shared_ptr<const Mesh> other) const
 		<< this->id() << ", " << other->id() << ") :"
 		<< "Index not found." << std::endl;
   }
-  this->_topology.add_mapping(std::make_pair(other->id(), std::make_shared<MeshView>(other, new_vertex_map, new_cell_map)));
+  this->_topology.add_mapping(std::make_pair(other->id(), std::make_shared<MeshView>(other, this->topology().dim(), new_vertex_map, new_cell_map)));
 }
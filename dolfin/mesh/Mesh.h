@@ -29,6 +29,7 @@
 #ifndef __MESH_H
 #define __MESH_H
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -515,9 +516,12 @@ namespace dolfin
   private:
 
     // Friends
+    friend class BlockMeshGenerator;
     friend class MeshEditor;
     friend class TopologyComputation;
     friend class MeshPartitioning;
+    friend class MeshRenumbering;
+    friend class PeriodicBoundaryComputation;
 
     // Mesh topology
     mutable MeshTopology _topology;
@@ -536,6 +540,18 @@ namespace dolfin
     // and is allocated and built when bounding_box_tree() is called.
     mutable std::shared_ptr<BoundingBoxTree> _tree;
 
+    // Slave to master entity maps computed by
+    // PeriodicBoundaryComputation, for a (SubDomain id, entity
+    // dimension) key, with the hash of the geometry and topology
+    // they were computed for. Not copied on assignment. Stale
+    // entries and the entries of the oldest SubDomains are evicted
+    // when pairs are cached.
+    mutable std::map<std::pair<std::size_t, std::size_t>,
+                     std::pair<std::size_t,
+                               std::map<unsigned int,
+                                        std::pair<unsigned int, unsigned int>>>>
+      _periodic_pairs;
+
     // Cell type
     std::unique_ptr<CellType> _cell_type;
 
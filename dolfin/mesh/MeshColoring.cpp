@@ -30,6 +30,7 @@
 #include <dolfin/graph/GraphBuilder.h>
 #include <dolfin/graph/GraphColoring.h>
 #include <dolfin/log/log.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "Cell.h"
 #include "Edge.h"
 #include "Facet.h"
@@ -109,15 +110,42 @@ MeshColoring::compute_colors(const Mesh& mesh,
                  "Mesh coloring does not support dim i - j coloring");
   }
 
-  // Create graph
-  Graph graph;
+  // Graph of the entities of dimension coloring_type[0] connected
+  // through entities of dimension coloring_type[1]. For cells
+  // connected through facets this is the dual graph, which has a
+  // cheaper builder.
+  const std::size_t tdim = mesh.topology().dim();
+  auto build_graph = [&mesh, &coloring_type, tdim]() -> CSRGraph<int>
+    {
+      if (coloring_type[0] == tdim and coloring_type[1] + 1 == tdim)
+        return GraphBuilder::local_csr_dual_graph(mesh);
+      return GraphBuilder::local_csr_graph(mesh, coloring_type[0],
+                                           coloring_type[1]);
+    };
+
+  // Color distance-2 graphs of the form (D, d, D, d, D) without
+  // building the distance-2 graph if coloring in parallel
+  const std::string colorer = parameters["graph_coloring_library"];
+  if (colorer == "DOLFIN" and coloring_type.size() == 5
+      and coloring_type[2] == coloring_type[0]
+      and coloring_type[3] == coloring_type[1])
+  {
+    const CSRGraph<int> graph = build_graph();
+    return GraphColoring::compute_speculative_vertex_coloring(graph, colors,
+                                                              2, true);
+  }
+
+  // Create and color graph
   if (coloring_type.size() == 3)
-    graph = GraphBuilder::local_graph(mesh, coloring_type[0], coloring_type[1]);
+  {
+    const CSRGraph<int> graph = build_graph();
+    return GraphColoring::compute_local_vertex_coloring(graph, colors);
+  }
   else
-    graph = GraphBuilder::local_graph(mesh, coloring_type);
-
-  // Color graph
-  return GraphColoring::compute_local_vertex_coloring(graph, colors);
+  {
+    const Graph graph = GraphBuilder::local_graph(mesh, coloring_type);
+    return GraphColoring::compute_local_vertex_coloring(graph, colors);
+  }
 }
 //-----------------------------------------------------------------------------
 MeshFunction<std::size_t>
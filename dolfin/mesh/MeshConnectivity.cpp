@@ -21,6 +21,7 @@
 // Last changed: 2014-01-09
 
 #include <sstream>
+#include <utility>
 #include <boost/functional/hash.hpp>
 #include <dolfin/log/log.h>
 #include "MeshConnectivity.h"
@@ -125,6 +126,19 @@ void MeshConnectivity::set(std::size_t entity, std::size_t* connections)
             _connections.begin() + index_to_position[entity]);
 }
 //-----------------------------------------------------------------------------
+void MeshConnectivity::set(std::vector<unsigned int>&& connections,
+                           std::vector<unsigned int>&& offsets)
+{
+  dolfin_assert(!offsets.empty());
+  dolfin_assert(offsets.back() == connections.size());
+
+  // Clear old data if any
+  clear();
+
+  _connections = std::move(connections);
+  index_to_position = std::move(offsets);
+}
+//-----------------------------------------------------------------------------
 std::size_t MeshConnectivity::hash() const
 {
   // Compute local hash key
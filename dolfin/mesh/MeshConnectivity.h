@@ -148,6 +148,13 @@ namespace dolfin
       _connections.shrink_to_fit();
     }
 
+    /// Set all connections for all entities from compressed row
+    /// storage, taking over the arrays. The array offsets has size
+    /// num_entities + 1, and the connections of entity e are
+    /// connections[offsets[e]:offsets[e + 1]].
+    void set(std::vector<unsigned int>&& connections,
+             std::vector<unsigned int>&& offsets);
+
     /// Set global number of connections for all local entities
     void
       set_global_size(const std::vector<unsigned int>& num_global_connections)
@@ -157,6 +164,18 @@ namespace dolfin
       _num_global_connections = num_global_connections;
     }
 
+    /// Return true if the global number of connections has been set
+    bool has_global_size() const
+    { return !_num_global_connections.empty(); }
+
+    /// Return memory usage (bytes) of connectivity data
+    std::size_t memory_usage() const
+    {
+      return sizeof(unsigned int)*(_connections.capacity()
+                                   + index_to_position.capacity()
+                                   + _num_global_connections.capacity());
+    }
+
     /// Hash of connections
     std::size_t hash() const;
 
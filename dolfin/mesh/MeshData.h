@@ -148,6 +148,7 @@ namespace dolfin
 
     /// Friends
     friend class XMLMesh;
+    friend class MeshRenumbering;
 
   private:
 
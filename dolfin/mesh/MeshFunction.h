@@ -24,11 +24,11 @@
 #ifndef __MESH_FUNCTION_H
 #define __MESH_FUNCTION_H
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
 #include <memory>
-#include <unordered_set>
 #include <dolfin/common/Hierarchical.h>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/NoDeleter.h>
@@ -52,12 +52,33 @@ namespace dolfin
   /// MeshFunction may for example be used to store a global numbering
   /// scheme for the entities of a (parallel) mesh, marking sub
   /// domains or boolean markers for mesh refinement.
+  ///
+  /// A MeshFunction used as a marker often has the same (default)
+  /// value at nearly all entities. Such a function may be compressed
+  /// (see compress), in which case only the runs of consecutive
+  /// entities that carry other values are stored. Values of a
+  /// compressed function are looked up in O(log n) time for n runs,
+  /// and the marked entities may be visited through runs(). A
+  /// compressed function is modified through set_value and set_all;
+  /// the non-const operator[] and values() require the function to be
+  /// decompressed first (see decompress).
 
   template <typename T> class MeshFunction : public Variable,
     public Hierarchical<MeshFunction<T>>
   {
   public:
 
+    /// A run of consecutive entities [begin, end) with the same value
+    struct Run
+    {
+      /// First entity of run
+      std::size_t begin;
+      /// One past last entity of run
+      std::size_t end;
+      /// Value of entities in run
+      T value;
+    };
+
     /// Create empty mesh function
     MeshFunction();
 
@@ -162,19 +183,28 @@ namespace dolfin
     ///         The size.
     std::size_t size() const;
 
-    /// Return array of values (const. version)
+    /// Return array of values (const. version). The function must
+    /// not be compressed.
     ///
     /// return T
     ///         The values.
     const T* values() const;
 
-    /// Return array of values
+    /// Return array of values. The function must not be compressed.
     ///
     /// return T
     ///         The values.
     T* values();
 
-    /// Return value at given mesh entity
+    /// Copy values at all entities into a vector. This works also
+    /// for a compressed function.
+    ///
+    /// @param values (std::vector<T>)
+    ///         The values (resized to size()).
+    void get_values(std::vector<T>& values) const;
+
+    /// Return value at given mesh entity. The function must not be
+    /// compressed.
     ///
     /// @param entity (_MeshEntity_)
     ///         The mesh entity.
@@ -192,7 +222,8 @@ namespace dolfin
     ///         The value at the given entity.
     const T& operator[] (const MeshEntity& entity) const;
 
-    /// Return value at given index
+    /// Return value at given index. The function must not be
+    /// compressed.
     ///
     /// @param index (std::size_t)
     ///         The index.
@@ -249,7 +280,8 @@ namespace dolfin
     void init(std::shared_ptr<const Mesh> mesh, std::size_t dim,
               std::size_t size);
 
-    /// Set value at given index
+    /// Set value at given index. For a compressed function, the
+    /// cost is O(n) for n runs.
     ///
     /// @param index (std::size_t)
     ///         The index.
@@ -281,7 +313,38 @@ namespace dolfin
     /// *Returns*
     ///     std::vector<T>
     ///         The indices.
-    std::vector<std::size_t> where_equal(T value);
+    std::vector<std::size_t> where_equal(T value) const;
+
+    /// Compress the function, storing only the runs of consecutive
+    /// entities with values different from a default value. The
+    /// array of values is released.
+    ///
+    /// @param default_value (T)
+    ///         The value that is not stored.
+    void compress(const T& default_value);
+
+    /// Decompress the function, restoring the array of values
+    void decompress();
+
+    /// Return true if the function is compressed
+    ///
+    /// @return bool
+    ///         True if compressed.
+    bool compressed() const;
+
+    /// Return the default value of a compressed function
+    ///
+    /// @return T
+    ///         The value at entities not covered by runs().
+    const T& default_value() const;
+
+    /// Return the runs of entities with values different from the
+    /// default value, ordered by entity index. The function must be
+    /// compressed.
+    ///
+    /// @return std::vector<Run>
+    ///         The runs.
+    const std::vector<Run>& runs() const;
 
     /// Return informal string representation (pretty-print)
     ///
@@ -294,11 +357,23 @@ namespace dolfin
 
   private:
 
+    // Set value at given index of a compressed function
+    void set_compressed_value(std::size_t index, const T& value);
+
+    // Return value at given index of a compressed function
+    const T& compressed_value(std::size_t index) const;
+
     // Values at the set of mesh entities. We don't use a
     // std::vector<T> here because it has trouble with bool, which C++
     // specialises.
     std::unique_ptr<T[]> _values;
 
+    // Compressed storage: runs of entities with values different
+    // from _default_value (used instead of _values if _compressed)
+    bool _compressed;
+    std::vector<Run> _runs;
+    T _default_value = T();
+
     // The mesh
     std::shared_ptr<const Mesh> _mesh;
 
@@ -324,7 +399,8 @@ namespace dolfin
   template <typename T>
   MeshFunction<T>::MeshFunction(std::shared_ptr<const Mesh> mesh)
     : Variable("f", "unnamed MeshFunction"),
-      Hierarchical<MeshFunction<T>>(*this), _mesh(mesh), _dim(0), _size(0)
+      Hierarchical<MeshFunction<T>>(*this), _compressed(false), _mesh(mesh),
+      _dim(0), _size(0)
   {
     // Do nothing
   }
@@ -333,7 +409,8 @@ namespace dolfin
   MeshFunction<T>::MeshFunction(std::shared_ptr<const Mesh> mesh,
                                 std::size_t dim)
     : Variable("f", "unnamed MeshFunction"),
-      Hierarchical<MeshFunction<T>>(*this), _mesh(mesh), _dim(0), _size(0)
+      Hierarchical<MeshFunction<T>>(*this), _compressed(false), _mesh(mesh),
+      _dim(0), _size(0)
   {
     init(dim);
   }
@@ -351,7 +428,8 @@ namespace dolfin
     MeshFunction<T>::MeshFunction(std::shared_ptr<const Mesh> mesh,
                                   const std::string filename)
     : Variable("f", "unnamed MeshFunction"),
-    Hierarchical<MeshFunction<T>>(*this), _mesh(mesh), _dim(0), _size(0)
+    Hierarchical<MeshFunction<T>>(*this), _compressed(false), _mesh(mesh),
+      _dim(0), _size(0)
   {
     File file(mesh->mpi_comm(), filename);
     file >> *this;
@@ -361,7 +439,7 @@ namespace dolfin
     MeshFunction<T>::MeshFunction(std::shared_ptr<const Mesh> mesh,
                                   const MeshValueCollection<T>& value_collection)
     : Variable("f", "unnamed MeshFunction"),
-      Hierarchical<MeshFunction<T>>(*this), _mesh(mesh),
+      Hierarchical<MeshFunction<T>>(*this), _compressed(false), _mesh(mesh),
       _dim(value_collection.dim()), _size(0)
   {
     *this = value_collection;
@@ -371,7 +449,8 @@ namespace dolfin
   MeshFunction<T>::MeshFunction(std::shared_ptr<const Mesh> mesh,
                                 std::size_t dim, const MeshDomains& domains)
     : Variable("f", "unnamed MeshFunction"),
-      Hierarchical<MeshFunction<T>>(*this), _mesh(mesh), _dim(0), _size(0)
+      Hierarchical<MeshFunction<T>>(*this), _compressed(false), _mesh(mesh),
+      _dim(0), _size(0)
   {
     dolfin_assert(_mesh);
 
@@ -407,7 +486,8 @@ namespace dolfin
   template <typename T>
   MeshFunction<T>::MeshFunction(const MeshFunction<T>& f) :
     Variable("f", "unnamed MeshFunction"),
-    Hierarchical<MeshFunction<T>>(*this), _dim(0), _size(0)
+    Hierarchical<MeshFunction<T>>(*this), _compressed(false), _dim(0),
+    _size(0)
   {
     *this = f;
   }
@@ -415,12 +495,18 @@ namespace dolfin
   template <typename T>
   MeshFunction<T>& MeshFunction<T>::operator= (const MeshFunction<T>& f)
   {
-    if (_size != f._size)
+    if (f._compressed)
+      _values.reset();
+    else if (_size != f._size || !_values)
       _values.reset(new T[f._size]);
     _mesh = f._mesh;
     _dim  = f._dim;
     _size = f._size;
-    std::copy(f._values.get(), f._values.get() + _size, _values.get());
+    _compressed = f._compressed;
+    _runs = f._runs;
+    _default_value = f._default_value;
+    if (!_compressed)
+      std::copy(f._values.get(), f._values.get() + _size, _values.get());
 
     Hierarchical<MeshFunction<T>>::operator=(f);
 
@@ -448,11 +534,10 @@ namespace dolfin
     set_all(std::numeric_limits<T>::max());
 
     // Iterate over all values
-    std::unordered_set<std::size_t> entities_values_set;
-    typename std::map<std::pair<std::size_t, std::size_t>, T>::const_iterator it;
-    const std::map<std::pair<std::size_t, std::size_t>, T>& values
-      = mesh_value_collection.values();
-    for (it = values.begin(); it != values.end(); ++it)
+    std::vector<bool> entity_is_set(_size, false);
+    std::size_t num_set = 0;
+    const auto& values = mesh_value_collection.values();
+    for (auto it = values.begin(); it != values.end(); ++it)
     {
       // Get value collection entry data
       const std::size_t cell_index = it->first.first;
@@ -476,12 +561,16 @@ namespace dolfin
       dolfin_assert(entity_index < _size);
       _values[entity_index] = value;
 
-      // Add entity index to set (used to check that all values are set)
-      entities_values_set.insert(entity_index);
+      // Mark entity as set (used to check that all values are set)
+      if (!entity_is_set[entity_index])
+      {
+        entity_is_set[entity_index] = true;
+        ++num_set;
+      }
     }
 
     // Check that all values have been set, if not issue a debug message
-    if (entities_values_set.size() != _size)
+    if (num_set != _size)
       dolfin_debug("Mesh value collection does not contain all values for all entities");
 
     return *this;
@@ -515,38 +604,75 @@ namespace dolfin
   template <typename T>
     const T* MeshFunction<T>::values() const
   {
+    if (_compressed)
+    {
+      dolfin_error("MeshFunction.h",
+                   "access values of mesh function",
+                   "Mesh function is compressed, use get_values() or "
+                   "decompress() first");
+    }
     return _values.get();
   }
   //---------------------------------------------------------------------------
   template <typename T>
     T* MeshFunction<T>::values()
   {
+    if (_compressed)
+    {
+      dolfin_error("MeshFunction.h",
+                   "access values of mesh function",
+                   "Mesh function is compressed, use get_values() or "
+                   "decompress() first");
+    }
     return _values.get();
   }
   //---------------------------------------------------------------------------
+  template <typename T>
+    void MeshFunction<T>::get_values(std::vector<T>& values) const
+  {
+    values.resize(_size);
+    if (!_compressed)
+    {
+      std::copy(_values.get(), _values.get() + _size, values.begin());
+      return;
+    }
+
+    std::fill(values.begin(), values.end(), _default_value);
+    for (const Run& run : _runs)
+      std::fill(values.begin() + run.begin, values.begin() + run.end,
+                run.value);
+  }
+  //---------------------------------------------------------------------------
   template <typename T>
     T& MeshFunction<T>::operator[] (const MeshEntity& entity)
   {
-    dolfin_assert(_values);
     dolfin_assert(&entity.mesh() == _mesh.get());
     dolfin_assert(entity.dim() == _dim);
-    dolfin_assert(entity.index() < _size);
-    return _values[entity.index()];
+    return (*this)[entity.index()];
   }
   //---------------------------------------------------------------------------
   template <typename T>
     const T& MeshFunction<T>::operator[] (const MeshEntity& entity) const
   {
-    dolfin_assert(_values);
     dolfin_assert(&entity.mesh() == _mesh.get());
     dolfin_assert(entity.dim() == _dim);
     dolfin_assert(entity.index() < _size);
+    if (_compressed)
+      return compressed_value(entity.index());
+    dolfin_assert(_values);
     return _values[entity.index()];
   }
   //---------------------------------------------------------------------------
   template <typename T>
     T& MeshFunction<T>::operator[] (std::size_t index)
   {
+    if (_compressed)
+    {
+      dolfin_error("MeshFunction.h",
+                   "access value of mesh function",
+                   "Mesh function is compressed, use set_value() or "
+                   "decompress() first");
+    }
     dolfin_assert(_values);
     dolfin_assert(index < _size);
     return _values[index];
@@ -555,8 +681,10 @@ namespace dolfin
   template <typename T>
     const T& MeshFunction<T>::operator[] (std::size_t index) const
   {
-    dolfin_assert(_values);
     dolfin_assert(index < _size);
+    if (_compressed)
+      return compressed_value(index);
+    dolfin_assert(_values);
     return _values[index];
   }
   //---------------------------------------------------------------------------
@@ -615,8 +743,10 @@ namespace dolfin
     dolfin_assert(mesh->num_entities(dim) == size);
 
     // Initialize data
-    if (_size != size)
+    if (_size != size || !_values)
       _values.reset(new T[size]);
+    _compressed = false;
+    _runs.clear();
     _mesh = mesh;
     _dim = dim;
     _size = size;
@@ -625,33 +755,73 @@ namespace dolfin
   template <typename T>
   void MeshFunction<T>::set_value(std::size_t index, const T& value)
   {
-    dolfin_assert(_values);
     dolfin_assert(index < _size);
+    if (_compressed)
+    {
+      set_compressed_value(index, value);
+      return;
+    }
+    dolfin_assert(_values);
     _values[index] = value;
   }
   //---------------------------------------------------------------------------
   template <typename T>
   void MeshFunction<T>::set_values(const std::vector<T>& values)
   {
-    dolfin_assert(_values);
     dolfin_assert(_size == values.size());
+    if (_compressed)
+    {
+      // Decompress via a temporary array and compress again
+      const T default_value = _default_value;
+      _values.reset(new T[_size]);
+      _compressed = false;
+      _runs.clear();
+      std::copy(values.begin(), values.end(), _values.get());
+      compress(default_value);
+      return;
+    }
+    dolfin_assert(_values);
     std::copy(values.begin(), values.end(), _values.get());
   }
   //---------------------------------------------------------------------------
   template <typename T>
   void MeshFunction<T>::set_all(const T& value)
   {
-    //dolfin_assert(_values);
-    if(_values)
+    if (_compressed)
+    {
+      _runs.clear();
+      _default_value = value;
+    }
+    else if (_values)
       std::fill(_values.get(), _values.get() + _size, value);
   }
   //---------------------------------------------------------------------------
   template <typename T>
-  std::vector<std::size_t> MeshFunction<T>::where_equal(T value)
+  std::vector<std::size_t> MeshFunction<T>::where_equal(T value) const
   {
+    std::vector<std::size_t> indices;
+    if (_compressed)
+    {
+      // Visit runs, and the gaps between runs if value is the default
+      std::size_t next = 0;
+      for (const Run& run : _runs)
+      {
+        if (value == _default_value)
+          for (std::size_t i = next; i < run.begin; ++i)
+            indices.push_back(i);
+        else if (run.value == value)
+          for (std::size_t i = run.begin; i < run.end; ++i)
+            indices.push_back(i);
+        next = run.end;
+      }
+      if (value == _default_value)
+        for (std::size_t i = next; i < _size; ++i)
+          indices.push_back(i);
+      return indices;
+    }
+
     dolfin_assert(_values);
     std::size_t n = std::count(_values.get(), _values.get() + _size, value);
-    std::vector<std::size_t> indices;
     indices.reserve(n);
     for (std::size_t i = 0; i < size(); ++i)
     {
@@ -662,6 +832,155 @@ namespace dolfin
   }
   //---------------------------------------------------------------------------
   template <typename T>
+  void MeshFunction<T>::compress(const T& default_value)
+  {
+    if (_compressed)
+      decompress();
+
+    // Find runs of equal values different from the default value
+    std::vector<Run> runs;
+    std::size_t i = 0;
+    while (i < _size)
+    {
+      if (_values[i] == default_value)
+      {
+        ++i;
+        continue;
+      }
+      const std::size_t begin = i;
+      while (i < _size && _values[i] == _values[begin])
+        ++i;
+      runs.push_back({begin, i, _values[begin]});
+    }
+
+    _runs = std::move(runs);
+    _runs.shrink_to_fit();
+    _default_value = default_value;
+    _compressed = true;
+    _values.reset();
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
+  void MeshFunction<T>::decompress()
+  {
+    if (!_compressed)
+      return;
+
+    _values.reset(new T[_size]);
+    std::fill(_values.get(), _values.get() + _size, _default_value);
+    for (const Run& run : _runs)
+      std::fill(_values.get() + run.begin, _values.get() + run.end, run.value);
+
+    _compressed = false;
+    _runs.clear();
+    _runs.shrink_to_fit();
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
+  bool MeshFunction<T>::compressed() const
+  {
+    return _compressed;
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
+  const T& MeshFunction<T>::default_value() const
+  {
+    dolfin_assert(_compressed);
+    return _default_value;
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
+  const std::vector<typename MeshFunction<T>::Run>&
+  MeshFunction<T>::runs() const
+  {
+    dolfin_assert(_compressed);
+    return _runs;
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
+  const T& MeshFunction<T>::compressed_value(std::size_t index) const
+  {
+    // Find first run ending after index
+    auto it = std::upper_bound(_runs.begin(), _runs.end(), index,
+                               [](std::size_t i, const Run& run)
+                               { return i < run.end; });
+    if (it != _runs.end() && it->begin <= index)
+      return it->value;
+    return _default_value;
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
+  void MeshFunction<T>::set_compressed_value(std::size_t index,
+                                             const T& value)
+  {
+    // Find first run ending after index
+    auto it = std::upper_bound(_runs.begin(), _runs.end(), index,
+                               [](std::size_t i, const Run& run)
+                               { return i < run.end; });
+    const bool inside = it != _runs.end() && it->begin <= index;
+    if ((inside && it->value == value)
+        || (!inside && value == _default_value))
+    {
+      return;
+    }
+
+    // Rebuild the runs next to the index: the run before, the run
+    // containing (or following) the index and the run after that
+    const std::size_t pos = it - _runs.begin();
+    const std::size_t lo = pos > 0 ? pos - 1 : 0;
+    const std::size_t hi = std::min(pos + 2, _runs.size());
+    const Run new_run = {index, index + 1, value};
+    const bool insert_new_run = !(value == _default_value);
+    bool inserted = !insert_new_run;
+    std::vector<Run> pieces;
+    for (std::size_t r = lo; r < hi; ++r)
+    {
+      const Run& run = _runs[r];
+      if (run.begin <= index && index < run.end)
+      {
+        // Split run around index
+        if (run.begin < index)
+          pieces.push_back({run.begin, index, run.value});
+        if (!inserted)
+        {
+          pieces.push_back(new_run);
+          inserted = true;
+        }
+        if (index + 1 < run.end)
+          pieces.push_back({index + 1, run.end, run.value});
+      }
+      else
+      {
+        if (!inserted && index < run.begin)
+        {
+          pieces.push_back(new_run);
+          inserted = true;
+        }
+        pieces.push_back(run);
+      }
+    }
+    if (!inserted)
+      pieces.push_back(new_run);
+
+    // Merge adjacent pieces with equal values
+    std::vector<Run> merged;
+    for (const Run& piece : pieces)
+    {
+      if (!merged.empty() && merged.back().end == piece.begin
+          && merged.back().value == piece.value)
+      {
+        merged.back().end = piece.end;
+      }
+      else
+        merged.push_back(piece);
+    }
+
+    // Replace runs [lo, hi) by merged runs
+    _runs.erase(_runs.begin() + lo, _runs.begin() + hi);
+    _runs.insert(_runs.begin() + lo, merged.begin(), merged.end());
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
   std::string MeshFunction<T>::str(bool verbose) const
   {
     std::stringstream s;
@@ -35,6 +35,7 @@
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/geometry/Point.h>
+#include <dolfin/graph/GeometricPartitioner.h>
 #include <dolfin/graph/GraphBuilder.h>
 #include <dolfin/graph/ParMETIS.h>
 #include <dolfin/graph/SCOTCH.h>
@@ -49,6 +50,7 @@
 #include "MeshEntity.h"
 #include "MeshEntityIterator.h"
 #include "MeshFunction.h"
+#include "MeshRenumbering.h"
 #include "MeshTopology.h"
 #include "MeshValueCollection.h"
 #include "Vertex.h"
@@ -116,22 +118,24 @@ void MeshPartitioning::build_distributed_mesh(Mesh& mesh,
 
   Timer timer("Build distributed mesh from local mesh data");
 
-  // Store used ghost mode
-  // NOTE: This is the only place in DOLFIN which eventually sets
-  //       mesh._ghost_mode != "none"
-  mesh._ghost_mode = ghost_mode;
-
   // Get mesh partitioner
   const std::string partitioner = parameters["mesh_partitioner"];
+  const std::string approach = parameters["partitioning_approach"];
 
   // MPI communicator
   MPI_Comm comm = mesh.mpi_comm();
 
-  // Compute cell partitioning or use partitioning provided in local_data
+  // Compute cell partitioning or use partitioning provided in
+  // local_data (processes without cells have an empty partition)
   std::vector<int> cell_partition;
   std::map<std::int64_t, std::vector<int>> ghost_procs;
-  if (local_data.topology.cell_partition.empty())
-    partition_cells(comm, local_data, partitioner, cell_partition, ghost_procs);
+  const int have_partition
+    = MPI::max(comm, (int) !local_data.topology.cell_partition.empty());
+  if (have_partition == 0)
+  {
+    partition_cells(comm, local_data, partitioner, approach, cell_partition,
+                    ghost_procs);
+  }
   else
   {
     // Copy cell partition
@@ -141,8 +145,147 @@ void MeshPartitioning::build_distributed_mesh(Mesh& mesh,
                   < (int) MPI::size(comm));
   }
 
+  // Build mesh
+  build_partitioned_mesh(mesh, local_data, cell_partition, ghost_procs,
+                         ghost_mode);
+}
+//-----------------------------------------------------------------------------
+void MeshPartitioning::build_distributed_mesh(Mesh& mesh,
+  const LocalMeshData& local_data,
+  std::int32_t num_regular_cells,
+  const std::map<std::int32_t, std::set<unsigned int>>& shared_cells,
+  const std::string ghost_mode)
+{
+  log(PROGRESS, "Building distributed mesh from partitioned local mesh data");
+
+  Timer timer("Build distributed mesh from partitioned local mesh data");
+
+  // Store used ghost mode
+  mesh._ghost_mode = ghost_mode;
+
+  // Check data
+  const std::int32_t num_cells = local_data.topology.global_cell_indices.size();
+  const std::int32_t num_cell_vertices = local_data.topology.num_vertices_per_cell;
+  dolfin_assert(num_regular_cells <= num_cells);
+  dolfin_assert((std::int32_t) local_data.topology.cell_vertices.shape()[0]
+                == num_cells);
+  if ((std::int32_t) local_data.topology.cell_partition.size() != num_cells)
+  {
+    dolfin_error("MeshPartitioning.cpp",
+                 "build distributed mesh",
+                 "Number of cell owners (%d) does not match number of cells (%d)",
+                 local_data.topology.cell_partition.size(), num_cells);
+  }
+
+  // Copy cells, without ghost cells if not ghosting
+  const std::int32_t num_local_cells
+    = (ghost_mode == "none") ? num_regular_cells : num_cells;
+  boost::multi_array<std::int64_t, 2>
+    cell_vertices(boost::extents[num_local_cells][num_cell_vertices]);
+  std::copy(local_data.topology.cell_vertices.data(),
+            local_data.topology.cell_vertices.data()
+            + num_local_cells*num_cell_vertices,
+            cell_vertices.data());
+  std::vector<std::int64_t> global_cell_indices(
+    local_data.topology.global_cell_indices.begin(),
+    local_data.topology.global_cell_indices.begin() + num_local_cells);
+  const std::vector<int> cell_owners(
+    local_data.topology.cell_partition.begin(),
+    local_data.topology.cell_partition.begin() + num_local_cells);
+  std::map<std::int32_t, std::set<unsigned int>> local_shared_cells;
+  if (ghost_mode != "none")
+    local_shared_cells = shared_cells;
+
+  // Build local mesh from the cells of this process
+  build_from_local_cells(mesh, local_data, num_regular_cells, cell_vertices,
+                         global_cell_indices, cell_owners, local_shared_cells);
+
+  complete_distributed_mesh(mesh, local_data);
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<Mesh>
+MeshPartitioning::repartition(const Mesh& mesh,
+                              const std::vector<std::size_t>& cell_weight)
+{
+  Timer timer("Repartition distributed mesh");
+
+  // Nothing to do in serial
+  MPI_Comm comm = mesh.mpi_comm();
+  if (MPI::size(comm) == 1)
+    return std::make_shared<Mesh>(mesh);
+
+  // Collect local mesh data from the current partition
+  LocalMeshData local_data(comm);
+  extract_local_mesh_data(mesh, local_data);
+  if (!cell_weight.empty())
+  {
+    const std::size_t num_cells = local_data.topology.global_cell_indices.size();
+    if (cell_weight.size() != num_cells)
+    {
+      dolfin_error("MeshPartitioning.cpp",
+                   "repartition mesh",
+                   "Number of cell weights (%d) does not match number of regular cells (%d)",
+                   cell_weight.size(), num_cells);
+    }
+    local_data.topology.cell_weight = cell_weight;
+  }
+
+  // Compute new partition, starting from the current one
+  const std::string partitioner = parameters["mesh_partitioner"];
+  std::vector<int> cell_partition;
+  std::map<std::int64_t, std::vector<int>> ghost_procs;
+  partition_cells(comm, local_data, partitioner, "REPARTITION", cell_partition,
+                  ghost_procs);
+
+  // Build new mesh
+  std::shared_ptr<Mesh> new_mesh(new Mesh(comm));
+  build_partitioned_mesh(*new_mesh, local_data, cell_partition, ghost_procs,
+                         mesh.ghost_mode());
+  return new_mesh;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<Mesh>
+MeshPartitioning::redistribute(const Mesh& mesh,
+                               const std::vector<int>& cell_destinations)
+{
+  Timer timer("Redistribute distributed mesh");
+
+  // Nothing to do in serial
+  MPI_Comm comm = mesh.mpi_comm();
+  if (MPI::size(comm) == 1)
+    return std::make_shared<Mesh>(mesh);
+
+  // Collect local mesh data from the current partition
+  LocalMeshData local_data(comm);
+  extract_local_mesh_data(mesh, local_data);
+  const std::size_t num_cells = local_data.topology.global_cell_indices.size();
+  if (cell_destinations.size() != num_cells)
+  {
+    dolfin_error("MeshPartitioning.cpp",
+                 "redistribute mesh",
+                 "Number of cell destinations (%d) does not match number of regular cells (%d)",
+                 cell_destinations.size(), num_cells);
+  }
+  local_data.topology.cell_partition = cell_destinations;
+
+  std::shared_ptr<Mesh> new_mesh(new Mesh(comm));
+  build_distributed_mesh(*new_mesh, local_data, mesh.ghost_mode());
+  return new_mesh;
+}
+//-----------------------------------------------------------------------------
+void MeshPartitioning::build_partitioned_mesh(Mesh& mesh,
+                        const LocalMeshData& local_data,
+                        const std::vector<int>& cell_partition,
+                        const std::map<std::int64_t, std::vector<int>>& ghost_procs,
+                        const std::string ghost_mode)
+{
+  // Store used ghost mode
+  // NOTE: This is the only place in DOLFIN which eventually sets
+  //       mesh._ghost_mode != "none"
+  mesh._ghost_mode = ghost_mode;
+
   // Check that we have some ghost information.
-  int all_ghosts = MPI::sum(comm, ghost_procs.size());
+  int all_ghosts = MPI::sum(mesh.mpi_comm(), ghost_procs.size());
   if (all_ghosts == 0 && ghost_mode != "none")
   {
     // FIXME: need to generate ghost cell information here by doing a
@@ -155,10 +298,22 @@ void MeshPartitioning::build_distributed_mesh(Mesh& mesh,
   // Build mesh from local mesh data and provided cell partition
   build(mesh, local_data, cell_partition, ghost_procs, ghost_mode);
 
+  complete_distributed_mesh(mesh, local_data);
+}
+//-----------------------------------------------------------------------------
+void MeshPartitioning::complete_distributed_mesh(Mesh& mesh,
+                                                 const LocalMeshData& local_data)
+{
   // Create MeshDomains from local_data
   // FIXME: probably not working with ghost cells?
   build_mesh_domains(mesh, local_data);
 
+  // Renumber cells and vertices within each partition along a
+  // space-filling curve
+  const std::string locality_ordering = parameters["reorder_mesh_locality"];
+  if (locality_ordering != "none")
+    MeshRenumbering::renumber_by_locality(mesh, locality_ordering);
+
   // Initialise number of globally connected cells to each facet. This
   // is necessary to distinguish between facets on an exterior
   // boundary and facets on a partition boundary (see
@@ -166,10 +321,101 @@ void MeshPartitioning::build_distributed_mesh(Mesh& mesh,
   DistributedMeshTools::init_facet_cell_connections(mesh);
 }
 //-----------------------------------------------------------------------------
+void MeshPartitioning::extract_local_mesh_data(const Mesh& mesh,
+                                               LocalMeshData& data)
+{
+  const MPI_Comm comm = mesh.mpi_comm();
+  const std::size_t tdim = mesh.topology().dim();
+  const std::size_t gdim = mesh.geometry().dim();
+
+  // Cells (regular cells only), with vertices given by global index
+  data.topology.dim = tdim;
+  data.topology.cell_type = mesh.type().cell_type();
+  data.topology.num_vertices_per_cell = mesh.type().num_vertices();
+  data.topology.num_global_cells = mesh.num_entities_global(tdim);
+
+  const std::size_t num_cells = mesh.topology().ghost_offset(tdim);
+  const std::size_t num_cell_vertices = data.topology.num_vertices_per_cell;
+  const std::vector<std::int64_t>& global_cells
+    = mesh.topology().global_indices(tdim);
+  const std::vector<std::int64_t>& global_vertices
+    = mesh.topology().global_indices(0);
+  const MeshConnectivity& cell_vertices = mesh.topology()(tdim, 0);
+  data.topology.global_cell_indices.resize(num_cells);
+  data.topology.cell_vertices.resize(boost::extents[num_cells][num_cell_vertices]);
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    data.topology.global_cell_indices[c] = global_cells[c];
+    const unsigned int* v = cell_vertices(c);
+    for (std::size_t i = 0; i < num_cell_vertices; ++i)
+      data.topology.cell_vertices[c][i] = global_vertices[v[i]];
+  }
+
+  // Vertices, distributed in contiguous blocks of global indices
+  data.geometry.dim = gdim;
+  data.geometry.num_global_vertices = mesh.num_entities_global(0);
+  const std::vector<double> x
+    = DistributedMeshTools::reorder_vertices_by_global_indices(mesh);
+  const std::size_t num_vertices = x.size()/gdim;
+  const std::int64_t vertex_offset
+    = MPI::global_offset(comm, num_vertices, true);
+  data.geometry.vertex_indices.resize(num_vertices);
+  for (std::size_t i = 0; i < num_vertices; ++i)
+    data.geometry.vertex_indices[i] = vertex_offset + i;
+  data.geometry.vertex_coordinates.resize(boost::extents[num_vertices][gdim]);
+  std::copy(x.begin(), x.end(), data.geometry.vertex_coordinates.data());
+
+  // MeshDomains, as (global cell index, local entity index, value)
+  const MeshDomains& domains = mesh.domains();
+  const std::size_t num_domain_dims
+    = domains.is_empty() ? 0 : domains.max_dim() + 1;
+  for (std::size_t d = 0; d < num_domain_dims; ++d)
+  {
+    if (domains.num_marked(d) == 0)
+      continue;
+    const std::map<std::size_t, std::size_t>& markers = domains.markers(d);
+
+    mesh.init(d, tdim);
+    mesh.init(tdim, d);
+    auto& domain_data = data.domain_data[d];
+    for (const auto& marker : markers)
+    {
+      // Find a regular cell containing the entity
+      std::size_t cell = num_cells;
+      std::size_t local_index = 0;
+      if (d == tdim)
+        cell = marker.first;
+      else
+      {
+        const MeshConnectivity& entity_cells = mesh.topology()(d, tdim);
+        for (std::size_t i = 0; i < entity_cells.size(marker.first); ++i)
+        {
+          if (entity_cells(marker.first)[i] < num_cells)
+          {
+            cell = entity_cells(marker.first)[i];
+            break;
+          }
+        }
+        if (cell == num_cells)
+          continue;
+
+        const unsigned int* cell_entities = mesh.topology()(tdim, d)(cell);
+        while (cell_entities[local_index] != marker.first)
+          ++local_index;
+      }
+
+      if (cell < num_cells)
+        domain_data.push_back({{(std::size_t) global_cells[cell], local_index},
+                               marker.second});
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 void
 MeshPartitioning::partition_cells(const MPI_Comm& mpi_comm,
                                   const LocalMeshData& mesh_data,
                                   const std::string partitioner,
+                                  const std::string approach,
                                   std::vector<int>& cell_partition,
                                   std::map<std::int64_t, std::vector<int>>& ghost_procs)
 {
@@ -194,10 +440,27 @@ MeshPartitioning::partition_cells(const MPI_Comm& mpi_comm,
   }
   else if (partitioner == "ParMETIS")
   {
+    // ParMETIS function follows the partitioning approach
+    std::string mode = "partition";
+    if (approach == "REPARTITION")
+      mode = "adaptive_repartition";
+    else if (approach == "REFINE")
+      mode = "refine";
     ParMETIS::compute_partition(mpi_comm, cell_partition, ghost_procs,
                                 mesh_data.topology.cell_vertices,
+                                mesh_data.topology.cell_weight,
                                 mesh_data.geometry.num_global_vertices,
-                                *cell_type);
+                                *cell_type, mode);
+  }
+  else if (partitioner == "RCB" || partitioner == "Hilbert")
+  {
+    // Native partitioner, refined on the dual graph
+    const std::size_t refinement_passes
+      = (int) parameters["partitioning_refinement_passes"];
+    GeometricPartitioner::compute_partition(mpi_comm, cell_partition,
+                                            ghost_procs, mesh_data,
+                                            partitioner == "RCB" ? "rcb" : "hilbert",
+                                            refinement_passes);
   }
   else
   {
@@ -220,9 +483,6 @@ void MeshPartitioning::build(Mesh& mesh, const LocalMeshData& mesh_data,
   // Sanity check
   dolfin_assert(mesh._ghost_mode == ghost_mode);
 
-  // Topological dimension
-  const int tdim = mesh_data.topology.dim;
-
   const std::int64_t num_global_vertices = mesh_data.geometry.num_global_vertices;
   const std::int32_t num_cell_vertices = mesh_data.topology.num_vertices_per_cell;
 
@@ -263,6 +523,25 @@ void MeshPartitioning::build(Mesh& mesh, const LocalMeshData& mesh_data,
     shared_cells.clear();
   }
 
+  // Build local mesh from the cells of this process
+  build_from_local_cells(mesh, mesh_data, num_regular_cells, new_cell_vertices,
+                         new_global_cell_indices, new_cell_partition,
+                         shared_cells);
+}
+//-----------------------------------------------------------------------------
+void MeshPartitioning::build_from_local_cells(Mesh& mesh,
+  const LocalMeshData& mesh_data,
+  const std::int32_t num_regular_cells,
+  boost::multi_array<std::int64_t, 2>& new_cell_vertices,
+  std::vector<std::int64_t>& new_global_cell_indices,
+  const std::vector<int>& new_cell_partition,
+  std::map<std::int32_t, std::set<unsigned int>>& shared_cells)
+{
+  // Topological dimension
+  const int tdim = mesh_data.topology.dim;
+
+  const std::int32_t num_cell_vertices = mesh_data.topology.num_vertices_per_cell;
+
   #ifdef HAS_SCOTCH
   if (parameters["reorder_cells_gps"])
   {
@@ -319,22 +598,43 @@ void MeshPartitioning::build(Mesh& mesh, const LocalMeshData& mesh_data,
   #endif
 
   // Send vertices to processes that need them, informing all
-  // sharing processes of their destinations
+  // sharing processes of their destinations. The vertex coordinates
+  // arrive in the background.
   std::map<std::int32_t, std::set<unsigned int>> shared_vertices;
-  boost::multi_array<double, 2> vertex_coordinates;
+  MPI::NonblockingExchange<double> coordinate_exchange;
+  std::vector<std::vector<std::size_t>> vertex_location;
   distribute_vertices(mesh.mpi_comm(), mesh_data, vertex_indices,
-                      vertex_coordinates, vertex_global_to_local,
-                      shared_vertices);
+                      vertex_global_to_local, shared_vertices,
+                      coordinate_exchange, vertex_location);
+
+  // Compute local cell-vertex connectivity while the coordinates are
+  // in transit
+  Timer timer_topology("Compute local cell-vertex connectivity");
+  boost::multi_array<std::int32_t, 2>
+    cell_local_vertices(boost::extents[new_cell_vertices.shape()[0]][num_cell_vertices]);
+  for (std::size_t i = 0; i < new_cell_vertices.shape()[0]; ++i)
+  {
+    for (std::int32_t j = 0; j < num_cell_vertices; ++j)
+    {
+      auto iter = vertex_global_to_local.find(new_cell_vertices[i][j]);
+      dolfin_assert(iter != vertex_global_to_local.end());
+      cell_local_vertices[i][j] = iter->second;
+    }
+  }
+  timer_topology.stop();
 
-  timer.stop();
+  // Receive vertex coordinates
+  boost::multi_array<double, 2> vertex_coordinates;
+  receive_vertex_coordinates(coordinate_exchange, vertex_location,
+                             vertex_global_to_local, mesh_data.geometry.dim,
+                             vertex_coordinates);
 
-  // Build lcoal mesh from new_mesh_data
-  build_local_mesh(mesh, new_global_cell_indices, new_cell_vertices,
+  // Build local mesh from new_mesh_data
+  build_local_mesh(mesh, new_global_cell_indices, cell_local_vertices,
                    mesh_data.topology.cell_type, mesh_data.topology.dim,
                    mesh_data.topology.num_global_cells, vertex_indices,
                    vertex_coordinates, mesh_data.geometry.dim,
-                   mesh_data.geometry.num_global_vertices,
-                   vertex_global_to_local);
+                   mesh_data.geometry.num_global_vertices);
 
   // Fix up some of the ancilliary data about sharing and ownership
   // now that the mesh has been initialised
@@ -546,7 +846,8 @@ void MeshPartitioning::distribute_cell_layer(MPI_Comm mpi_comm,
   }
 
   // Send lists of cells/owners to MPI::index_owner of vertex,
-  // collating and sending back out...
+  // collating and sending back out. Only processes holding shared
+  // vertices communicate, so the exchanges are sparse.
   std::vector<std::vector<std::int64_t>> send_vertcells(mpi_size);
   std::vector<std::vector<std::int64_t>> recv_vertcells(mpi_size);
   for (auto vc_it = sh_vert_to_cell.begin(); vc_it != sh_vert_to_cell.end(); ++vc_it)
@@ -569,7 +870,7 @@ void MeshPartitioning::distribute_cell_layer(MPI_Comm mpi_comm,
     }
   }
 
-  MPI::all_to_all(mpi_comm, send_vertcells, recv_vertcells);
+  MPI::sparse_all_to_all(mpi_comm, send_vertcells, recv_vertcells);
 
   const unsigned int num_cell_vertices = cell_vertices.shape()[1];
 
@@ -611,7 +912,7 @@ void MeshPartitioning::distribute_cell_layer(MPI_Comm mpi_comm,
     }
   }
 
-  MPI::all_to_all(mpi_comm, send_vertcells, recv_vertcells);
+  MPI::sparse_all_to_all(mpi_comm, send_vertcells, recv_vertcells);
 
   // Count up new cells, assign local index, set owner
   // and initialise shared_cells
@@ -741,9 +1042,9 @@ MeshPartitioning::distribute_cells(
 
   // Send all cells to their destinations including their global
   // indices.  First element of vector is cell count of unghosted
-  // cells, second element is count of ghost cells.
-  std::vector<std::vector<std::size_t>>
-    send_cell_vertices(mpi_size, std::vector<std::size_t>(2, 0));
+  // cells, second element is count of ghost cells. Only processes
+  // that receive cells get a message.
+  std::vector<std::vector<std::size_t>> send_cell_vertices(mpi_size);
 
   for (unsigned int i = 0; i != cell_partition.size(); ++i)
   {
@@ -757,6 +1058,8 @@ MeshPartitioning::distribute_cells(
       {
         // Create reference to destination vector
         std::vector<std::size_t>& send_cell_dest = send_cell_vertices[*dest];
+        if (send_cell_dest.empty())
+          send_cell_dest.assign(2, 0);
 
         // Count of ghost cells, followed by ghost processes
         send_cell_dest.push_back(destinations.size());
@@ -784,6 +1087,8 @@ MeshPartitioning::distribute_cells(
       // Single destination (unghosted cell)
       std::vector<std::size_t>& send_cell_dest
         = send_cell_vertices[cell_partition[i]];
+      if (send_cell_dest.empty())
+        send_cell_dest.assign(2, 0);
       send_cell_dest.push_back(0);
 
       // Global cell index
@@ -799,7 +1104,7 @@ MeshPartitioning::distribute_cells(
 
   // Distribute cell-vertex connectivity and ownership information
   std::vector<std::vector<std::size_t>> received_cell_vertices(mpi_size);
-  MPI::all_to_all(mpi_comm, send_cell_vertices, received_cell_vertices);
+  MPI::sparse_all_to_all(mpi_comm, send_cell_vertices, received_cell_vertices);
 
   // Count number of received cells (first entry in vector) and find
   // out how many ghost cells there are...
@@ -808,8 +1113,11 @@ MeshPartitioning::distribute_cells(
   for (std::size_t p = 0; p < mpi_size; ++p)
   {
     std::vector<std::size_t>& received_data = received_cell_vertices[p];
-    local_count += received_data[0];
-    ghost_count += received_data[1];
+    if (!received_data.empty())
+    {
+      local_count += received_data[0];
+      ghost_count += received_data[1];
+    }
   }
 
   const std::size_t all_count = ghost_count + local_count;
@@ -827,6 +1135,8 @@ MeshPartitioning::distribute_cells(
   for (std::size_t p = 0; p < mpi_size; ++p)
   {
     std::vector<std::size_t>& received_data = received_cell_vertices[p];
+    if (received_data.empty())
+      continue;
     for (auto it = received_data.begin() + 2; it != received_data.end();
          it += (*it + num_cell_vertices + 2))
     {
@@ -872,6 +1182,8 @@ std::int32_t MeshPartitioning::compute_vertex_mapping(MPI_Comm mpi_comm,
                  std::vector<std::int64_t>& vertex_indices,
                  std::map<std::int64_t, std::int32_t>& vertex_global_to_local)
 {
+  Timer timer("Compute local vertex numbering");
+
   vertex_indices.clear();
   vertex_global_to_local.clear();
 
@@ -904,9 +1216,10 @@ void MeshPartitioning::distribute_vertices(
   const MPI_Comm mpi_comm,
   const LocalMeshData& mesh_data,
   const std::vector<std::int64_t>& vertex_indices,
-  boost::multi_array<double, 2>& vertex_coordinates,
-  std::map<std::int64_t, std::int32_t>& vertex_global_to_local,
-  std::map<std::int32_t, std::set<unsigned int>>& shared_vertices_local)
+  const std::map<std::int64_t, std::int32_t>& vertex_global_to_local,
+  std::map<std::int32_t, std::set<unsigned int>>& shared_vertices_local,
+  MPI::NonblockingExchange<double>& coordinate_exchange,
+  std::vector<std::vector<std::size_t>>& vertex_location)
 {
   // This function distributes all vertices (coordinates and
   // local-to-global mapping) according to the cells that are stored
@@ -914,7 +1227,8 @@ void MeshPartitioning::distribute_vertices(
   // process figures out which vertices it needs (by looking at its
   // cells) and where those vertices are located. That information is
   // then distributed so that each process learns where it needs to
-  // send its vertices.
+  // send its vertices. The coordinates are sent without waiting for
+  // them to arrive.
 
   log(PROGRESS, "Distribute vertices during distributed mesh construction");
   Timer timer("Distribute vertices");
@@ -933,30 +1247,21 @@ void MeshPartitioning::distribute_vertices(
     ranges[i] += ranges[i - 1];
   ranges.insert(ranges.begin(), 0);
 
-  std::vector<std::vector<std::size_t>> send_vertex_indices(mpi_size);
+  vertex_location.assign(mpi_size, std::vector<std::size_t>());
   for (const auto& required_vertex : vertex_indices)
   {
     const int location
       = std::upper_bound(ranges.begin(), ranges.end(), required_vertex)
       - ranges.begin() - 1;
-    send_vertex_indices[location].push_back(required_vertex);
+    vertex_location[location].push_back(required_vertex);
   }
 
-  // Convenience reference
-  const std::vector<std::vector<std::size_t>>& vertex_location
-    = send_vertex_indices;
-
   // Send required vertices to other processes, and receive back
   // vertices required by other processes.
   std::vector<std::vector<std::size_t>> received_vertex_indices;
-  MPI::all_to_all(mpi_comm, send_vertex_indices, received_vertex_indices);
-
-  // Redistribute received_vertex_indices as vertex sharing
-  // information
-  build_shared_vertices(mpi_comm, shared_vertices_local,
-                        vertex_global_to_local, received_vertex_indices);
+  MPI::sparse_all_to_all(mpi_comm, vertex_location, received_vertex_indices);
 
-  // Distribute vertex coordinates
+  // Start sending vertex coordinates to destinations
   std::vector<std::vector<double>> send_vertex_coordinates(mpi_size);
   const std::pair<std::size_t, std::size_t> local_vertex_range = {ranges[mpi_rank], ranges[mpi_rank + 1]};
   for (int p = 0; p < mpi_size; ++p)
@@ -973,30 +1278,43 @@ void MeshPartitioning::distribute_vertices(
                                         mesh_data.geometry.vertex_coordinates[location].end());
     }
   }
+  std::vector<std::size_t> recv_sizes(mpi_size);
+  for (int p = 0; p < mpi_size; ++p)
+    recv_sizes[p] = vertex_location[p].size()*gdim;
+  coordinate_exchange.start(mpi_comm, send_vertex_coordinates, recv_sizes);
 
-  // Send actual coordinates to destinations
-  std::vector<std::vector<double>> received_vertex_coordinates;
-  MPI::all_to_all(mpi_comm, send_vertex_coordinates,
-                  received_vertex_coordinates);
+  // Redistribute received_vertex_indices as vertex sharing
+  // information while the coordinates are in transit
+  build_shared_vertices(mpi_comm, shared_vertices_local,
+                        vertex_global_to_local, received_vertex_indices);
+}
+//-----------------------------------------------------------------------------
+void MeshPartitioning::receive_vertex_coordinates(
+  MPI::NonblockingExchange<double>& coordinate_exchange,
+  const std::vector<std::vector<std::size_t>>& vertex_location,
+  const std::map<std::int64_t, std::int32_t>& vertex_global_to_local,
+  const int gdim,
+  boost::multi_array<double, 2>& vertex_coordinates)
+{
+  Timer timer("Receive vertex coordinates");
 
-  // Count number of received local vertices and check it agrees with map
-  std::size_t num_received_vertices = 0;
-  for (int p = 0; p < mpi_size; ++p)
-    num_received_vertices += received_vertex_coordinates[p].size()/gdim;
-  dolfin_assert(num_received_vertices == vertex_indices.size());
+  // Wait for coordinates
+  const std::vector<std::vector<double>>& received_vertex_coordinates
+    = coordinate_exchange.wait();
 
   // Initialise coordinates array
-  vertex_coordinates.resize(boost::extents[vertex_indices.size()][gdim]);
+  vertex_coordinates.resize(boost::extents[vertex_global_to_local.size()][gdim]);
 
   // Store coordinates according to global_to_local mapping
-  for (int p = 0; p < mpi_size; ++p)
+  for (std::size_t p = 0; p < vertex_location.size(); ++p)
   {
-    for (std::size_t i = 0; i < received_vertex_coordinates[p].size()/gdim; ++i)
+    dolfin_assert(received_vertex_coordinates[p].size()
+                  == vertex_location[p].size()*gdim);
+    for (std::size_t i = 0; i < vertex_location[p].size(); ++i)
     {
       const std::int64_t global_vertex_index = vertex_location[p][i];
       auto v = vertex_global_to_local.find(global_vertex_index);
       dolfin_assert(v != vertex_global_to_local.end());
-      dolfin_assert(vertex_indices[v->second] == global_vertex_index);
       for (int j = 0; j < gdim; ++j)
         vertex_coordinates[v->second][j] = received_vertex_coordinates[p][i*gdim + j];
     }
@@ -1009,6 +1327,7 @@ void MeshPartitioning::build_shared_vertices(MPI_Comm mpi_comm,
      const std::vector<std::vector<std::size_t>>& received_vertex_indices)
 {
   log(PROGRESS, "Build shared vertices during distributed mesh construction");
+  Timer timer("Build shared vertices");
 
   const int mpi_size = MPI::size(mpi_comm);
 
@@ -1050,37 +1369,39 @@ void MeshPartitioning::build_shared_vertices(MPI_Comm mpi_comm,
     }
   }
 
-  // Receive as a flat array
-  std::vector<std::size_t> recv_sharing(mpi_size);
-  MPI::all_to_all(mpi_comm, send_sharing, recv_sharing);
+  // Only processes holding shared vertices receive data
+  std::vector<std::vector<std::size_t>> recv_sharing;
+  MPI::sparse_all_to_all(mpi_comm, send_sharing, recv_sharing);
 
-  for (auto q = recv_sharing.begin(); q != recv_sharing.end(); q += (*q + 2))
+  for (auto& recv : recv_sharing)
   {
-    const std::size_t num_sharing = *q;
-    const std::size_t global_vertex_index = *(q + 1);
-    std::set<unsigned int> sharing_processes(q + 2, q + 2 + num_sharing);
-
-    auto local_index_it = vertex_global_to_local.find(global_vertex_index);
-    dolfin_assert(local_index_it != vertex_global_to_local.end());
-    const unsigned int local_index = local_index_it->second;
-    dolfin_assert(shared_vertices_local.find(local_index)
-                  == shared_vertices_local.end());
-    shared_vertices_local.insert({local_index, sharing_processes});
+    for (auto q = recv.begin(); q != recv.end(); q += (*q + 2))
+    {
+      const std::size_t num_sharing = *q;
+      const std::size_t global_vertex_index = *(q + 1);
+      std::set<unsigned int> sharing_processes(q + 2, q + 2 + num_sharing);
+
+      auto local_index_it = vertex_global_to_local.find(global_vertex_index);
+      dolfin_assert(local_index_it != vertex_global_to_local.end());
+      const unsigned int local_index = local_index_it->second;
+      dolfin_assert(shared_vertices_local.find(local_index)
+                    == shared_vertices_local.end());
+      shared_vertices_local.insert({local_index, sharing_processes});
+    }
   }
 
 }
 //-----------------------------------------------------------------------------
 void MeshPartitioning::build_local_mesh(Mesh& mesh,
   const std::vector<std::int64_t>& global_cell_indices,
-  const boost::multi_array<std::int64_t, 2>& cell_global_vertices,
+  const boost::multi_array<std::int32_t, 2>& cell_local_vertices,
   const CellType::Type cell_type,
   const int tdim,
   const std::int64_t num_global_cells,
   const std::vector<std::int64_t>& vertex_indices,
   const boost::multi_array<double, 2>& vertex_coordinates,
   const int gdim,
-  const std::int64_t num_global_vertices,
-  const std::map<std::int64_t, std::int32_t>& vertex_global_to_local)
+  const std::int64_t num_global_vertices)
 {
   log(PROGRESS, "Build local mesh during distributed mesh construction");
   Timer timer("Build local part of distributed mesh (from local mesh data)");
@@ -1105,20 +1426,14 @@ void MeshPartitioning::build_local_mesh(Mesh& mesh,
   dolfin_assert(_cell_type);
 
   // Add cells
-  editor.init_cells_global(cell_global_vertices.size(), num_global_cells);
+  editor.init_cells_global(cell_local_vertices.size(), num_global_cells);
 
   const std::int8_t num_cell_vertices = _cell_type->num_vertices();
   std::vector<std::size_t> cell(num_cell_vertices);
-  for (std::size_t i = 0; i < cell_global_vertices.size(); ++i)
+  for (std::size_t i = 0; i < cell_local_vertices.size(); ++i)
   {
     for (std::int8_t j = 0; j < num_cell_vertices; ++j)
-    {
-      // Get local cell vertex
-      auto iter = vertex_global_to_local.find(cell_global_vertices[i][j]);
-      dolfin_assert(iter != vertex_global_to_local.end());
-      cell[j] = iter->second;
-    }
-
+      cell[j] = cell_local_vertices[i][j];
     editor.add_cell(i, global_cell_indices[i], cell);
   }
 
@@ -1187,8 +1502,7 @@ void MeshPartitioning::build_mesh_domains(Mesh& mesh,
     }
 
     // Get data from mesh value collection
-    const std::map<std::pair<std::size_t, std::size_t>, std::size_t>& values
-      = mvc.values();
+    const auto& values = mvc.values();
 
     // Get map from mesh domains
     std::map<std::size_t, std::size_t>& markers = mesh.domains().markers(d);
@@ -1198,7 +1512,7 @@ void MeshPartitioning::build_mesh_domains(Mesh& mesh,
       const std::size_t local_entity_index = it->first.second;
 
       if (d == D)
-        markers[0] = it->second;
+        markers[cell_index] = it->second;
       else
       {
         const Cell cell(mesh, cell_index);
@@ -28,10 +28,13 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <boost/multi_array.hpp>
 #include <dolfin/log/log.h>
+#include <dolfin/common/MPI.h>
 #include <dolfin/common/Set.h>
 #include "CellType.h"
 #include "DistributedMeshTools.h"
@@ -78,6 +81,19 @@ namespace dolfin
     static void build_distributed_mesh(Mesh& mesh, const LocalMeshData& data,
                                        const std::string ghost_mode);
 
+    /// Build a distributed mesh from 'local mesh data' that already
+    /// holds the cells of each process, e.g. as read back from a file
+    /// written by the same number of processes. No partitioner is
+    /// called and no cells are exchanged. The first num_regular_cells
+    /// cells in data are owned by this process and the others are
+    /// ghost cells, with owning processes given by
+    /// data.topology.cell_partition. shared_cells maps the local
+    /// index of each shared cell to the other processes holding it.
+    static void build_distributed_mesh(Mesh& mesh, const LocalMeshData& data,
+         std::int32_t num_regular_cells,
+         const std::map<std::int32_t, std::set<unsigned int>>& shared_cells,
+         const std::string ghost_mode);
+
     /// Build a MeshValueCollection based on LocalMeshValueCollection
     template<typename T>
       static void
@@ -85,8 +101,47 @@ namespace dolfin
                                 const LocalMeshValueCollection<T>& local_data,
                                 const Mesh& mesh);
 
+    /// Repartition a distributed mesh in memory, e.g. after local
+    /// refinement has left the processes unevenly loaded. If
+    /// cell_weight is not empty, it holds a weight (e.g. an estimate
+    /// of the assembly cost) for each regular cell, and the sum of
+    /// the weights on each process is balanced. The partitioner is
+    /// given by the parameter "mesh_partitioner"; ParMETIS uses
+    /// adaptive repartitioning, which favours keeping cells on their
+    /// current process. Global cell and vertex indices and
+    /// MeshDomains are preserved. Data on the old mesh can be
+    /// transferred to the returned mesh with migrate().
+    static std::shared_ptr<Mesh>
+      repartition(const Mesh& mesh,
+                  const std::vector<std::size_t>& cell_weight
+                  =std::vector<std::size_t>());
+
+    /// Redistribute a distributed mesh in memory, sending each
+    /// regular cell to the process given in cell_destinations. Global
+    /// cell and vertex indices and MeshDomains are preserved.
+    static std::shared_ptr<Mesh>
+      redistribute(const Mesh& mesh, const std::vector<int>& cell_destinations);
+
+    /// Transfer the values of a MeshFunction to a MeshFunction of the
+    /// same dimension on another distribution of the same mesh, as
+    /// returned by repartition() or redistribute()
+    template<typename T>
+      static void migrate(const MeshFunction<T>& f0, MeshFunction<T>& f1);
+
   private:
 
+    // Build a distributed mesh from local mesh data and a computed
+    // partition
+    static void build_partitioned_mesh(Mesh& mesh, const LocalMeshData& data,
+                     const std::vector<int>& cell_partition,
+                     const std::map<std::int64_t, std::vector<int>>& ghost_procs,
+                     const std::string ghost_mode);
+
+    // Extract the regular cells of a distributed mesh, its vertices
+    // (distributed by global index) and its MeshDomains as local mesh
+    // data
+    static void extract_local_mesh_data(const Mesh& mesh, LocalMeshData& data);
+
     // Compute cell partitioning from local mesh data. Returns a
     // vector 'cell -> process' vector for cells in LocalMeshData, and
     // a map 'local cell index -> processes' to which ghost cells must
@@ -95,6 +150,7 @@ namespace dolfin
     void partition_cells(const MPI_Comm& mpi_comm,
                          const LocalMeshData& mesh_data,
                          const std::string partitioner,
+                         const std::string approach,
                          std::vector<int>& cell_partition,
                          std::map<std::int64_t, std::vector<int>>& ghost_procs);
 
@@ -105,6 +161,22 @@ namespace dolfin
                       const std::map<std::int64_t, std::vector<int>>& ghost_procs,
                       const std::string ghost_mode);
 
+    // Build the local part of a distributed mesh from the cells of
+    // this process (regular cells followed by ghost cells), with cell
+    // vertices given by global index. Vertices are numbered, shared
+    // and received here.
+    static void
+      build_from_local_cells(Mesh& mesh, const LocalMeshData& data,
+                             const std::int32_t num_regular_cells,
+                             boost::multi_array<std::int64_t, 2>& cell_vertices,
+                             std::vector<std::int64_t>& global_cell_indices,
+                             const std::vector<int>& cell_owners,
+                             std::map<std::int32_t, std::set<unsigned int>>& shared_cells);
+
+    // Create MeshDomains, reorder for locality and initialise the
+    // facet-cell connections of a newly built distributed mesh
+    static void complete_distributed_mesh(Mesh& mesh, const LocalMeshData& data);
+
     // FIXME: Improve this docstring
     // Distribute a layer of cells attached by vertex to boundary updating
     // new_mesh_data and shared_cells. Used when ghosting by vertex.
@@ -173,15 +245,30 @@ namespace dolfin
      const std::map<std::int64_t, std::int32_t>& vertex_global_to_local_indices,
      const std::vector<std::vector<std::size_t>>& received_vertex_indices);
 
-    // FIXME: make clear what is computed
-    // Distribute vertices and vertex sharing information
+    // Distribute vertices and vertex sharing information. Requests
+    // for the vertices in vertex_indices are sent to the processes
+    // holding them, and the transfer of their coordinates is started
+    // in coordinate_exchange. Vertex sharing is computed while the
+    // coordinates are in transit. On return, vertex_location[p]
+    // lists the global vertices whose coordinates come from process
+    // p (see receive_vertex_coordinates).
     static void
       distribute_vertices(const MPI_Comm mpi_comm,
         const LocalMeshData& mesh_data,
         const std::vector<std::int64_t>& vertex_indices,
-        boost::multi_array<double, 2>& new_vertex_coordinates,
-        std::map<std::int64_t, std::int32_t>& vertex_global_to_local_indices,
-        std::map<std::int32_t, std::set<unsigned int>>& shared_vertices_local);
+        const std::map<std::int64_t, std::int32_t>& vertex_global_to_local_indices,
+        std::map<std::int32_t, std::set<unsigned int>>& shared_vertices_local,
+        MPI::NonblockingExchange<double>& coordinate_exchange,
+        std::vector<std::vector<std::size_t>>& vertex_location);
+
+    // Complete the transfer of vertex coordinates started by
+    // distribute_vertices, storing them by local vertex index
+    static void receive_vertex_coordinates(
+      MPI::NonblockingExchange<double>& coordinate_exchange,
+      const std::vector<std::vector<std::size_t>>& vertex_location,
+      const std::map<std::int64_t, std::int32_t>& vertex_global_to_local_indices,
+      const int gdim,
+      boost::multi_array<double, 2>& vertex_coordinates);
 
     // Compute the local->global and global->local maps for all local vertices
     // on this process, from the global vertex indices on each local cell.
@@ -196,15 +283,14 @@ namespace dolfin
     // Build mesh
     static void build_local_mesh(Mesh& mesh,
       const std::vector<std::int64_t>& global_cell_indices,
-      const boost::multi_array<std::int64_t, 2>& cell_global_vertices,
+      const boost::multi_array<std::int32_t, 2>& cell_local_vertices,
       const CellType::Type cell_type,
       const int tdim,
       const std::int64_t num_global_cells,
       const std::vector<std::int64_t>& vertex_indices,
       const boost::multi_array<double, 2>& vertex_coordinates,
       const int gdim,
-      const std::int64_t num_global_vertices,
-      const std::map<std::int64_t, std::int32_t>& vertex_global_to_local_indices);
+      const std::int64_t num_global_vertices);
 
     // Create and attach distributed MeshDomains from local_data
     static void build_mesh_domains(Mesh& mesh, const LocalMeshData& local_data);
@@ -229,6 +315,63 @@ namespace dolfin
     build_mesh_value_collection(mesh, local_values, values);
   }
   //---------------------------------------------------------------------------
+  template<typename T>
+  void MeshPartitioning::migrate(const MeshFunction<T>& f0, MeshFunction<T>& f1)
+  {
+    // Values are sent as doubles or 64-bit integers
+    typedef typename std::conditional<std::is_floating_point<T>::value,
+                                      double, std::int64_t>::type value_type;
+
+    dolfin_assert(f0.mesh());
+    dolfin_assert(f1.mesh());
+    const Mesh& mesh0 = *f0.mesh();
+    const Mesh& mesh1 = *f1.mesh();
+    const std::size_t D = mesh0.topology().dim();
+    const std::size_t dim = f0.dim();
+    if (f1.dim() != dim || mesh1.topology().dim() != D)
+    {
+      dolfin_error("MeshPartitioning.h",
+                   "migrate MeshFunction",
+                   "MeshFunction dimensions do not match");
+    }
+
+    // Pack the values of the entities of each regular cell, in
+    // cell-local order
+    const std::size_t width = (dim == D) ? 1 : mesh0.type().num_entities(dim);
+    mesh0.init(D, dim);
+    const std::size_t num_cells0 = mesh0.topology().ghost_offset(D);
+    std::vector<value_type> data0(num_cells0*width);
+    for (std::size_t c = 0; c < num_cells0; ++c)
+    {
+      if (dim == D)
+        data0[c] = f0[c];
+      else
+      {
+        const unsigned int* entities = mesh0.topology()(D, dim)(c);
+        for (std::size_t i = 0; i < width; ++i)
+          data0[c*width + i] = f0[entities[i]];
+      }
+    }
+
+    // Send to the new owners of the cells
+    const std::vector<value_type> data1
+      = DistributedMeshTools::migrate_cell_data(mesh0, data0, width, mesh1);
+
+    // Unpack
+    mesh1.init(D, dim);
+    for (std::size_t c = 0; c < mesh1.num_cells(); ++c)
+    {
+      if (dim == D)
+        f1.set_value(c, static_cast<T>(data1[c]));
+      else
+      {
+        const unsigned int* entities = mesh1.topology()(D, dim)(c);
+        for (std::size_t i = 0; i < width; ++i)
+          f1.set_value(entities[i], static_cast<T>(data1[c*width + i]));
+      }
+    }
+  }
+  //---------------------------------------------------------------------------
   template<typename T, typename MeshValueCollection>
   void MeshPartitioning::build_mesh_value_collection(const Mesh& mesh,
     const std::vector<std::pair<std::pair<std::size_t, std::size_t>, T>>& local_value_data,
@@ -270,6 +413,10 @@ namespace dolfin
     // Get global indices on local process
     const auto& global_entity_indices = mesh.topology().global_indices(D);
 
+    // Values to add to the domain marker, set in bulk at the end
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>, T>> values;
+    values.reserve(ldata.size());
+
     // Add local (to this process) data to domain marker
     std::vector<std::size_t> off_process_global_cell_entities;
 
@@ -291,7 +438,7 @@ namespace dolfin
         const std::size_t local_cell_index = data->second;
         const std::size_t entity_local_index = ldata[i].first.second;
         const T value = ldata[i].second;
-        markers.set_value(local_cell_index, entity_local_index, value);
+        values.push_back({{local_cell_index, entity_local_index}, value});
 
         // If shared with other processes, add to off process list
         if (sharing_map.find(local_cell_index) != sharing_map.end())
@@ -370,9 +517,10 @@ namespace dolfin
       const std::size_t local_entity_index = received_data0[2*i + 1];
       const T value = received_data1[i];
       dolfin_assert(local_cell_entity < mesh.num_cells());
-      markers.set_value(local_cell_entity, local_entity_index, value);
+      values.push_back({{local_cell_entity, local_entity_index}, value});
     }
 
+    markers.set_values(std::move(values));
   }
   //---------------------------------------------------------------------------
 
@@ -20,26 +20,161 @@
 
 #include "MeshQuality.h"
 #include "Cell.h"
+#include "CellType.h"
+#include "EntityRange.h"
 #include "Mesh.h"
 #include "MeshFunction.h"
 #include "Vertex.h"
 #include <dolfin/common/MPI.h>
+#include <dolfin/common/threads.h>
+#include <dolfin/parameter/GlobalParameters.h>
+#include <limits>
 #include <sstream>
 
 using namespace dolfin;
 
+namespace
+{
+  // Convert name of quality measure to CellType::Quality
+  CellType::Quality quality_measure(std::string measure)
+  {
+    if (measure == "volume")
+      return CellType::Quality::volume;
+    else if (measure == "circumradius")
+      return CellType::Quality::circumradius;
+    else if (measure == "inradius")
+      return CellType::Quality::inradius;
+    else if (measure == "radius_ratio")
+      return CellType::Quality::radius_ratio;
+    else if (measure == "edge_ratio")
+      return CellType::Quality::edge_ratio;
+    else if (measure == "min_angle")
+      return CellType::Quality::min_angle;
+
+    dolfin_error("MeshQuality.cpp",
+                 "compute cell quality",
+                 "Unknown quality measure \"%s\"", measure.c_str());
+    return CellType::Quality::volume;
+  }
+  //---------------------------------------------------------------------------
+  // Compute quality measure for the (regular) cells of the mesh. The
+  // vertex coordinates of blocks of cells are gathered and passed to
+  // CellType::quality, with blocks shared between threads.
+  std::vector<double> compute_cell_quality(const Mesh& mesh,
+                                           std::string measure)
+  {
+    const CellType::Quality m = quality_measure(measure);
+    const CellType& cell_type = mesh.type();
+    const std::size_t gdim = mesh.geometry().dim();
+    const std::size_t num_vertices = cell_type.num_vertices();
+
+    // Check that the measure is defined for the cell type, outside
+    // the threads
+    cell_type.quality(nullptr, 0, gdim, m, nullptr);
+
+    const EntityRange cells(mesh, mesh.topology().dim());
+    const MeshConnectivity& cell_vertices = cells.connectivity(0);
+    const std::size_t num_cells = cells.size();
+    std::vector<double> q(num_cells);
+
+    const std::size_t block_size = 64;
+    const std::size_t num_blocks = (num_cells + block_size - 1)/block_size;
+    const std::size_t num_threads = (int) parameters["num_threads"];
+    parallel_for(num_threads, num_blocks,
+                 [&](std::size_t thread, std::size_t b0, std::size_t b1)
+                 {
+                   std::vector<double> x(num_vertices*gdim*block_size);
+                   for (std::size_t b = b0; b < b1; ++b)
+                   {
+                     const std::size_t c0 = b*block_size;
+                     const std::size_t n = std::min(block_size, num_cells - c0);
+                     for (std::size_t c = 0; c < n; ++c)
+                     {
+                       const unsigned int* v = cell_vertices(c0 + c);
+                       for (std::size_t i = 0; i < num_vertices; ++i)
+                       {
+                         const double* xv = cells.x(v[i]);
+                         for (std::size_t j = 0; j < gdim; ++j)
+                           x[(i*gdim + j)*n + c] = xv[j];
+                       }
+                     }
+                     cell_type.quality(x.data(), n, gdim, m, q.data() + c0);
+                   }
+                 });
+
+    return q;
+  }
+  //---------------------------------------------------------------------------
+  // Compute minimum and maximum of values (across all processes)
+  std::pair<double, double> min_max(MPI_Comm mpi_comm,
+                                    const std::vector<double>& q)
+  {
+    const std::size_t num_threads = (int) parameters["num_threads"];
+    std::vector<double> qmin(num_threads, std::numeric_limits<double>::max());
+    std::vector<double> qmax(num_threads, -std::numeric_limits<double>::max());
+    parallel_for(num_threads, q.size(),
+                 [&](std::size_t thread, std::size_t begin, std::size_t end)
+                 {
+                   for (std::size_t i = begin; i < end; ++i)
+                   {
+                     qmin[thread] = std::min(qmin[thread], q[i]);
+                     qmax[thread] = std::max(qmax[thread], q[i]);
+                   }
+                 });
+
+    return {dolfin::MPI::min(mpi_comm, *std::min_element(qmin.begin(), qmin.end())),
+            dolfin::MPI::max(mpi_comm, *std::max_element(qmax.begin(), qmax.end()))};
+  }
+  //---------------------------------------------------------------------------
+  // Compute (bin centre, number of values) histogram data for values
+  // in [qmin, qmax] (summed across all processes)
+  std::pair<std::vector<double>, std::vector<double>>
+  histogram(MPI_Comm mpi_comm, const std::vector<double>& q,
+            double qmin, double qmax, std::size_t num_bins)
+  {
+    std::vector<double> bins(num_bins);
+    const double interval = (qmax - qmin)/static_cast<double>(num_bins);
+    for (std::size_t i = 0; i < num_bins; ++i)
+      bins[i] = qmin + static_cast<double>(i)*interval + interval/2.0;
+
+    // Count values for each thread, and handle special case that
+    // value = qmax
+    const std::size_t num_threads = (int) parameters["num_threads"];
+    std::vector<std::vector<double>>
+      counts(num_threads, std::vector<double>(num_bins, 0.0));
+    parallel_for(num_threads, q.size(),
+                 [&](std::size_t thread, std::size_t begin, std::size_t end)
+                 {
+                   std::vector<double>& c = counts[thread];
+                   for (std::size_t i = begin; i < end; ++i)
+                   {
+                     const double s = (interval > 0.0)
+                       ? (q[i] - qmin)/interval : 0.0;
+                     const std::size_t slot = (s > 0.0)
+                       ? std::min(static_cast<std::size_t>(s), num_bins - 1) : 0;
+                     c[slot] += 1.0;
+                   }
+                 });
+
+    std::vector<double> values(num_bins, 0.0);
+    for (const auto& c : counts)
+      for (std::size_t i = 0; i < num_bins; ++i)
+        values[i] += c[i];
+
+    // Sum over processes in one reduction
+    #ifdef HAS_MPI
+    values = dolfin::MPI::all_reduce(mpi_comm, values, MPI_SUM);
+    #endif
+
+    return {bins, values};
+  }
+}
+
 //-----------------------------------------------------------------------------
 dolfin::MeshFunction<double>
 MeshQuality::radius_ratios(std::shared_ptr<const Mesh> mesh)
 {
-  // Create MeshFunction
-  MeshFunction<double> cf(mesh, mesh->topology().dim(), 0.0);
-
-  // Compute radius ration
-  for (CellIterator cell(*mesh); !cell.end(); ++cell)
-    cf[*cell] = cell->radius_ratio();
-
-  return cf;
+  return cell_quality(mesh, "radius_ratio");
 }
 //-----------------------------------------------------------------------------
 dolfin::MeshFunction<double>
@@ -67,49 +202,15 @@ MeshQuality::aspect_ratio_gamma(std::shared_ptr<const Mesh> mesh)
 //-----------------------------------------------------------------------------
 std::pair<double, double> MeshQuality::radius_ratio_min_max(const Mesh& mesh)
 {
-  CellIterator cell(mesh);
-  double qmin = cell->radius_ratio();
-  double qmax = cell->radius_ratio();
-  for (; !cell.end(); ++cell)
-  {
-    qmin = std::min(qmin, cell->radius_ratio());
-    qmax = std::max(qmax, cell->radius_ratio());
-  }
-
-  qmin = MPI::min(mesh.mpi_comm(), qmin);
-  qmax = MPI::max(mesh.mpi_comm(), qmax);
-  return {qmin, qmax};
+  return cell_quality_min_max(mesh, "radius_ratio");
 }
 //-----------------------------------------------------------------------------
 std::pair<std::vector<double>, std::vector<double>>
 MeshQuality::radius_ratio_histogram_data(const Mesh& mesh, std::size_t num_bins)
 {
-  std::vector<double> bins(num_bins), values(num_bins, 0.0);
-  dolfin_assert(radius_ratio_min_max(mesh).second <= 1.0);
-
-  const double interval = 1.0 / static_cast<double>(num_bins);
-  for (std::size_t i = 0; i < num_bins; ++i)
-    bins[i] = static_cast<double>(i) * interval + interval / 2.0;
-
-  std::cout << interval << std::endl;
-  std::cout << num_bins << std::endl;
-  std::cout << static_cast<double>(num_bins) << std::endl;
-
-  for (CellIterator cell(mesh); !cell.end(); ++cell)
-  {
-    const double ratio = cell->radius_ratio();
-
-    // Compute 'bin' index, and handle special case that ratio = 1.0
-    const std::size_t slot
-        = std::min(static_cast<std::size_t>(ratio / interval), num_bins - 1);
-
-    values[slot] += 1.0;
-  }
-
-  for (std::size_t i = 0; i < values.size(); ++i)
-    values[i] = MPI::sum(mesh.mpi_comm(), values[i]);
-
-  return {bins, values};
+  const std::vector<double> q = compute_cell_quality(mesh, "radius_ratio");
+  dolfin_assert(min_max(mesh.mpi_comm(), q).second <= 1.0);
+  return histogram(mesh.mpi_comm(), q, 0.0, 1.0, num_bins);
 }
 //-----------------------------------------------------------------------------
 std::string
@@ -164,6 +265,36 @@ MeshQuality::radius_ratio_matplotlib_histogram(const Mesh& mesh,
   return matplotlib.str();
 }
 //-----------------------------------------------------------------------------
+MeshFunction<double>
+MeshQuality::cell_quality(std::shared_ptr<const Mesh> mesh,
+                          std::string measure)
+{
+  dolfin_assert(mesh);
+  const std::vector<double> q = compute_cell_quality(*mesh, measure);
+
+  // Create MeshFunction, with values for the regular cells
+  MeshFunction<double> cf(mesh, mesh->topology().dim(), 0.0);
+  std::copy(q.begin(), q.end(), cf.values());
+
+  return cf;
+}
+//-----------------------------------------------------------------------------
+std::pair<double, double>
+MeshQuality::cell_quality_min_max(const Mesh& mesh, std::string measure)
+{
+  return min_max(mesh.mpi_comm(), compute_cell_quality(mesh, measure));
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<double>, std::vector<double>>
+MeshQuality::cell_quality_histogram_data(const Mesh& mesh,
+                                         std::string measure,
+                                         std::size_t num_bins)
+{
+  const std::vector<double> q = compute_cell_quality(mesh, measure);
+  const std::pair<double, double> range = min_max(mesh.mpi_comm(), q);
+  return histogram(mesh.mpi_comm(), q, range.first, range.second, num_bins);
+}
+//-----------------------------------------------------------------------------
 void MeshQuality::dihedral_angles(const Cell& cell,
                                   std::vector<double>& dh_angle)
 {
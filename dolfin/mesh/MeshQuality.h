@@ -89,6 +89,37 @@ namespace dolfin
       radius_ratio_matplotlib_histogram(const Mesh& mesh,
 					std::size_t num_intervals = 50);
 
+    /// Compute a quality measure for all cells. The cells are
+    /// processed in blocks by the batched CellType::quality kernels,
+    /// using parameters["num_threads"] threads.
+    /// @param mesh (std::shared_ptr<const Mesh>)
+    /// @param measure (std::string)
+    ///         One of "volume", "circumradius", "inradius",
+    ///         "radius_ratio", "edge_ratio" (longest over shortest
+    ///         edge) and "min_angle" (see CellType::quality).
+    /// @return MeshFunction<double>
+    static MeshFunction<double>
+      cell_quality(std::shared_ptr<const Mesh> mesh, std::string measure);
+
+    /// Compute the minimum and maximum of a quality measure of cells
+    /// (across all processes)
+    /// @param mesh (const Mesh&)
+    /// @param measure (std::string)
+    /// @return std::pair<double, double>
+    static std::pair<double, double>
+      cell_quality_min_max(const Mesh& mesh, std::string measure);
+
+    /// Create (value, number of cells) data for creating a histogram
+    /// of a quality measure of cells, with bins evenly spaced between
+    /// the minimum and maximum value (across all processes)
+    /// @param mesh (const Mesh&)
+    /// @param measure (std::string)
+    /// @param num_bins (std::size_t)
+    /// @return std::pair<std::vector<double>, std::vector<double>>
+    static std::pair<std::vector<double>, std::vector<double>>
+      cell_quality_histogram_data(const Mesh& mesh, std::string measure,
+                                  std::size_t num_bins = 50);
+
     /// Get internal dihedral angles of a tetrahedral cell
     static void dihedral_angles(const Cell& cell, std::vector<double>& dh_angle);
 
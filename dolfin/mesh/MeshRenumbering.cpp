@@ -21,12 +21,18 @@
 // Last changed: 2014-02-06
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <vector>
 
 #include <dolfin/log/log.h>
+#include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/utils.h>
+#include <dolfin/geometry/SpaceFillingCurve.h>
 #include "Cell.h"
+#include "DistributedMeshTools.h"
 #include "Mesh.h"
 #include "MeshEditor.h"
 #include "MeshTopology.h"
@@ -35,6 +41,78 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Compute new index of each entity by sorting the entities in
+  // [0, num_regular) and the ghost entities [num_regular, n)
+  // separately by key
+  std::vector<std::size_t> sort_by_key(const std::vector<std::uint64_t>& keys,
+                                       std::size_t num_regular)
+  {
+    std::vector<std::size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto less = [&keys](std::size_t a, std::size_t b)
+      { return keys[a] < keys[b] || (keys[a] == keys[b] && a < b); };
+    num_regular = std::min(num_regular, keys.size());
+    std::sort(order.begin(), order.begin() + num_regular, less);
+    std::sort(order.begin() + num_regular, order.end(), less);
+
+    std::vector<std::size_t> new_index(keys.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+      new_index[order[i]] = i;
+    return new_index;
+  }
+
+  // Move blocks of values to their new position
+  template<typename T>
+  void permute(std::vector<T>& values,
+               const std::vector<std::size_t>& new_index,
+               std::size_t block_size=1)
+  {
+    dolfin_assert(values.size() == new_index.size()*block_size);
+    const std::vector<T> old_values(values);
+    for (std::size_t i = 0; i < new_index.size(); ++i)
+    {
+      std::copy(old_values.begin() + i*block_size,
+                old_values.begin() + (i + 1)*block_size,
+                values.begin() + new_index[i]*block_size);
+    }
+  }
+
+  // Renumber the keys of a map from entity index
+  template<typename Map>
+  void permute_keys(Map& map, const std::vector<std::size_t>& new_index)
+  {
+    Map new_map;
+    for (auto& entry : map)
+      new_map.insert(new_map.end(),
+                     std::make_pair(new_index[entry.first], entry.second));
+    std::swap(map, new_map);
+  }
+
+  // Compute the sorted vertices of each entity of dimension d
+  // (numbering vertices by new_vertex if not empty)
+  std::vector<std::vector<unsigned int>>
+  entity_vertices(const MeshTopology& topology, std::size_t d,
+                  const std::vector<std::size_t>& new_vertex)
+  {
+    const MeshConnectivity& connectivity = topology(d, 0);
+    std::vector<std::vector<unsigned int>> vertices(topology.size(d));
+    for (std::size_t e = 0; e < vertices.size(); ++e)
+    {
+      const unsigned int* v = connectivity(e);
+      vertices[e].assign(v, v + connectivity.size(e));
+      if (!new_vertex.empty())
+      {
+        for (auto& vertex : vertices[e])
+          vertex = new_vertex[vertex];
+      }
+      std::sort(vertices[e].begin(), vertices[e].end());
+    }
+    return vertices;
+  }
+}
+
 //-----------------------------------------------------------------------------
 dolfin::Mesh MeshRenumbering::renumber_by_color(const Mesh& mesh,
                                  const std::vector<std::size_t> coloring_type)
@@ -266,3 +344,225 @@ void MeshRenumbering::compute_renumbering(const Mesh& mesh,
   }
 }
 //-----------------------------------------------------------------------------
+std::vector<std::vector<std::size_t>>
+MeshRenumbering::renumber_by_locality(Mesh& mesh, std::string curve)
+{
+  // Start timer
+  Timer timer("Renumber mesh by locality");
+
+  // Check arguments
+  if (curve != "hilbert" && curve != "morton")
+  {
+    dolfin_error("MeshRenumbering.cpp",
+                 "renumber mesh by locality",
+                 "Unknown space-filling curve \"%s\" (use \"hilbert\" or \"morton\")",
+                 curve.c_str());
+  }
+  if (mesh.geometry().degree() != 1)
+  {
+    dolfin_error("MeshRenumbering.cpp",
+                 "renumber mesh by locality",
+                 "Only meshes with affine geometry (degree 1) are supported");
+  }
+  if (mesh.topology().dim() == 0)
+  {
+    dolfin_error("MeshRenumbering.cpp",
+                 "renumber mesh by locality",
+                 "Mesh has topological dimension zero");
+  }
+  if (!mesh.topology().mapping().empty())
+  {
+    dolfin_error("MeshRenumbering.cpp",
+                 "renumber mesh by locality",
+                 "Mesh has views which would be invalidated by renumbering");
+  }
+
+  MeshTopology& topology = mesh._topology;
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
+  const std::size_t tdim = topology.dim();
+  const std::size_t gdim = mesh.geometry().dim();
+  const std::size_t num_vertices = mesh.num_vertices();
+  const std::size_t num_cells = mesh.num_cells();
+  std::vector<std::vector<std::size_t>> new_indices(tdim + 1);
+
+  // Record entities, global numberings and connectivity which must
+  // be recomputed. Numbering entities is collective, so processes
+  // must agree.
+  std::vector<bool> has_entities(tdim + 1, false);
+  std::vector<bool> has_global_indices(tdim + 1, false);
+  for (std::size_t d = 1; d < tdim; ++d)
+  {
+    has_entities[d]
+      = MPI::max(mpi_comm, (std::size_t) (topology.size(d) > 0)) > 0;
+    has_global_indices[d]
+      = MPI::max(mpi_comm, (std::size_t) topology.have_global_indices(d)) > 0;
+  }
+  const bool has_facet_cell_connections
+    = tdim > 0 && MPI::max(mpi_comm,
+              (std::size_t) topology(tdim - 1, tdim).has_global_size()) > 0;
+  std::vector<std::pair<std::size_t, std::size_t>> connectivity;
+  for (std::size_t d0 = 0; d0 <= tdim; ++d0)
+  {
+    for (std::size_t d1 = 0; d1 <= tdim; ++d1)
+    {
+      if (!(d0 == tdim && d1 == 0) && !topology(d0, d1).empty())
+        connectivity.push_back({d0, d1});
+    }
+  }
+
+  // Compute new vertex numbering from vertex coordinates
+  std::vector<double>& x = mesh.geometry().x();
+  dolfin_assert(x.size() == num_vertices*gdim);
+  std::vector<double> xmin(gdim, std::numeric_limits<double>::max());
+  std::vector<double> xmax(gdim, std::numeric_limits<double>::lowest());
+  for (std::size_t i = 0; i < x.size(); ++i)
+  {
+    xmin[i % gdim] = std::min(xmin[i % gdim], x[i]);
+    xmax[i % gdim] = std::max(xmax[i % gdim], x[i]);
+  }
+  const SpaceFillingCurve key(xmin, xmax, curve);
+  std::vector<std::uint64_t> keys(num_vertices);
+  for (std::size_t v = 0; v < num_vertices; ++v)
+    keys[v] = key(x.data() + v*gdim);
+  new_indices[0] = sort_by_key(keys, topology.ghost_offset(0));
+  const std::vector<std::size_t>& new_vertex = new_indices[0];
+
+  // Compute new cell numbering from cell midpoints
+  const MeshConnectivity& cell_vertices = topology(tdim, 0);
+  keys.resize(num_cells);
+  std::vector<double> midpoint(gdim);
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    std::fill(midpoint.begin(), midpoint.end(), 0.0);
+    const unsigned int* v = cell_vertices(c);
+    const std::size_t num_cell_vertices = cell_vertices.size(c);
+    for (std::size_t i = 0; i < num_cell_vertices; ++i)
+      for (std::size_t j = 0; j < gdim; ++j)
+        midpoint[j] += x[v[i]*gdim + j]/num_cell_vertices;
+    keys[c] = key(midpoint.data());
+  }
+  new_indices[tdim] = sort_by_key(keys, topology.ghost_offset(tdim));
+  const std::vector<std::size_t>& new_cell = new_indices[tdim];
+
+  // Store sorted (renumbered) vertices of the entities of other
+  // dimensions, to match them after recomputing the entities
+  std::vector<std::vector<std::vector<unsigned int>>> old_entities(tdim + 1);
+  for (std::size_t d = 1; d < tdim; ++d)
+  {
+    if (topology.size(d) > 0)
+      old_entities[d] = entity_vertices(topology, d, new_vertex);
+  }
+
+  // Renumber coordinates
+  permute(x, new_vertex, gdim);
+
+  // Renumber cell-vertex connectivity
+  std::vector<unsigned int> offsets(num_cells + 1, 0);
+  for (std::size_t c = 0; c < num_cells; ++c)
+    offsets[new_cell[c] + 1] = cell_vertices.size(c);
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<unsigned int> connections(offsets.back());
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    const unsigned int* v = cell_vertices(c);
+    for (std::size_t i = 0; i < cell_vertices.size(c); ++i)
+      connections[offsets[new_cell[c]] + i] = new_vertex[v[i]];
+  }
+  topology(tdim, 0).set(std::move(connections), std::move(offsets));
+
+  // Renumber global indices, shared entities and ghost cell owners
+  for (std::size_t d : {(std::size_t) 0, tdim})
+  {
+    if (topology.have_global_indices(d))
+      permute(topology._global_indices[d], new_indices[d]);
+    if (topology.have_shared_entities(d))
+      permute_keys(topology.shared_entities(d), new_indices[d]);
+  }
+  std::vector<unsigned int>& cell_owner = topology.cell_owner();
+  if (!cell_owner.empty())
+  {
+    const std::size_t ghost_offset = topology.ghost_offset(tdim);
+    dolfin_assert(ghost_offset + cell_owner.size() == num_cells);
+    const std::vector<unsigned int> old_cell_owner(cell_owner);
+    for (std::size_t i = 0; i < old_cell_owner.size(); ++i)
+      cell_owner[new_cell[ghost_offset + i] - ghost_offset] = old_cell_owner[i];
+  }
+
+  // Renumber cell orientations
+  if (mesh._cell_orientations.size() == num_cells)
+    permute(mesh._cell_orientations, new_cell);
+
+  // Remove all other connectivity and entities (recomputed below)
+  for (std::size_t d0 = 0; d0 <= tdim; ++d0)
+  {
+    for (std::size_t d1 = 0; d1 <= tdim; ++d1)
+    {
+      if (!(d0 == tdim && d1 == 0))
+        topology.connectivity[d0][d1] = MeshConnectivity(d0, d1);
+    }
+  }
+  for (std::size_t d = 1; d < tdim; ++d)
+  {
+    topology.num_entities[d] = 0;
+    topology.global_num_entities[d] = 0;
+    topology.ghost_offset_index[d] = 0;
+    topology._global_indices[d].clear();
+    topology._shared_entities.erase(d);
+  }
+  topology.coloring.clear();
+  mesh._tree.reset();
+
+  // Recompute entities and their global numbering
+  for (std::size_t d = 1; d < tdim; ++d)
+  {
+    if (has_entities[d])
+      mesh.init(d);
+    if (has_global_indices[d])
+      DistributedMeshTools::number_entities(mesh, d);
+
+    // Match old entities to recomputed entities
+    if (old_entities[d].empty())
+      continue;
+    std::vector<std::vector<unsigned int>> entities
+      = entity_vertices(topology, d, std::vector<std::size_t>());
+    std::vector<std::size_t> order(entities.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&entities](std::size_t a, std::size_t b)
+              { return entities[a] < entities[b]; });
+
+    new_indices[d].resize(old_entities[d].size());
+    for (std::size_t e = 0; e < old_entities[d].size(); ++e)
+    {
+      auto it = std::lower_bound(order.begin(), order.end(), old_entities[d][e],
+                                 [&entities](std::size_t a,
+                                             const std::vector<unsigned int>& b)
+                                 { return entities[a] < b; });
+      dolfin_assert(it != order.end() && entities[*it] == old_entities[d][e]);
+      new_indices[d][e] = *it;
+    }
+  }
+  if (has_facet_cell_connections)
+    DistributedMeshTools::init_facet_cell_connections(mesh);
+  for (auto& c : connectivity)
+    mesh.init(c.first, c.second);
+
+  // Renumber mesh domain markers and mesh data
+  MeshDomains& domains = mesh.domains();
+  for (std::size_t d = 0; d <= std::min(tdim, domains.max_dim()); ++d)
+  {
+    if (!domains.markers(d).empty() && !new_indices[d].empty())
+      permute_keys(domains.markers(d), new_indices[d]);
+  }
+  MeshData& data = mesh.data();
+  for (std::size_t d = 0; d < std::min(tdim + 1, data._arrays.size()); ++d)
+  {
+    for (auto& array : data._arrays[d])
+    {
+      if (!new_indices[d].empty() && array.second.size() == new_indices[d].size())
+        permute(array.second, new_indices[d]);
+    }
+  }
+
+  return new_indices;
+}
+//-----------------------------------------------------------------------------
@@ -23,7 +23,10 @@
 #ifndef __MESH_RENUMBERING_H
 #define __MESH_RENUMBERING_H
 
+#include <string>
 #include <vector>
+#include <dolfin/log/log.h>
+#include "MeshFunction.h"
 
 namespace dolfin
 {
@@ -51,6 +54,41 @@ namespace dolfin
     static Mesh renumber_by_color(const Mesh& mesh,
                                   std::vector<std::size_t> coloring);
 
+    /// Renumber the cells and vertices of a mesh (in place) along a
+    /// space-filling curve through the cell midpoints and vertex
+    /// coordinates, so that entities which are close in space are
+    /// also close in memory. Owned and ghost entities are renumbered
+    /// separately, so a distributed mesh is renumbered within each
+    /// partition. Global indices are carried along with the
+    /// entities, which keeps the mesh ordered (see MeshOrdering).
+    ///
+    /// The coordinates, global indices, shared entities, ghost cell
+    /// owners, mesh domain markers and mesh data arrays are
+    /// renumbered. Entities and connectivity of other dimensions
+    /// which have been computed are recomputed. Mesh functions
+    /// created before renumbering can be updated using remap().
+    ///
+    /// @param  mesh (Mesh)
+    ///         Mesh to be renumbered (affine geometry only).
+    /// @param  curve (std::string)
+    ///         Space-filling curve ("hilbert" or "morton").
+    /// @return std::vector<std::vector<std::size_t>>
+    ///         New index of each old entity, for each topological
+    ///         dimension (empty if entities had not been computed).
+    static std::vector<std::vector<std::size_t>>
+      renumber_by_locality(Mesh& mesh, std::string curve="hilbert");
+
+    /// Renumber the values of a mesh function which was created
+    /// before the mesh was renumbered.
+    ///
+    /// @param  f (MeshFunction<T>)
+    ///         Mesh function to be renumbered.
+    /// @param  new_indices (std::vector<std::vector<std::size_t>>)
+    ///         Renumbering returned by renumber_by_locality().
+    template<typename T>
+    static void remap(MeshFunction<T>& f,
+                      const std::vector<std::vector<std::size_t>>& new_indices);
+
   private:
 
     static void compute_renumbering(const Mesh& mesh,
@@ -61,6 +99,33 @@ namespace dolfin
 
   };
 
+  //---------------------------------------------------------------------------
+  // Implementation of MeshRenumbering
+  //---------------------------------------------------------------------------
+  template<typename T>
+  void MeshRenumbering::remap(MeshFunction<T>& f,
+                   const std::vector<std::vector<std::size_t>>& new_indices)
+  {
+    if (f.dim() >= new_indices.size()
+        || new_indices[f.dim()].size() != f.size())
+    {
+      dolfin_error("MeshRenumbering.h",
+                   "remap mesh function",
+                   "Renumbering does not match mesh function of dimension %d",
+                   f.dim());
+    }
+
+    // Permute values, keeping a compressed function compressed
+    const std::vector<std::size_t>& new_index = new_indices[f.dim()];
+    std::vector<T> values;
+    f.get_values(values);
+    std::vector<T> new_values(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+      new_values[new_index[i]] = values[i];
+    f.set_values(new_values);
+  }
+  //---------------------------------------------------------------------------
+
 }
 
 #endif
@@ -18,6 +18,7 @@
 // First added:  2006-05-08
 // Last changed: 2014-07-02
 
+#include <algorithm>
 #include <numeric>
 #include <sstream>
 #include <dolfin/log/log.h>
@@ -29,7 +30,8 @@
 using namespace dolfin;
 
 //-----------------------------------------------------------------------------
-MeshTopology::MeshTopology() : Variable("topology", "mesh topology")
+MeshTopology::MeshTopology() : Variable("topology", "mesh topology"),
+  _memory_budget(0), _access_counter(0)
 {
   // Do nothing
 }
@@ -43,9 +45,13 @@ MeshTopology::MeshTopology(const MeshTopology& topology)
     global_num_entities(topology.global_num_entities),
     _global_indices(topology._global_indices),
     _shared_entities(topology._shared_entities),
-    connectivity(topology.connectivity)
+    connectivity(topology.connectivity),
+    _memory_budget(topology._memory_budget),
+    _last_access(topology._last_access.size()),
+    _access_counter(topology._access_counter.load())
 {
-  // Do nothing
+  for (std::size_t i = 0; i < _last_access.size(); ++i)
+    _last_access[i] = topology._last_access[i].load();
 }
 //-----------------------------------------------------------------------------
 MeshTopology::~MeshTopology()
@@ -67,6 +73,12 @@ MeshTopology& MeshTopology::operator= (const MeshTopology& topology)
   _shared_entities = topology._shared_entities;
   connectivity = topology.connectivity;
   _cell_owner = topology._cell_owner;
+  _memory_budget = topology._memory_budget;
+  _last_access
+    = std::vector<std::atomic<std::uint64_t>>(topology._last_access.size());
+  for (std::size_t i = 0; i < _last_access.size(); ++i)
+    _last_access[i] = topology._last_access[i].load();
+  _access_counter = topology._access_counter.load();
 
   return *this;
 }
@@ -114,6 +126,7 @@ void MeshTopology::clear()
   _global_indices.clear();
   _shared_entities.clear();
   connectivity.clear();
+  _last_access.clear();
 }
 //-----------------------------------------------------------------------------
 void MeshTopology::clear(std::size_t d0, std::size_t d1)
@@ -141,6 +154,10 @@ void MeshTopology::init(std::size_t dim)
   for (std::size_t d0 = 0; d0 <= dim; d0++)
     for (std::size_t d1 = 0; d1 <= dim; d1++)
       connectivity[d0].push_back(MeshConnectivity(d0, d1));
+  _last_access
+    = std::vector<std::atomic<std::uint64_t>>((dim + 1)*(dim + 1));
+  for (auto& a : _last_access)
+    a = 0;
 }
 //-----------------------------------------------------------------------------
 void MeshTopology::init(std::size_t dim, std::size_t local_size,
@@ -207,6 +224,79 @@ const std::map<std::int32_t, std::set<unsigned int>>&
   return e->second;
 }
 //-----------------------------------------------------------------------------
+std::size_t MeshTopology::memory_usage(std::size_t d0, std::size_t d1) const
+{
+  dolfin_assert(d0 < connectivity.size());
+  dolfin_assert(d1 < connectivity[d0].size());
+  return connectivity[d0][d1].memory_usage();
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshTopology::memory_usage() const
+{
+  std::size_t bytes = 0;
+  for (auto& c : connectivity)
+    for (auto& c01 : c)
+      bytes += c01.memory_usage();
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+void MeshTopology::record_access(std::size_t d0, std::size_t d1) const
+{
+  if (_memory_budget == 0)
+    return;
+
+  dolfin_assert(d0 < connectivity.size());
+  dolfin_assert(d1 < connectivity.size());
+  _last_access[d0*connectivity.size() + d1].store(++_access_counter,
+                                                  std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshTopology::enforce_memory_budget()
+{
+  if (_memory_budget == 0)
+    return 0;
+
+  std::size_t bytes = memory_usage();
+  if (bytes <= _memory_budget)
+    return 0;
+
+  // Collect connectivity that can be recomputed, ordered by last
+  // access
+  const std::size_t tdim = dim();
+  std::vector<std::pair<std::uint64_t, std::pair<std::size_t, std::size_t>>>
+    candidates;
+  for (std::size_t i = 0; i <= tdim; ++i)
+  {
+    for (std::size_t j = 1; j <= tdim; ++j)
+    {
+      const MeshConnectivity& c = connectivity[i][j];
+      if (i == tdim or c.empty() or c.has_global_size())
+      {
+        continue;
+      }
+      candidates.push_back({_last_access[i*(tdim + 1) + j].load(), {i, j}});
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  // Evict least recently used connectivity until within budget
+  const std::size_t initial_bytes = bytes;
+  for (auto& candidate : candidates)
+  {
+    if (bytes <= _memory_budget)
+      break;
+
+    const std::size_t i = candidate.second.first;
+    const std::size_t j = candidate.second.second;
+    log(DBG, "Evicting mesh connectivity %d - %d (%d bytes)", i, j,
+        connectivity[i][j].memory_usage());
+    bytes -= connectivity[i][j].memory_usage();
+    connectivity[i][j].clear();
+  }
+
+  return initial_bytes - bytes;
+}
+//-----------------------------------------------------------------------------
 size_t MeshTopology::hash() const
 {
   return (*this)(dim(), 0).hash();
@@ -244,6 +334,19 @@ std::string MeshTopology::str(bool verbose) const
     }
     s << std::endl;
 
+    s << "  Connectivity memory usage (bytes):" << std::endl << std::endl;
+    for (std::size_t d0 = 0; d0 <= _dim; d0++)
+    {
+      s << "    " << d0;
+      for (std::size_t d1 = 0; d1 <= _dim; d1++)
+        s << " " << connectivity[d0][d1].memory_usage();
+      s << std::endl;
+    }
+    s << "    total: " << memory_usage();
+    if (_memory_budget > 0)
+      s << " (budget: " << _memory_budget << ")";
+    s << std::endl << std::endl;
+
     for (std::size_t d0 = 0; d0 <= _dim; d0++)
     {
       for (std::size_t d1 = 0; d1 <= _dim; d1++)
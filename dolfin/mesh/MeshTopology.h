@@ -21,6 +21,7 @@
 #ifndef __MESH_TOPOLOGY_H
 #define __MESH_TOPOLOGY_H
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <utility>
@@ -158,6 +159,42 @@ namespace dolfin
     const dolfin::MeshConnectivity& operator() (std::size_t d0,
                                                 std::size_t d1) const;
 
+    /// Return memory usage (bytes) of connectivity for given pair of
+    /// topological dimensions
+    std::size_t memory_usage(std::size_t d0, std::size_t d1) const;
+
+    /// Return memory usage (bytes) of connectivity for all pairs of
+    /// topological dimensions
+    std::size_t memory_usage() const;
+
+    /// Set memory budget (bytes) for connectivity. Zero (default)
+    /// means no limit. The budget is applied only when
+    /// enforce_memory_budget is called; Mesh::init never evicts
+    /// connectivity.
+    void set_memory_budget(std::size_t bytes)
+    { _memory_budget = bytes; }
+
+    /// Return memory budget (bytes) for connectivity
+    std::size_t memory_budget() const
+    { return _memory_budget; }
+
+    /// Record an access to connectivity d0 - d1 for least recently
+    /// used eviction. Called by Mesh::init; does nothing unless a
+    /// memory budget is set. Safe to call from several threads.
+    void record_access(std::size_t d0, std::size_t d1) const;
+
+    /// Evict connectivity, least recently used first, until memory
+    /// usage is within the budget. Evicted connectivity is
+    /// recomputed on demand by Mesh::init. Entity definitions (d - 0
+    /// and tdim - d) and connectivity with global sizes are never
+    /// evicted. Returns the number of bytes released.
+    ///
+    /// References and iterators to evicted connectivity are
+    /// invalidated, so this must only be called when no such
+    /// references or iterators are in use, e.g. between assembly
+    /// loops, and not while other threads use the mesh.
+    std::size_t enforce_memory_budget();
+
     /// Return hash based on the hash of cell-vertex connectivity
     size_t hash() const;
 
@@ -188,6 +225,7 @@ namespace dolfin
   private:
 
     friend class MeshView;
+    friend class MeshRenumbering;
 
     // Mappings to other Mesh objects, if any
     std::map<unsigned, std::shared_ptr<MeshView>> _mapping;
@@ -217,6 +255,16 @@ namespace dolfin
     // Connectivity for pairs of topological dimensions
     std::vector<std::vector<MeshConnectivity> > connectivity;
 
+    // Memory budget (bytes) for connectivity (zero if unlimited)
+    std::size_t _memory_budget;
+
+    // Access counter at last access of each connectivity (d0*(D + 1)
+    // + d1), used for least recently used eviction. Atomic since
+    // Mesh::init may be called concurrently, e.g. by mesh iterators in
+    // threaded loops.
+    mutable std::vector<std::atomic<std::uint64_t>> _last_access;
+    mutable std::atomic<std::uint64_t> _access_counter;
+
   };
 
 }
@@ -23,9 +23,11 @@
 #ifndef __MESH_VALUE_COLLECTION_H
 #define __MESH_VALUE_COLLECTION_H
 
-#include <map>
+#include <algorithm>
 #include <utility>
 #include <memory>
+#include <vector>
+#include <dolfin/common/FlatMap.h>
 #include <dolfin/common/NoDeleter.h>
 #include <dolfin/common/Variable.h>
 #include <dolfin/log/log.h>
@@ -45,6 +47,11 @@ namespace dolfin
   /// entities through the corresponding cell index and local entity
   /// number (relative to the cell), not by global entity index, which
   /// means that data may be stored robustly to file.
+  ///
+  /// The values are stored in a vector sorted by (cell index, local
+  /// entity) (see FlatMap). Values set in increasing order of cell
+  /// index, or in bulk with set_values, are inserted in constant
+  /// amortized time.
 
   template <typename T>
   class MeshValueCollection : public Variable
@@ -171,6 +178,26 @@ namespace dolfin
     ///         an existing value.
     bool set_value(std::size_t entity_index, const T& value);
 
+    /// Set values in bulk, overwriting existing values. This is much
+    /// faster than calling set_value repeatedly when the values are
+    /// not ordered by cell index.
+    ///
+    /// @param    values (std::vector<std::pair<std::pair<std::size_t, std::size_t>, T>>)
+    ///         List of ((cell index, local entity), value). If an
+    ///         entity appears more than once, the last value is used.
+    void set_values(std::vector<std::pair<std::pair<std::size_t,
+                    std::size_t>, T>> values);
+
+    /// Set values for given entity indices in bulk, overwriting
+    /// existing values (see set_value(entity_index, value))
+    ///
+    /// @param    entity_indices (std::vector<std::size_t>)
+    ///         Indices of the entities.
+    /// @param    values (std::vector<T>)
+    ///         The values of the markers.
+    void set_values(const std::vector<std::size_t>& entity_indices,
+                    const std::vector<T>& values);
+
     /// Get marker value for given entity defined by a cell index and
     /// a local entity index
     ///
@@ -183,17 +210,20 @@ namespace dolfin
     ///         The value of the marker.
     T get_value(std::size_t cell_index, std::size_t local_entity);
 
-    /// Get all values
+    /// Get all values. FlatMap has the same interface as std::map
+    /// for lookup, insertion, removal and iteration in key order,
+    /// and converts to a std::map copy, e.g. std::map<...> m =
+    /// mvc.values().
     ///
-    /// @return    std::map<std::pair<std::size_t, std::size_t>, T>
+    /// @return    FlatMap<std::pair<std::size_t, std::size_t>, T>
     ///         A map from positions to values.
-    std::map<std::pair<std::size_t, std::size_t>, T>& values();
+    FlatMap<std::pair<std::size_t, std::size_t>, T>& values();
 
-    /// Get all values (const version)
+    /// Get all values (const version, see values())
     ///
-    /// @return    std::map<std::pair<std::size_t, std::size_t>, T>
+    /// @return    FlatMap<std::pair<std::size_t, std::size_t>, T>
     ///         A map from positions to values.
-    const std::map<std::pair<std::size_t, std::size_t>, T>& values() const;
+    const FlatMap<std::pair<std::size_t, std::size_t>, T>& values() const;
 
     /// Clear all values
     void clear();
@@ -209,14 +239,18 @@ namespace dolfin
 
   private:
 
+    // Return (cell index, local entity) position of entity
+    std::pair<std::size_t, std::size_t>
+      position(std::size_t entity_index) const;
+
     // Associated mesh
     std::shared_ptr<const Mesh> _mesh;
 
     // Topological dimension
     int _dim;
 
-    // The values
-    std::map<std::pair<std::size_t, std::size_t>, T> _values;
+    // The values, sorted by (cell index, local entity)
+    FlatMap<std::pair<std::size_t, std::size_t>, T> _values;
 
   };
 
@@ -248,48 +282,9 @@ namespace dolfin
   template <typename T>
   MeshValueCollection<T>::MeshValueCollection(const MeshFunction<T>&
                                               mesh_function)
-    : Variable("m", "unnamed MeshValueCollection"), _mesh(mesh_function.mesh()),
-      _dim(mesh_function.dim())
+    : Variable("m", "unnamed MeshValueCollection"), _dim(-1)
   {
-    dolfin_assert(_mesh);
-    const std::size_t D = _mesh->topology().dim();
-
-    // Handle cells as a special case
-    if ((int) D == _dim)
-    {
-      for (std::size_t cell_index = 0; cell_index < mesh_function.size();
-           ++cell_index)
-      {
-        const std::pair<std::size_t, std::size_t> key(cell_index, 0);
-        _values.insert({key, mesh_function[cell_index]});
-      }
-    }
-    else
-    {
-      _mesh->init(_dim, D);
-      const MeshConnectivity& connectivity = _mesh->topology()(_dim, D);
-      dolfin_assert(!connectivity.empty());
-      for (std::size_t entity_index = 0; entity_index < mesh_function.size();
-           ++entity_index)
-      {
-        // Find the cell
-        dolfin_assert(connectivity.size(entity_index) > 0);
-        const MeshEntity entity(*_mesh, _dim, entity_index);
-        for (std::size_t i = 0; i < entity.num_entities(D) ; ++i)
-        {
-          // Create cell
-          const Cell cell(*_mesh, connectivity(entity_index)[i]);
-
-          // Find the local entity index
-          const std::size_t local_entity = cell.index(entity);
-
-          // Insert into map
-          const std::pair<std::size_t, std::size_t> key(cell.index(),
-                                                        local_entity);
-          _values.insert({key, mesh_function[entity_index]});
-        }
-      }
-    }
+    *this = mesh_function;
   }
   //---------------------------------------------------------------------------
   template <typename T>
@@ -313,45 +308,51 @@ namespace dolfin
     dolfin_assert(_mesh);
     const std::size_t D = _mesh->topology().dim();
 
-    // FIXME: Use iterators
-
-    // Handle cells as a special case
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>, T>> values;
     if ((int) D == _dim)
     {
+      // Handle cells as a special case
+      values.reserve(mesh_function.size());
       for (std::size_t cell_index = 0; cell_index < mesh_function.size();
            ++cell_index)
       {
-        const std::pair<std::size_t, std::size_t> key(cell_index, 0);
-        _values.insert({key, mesh_function[cell_index]});
+        values.push_back({{cell_index, 0}, mesh_function[cell_index]});
       }
     }
     else
     {
+      // Get connectivity cell -> entity and entity -> cell
+      _mesh->init(D, _dim);
       _mesh->init(_dim, D);
+      const MeshConnectivity& cell_entities = _mesh->topology()(D, _dim);
       const MeshConnectivity& connectivity = _mesh->topology()(_dim, D);
       dolfin_assert(!connectivity.empty());
+
+      values.reserve(connectivity.size());
       for (std::size_t entity_index = 0; entity_index < mesh_function.size();
            ++entity_index)
       {
-        // Find the cell
         dolfin_assert(connectivity.size(entity_index) > 0);
-        const MeshEntity entity(*_mesh, _dim, entity_index);
-        for (std::size_t i = 0; i < entity.num_entities(D) ; ++i)
+        for (std::size_t i = 0; i < connectivity.size(entity_index); ++i)
         {
-          // Create cell
-          const Cell cell(*_mesh, connectivity(entity_index)[i]);
-
-          // Find the local entity index
-          const std::size_t local_entity = cell.index(entity);
-
-          // Insert into map
-          const std::pair<std::size_t, std::size_t> key(cell.index(),
-                                                        local_entity);
-          _values.insert({key, mesh_function[entity_index]});
+          // Find the local entity index in the cell
+          const std::size_t cell_index = connectivity(entity_index)[i];
+          const unsigned int* entities = cell_entities(cell_index);
+          const std::size_t local_entity
+            = std::find(entities, entities + cell_entities.size(cell_index),
+                        entity_index) - entities;
+          dolfin_assert(local_entity < cell_entities.size(cell_index));
+
+          values.push_back({{cell_index, local_entity},
+                mesh_function[entity_index]});
         }
       }
     }
 
+    // Sort values by cell index
+    _values.clear();
+    _values.update(std::move(values));
+
     return *this;
   }
   //---------------------------------------------------------------------------
@@ -425,8 +426,7 @@ namespace dolfin
     }
 
     const std::pair<std::size_t, std::size_t> pos(cell_index, local_entity);
-    std::pair<typename std::map<std::pair<std::size_t, std::size_t>, T>::iterator, bool>
-      it = _values.insert({pos, value});
+    auto it = _values.insert({pos, value});
 
     // If an item with same key already exists the value has not been
     // set and we need to update it
@@ -449,49 +449,82 @@ namespace dolfin
 
     dolfin_assert(_dim >= 0);
 
-    // Special case when d = D
-    const std::size_t D = _mesh->topology().dim();
-    if (_dim == (int) D)
+    // Add value
+    auto it = _values.insert({position(entity_index), value});
+
+    // If an item with same key already exists the value has not been
+    // set and we need to update it
+    if (!it.second)
+      it.first->second = value;
+
+    return it.second;
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
+  void MeshValueCollection<T>::set_values(
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>, T>> values)
+  {
+    dolfin_assert(_dim >= 0);
+    if (!_mesh)
+    {
+      dolfin_error("MeshValueCollection.h",
+                   "set values",
+                   "A mesh has not been associated with this MeshValueCollection");
+    }
+
+    _values.update(std::move(values));
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
+  void MeshValueCollection<T>::set_values(
+    const std::vector<std::size_t>& entity_indices,
+    const std::vector<T>& values)
+  {
+    dolfin_assert(_dim >= 0);
+    dolfin_assert(entity_indices.size() == values.size());
+    if (!_mesh)
     {
-      // Set local entity index to zero when we mark a cell
-      const std::pair<std::size_t, std::size_t> pos(entity_index, 0);
-      std::pair<typename std::map<std::pair<std::size_t,
-        std::size_t>, T>::iterator, bool> it;
-      it = _values.insert({pos, value});
-
-      // If an item with same key already exists the value has not been
-      // set and we need to update it
-      if (!it.second)
-        it.first->second = value;
-
-      return it.second;
+      dolfin_error("MeshValueCollection.h",
+                   "set values",
+                   "A mesh has not been associated with this MeshValueCollection");
     }
 
-    // Get mesh connectivity d --> D
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>, T>> data;
+    data.reserve(values.size());
+    for (std::size_t i = 0; i < entity_indices.size(); ++i)
+      data.push_back({position(entity_indices[i]), values[i]});
+    _values.update(std::move(data));
+  }
+  //---------------------------------------------------------------------------
+  template <typename T>
+  std::pair<std::size_t, std::size_t>
+  MeshValueCollection<T>::position(std::size_t entity_index) const
+  {
+    // Special case when d = D: set local entity index to zero when
+    // we mark a cell
+    const std::size_t D = _mesh->topology().dim();
+    if (_dim == (int) D)
+      return {entity_index, 0};
+
+    // Get mesh connectivity d --> D and D --> d
+    _mesh->init(D, _dim);
     _mesh->init(_dim, D);
+    const MeshConnectivity& cell_entities = _mesh->topology()(D, _dim);
     const MeshConnectivity& connectivity = _mesh->topology()(_dim, D);
 
     // Find the cell
     dolfin_assert(!connectivity.empty());
     dolfin_assert(connectivity.size(entity_index) > 0);
-    const MeshEntity entity(*_mesh, _dim, entity_index);
-    const Cell cell(*_mesh, connectivity(entity_index)[0]); // choose first
+    const std::size_t cell_index = connectivity(entity_index)[0]; // choose first
 
     // Find the local entity index
-    const std::size_t local_entity = cell.index(entity);
-
-    // Add value
-    const std::pair<std::size_t, std::size_t> pos(cell.index(), local_entity);
-    std::pair<typename std::map<std::pair<std::size_t,
-      std::size_t>, T>::iterator, bool> it;
-    it = _values.insert({pos, value});
-
-    // If an item with same key already exists the value has not been
-    // set and we need to update it
-    if (!it.second)
-      it.first->second = value;
+    const unsigned int* entities = cell_entities(cell_index);
+    const std::size_t local_entity
+      = std::find(entities, entities + cell_entities.size(cell_index),
+                  entity_index) - entities;
+    dolfin_assert(local_entity < cell_entities.size(cell_index));
 
-    return it.second;
+    return {cell_index, local_entity};
   }
   //---------------------------------------------------------------------------
   template <typename T>
@@ -501,9 +534,7 @@ namespace dolfin
     dolfin_assert(_dim >= 0);
 
     const std::pair<std::size_t, std::size_t> pos(cell_index, local_entity);
-    const typename std::map<std::pair<std::size_t,
-      std::size_t>, T>::const_iterator
-      it = _values.find(pos);
+    auto it = _values.find(pos);
 
     if (it == _values.end())
     {
@@ -517,14 +548,14 @@ namespace dolfin
   }
   //---------------------------------------------------------------------------
   template <typename T>
-  std::map<std::pair<std::size_t, std::size_t>, T>&
+  FlatMap<std::pair<std::size_t, std::size_t>, T>&
     MeshValueCollection<T>::values()
   {
     return _values;
   }
   //---------------------------------------------------------------------------
   template <typename T>
-  const std::map<std::pair<std::size_t, std::size_t>, T>&
+  const FlatMap<std::pair<std::size_t, std::size_t>, T>&
   MeshValueCollection<T>::values() const
   {
     return _values;
@@ -15,6 +15,8 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
+#include <unordered_map>
+
 #include "Mesh.h"
 #include "MeshEditor.h"
 #include "MeshFunction.h"
@@ -28,17 +30,18 @@ using namespace dolfin;
 Mesh MeshView::create(const MeshFunction<std::size_t>& marker,
                       std::size_t tag)
 {
-  // Get original Mesh and tdim of marker
-  std::shared_ptr<const Mesh> mesh = marker.mesh();
-  unsigned int tdim = marker.dim();
-
-  // Get indices of marked entities - each of these will represent a Cell in "new_mesh"
-  std::vector<std::size_t> indices;
-  for (std::size_t idx = 0; idx < mesh->num_entities(tdim); ++idx)
-  {
-    if (marker[idx] == tag)
-      indices.push_back(idx);
-  }
+  // Get indices of marked entities - each of these will represent a
+  // Cell in the new Mesh. For a compressed marker only the stored
+  // runs are visited.
+  return create(marker.mesh(), marker.dim(), marker.where_equal(tag));
+}
+//-----------------------------------------------------------------------------
+Mesh MeshView::create(std::shared_ptr<const Mesh> mesh, std::size_t dim,
+                      const std::vector<std::size_t>& entities)
+{
+  dolfin_assert(mesh);
+  const unsigned int tdim = dim;
+  std::vector<std::size_t> indices(entities);
 
   // Create a new Mesh of dimension tdim
   Mesh new_mesh;
@@ -46,10 +49,13 @@ Mesh MeshView::create(const MeshFunction<std::size_t>& marker,
   editor.open(new_mesh, mesh->type().entity_type(tdim), tdim,
               mesh->geometry().dim());
 
-  std::size_t num_cell_vertices = mesh->type().num_vertices(tdim);
+  const std::size_t num_cell_vertices = mesh->type().num_vertices(tdim);
 
-  // Reverse mapping from full Mesh for vertices
-  std::map<std::size_t, std::size_t> vertex_rev_map;
+  // Reverse mapping from full Mesh for vertices. Only the vertices
+  // of the marked entities are stored, so the cost of building the
+  // new Mesh does not depend on the size of the full Mesh.
+  std::unordered_map<std::size_t, std::size_t> vertex_rev_map;
+  vertex_rev_map.reserve(indices.size()*num_cell_vertices);
   // Forward map to full Mesh for vertices
   std::vector<std::size_t> vertex_fwd_map;
 
@@ -60,24 +66,25 @@ Mesh MeshView::create(const MeshFunction<std::size_t>& marker,
   // FIXME: may fail with ghost mesh - assumes no shared cells
   editor.init_cells_global(indices.size(),
                            MPI::sum(mesh->mpi_comm(), indices.size()));
+  mesh->init(tdim);
   const auto& conn_tdim = mesh->topology()(tdim, 0);
 
   // Add cells to new_mesh
-  std::vector<std::size_t> new_cell;
+  std::vector<std::size_t> new_cell(num_cell_vertices);
   for (unsigned int j = 0; j != indices.size(); ++j)
   {
     const std::size_t idx = indices[j];
-    new_cell.clear();
+    dolfin_assert(idx < mesh->num_entities(tdim));
+    const unsigned int* v = conn_tdim(idx);
     for (unsigned int i = 0; i != num_cell_vertices; ++i)
     {
-      const std::size_t main_idx = conn_tdim(idx)[i];
-      auto mapit = vertex_rev_map.insert({main_idx, vertex_num});
+      auto mapit = vertex_rev_map.insert({v[i], vertex_num});
       if (mapit.second)
       {
-        vertex_fwd_map.push_back(main_idx);
+        vertex_fwd_map.push_back(v[i]);
         ++vertex_num;
       }
-      new_cell.push_back(mapit.first->second);
+      new_cell[i] = mapit.first->second;
     }
     editor.add_cell(j, new_cell);
   }
@@ -99,7 +106,7 @@ Mesh MeshView::create(const MeshFunction<std::size_t>& marker,
   std::vector<std::vector<std::size_t>> recv_vertex_numbering(mpi_size);
 
   // Map from global vertices on main mesh to local on new_mesh
-  std::map<std::size_t, std::size_t> main_global_to_new;
+  std::unordered_map<std::size_t, std::size_t> main_global_to_new;
 
   for (unsigned int i = 0; i != vertex_num; ++i)
   {
@@ -134,10 +141,9 @@ Mesh MeshView::create(const MeshFunction<std::size_t>& marker,
   // Send global indices of all unnumbered vertices to owner
   MPI::all_to_all(mesh->mpi_comm(), send_vertex_numbering, recv_vertex_numbering);
 
-  // Create global->local map for *all* shared vertices of main mesh
-  std::map<std::size_t, std::size_t> main_global_to_local;
-  for (auto it : mesh_shared)
-    main_global_to_local.insert({mesh_global[it.first], it.first});
+  // Global->local map for the shared vertices of main mesh, built
+  // only if some received vertex is not yet in new_mesh
+  std::unordered_map<std::size_t, std::size_t> main_global_to_local;
 
   // Search for received vertices which are not already there. This may be because
   // they are not part of a new_mesh cell for this process.
@@ -147,6 +153,13 @@ Mesh MeshView::create(const MeshFunction<std::size_t>& marker,
     {
       if (main_global_to_new.find(q) == main_global_to_new.end())
       {
+        if (main_global_to_local.empty())
+        {
+          main_global_to_local.reserve(mesh_shared.size());
+          for (auto it : mesh_shared)
+            main_global_to_local.insert({mesh_global[it.first], it.first});
+        }
+
         // Not found - shared, but not part of local MeshView, yet.
         // This Vertex may have no locally associated Cell in new_mesh
         auto mgl_find = main_global_to_local.find(q);
@@ -158,15 +171,6 @@ Mesh MeshView::create(const MeshFunction<std::size_t>& marker,
         const auto shared_it = mesh_shared.find(main_idx);
         dolfin_assert(shared_it != mesh_shared.end());
         new_shared.insert({vertex_num, shared_it->second});
-#if 0
-        // DEBUG : Print new shared vertex global index
-        for(auto ii=shared_it->second.begin(); ii!=shared_it->second.end(); ++ii)
-          std::cout << "new_shared - "
-                    << " new mesh index = " << vertex_num
-                    << ", vertex_global_index = " << local_count
-                    << ", main global index = " << q
-                    << ", owned by " << *ii << std::endl;
-#endif
         ++local_count;
         ++vertex_num;
       }
@@ -179,7 +183,7 @@ Mesh MeshView::create(const MeshFunction<std::size_t>& marker,
   editor.init_vertices_global(vertex_fwd_map.size(),
                               MPI::sum(mesh->mpi_comm(), local_count));
   for (unsigned int i = 0; i != vertex_fwd_map.size(); ++i)
-    new_mesh.geometry().set(i, mesh->geometry().point(vertex_fwd_map[i]).coordinates());
+    new_mesh.geometry().set(i, mesh->geometry().x(vertex_fwd_map[i]));
 
   editor.close();
 
@@ -234,7 +238,82 @@ Mesh MeshView::create(const MeshFunction<std::size_t>& marker,
     new_topo.set_global_index(0, i, vertex_global_index[i]);
 
   // Store relationship between meshes
-  new_topo._mapping.insert(std::make_pair(mesh->id(), std::make_shared<MeshView>(mesh, vertex_fwd_map, indices)));
+  new_topo._mapping.insert(std::make_pair(mesh->id(), std::make_shared<MeshView>(mesh, tdim, vertex_fwd_map, indices)));
 
   return new_mesh;
 }
+//-----------------------------------------------------------------------------
+std::shared_ptr<MeshView>
+MeshView::create_view(const MeshFunction<std::size_t>& marker,
+                      std::size_t tag)
+{
+  return create_view(marker.mesh(), marker.dim(), marker.where_equal(tag));
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<MeshView>
+MeshView::create_view(std::shared_ptr<const Mesh> mesh, std::size_t dim,
+                      const std::vector<std::size_t>& entities)
+{
+  dolfin_assert(mesh);
+  mesh->init(dim);
+  const auto& conn = mesh->topology()(dim, 0);
+  const std::size_t num_cell_vertices = mesh->type().num_vertices(dim);
+
+  // Number the vertices of the entities in order of first
+  // appearance
+  std::unordered_map<std::size_t, std::size_t> vertex_rev_map;
+  vertex_rev_map.reserve(entities.size()*num_cell_vertices);
+  std::vector<std::size_t> vertex_map;
+  for (auto idx : entities)
+  {
+    dolfin_assert(idx < mesh->num_entities(dim));
+    const unsigned int* v = conn(idx);
+    for (std::size_t i = 0; i != num_cell_vertices; ++i)
+    {
+      if (vertex_rev_map.insert({v[i], vertex_map.size()}).second)
+        vertex_map.push_back(v[i]);
+    }
+  }
+
+  return std::make_shared<MeshView>(mesh, dim, std::move(vertex_map),
+                                    entities);
+}
+//-----------------------------------------------------------------------------
+const double* MeshView::x(std::size_t i) const
+{
+  dolfin_assert(i < _vertex_map.size());
+  return _mesh->geometry().x(_vertex_map[i]);
+}
+//-----------------------------------------------------------------------------
+const unsigned int* MeshView::parent_cell_vertices(std::size_t i) const
+{
+  dolfin_assert(i < _cell_map.size());
+  return _mesh->topology()(_dim, 0)(_cell_map[i]);
+}
+//-----------------------------------------------------------------------------
+const unsigned int* MeshView::cell_vertices(std::size_t i) const
+{
+  dolfin_assert(i < _cell_map.size());
+  const std::size_t num_cell_vertices = _mesh->type().num_vertices(_dim);
+  if (_cell_vertices.empty() and !_cell_map.empty())
+  {
+    std::unordered_map<std::size_t, unsigned int> vertex_rev_map;
+    vertex_rev_map.reserve(_vertex_map.size());
+    for (std::size_t v = 0; v != _vertex_map.size(); ++v)
+      vertex_rev_map.insert({_vertex_map[v], v});
+
+    _cell_vertices.reserve(_cell_map.size()*num_cell_vertices);
+    for (std::size_t c = 0; c != _cell_map.size(); ++c)
+    {
+      const unsigned int* v = parent_cell_vertices(c);
+      for (std::size_t j = 0; j != num_cell_vertices; ++j)
+      {
+        const auto it = vertex_rev_map.find(v[j]);
+        dolfin_assert(it != vertex_rev_map.end());
+        _cell_vertices.push_back(it->second);
+      }
+    }
+  }
+
+  return _cell_vertices.data() + i*num_cell_vertices;
+}
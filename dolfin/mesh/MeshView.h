@@ -19,6 +19,10 @@
 #ifndef __MESH_VIEW_H
 #define __MESH_VIEW_H
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace dolfin
 {
   // Forward declarations
@@ -32,11 +36,13 @@ namespace dolfin
 
   public:
 
-    /// Constructor
-    MeshView(std::shared_ptr<const Mesh> parent_mesh,
-             std::vector<std::size_t>& vertex_map,
-             std::vector<std::size_t>& cell_map)
-      : _mesh(parent_mesh), _vertex_map(vertex_map), _cell_map(cell_map)
+    /// Constructor, for a mapping of entities of dimension dim of
+    /// parent_mesh
+    MeshView(std::shared_ptr<const Mesh> parent_mesh, std::size_t dim,
+             std::vector<std::size_t> vertex_map,
+             std::vector<std::size_t> cell_map)
+      : _mesh(parent_mesh), _dim(dim), _vertex_map(std::move(vertex_map)),
+        _cell_map(std::move(cell_map))
     {
       // Do nothing
     }
@@ -59,22 +65,84 @@ namespace dolfin
       return _cell_map;
     }
 
+    /// Topological dimension of the cells of the view
+    std::size_t dim() const
+    {
+      return _dim;
+    }
+
+    /// Number of cells of the view
+    std::size_t num_cells() const
+    {
+      return _cell_map.size();
+    }
+
+    /// Number of vertices of the view
+    std::size_t num_vertices() const
+    {
+      return _vertex_map.size();
+    }
+
+    /// Coordinates of vertex i of the view, stored in the geometry of
+    /// the parent mesh
+    const double* x(std::size_t i) const;
+
+    /// Vertices of cell i of the view, numbered and stored in the
+    /// connectivity of the parent mesh
+    const unsigned int* parent_cell_vertices(std::size_t i) const;
+
+    /// Vertices of cell i of the view in the numbering of the view.
+    /// Computed for all cells on first call, which is therefore not
+    /// safe to make from several threads.
+    const unsigned int* cell_vertices(std::size_t i) const;
+
     /// Create a new Mesh based on the Meshfunction marker, where it has a value equal
     /// to tag, setting the MeshViewMapping in MeshTopology accordingly.
     /// FIXME: this could be a free function
     static Mesh create(const MeshFunction<std::size_t>& marker, std::size_t tag);
 
+    /// Create a new Mesh from a list of entities of dimension dim
+    /// of mesh, each of which becomes a cell of the new Mesh, setting
+    /// the MeshViewMapping in MeshTopology accordingly. The cost is
+    /// proportional to the number of entities in the list, not to
+    /// the size of mesh.
+    static Mesh create(std::shared_ptr<const Mesh> mesh, std::size_t dim,
+                       const std::vector<std::size_t>& entities);
+
+    /// Create a view of a list of entities of dimension dim of mesh
+    /// without building a new Mesh. The view holds only vertex_map
+    /// and cell_map and reads coordinates and cell vertices from
+    /// mesh, which must not be modified while the view is in use.
+    /// The cost is proportional to the number of entities in the
+    /// list. The view is local to each process, with no global
+    /// numbering.
+    static std::shared_ptr<MeshView>
+      create_view(std::shared_ptr<const Mesh> mesh, std::size_t dim,
+                  const std::vector<std::size_t>& entities);
+
+    /// Create a view of the entities where marker has a value equal
+    /// to tag, without building a new Mesh (see create_view above)
+    static std::shared_ptr<MeshView>
+      create_view(const MeshFunction<std::size_t>& marker, std::size_t tag);
+
   private:
 
     // The parent mesh which this mapping points to
     std::shared_ptr<const Mesh> _mesh;
 
+    // Topological dimension of the mapped entities of _mesh
+    std::size_t _dim;
+
     // Map to vertices in _mesh
     std::vector<std::size_t> _vertex_map;
 
     // Map to cells in _mesh
     std::vector<std::size_t> _cell_map;
 
+    // Cell-vertex connectivity in the numbering of the view,
+    // computed on demand
+    mutable std::vector<unsigned int> _cell_vertices;
+
   };
 
 }
@@ -18,13 +18,18 @@
 // First added:  2013-01-10
 // Last changed:
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <boost/functional/hash.hpp>
 #include <dolfin/common/Array.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/log/log.h>
 #include "DistributedMeshTools.h"
 #include "Facet.h"
@@ -35,40 +40,69 @@
 
 using namespace dolfin;
 
-// Comparison operator for hashing coordinates. Note that two
-// coordinates are considered equal if equal to within specified
-// tolerance.
+// Spatial hash used for matching mapped slave coordinates with master
+// coordinates. Space is divided into cubic buckets of size h (at
+// least twice the map tolerance), and each bucket is assigned to a
+// process. Coordinates within the tolerance of a point lie in at most
+// two buckets along each axis.
 namespace
 {
-  struct lt_coordinate
+  typedef std::vector<std::int64_t> BucketKey;
+
+  // Hash of bucket key, identical on all processes
+  struct BucketHash
   {
-    lt_coordinate(double tolerance) : TOL(tolerance) {}
+    std::size_t operator() (const BucketKey& key) const
+    {
+      std::uint64_t h = 14695981039346656037ULL;
+      for (std::int64_t k : key)
+      {
+        h ^= (std::uint64_t) k;
+        h *= 1099511628211ULL;
+        h ^= h >> 29;
+      }
+      return h;
+    }
+  };
 
-    bool operator() (const std::vector<double>& x,
-                     const std::vector<double>& y) const
+  // Compute keys of the buckets that contain a point within distance
+  // tol (in each coordinate direction) from x
+  void bucket_keys(const double* x, std::size_t gdim, double h, double tol,
+                   std::vector<BucketKey>& keys)
+  {
+    keys.assign(1, BucketKey());
+    for (std::size_t i = 0; i < gdim; ++i)
     {
-      std::size_t n = std::max(x.size(), y.size());
-      for (std::size_t i = 0; i < n; ++i)
+      const std::int64_t k0 = std::floor((x[i] - tol)/h);
+      const std::int64_t k1 = std::floor((x[i] + tol)/h);
+      const std::size_t num_keys = keys.size();
+      for (std::size_t j = 0; j < num_keys; ++j)
       {
-        double xx = 0.0;
-        double yy = 0.0;
-        if (i < x.size())
-          xx = x[i];
-        if (i < y.size())
-          yy = y[i];
-
-        if (xx < (yy - TOL))
-          return true;
-        else if (xx > (yy + TOL))
-          return false;
+        if (k1 != k0)
+        {
+          keys.push_back(keys[j]);
+          keys.back().push_back(k1);
+        }
+        keys[j].push_back(k0);
       }
-      return false;
     }
+  }
 
-    // Tolerance
-    const double TOL;
+  // Return true if coordinates are equal to within tolerance
+  bool equal_coordinates(const double* x, const double* y, std::size_t gdim,
+                         double tol)
+  {
+    for (std::size_t i = 0; i < gdim; ++i)
+    {
+      if (x[i] < (y[i] - tol) || x[i] > (y[i] + tol))
+        return false;
+    }
+    return true;
+  }
 
-  };
+  // Maximum number of (SubDomain, dimension) entries of periodic
+  // pairs cached on a mesh
+  const std::size_t max_cached_pairs = 16;
 }
 
 //-----------------------------------------------------------------------------
@@ -80,33 +114,42 @@ std::map<unsigned int, std::pair<unsigned int, unsigned int>>
   // MPI communication
   const MPI_Comm mpi_comm = mesh.mpi_comm();
 
+  // Entities of dimension dim must exist before the cache is
+  // checked, since their numbering is part of the key
+  mesh.init(dim);
+
+  // Return pairs cached on the mesh if neither the mesh geometry nor
+  // the cell and entity numbering have changed since they were
+  // computed (on any process)
+  const std::pair<std::size_t, std::size_t> key(sub_domain.id(), dim);
+  std::size_t base_hash = mesh.geometry().hash();
+  boost::hash_combine(base_hash, mesh.topology().hash());
+  auto entity_hash = [&mesh, base_hash](std::size_t d)
+    {
+      std::size_t hash = base_hash;
+      boost::hash_combine(hash, mesh.topology()(d, 0).hash());
+      return hash;
+    };
+  const std::size_t mesh_hash = entity_hash(dim);
+  auto cached = mesh._periodic_pairs.find(key);
+  const bool valid = (cached != mesh._periodic_pairs.end()
+                      && cached->second.first == mesh_hash);
+  if (MPI::min(mpi_comm, valid ? 1 : 0) == 1)
+    return cached->second.second;
+
+  Timer timer("Compute periodic pairs");
+
   // Get geometric and topological dimensions
   const std::size_t gdim = mesh.geometry().dim();
   const std::size_t tdim = mesh.topology().dim();
-
-  // Arrays used for mapping coordinates
-  std::vector<double> x(gdim);
-  std::vector<double> y(gdim);
-
-  // Wrap x and y (Array view of x and y)
-  Array<double> _x(gdim, x.data());
-  Array<double> _y(gdim, y.data());
-
-  std::vector<std::size_t> slave_entities;
-  std::vector<std::vector<double>> slave_mapped_coords;
-
-  // Min/max coordinates of facet midpoints [min_x, max_x]. Used to
-  // build bounding box of all master entity midpoints on this process
-  std::vector<double> x_min_max;
-
-  // Map from master entity midpoint coordinate to local facet index
-  std::map<std::vector<double>, unsigned int, lt_coordinate>
-    master_coord_to_entity_index((lt_coordinate(sub_domain.map_tolerance)));
+  const double tol = sub_domain.map_tolerance;
 
   // Initialise facet-cell connectivity
   mesh.init(tdim - 1, tdim);
-  mesh.init(dim);
 
+  // Collect entities on the boundary and their midpoints
+  std::vector<unsigned int> boundary_entities;
+  std::vector<double> midpoints;
   std::vector<bool> visited(mesh.num_entities(dim), false);
   for (FacetIterator f(mesh); !f.end(); ++f)
   {
@@ -122,161 +165,244 @@ std::map<unsigned int, std::pair<unsigned int, unsigned int>>
         else
           visited[e->index()] = true;
 
-        // Copy entity coordinate
         const Point midpoint = e->midpoint();
-        std::copy(midpoint.coordinates(), midpoint.coordinates() + gdim,
-                  x.begin());
-
-        // Check if entity lies on a 'master' or 'slave' boundary
-        if (sub_domain.inside(_x, true))
-        {
-          // Build bounding box data for master entity midpoints
-          if (x_min_max.empty())
-          {
-            x_min_max = x;
-            x_min_max.insert(x_min_max.end(), x.begin(), x.end());
-          }
-
-          for (std::size_t i = 0; i < gdim; ++i)
-          {
-            x_min_max[i]        = std::min(x_min_max[i], x[i]);
-            x_min_max[gdim + i] = std::max(x_min_max[gdim + i], x[i]);
-          }
+        boundary_entities.push_back(e->index());
+        midpoints.insert(midpoints.end(), midpoint.coordinates(),
+                         midpoint.coordinates() + gdim);
+      }
+    }
+  }
 
-          // Insert (midpoint coordinates, local index) into map
-          master_coord_to_entity_index.insert({x, e->index()});
-        }
-        else
-        {
-          // Let's check the user is going to map all coordinates
-          for (size_t i = 0; i < y.size(); i++)
-          {
-            y[i] = std::numeric_limits<double>::quiet_NaN();
-          }
+  // Check which entities lie on the 'master' boundary
+  typedef Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+    PointArray;
+  typedef Eigen::Array<bool, Eigen::Dynamic, 1> MaskArray;
+  const std::size_t num_boundary_entities = boundary_entities.size();
+  MaskArray is_master(num_boundary_entities);
+  sub_domain.inside(Eigen::Map<const PointArray>(midpoints.data(),
+                                                 num_boundary_entities, gdim),
+                    true, is_master);
+
+  // Map other entities, and check if the mapped midpoint lies on the
+  // 'master' boundary
+  std::vector<double> x(gdim);
+  std::vector<double> y(gdim);
+  Array<double> _x(gdim, x.data());
+  Array<double> _y(gdim, y.data());
+  std::vector<unsigned int> master_entities, candidate_entities;
+  std::vector<double> master_coords, candidate_mapped_coords;
+  for (std::size_t i = 0; i < num_boundary_entities; ++i)
+  {
+    const double* midpoint = midpoints.data() + i*gdim;
+    if (is_master[i])
+    {
+      master_entities.push_back(boundary_entities[i]);
+      master_coords.insert(master_coords.end(), midpoint, midpoint + gdim);
+      continue;
+    }
 
-          // Get mapped midpoint (y) of slave entity
-          sub_domain.map(_x, _y);
+    // Let's check the user is going to map all coordinates
+    std::copy(midpoint, midpoint + gdim, x.begin());
+    std::fill(y.begin(), y.end(), std::numeric_limits<double>::quiet_NaN());
 
-          // Check for NaNs after the map
-          for (size_t i = 0; i < y.size(); i++)
-          {
-            if (std::isnan(y[i]))
-            {
-              dolfin_error("PeriodicBoundaryComputation.cpp",
-                           "periodic boundary mapping",
-                           "Need to set coordinate %d in sub_domain.map", i);
-            }
-          }
+    // Get mapped midpoint (y) of slave entity
+    sub_domain.map(_x, _y);
 
-          // Check if entity lies on a 'slave' boundary
-          if (sub_domain.inside(_y, true))
-          {
-            // Store slave local index and midpoint coordinates
-            slave_entities.push_back(e->index());
-            slave_mapped_coords.push_back(y);
-          }
-        }
+    // Check for NaNs after the map
+    for (std::size_t j = 0; j < gdim; ++j)
+    {
+      if (std::isnan(y[j]))
+      {
+        dolfin_error("PeriodicBoundaryComputation.cpp",
+                     "periodic boundary mapping",
+                     "Need to set coordinate %d in sub_domain.map", j);
       }
     }
+
+    candidate_entities.push_back(boundary_entities[i]);
+    candidate_mapped_coords.insert(candidate_mapped_coords.end(),
+                                   y.begin(), y.end());
   }
 
-  // Communicate bounding boxes for master entities
-  std::vector<std::vector<double>> bounding_boxes;
-  MPI::all_gather(mpi_comm, x_min_max, bounding_boxes);
+  MaskArray is_slave(candidate_entities.size());
+  sub_domain.inside(Eigen::Map<const PointArray>(candidate_mapped_coords.data(),
+                                                 candidate_entities.size(),
+                                                 gdim),
+                    true, is_slave);
+  std::vector<unsigned int> slave_entities;
+  std::vector<double> slave_mapped_coords;
+  for (std::size_t i = 0; i < candidate_entities.size(); ++i)
+  {
+    if (is_slave[i])
+    {
+      slave_entities.push_back(candidate_entities[i]);
+      slave_mapped_coords.insert(slave_mapped_coords.end(),
+                                 candidate_mapped_coords.begin() + i*gdim,
+                                 candidate_mapped_coords.begin() + (i + 1)*gdim);
+    }
+  }
 
-  // Number of MPI processes
-  std::size_t num_processes = MPI::size(mpi_comm);
+  // Bucket size, the same on all processes. Buckets are not made
+  // smaller than a fraction of the domain size, so that the keys
+  // stay small for tiny tolerances.
+  double x_max = 0.0;
+  for (double c : master_coords)
+    x_max = std::max(x_max, std::abs(c));
+  for (double c : slave_mapped_coords)
+    x_max = std::max(x_max, std::abs(c));
+  x_max = MPI::max(mpi_comm, x_max);
+  double h = std::max(2.0*tol, 1.0e-6*x_max);
+  if (h == 0.0)
+    h = 1.0;
+
+  // Send master midpoints to the owner of their bucket
+  const std::size_t num_processes = MPI::size(mpi_comm);
+  BucketHash bucket_hash;
+  std::vector<BucketKey> keys;
+  std::vector<std::vector<double>> master_coords_send(num_processes);
+  std::vector<std::vector<unsigned int>> master_entities_send(num_processes);
+  for (std::size_t i = 0; i < master_entities.size(); ++i)
+  {
+    const double* xm = master_coords.data() + i*gdim;
+    bucket_keys(xm, gdim, h, 0.0, keys);
+    dolfin_assert(keys.size() == 1);
+    const std::size_t p = bucket_hash(keys[0]) % num_processes;
+    master_coords_send[p].insert(master_coords_send[p].end(), xm, xm + gdim);
+    master_entities_send[p].push_back(master_entities[i]);
+  }
 
-  // Build send buffer of mapped slave midpoint coordinate to
-  // processes that may own the master entity
-  std::vector<std::vector<double>> slave_mapped_coords_send(num_processes);
+  // Send mapped slave midpoints to the owners of all buckets that
+  // may contain the master
+  std::vector<std::vector<double>> slave_coords_send(num_processes);
   std::vector<std::vector<unsigned int>> sent_slave_indices(num_processes);
+  std::vector<std::size_t> owners;
   for (std::size_t i = 0; i < slave_entities.size(); ++i)
   {
-    for (std::size_t p = 0; p < num_processes; ++p)
+    const double* ys = slave_mapped_coords.data() + i*gdim;
+    bucket_keys(ys, gdim, h, tol, keys);
+    owners.clear();
+    for (const BucketKey& k : keys)
+      owners.push_back(bucket_hash(k) % num_processes);
+    std::sort(owners.begin(), owners.end());
+    owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+    for (std::size_t p : owners)
     {
-      // Slave mapped coordinates from process p
-      std::vector<double>& slave_mapped_coords_send_p
-        = slave_mapped_coords_send[p];
-
-      // Check if mapped slave falls within master entity bounding box
-      // on process p
-      if (in_bounding_box(slave_mapped_coords[i], bounding_boxes[p],
-                          sub_domain.map_tolerance))
-      {
-        sent_slave_indices[p].push_back(slave_entities[i]);
-        slave_mapped_coords_send_p.insert(slave_mapped_coords_send_p.end(),
-                                          slave_mapped_coords[i].begin(),
-                                          slave_mapped_coords[i].end());
-      }
+      slave_coords_send[p].insert(slave_coords_send[p].end(), ys, ys + gdim);
+      sent_slave_indices[p].push_back(slave_entities[i]);
+    }
+  }
+
+  std::vector<std::vector<double>> master_coords_recv, slave_coords_recv;
+  std::vector<std::vector<unsigned int>> master_entities_recv;
+  MPI::all_to_all(mpi_comm, master_coords_send, master_coords_recv);
+  MPI::all_to_all(mpi_comm, master_entities_send, master_entities_recv);
+  MPI::all_to_all(mpi_comm, slave_coords_send, slave_coords_recv);
+
+  // Build spatial hash of received master midpoints, as (process,
+  // position in received data). Entries in a bucket are ordered by
+  // process.
+  std::unordered_map<BucketKey, std::vector<std::pair<unsigned int,
+                                                      std::size_t>>,
+                     BucketHash> buckets;
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    const std::vector<double>& coords_p = master_coords_recv[p];
+    for (std::size_t i = 0; i < master_entities_recv[p].size(); ++i)
+    {
+      bucket_keys(coords_p.data() + i*gdim, gdim, h, 0.0, keys);
+      buckets[keys[0]].push_back({p, i});
     }
   }
 
-  // Send slave midpoints to possible owners of corresponding master
-  // entity
-  std::vector<std::vector<double>> slave_mapped_coords_recv;
-  MPI::all_to_all(mpi_comm,  slave_mapped_coords_send,
-                  slave_mapped_coords_recv);
-  dolfin_assert(slave_mapped_coords_recv.size() == num_processes);
-
-  // Check if this process owns the master facet for a received (mapped)
-  // slave
-  std::vector<double> coordinates(gdim);
-  std::vector<std::vector<unsigned int>> master_local_entity(num_processes);
+  // Find master for each received slave midpoint and return (process,
+  // local index) of the master, or std::numeric_limits<unsigned
+  // int>::max() if not found. If a master entity is shared, the
+  // lowest process is chosen.
+  const unsigned int not_found = std::numeric_limits<unsigned int>::max();
+  std::vector<std::vector<unsigned int>> masters_send(num_processes);
   for (std::size_t p = 0; p < num_processes; ++p)
   {
-    const std::vector<double>& slave_mapped_coords_p
-      = slave_mapped_coords_recv[p];
-    for (std::size_t i = 0; i < slave_mapped_coords_p.size(); i += gdim)
+    const std::vector<double>& coords_p = slave_coords_recv[p];
+    for (std::size_t i = 0; i < coords_p.size(); i += gdim)
     {
-      // Unpack received mapped slave midpoint coordinate
-      std::copy(&slave_mapped_coords_p[i],
-                &slave_mapped_coords_p[i] + gdim, coordinates.begin());
-
-      // Check is this process has a master entity that is paired with
-      // a received slave entity
-      std::map<std::vector<double>, unsigned int>::const_iterator
-        it = master_coord_to_entity_index.find(coordinates);
-
-      // If this process owns the master, insert master entity index,
-      // else insert std::numeric_limits<unsigned int>::max()
-      if (it !=  master_coord_to_entity_index.end())
-        master_local_entity[p].push_back(it->second);
-      else
-        master_local_entity[p].push_back(std::numeric_limits<unsigned int>::max());
+      std::pair<unsigned int, unsigned int> master(not_found, not_found);
+      bucket_keys(coords_p.data() + i, gdim, h, tol, keys);
+      for (const BucketKey& k : keys)
+      {
+        auto bucket = buckets.find(k);
+        if (bucket == buckets.end())
+          continue;
+        for (const auto& m : bucket->second)
+        {
+          if (m.first >= master.first)
+            break;
+          const double* xm = master_coords_recv[m.first].data() + m.second*gdim;
+          if (equal_coordinates(xm, coords_p.data() + i, gdim, tol))
+          {
+            master.first = m.first;
+            master.second = master_entities_recv[m.first][m.second];
+            break;
+          }
+        }
+      }
+      masters_send[p].push_back(master.first);
+      masters_send[p].push_back(master.second);
     }
   }
 
-  // Send local index of master entity back to owner of slave entity
-  std::vector<std::vector<unsigned int>> master_entity_local_index_recv;
-  MPI::all_to_all(mpi_comm, master_local_entity,
-                  master_entity_local_index_recv);
+  // Send masters back to owner of slave entity
+  std::vector<std::vector<unsigned int>> masters_recv;
+  MPI::all_to_all(mpi_comm, masters_send, masters_recv);
 
-  // Build map from slave facets on this process to master facet (local
-  // facet index, process owner)
+  // Build map from slave entities on this process to master entity
+  // (process owner, local index). A slave sent to several processes
+  // is paired with the master on the lowest process.
   std::map<unsigned int, std::pair<unsigned int, unsigned int>>
     slave_to_master_entity;
-  std::size_t num_local_slave_entities = 0;
   for (std::size_t p = 0; p < num_processes; ++p)
   {
-    const std::vector<unsigned int> master_entity_index_p
-      = master_entity_local_index_recv[p];
-    const std::vector<unsigned int> sent_slaves_p = sent_slave_indices[p];
-    dolfin_assert(master_entity_index_p.size() == sent_slaves_p.size());
-
-    for (std::size_t i = 0; i < master_entity_index_p.size(); ++i)
+    const std::vector<unsigned int>& masters_p = masters_recv[p];
+    const std::vector<unsigned int>& sent_slaves_p = sent_slave_indices[p];
+    dolfin_assert(masters_p.size() == 2*sent_slaves_p.size());
+    for (std::size_t i = 0; i < sent_slaves_p.size(); ++i)
     {
-      if (master_entity_index_p[i] < std::numeric_limits<unsigned int>::max())
-      {
-        ++num_local_slave_entities;
-        slave_to_master_entity.insert({sent_slaves_p[i], {p, master_entity_index_p[i]}});
-      }
+      if (masters_p[2*i] == not_found)
+        continue;
+
+      const std::pair<unsigned int, unsigned int>
+        master(masters_p[2*i], masters_p[2*i + 1]);
+      auto slave = slave_to_master_entity.insert({sent_slaves_p[i], master});
+      if (!slave.second && master.first < slave.first->second.first)
+        slave.first->second = master;
     }
   }
 
+  // Cache pairs on mesh. Entries computed for an earlier geometry or
+  // numbering are dropped, and so are the entries of the oldest
+  // SubDomains (ids increase with creation) when the cache is full,
+  // since SubDomains created in a loop would otherwise grow it
+  // without bound
+  auto& cache = mesh._periodic_pairs;
+  for (auto it = cache.begin(); it != cache.end(); )
+  {
+    if (it->second.first != entity_hash(it->first.second))
+      it = cache.erase(it);
+    else
+      ++it;
+  }
+  cache.erase(key);
+  while (cache.size() >= max_cached_pairs)
+    cache.erase(cache.begin());
+  cache[key] = {mesh_hash, slave_to_master_entity};
+
   return slave_to_master_entity;
 }
 //-----------------------------------------------------------------------------
+void PeriodicBoundaryComputation::clear_cache(const Mesh& mesh)
+{
+  mesh._periodic_pairs.clear();
+}
+//-----------------------------------------------------------------------------
 MeshFunction<std::size_t>
 PeriodicBoundaryComputation::masters_slaves(std::shared_ptr<const Mesh> mesh,
                                             const SubDomain& sub_domain,
@@ -361,25 +487,3 @@ PeriodicBoundaryComputation::masters_slaves(std::shared_ptr<const Mesh> mesh,
   return mf;
 }
 //-----------------------------------------------------------------------------
-bool
-PeriodicBoundaryComputation::in_bounding_box(const std::vector<double>& point,
-                                       const std::vector<double>& bounding_box,
-                                       const double tol)
-{
-  // Return false if bounding box is empty
-  if (bounding_box.empty())
-    return false;
-
-  const std::size_t gdim = point.size();
-  dolfin_assert(bounding_box.size() == 2*gdim);
-  for (std::size_t i = 0; i < gdim; ++i)
-  {
-    if (!(point[i] >= (bounding_box[i] - tol)
-          && point[i] <= (bounding_box[gdim + i] + tol)))
-    {
-      return false;
-    }
-  }
-  return true;
-}
-//-----------------------------------------------------------------------------
@@ -43,6 +43,14 @@ namespace dolfin
     /// on this process (local index) to its master entity (owning
     /// process, local index on owner). If a master entity is shared
     /// by processes, only one of the owning processes is returned.
+    ///
+    /// Master and mapped slave midpoints are matched by a spatial
+    /// hash, with each bucket of the hash assigned to one process, so
+    /// the matching is local and linear in the number of entities.
+    /// The pairs are cached on the mesh and reused in later calls for
+    /// the same SubDomain object (see SubDomain::id) and dimension,
+    /// unless the mesh coordinates, cells or entity numbering have
+    /// changed. This function is collective.
     static std::map<unsigned int, std::pair<unsigned int, unsigned int> >
       compute_periodic_pairs(const Mesh& mesh, const SubDomain& sub_domain,
                              const std::size_t dim);
@@ -60,12 +68,10 @@ namespace dolfin
       masters_slaves(std::shared_ptr<const Mesh> mesh,
                      const SubDomain& sub_domain, const std::size_t dim);
 
-  private:
-
-    // Return true is point lies within bounding box
-    static bool in_bounding_box(const std::vector<double>& point,
-                                const std::vector<double>& bounding_box,
-                                const double tol);
+    /// Clear the periodic pairs cached on a mesh by
+    /// compute_periodic_pairs. This is needed if a SubDomain is
+    /// modified after it has been used to compute periodic pairs.
+    static void clear_cache(const Mesh& mesh);
 
   };
 
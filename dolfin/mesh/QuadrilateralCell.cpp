@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <Eigen/Dense>
 #include <dolfin/log/log.h>
 #include <dolfin/common/constants.h>
@@ -169,6 +170,110 @@ double QuadrilateralCell::circumradius(const MeshEntity& cell) const
   return 0.0;
 }
 //-----------------------------------------------------------------------------
+namespace
+{
+  // Quality measure for a block of quadrilaterals in R^GDIM (see
+  // CellType::quality)
+  template<std::size_t GDIM>
+  void quadrilateral_quality(const double* x, std::size_t num_cells,
+                             CellType::Quality measure, double* q)
+  {
+    // Edges, and the two neighbours of each vertex
+    static const std::size_t edges[4][2] = {{0, 1}, {0, 2}, {1, 3}, {2, 3}};
+    static const std::size_t corners[4][2] = {{1, 2}, {0, 3}, {0, 3}, {1, 2}};
+
+    // Coordinate j of vertex i of cell c is x[(i*GDIM + j)*n + c]
+    const std::size_t n = num_cells;
+    for (std::size_t c = 0; c < n; ++c)
+    {
+      double v[4][GDIM];
+      for (std::size_t i = 0; i < 4; ++i)
+        for (std::size_t j = 0; j < GDIM; ++j)
+          v[i][j] = x[(i*GDIM + j)*n + c];
+
+      switch (measure)
+      {
+      case CellType::Quality::volume:
+      {
+        // Area, as in QuadrilateralCell::volume
+        double u[3] = {0.0, 0.0, 0.0}, w[3] = {0.0, 0.0, 0.0};
+        for (std::size_t j = 0; j < GDIM; ++j)
+        {
+          u[j] = v[0][j] - v[3][j];
+          w[j] = v[1][j] - v[2][j];
+        }
+        const double n0 = u[1]*w[2] - u[2]*w[1];
+        const double n1 = u[2]*w[0] - u[0]*w[2];
+        const double n2 = u[0]*w[1] - u[1]*w[0];
+        q[c] = 0.5*std::sqrt(n0*n0 + n1*n1 + n2*n2);
+        break;
+      }
+      case CellType::Quality::edge_ratio:
+      {
+        double l2_min = std::numeric_limits<double>::max(), l2_max = 0.0;
+        for (std::size_t e = 0; e < 4; ++e)
+        {
+          double l2 = 0.0;
+          for (std::size_t j = 0; j < GDIM; ++j)
+          {
+            const double d = v[edges[e][1]][j] - v[edges[e][0]][j];
+            l2 += d*d;
+          }
+          l2_min = std::min(l2_min, l2);
+          l2_max = std::max(l2_max, l2);
+        }
+        q[c] = std::sqrt(l2_max/l2_min);
+        break;
+      }
+      default:
+      {
+        // Minimum interior angle
+        double cos_max = -1.0;
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+          double ab = 0.0, aa = 0.0, bb = 0.0;
+          for (std::size_t j = 0; j < GDIM; ++j)
+          {
+            const double a = v[corners[i][0]][j] - v[i][j];
+            const double b = v[corners[i][1]][j] - v[i][j];
+            ab += a*b;
+            aa += a*a;
+            bb += b*b;
+          }
+          const double d = std::sqrt(aa*bb);
+          cos_max = std::max(cos_max, (d == 0.0) ? 1.0 : ab/d);
+        }
+        q[c] = std::acos(std::min(1.0, cos_max));
+      }
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void QuadrilateralCell::quality(const double* x, std::size_t num_cells,
+                                std::size_t gdim, Quality measure,
+                                double* q) const
+{
+  if (measure != Quality::volume && measure != Quality::edge_ratio
+      && measure != Quality::min_angle)
+  {
+    dolfin_error("QuadrilateralCell.cpp",
+                 "compute quality of quadrilateral cells",
+                 "Only volume, edge ratio and minimum angle are defined for quadrilaterals");
+  }
+
+  if (gdim == 2)
+    quadrilateral_quality<2>(x, num_cells, measure, q);
+  else if (gdim == 3)
+    quadrilateral_quality<3>(x, num_cells, measure, q);
+  else
+  {
+    dolfin_error("QuadrilateralCell.cpp",
+                 "compute quality of quadrilateral cells",
+                 "Only know how to compute quality in R^2 or R^3");
+  }
+}
+//-----------------------------------------------------------------------------
 double QuadrilateralCell::squared_distance(const Cell& cell,
                                            const Point& point) const
 {
@@ -20,16 +20,16 @@
 // First added:  2007-04-24
 // Last changed: 2011-08-31
 
+#include <exception>
 #include <dolfin/common/Array.h>
-#include <dolfin/common/RangedIndexSet.h>
+#include <dolfin/common/UniqueIdGenerator.h>
+#include <dolfin/common/threads.h>
 #include <dolfin/log/log.h>
-#include <dolfin/log/Progress.h>
+#include <dolfin/parameter/GlobalParameters.h>
+#include "EntityRange.h"
 #include "Mesh.h"
+#include "MeshConnectivity.h"
 #include "MeshData.h"
-#include "MeshEntity.h"
-#include "MeshEntityIterator.h"
-#include "Facet.h"
-#include "Vertex.h"
 #include "MeshFunction.h"
 #include "MeshValueCollection.h"
 #include "SubDomain.h"
@@ -38,7 +38,8 @@ using namespace dolfin;
 
 //-----------------------------------------------------------------------------
 SubDomain::SubDomain(const double map_tol) : map_tolerance(map_tol),
-                                             _geometric_dimension(0)
+                                             _geometric_dimension(0),
+                                             _unique_id(UniqueIdGenerator::id())
 {
   // Do nothing
 }
@@ -62,6 +63,43 @@ bool SubDomain::inside(Eigen::Ref<const Eigen::VectorXd> x, bool on_boundary) co
   return false;
 }
 //-----------------------------------------------------------------------------
+void SubDomain::inside(Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic,
+                       Eigen::Dynamic, Eigen::RowMajor>> x,
+                       bool on_boundary,
+                       Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, 1>> values) const
+{
+  dolfin_assert(values.size() == x.rows());
+  const std::size_t gdim = x.cols();
+
+  // Check points in contiguous chunks, one chunk per thread.
+  // Exceptions are passed on from the threads.
+  const std::size_t num_threads = (int) parameters["num_threads"];
+  std::vector<std::exception_ptr> errors(num_threads);
+  parallel_for(num_threads, x.rows(),
+               [&](std::size_t thread, std::size_t begin, std::size_t end)
+               {
+                 try
+                 {
+                   for (std::size_t i = begin; i < end; ++i)
+                   {
+                     const Array<double>
+                       _x(gdim, const_cast<double*>(x.data() + i*x.outerStride()));
+                     values[i] = inside(_x, on_boundary);
+                   }
+                 }
+                 catch (...)
+                 {
+                   errors[thread] = std::current_exception();
+                 }
+               });
+
+  for (auto& error : errors)
+  {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+//-----------------------------------------------------------------------------
 void SubDomain::map(const Array<double>& x, Array<double>& y) const
 {
   Eigen::Map<const Eigen::VectorXd> _x(x.data(), x.size());
@@ -188,207 +226,233 @@ std::size_t SubDomain::geometric_dimension() const
   return _geometric_dimension;
 }
 //-----------------------------------------------------------------------------
-template<typename S, typename T>
-void SubDomain::apply_markers(S& sub_domains,
-                              T sub_domain,
-                              const Mesh& mesh,
-                              bool check_midpoint) const
+std::vector<std::size_t>
+SubDomain::compute_marked_entities(const Mesh& mesh, std::size_t dim,
+                                   bool check_midpoint) const
 {
-  log(TRACE, "Computing sub domain markers for sub domain %d.", sub_domain);
-
-  // Get the dimension of the entities we are marking
-  const std::size_t dim = sub_domains.dim();
-
-  // Compute connectivities for boundary detection, if necessary
+  // Compute connectivities for boundary detection, if necessary, and
+  // entity-vertex connectivity
   const std::size_t D = mesh.topology().dim();
+  mesh.init(dim);
   if (dim < D)
   {
-    mesh.init(dim);
     if (dim != D - 1)
       mesh.init(dim, D - 1);
     mesh.init(D - 1, D);
   }
+  if (dim > 0)
+    mesh.init(dim, 0);
 
   // Set geometric dimension (needed for SWIG interface)
   _geometric_dimension = mesh.geometry().dim();
+  const std::size_t gdim = _geometric_dimension;
+  const std::vector<double>& x = mesh.geometry().x();
 
-  // Speed up the computation by only checking each vertex once (or
-  // twice if it is on the boundary for some but not all facets).
-  RangedIndexSet boundary_visited(mesh.num_vertices());
-  RangedIndexSet interior_visited(mesh.num_vertices());
-  std::vector<bool> boundary_inside(mesh.num_vertices());
-  std::vector<bool> interior_inside(mesh.num_vertices());
+  typedef Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+    PointArray;
+  typedef Eigen::Array<bool, Eigen::Dynamic, 1> MaskArray;
 
-  // Always false when marking cells
-  bool on_boundary = false;
+  // Entities to check
+  const EntityRange entities(mesh, dim);
+  const std::size_t num_entities = entities.size();
 
-  // Compute sub domain markers
-  Progress p("Computing sub domain markers", mesh.num_entities(dim));
-  for (MeshEntityIterator entity(mesh, dim); !entity.end(); ++entity)
+  // Check if entities are on the boundary: facets with one cell, or
+  // (if entity is of topological dimension less than D - 1) entities
+  // with any connected facet on the boundary. Always false when
+  // marking cells.
+  std::vector<char> on_boundary(num_entities, 0);
+  if (dim < D)
   {
-    // Check if entity is on the boundary if entity is a facet
+    const MeshConnectivity& facet_cells = mesh.topology()(D - 1, D);
     if (dim == D - 1)
-      on_boundary = (entity->num_global_entities(D) == 1);
-    // Or, if entity is of topological dimension less than D - 1, check if any connected
-    // facet is on the boundary
-    else if (dim < D - 1)
     {
-      on_boundary = false;
-      for (std::size_t f(0); f < entity->num_entities(D - 1); ++f)
+      for (std::size_t e : entities)
+        on_boundary[e] = (facet_cells.size_global(e) == 1);
+    }
+    else
+    {
+      const MeshConnectivity& entity_facets = mesh.topology()(dim, D - 1);
+      for (std::size_t e : entities)
       {
-        std::size_t facet_id = entity->entities(D - 1)[f];
-        Facet facet(mesh, facet_id);
-        if (facet.num_global_entities(D) == 1)
+        const unsigned int* facets = entity_facets(e);
+        for (std::size_t i = 0; i < entity_facets.size(e); ++i)
         {
-          on_boundary = true;
-          break;
+          if (facet_cells.size_global(facets[i]) == 1)
+          {
+            on_boundary[e] = 1;
+            break;
+          }
         }
       }
     }
+  }
 
-    // Select the visited-cache to use for this entity
-    RangedIndexSet&    is_visited = (on_boundary ? boundary_visited : interior_visited);
-    std::vector<bool>& is_inside  = (on_boundary ? boundary_inside  : interior_inside);
+  // Evaluate inside() for a list of points, with points on and off
+  // the boundary in separate calls
+  auto check_points = [this, gdim](const std::vector<double>& points,
+                                   const std::vector<char>& points_on_boundary,
+                                   std::vector<char>& points_inside)
+    {
+      const std::size_t num_points = points_on_boundary.size();
+      points_inside.assign(num_points, 0);
+      for (char b = 0; b < 2; ++b)
+      {
+        std::vector<std::size_t> selected;
+        for (std::size_t i = 0; i < num_points; ++i)
+          if (points_on_boundary[i] == b)
+            selected.push_back(i);
+        if (selected.empty())
+          continue;
 
-    // Start by assuming all points are inside
-    bool all_points_inside = true;
+        PointArray block(selected.size(), gdim);
+        for (std::size_t i = 0; i < selected.size(); ++i)
+          for (std::size_t j = 0; j < gdim; ++j)
+            block(i, j) = points[selected[i]*gdim + j];
 
-    // Check all incident vertices if dimension is > 0 (not a vertex)
-    if (entity->dim() > 0)
+        MaskArray mask(selected.size());
+        inside(block, b == 1, mask);
+        for (std::size_t i = 0; i < selected.size(); ++i)
+          points_inside[selected[i]] = mask[i];
+      }
+    };
+
+  // Entities with all vertices inside
+  std::vector<std::size_t> candidates;
+  if (dim > 0)
+  {
+    // Each vertex is checked once (or twice if it is on the boundary
+    // for some but not all entities). Collect the vertex-boundary
+    // pairs to check.
+    const MeshConnectivity& entity_vertices = mesh.topology()(dim, 0);
+    const std::size_t num_vertices = mesh.num_vertices();
+    std::vector<char> needed(2*num_vertices, 0);
+    for (std::size_t e : entities)
     {
-      for (VertexIterator vertex(*entity); !vertex.end(); ++vertex)
-      {
-        if (is_visited.insert(vertex->index()))
-        {
-          Array<double> x(_geometric_dimension, const_cast<double*>(vertex->x()));
-          is_inside[vertex->index()] = inside(x, on_boundary);
-        }
+      const unsigned int* v = entity_vertices(e);
+      for (std::size_t i = 0; i < entity_vertices.size(e); ++i)
+        needed[2*v[i] + on_boundary[e]] = 1;
+    }
+
+    std::vector<std::size_t> position(2*num_vertices);
+    std::vector<double> points;
+    std::vector<char> points_on_boundary;
+    for (std::size_t k = 0; k < 2*num_vertices; ++k)
+    {
+      if (!needed[k])
+        continue;
+      const std::size_t v = k/2;
+      position[k] = points_on_boundary.size();
+      points.insert(points.end(), x.begin() + v*gdim,
+                    x.begin() + (v + 1)*gdim);
+      points_on_boundary.push_back(k % 2);
+    }
 
-        if (!is_inside[vertex->index()])
+    std::vector<char> points_inside;
+    check_points(points, points_on_boundary, points_inside);
+
+    for (std::size_t e : entities)
+    {
+      const unsigned int* v = entity_vertices(e);
+      bool all_points_inside = true;
+      for (std::size_t i = 0; i < entity_vertices.size(e); ++i)
+      {
+        if (!points_inside[position[2*v[i] + on_boundary[e]]])
         {
           all_points_inside = false;
           break;
         }
       }
+      if (all_points_inside)
+        candidates.push_back(e);
     }
+  }
+  else
+  {
+    candidates.reserve(num_entities);
+    for (std::size_t e : entities)
+      candidates.push_back(e);
+  }
 
-    // Check midpoint (works also in the case when we have a single vertex)
-    if (all_points_inside && check_midpoint)
+  if (!check_midpoint)
+    return candidates;
+
+  // Check midpoints of the candidates (works also in the case when
+  // we have a single vertex)
+  std::vector<double> midpoints(candidates.size()*gdim, 0.0);
+  std::vector<char> midpoints_on_boundary(candidates.size());
+  for (std::size_t i = 0; i < candidates.size(); ++i)
+  {
+    const std::size_t e = candidates[i];
+    midpoints_on_boundary[i] = on_boundary[e];
+    if (dim == 0)
     {
-      Array<double> x(_geometric_dimension,
-                      const_cast<double*>(entity->midpoint().coordinates()));
-      if (!inside(x, on_boundary))
-        all_points_inside = false;
+      std::copy(x.begin() + e*gdim, x.begin() + (e + 1)*gdim,
+                midpoints.begin() + i*gdim);
+      continue;
     }
 
-    // Mark entity with all vertices inside
-    if (all_points_inside)
-      sub_domains.set_value(entity->index(), sub_domain);
-
-    p++;
+    // Average of vertex coordinates, as in MeshEntity::midpoint
+    const MeshConnectivity& entity_vertices = mesh.topology()(dim, 0);
+    const unsigned int* v = entity_vertices(e);
+    const std::size_t num_entity_vertices = entity_vertices.size(e);
+    for (std::size_t k = 0; k < num_entity_vertices; ++k)
+      for (std::size_t j = 0; j < gdim; ++j)
+        midpoints[i*gdim + j] += x[v[k]*gdim + j];
+    for (std::size_t j = 0; j < gdim; ++j)
+      midpoints[i*gdim + j] /= double(num_entity_vertices);
   }
+
+  std::vector<char> midpoints_inside;
+  check_points(midpoints, midpoints_on_boundary, midpoints_inside);
+
+  std::vector<std::size_t> marked;
+  for (std::size_t i = 0; i < candidates.size(); ++i)
+    if (midpoints_inside[i])
+      marked.push_back(candidates[i]);
+
+  return marked;
 }
 //-----------------------------------------------------------------------------
 template<typename T>
-void SubDomain::apply_markers(std::map<std::size_t, std::size_t>& sub_domains,
-                              std::size_t dim,
+void SubDomain::apply_markers(MeshFunction<T>& sub_domains,
                               T sub_domain,
                               const Mesh& mesh,
                               bool check_midpoint) const
 {
-  // FIXME: This function can probably be folded into the above
-  //        function operator[] in std::map and MeshFunction.
-
   log(TRACE, "Computing sub domain markers for sub domain %d.", sub_domain);
 
-  // Compute connectivities for boundary detection, if necessary
-  const std::size_t D = mesh.topology().dim();
-  if (dim < D)
-  {
-    mesh.init(dim);
-    if (dim != D - 1)
-      mesh.init(dim, D - 1);
-    mesh.init(D - 1, D);
-  }
-
-  // Set geometric dimension (needed for SWIG interface)
-  _geometric_dimension = mesh.geometry().dim();
-
-  // Speed up the computation by only checking each vertex once (or
-  // twice if it is on the boundary for some but not all facets).
-  RangedIndexSet boundary_visited(mesh.num_vertices());
-  RangedIndexSet interior_visited(mesh.num_vertices());
-  std::vector<bool> boundary_inside(mesh.num_vertices());
-  std::vector<bool> interior_inside(mesh.num_vertices());
-
-  // Always false when marking cells
-  bool on_boundary = false;
-
-  // Compute sub domain markers
-  Progress p("Computing sub domain markers", mesh.num_entities(dim));
-  for (MeshEntityIterator entity(mesh, dim); !entity.end(); ++entity)
-  {
-    // Check if entity is on the boundary if entity is a facet
-    if (dim == D - 1)
-      on_boundary = (entity->num_global_entities(D) == 1);
-    // Or, if entity is of topological dimension less than D - 1, check if any connected
-    // facet is on the boundary
-    else if (dim < D - 1)
-    {
-      on_boundary = false;
-      for (std::size_t f(0); f < entity->num_entities(D - 1); ++f)
-      {
-        std::size_t facet_id = entity->entities(D - 1)[f];
-        Facet facet(mesh, facet_id);
-        if (facet.num_global_entities(D) == 1)
-        {
-          on_boundary = true;
-          break;
-        }
-      }
-    }
-
-    // Select the visited-cache to use for this entity
-    RangedIndexSet&    is_visited = (on_boundary ? boundary_visited : interior_visited);
-    std::vector<bool>& is_inside  = (on_boundary ? boundary_inside  : interior_inside);
-
-    // Start by assuming all points are inside
-    bool all_points_inside = true;
-
-    // Check all incident vertices if dimension is > 0 (not a vertex)
-    if (entity->dim() > 0)
-    {
-      for (VertexIterator vertex(*entity); !vertex.end(); ++vertex)
-      {
-        if (is_visited.insert(vertex->index()))
-        {
-          Array<double> x(_geometric_dimension, const_cast<double*>(vertex->x()));
-          is_inside[vertex->index()] = inside(x, on_boundary);
-        }
-
-        if (!is_inside[vertex->index()])
-        {
-          all_points_inside = false;
-          break;
-        }
-      }
-    }
-
-    // Check midpoint (works also in the case when we have a single vertex)
-    if (all_points_inside && check_midpoint)
-    {
-      Array<double> x(_geometric_dimension,
-                      const_cast<double*>(entity->midpoint().coordinates()));
-      if (!inside(x, on_boundary))
-        all_points_inside = false;
-    }
+  const std::vector<std::size_t> marked
+    = compute_marked_entities(mesh, sub_domains.dim(), check_midpoint);
+  for (std::size_t e : marked)
+    sub_domains.set_value(e, sub_domain);
+}
+//-----------------------------------------------------------------------------
+template<typename T>
+void SubDomain::apply_markers(MeshValueCollection<T>& sub_domains,
+                              T sub_domain,
+                              const Mesh& mesh,
+                              bool check_midpoint) const
+{
+  log(TRACE, "Computing sub domain markers for sub domain %d.", sub_domain);
 
-    // Mark entity with all vertices inside
-    if (all_points_inside)
-      sub_domains[entity->index()] =  sub_domain;
+  const std::vector<std::size_t> marked
+    = compute_marked_entities(mesh, sub_domains.dim(), check_midpoint);
+  sub_domains.set_values(marked, std::vector<T>(marked.size(), sub_domain));
+}
+//-----------------------------------------------------------------------------
+template<typename T>
+void SubDomain::apply_markers(std::map<std::size_t, std::size_t>& sub_domains,
+                              std::size_t dim,
+                              T sub_domain,
+                              const Mesh& mesh,
+                              bool check_midpoint) const
+{
+  log(TRACE, "Computing sub domain markers for sub domain %d.", sub_domain);
 
-    p++;
-  }
+  const std::vector<std::size_t> marked
+    = compute_marked_entities(mesh, dim, check_midpoint);
+  for (std::size_t e : marked)
+    sub_domains[e] = sub_domain;
 }
 //-----------------------------------------------------------------------------
 void SubDomain::set_property(std::string name, double value)
@@ -23,6 +23,7 @@
 
 #include <cstddef>
 #include <map>
+#include <vector>
 #include <dolfin/common/constants.h>
 #include <Eigen/Dense>
 
@@ -75,6 +76,24 @@ namespace dolfin
     ///         True for points inside the subdomain.
     virtual bool inside(Eigen::Ref<const Eigen::VectorXd> x, bool on_boundary) const;
 
+    /// Compute for a block of points whether they are inside the
+    /// subdomain. This is used when marking meshes, with all points
+    /// to be checked passed in one call. The default implementation
+    /// calls inside() for each point, using parameters["num_threads"]
+    /// threads, in which case inside() must be thread safe.
+    /// Subclasses may override it to evaluate all points at once.
+    ///
+    /// @param    x (Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>)
+    ///         The coordinates of the points, one point per row.
+    /// @param   on_boundary (bool)
+    ///         True for points on the boundary.
+    /// @param    values (Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, 1>>)
+    ///         True for points inside the subdomain (one per row of x).
+    virtual void inside(Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic,
+                        Eigen::Dynamic, Eigen::RowMajor>> x,
+                        bool on_boundary,
+                        Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, 1>> values) const;
+
     /// Map coordinate x in domain H to coordinate y in domain G (used for
     /// periodic boundary conditions)
     ///
@@ -285,12 +304,35 @@ namespace dolfin
     ///         The tolerance.
     const double map_tolerance;
 
+    /// Return unique identifier of subdomain, used as key for data
+    /// computed for the subdomain and cached on meshes
+    ///
+    /// @return    std::size_t
+    ///         The identifier.
+    std::size_t id() const
+    { return _unique_id; }
+
   private:
 
-    /// Apply marker of type T (most likely an std::size_t) to object of class
-    /// S (most likely MeshFunction or MeshValueCollection)
-    template<typename S, typename T>
-    void apply_markers(S& sub_domains,
+    // Compute the (regular) entities of dimension dim that have all
+    // vertices, and the midpoint if check_midpoint is true, inside
+    // the subdomain. The entities are returned in increasing order.
+    std::vector<std::size_t> compute_marked_entities(const Mesh& mesh,
+                                                     std::size_t dim,
+                                                     bool check_midpoint) const;
+
+    /// Apply marker of type T (most likely an std::size_t) to a
+    /// MeshFunction
+    template<typename T>
+    void apply_markers(MeshFunction<T>& sub_domains,
+                       T sub_domain,
+                       const Mesh& mesh,
+                       bool check_midpoint) const;
+
+    /// Apply marker of type T (most likely an std::size_t) to a
+    /// MeshValueCollection
+    template<typename T>
+    void apply_markers(MeshValueCollection<T>& sub_domains,
                        T sub_domain,
                        const Mesh& mesh,
                        bool check_midpoint) const;
@@ -310,6 +352,9 @@ namespace dolfin
     // calls to inside() and map()
     mutable std::size_t _geometric_dimension;
 
+    // Unique identifier
+    const std::size_t _unique_id;
+
   };
 
 }
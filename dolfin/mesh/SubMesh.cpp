@@ -45,9 +45,8 @@ SubMesh::SubMesh(const Mesh& mesh, const SubDomain& sub_domain)
   sub_domain.mark(sub_domains, 1);
 
   // Copy data into std::vector
-  const std::vector<std::size_t> _sub_domains(sub_domains.values(),
-                                              sub_domains.values()
-                                              + sub_domains.size());
+  std::vector<std::size_t> _sub_domains;
+  sub_domains.get_values(_sub_domains);
 
   // Create sub mesh
   init(mesh, _sub_domains, 1);
@@ -58,9 +57,8 @@ SubMesh::SubMesh(const Mesh& mesh,
                  std::size_t sub_domain)
 {
   // Copy data into std::vector
-  const std::vector<std::size_t> _sub_domains(sub_domains.values(),
-                                              sub_domains.values()
-                                              + sub_domains.size());
+  std::vector<std::size_t> _sub_domains;
+  sub_domains.get_values(_sub_domains);
 
   // Create sub mesh
   init(mesh, _sub_domains, sub_domain);
@@ -108,123 +106,74 @@ void SubMesh::init(const Mesh& mesh,
   editor.open(*this, mesh.type().cell_type(), D,
               mesh.geometry().dim());
 
-  // Build set of cells that are in sub-mesh
-  std::vector<bool> parent_cell_in_subdomain(mesh.num_cells(), false);
-  std::set<std::size_t> submesh_cells;
-  for (CellIterator cell(mesh); !cell.end(); ++cell)
+  // Build list of cells that are in sub-mesh (in increasing order)
+  std::vector<std::size_t> submesh_cells;
+  for (std::size_t c = 0; c < mesh.num_cells(); ++c)
   {
-    if (sub_domains[cell->index()] == sub_domain)
-    {
-      parent_cell_in_subdomain[cell->index()] = true;
-      submesh_cells.insert(cell->index());
-    }
+    if (sub_domains[c] == sub_domain)
+      submesh_cells.push_back(c);
   }
 
   // Map from parent vertex index to submesh vertex index
-  std::map<std::size_t, std::size_t> parent_to_submesh_vertex_indices;
+  const std::size_t not_in_submesh = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> parent_to_submesh_vertex_indices(mesh.num_vertices(),
+                                                            not_in_submesh);
 
-  // Map from submesh cell to parent cell
-  std::vector<std::size_t> submesh_cell_parent_indices;
-  submesh_cell_parent_indices.reserve(submesh_cells.size());
+  // Vector to hold submesh vertex -> parent vertex
+  std::vector<std::size_t> parent_vertex_indices;
 
   // Vector from parent cell index to submesh cell index
   std::vector<std::size_t> parent_to_submesh_cell_indices(mesh.num_cells(), 0);
 
-  // Add sub-mesh cells
+  // Add sub-mesh cells, numbering vertices in order of appearance
   editor.init_cells_global(submesh_cells.size(), submesh_cells.size());
-  std::size_t current_cell = 0;
-  std::size_t current_vertex = 0;
-  for (std::set<std::size_t>::iterator cell_it = submesh_cells.begin();
-       cell_it != submesh_cells.end(); ++cell_it)
+  const MeshConnectivity& parent_cell_vertices = mesh.topology()(D, 0);
+  std::vector<std::size_t> cell_vertices(mesh.type().num_vertices());
+  for (std::size_t current_cell = 0; current_cell < submesh_cells.size();
+       ++current_cell)
   {
-    // Data structure to hold new vertex indices for cell
-    std::vector<std::size_t> cell_vertices;
-
-    // Create cell
-    Cell cell(mesh, *cell_it);
-
-    // Iterate over cell vertices
-    for (VertexIterator vertex(cell); !vertex.end(); ++vertex)
+    const std::size_t parent_cell = submesh_cells[current_cell];
+    const unsigned int* v = parent_cell_vertices(parent_cell);
+    for (std::size_t i = 0; i < cell_vertices.size(); ++i)
     {
-      const std::size_t parent_vertex_index = vertex->index();
-
-      // Look for parent vertex in map
-      std::map<std::size_t, std::size_t>::iterator vertex_it
-        = parent_to_submesh_vertex_indices.find(parent_vertex_index);
-
-      // If vertex has been inserted, get new index, otherwise
-      // increment and insert
-      std::size_t submesh_vertex_index = 0;
-      if (vertex_it != parent_to_submesh_vertex_indices.end())
-        submesh_vertex_index = vertex_it->second;
-      else
+      std::size_t& submesh_vertex_index = parent_to_submesh_vertex_indices[v[i]];
+      if (submesh_vertex_index == not_in_submesh)
       {
-        submesh_vertex_index = current_vertex++;
-        parent_to_submesh_vertex_indices[parent_vertex_index]
-          = submesh_vertex_index;
+        submesh_vertex_index = parent_vertex_indices.size();
+        parent_vertex_indices.push_back(v[i]);
       }
-
-      // Add vertex to list of cell vertices (new indexing)
-      cell_vertices.push_back(submesh_vertex_index);
+      cell_vertices[i] = submesh_vertex_index;
     }
 
-    // Add parent cell index to list
-    submesh_cell_parent_indices.push_back(cell.index());
-
     // Store parent cell -> submesh cell indices
-    parent_to_submesh_cell_indices[cell.index()] = current_cell;
+    parent_to_submesh_cell_indices[parent_cell] = current_cell;
 
     // Add cell to mesh
-    editor.add_cell(current_cell++, cell_vertices);
+    editor.add_cell(current_cell, cell_vertices);
   }
 
-  // Vector to hold submesh vertex -> parent vertex
-  std::vector<std::size_t> parent_vertex_indices;
-  parent_vertex_indices.resize(parent_to_submesh_vertex_indices.size());
-
   // Initialise mesh editor
-  editor.init_vertices_global(parent_to_submesh_vertex_indices.size(),
-                              parent_to_submesh_vertex_indices.size());
+  editor.init_vertices_global(parent_vertex_indices.size(),
+                              parent_vertex_indices.size());
 
   // Add vertices
-  for (std::map<std::size_t, std::size_t>::iterator it
-         = parent_to_submesh_vertex_indices.begin();
-       it != parent_to_submesh_vertex_indices.end(); ++it)
+  if (!parent_vertex_indices.empty() && MPI::size(mesh.mpi_comm()) > 1)
+    not_working_in_parallel("SubMesh::init");
+  const std::size_t gdim = mesh.geometry().dim();
+  for (std::size_t i = 0; i < parent_vertex_indices.size(); ++i)
   {
-    Vertex vertex(mesh, it->first);
-    if (MPI::size(mesh.mpi_comm()) > 1)
-      not_working_in_parallel("SubMesh::init");
-
     // FIXME: Get global vertex index
-    editor.add_vertex(it->second, vertex.point());
-    parent_vertex_indices[it->second] = it->first;
+    editor.add_vertex(i, Point(gdim, mesh.geometry().x(parent_vertex_indices[i])));
   }
 
   // Close editor
   editor.close();
 
   // Build submesh-to-parent map for vertices
-  std::vector<std::size_t>& parent_vertex_indices_mf
-    = data().create_array("parent_vertex_indices", 0);
-  parent_vertex_indices_mf.resize(num_vertices());
-  for (std::map<std::size_t, std::size_t>::iterator it
-         = parent_to_submesh_vertex_indices.begin();
-       it != parent_to_submesh_vertex_indices.end(); ++it)
-  {
-    parent_vertex_indices_mf[it->second] = it->first;
-  }
+  data().create_array("parent_vertex_indices", 0) = parent_vertex_indices;
 
   // Build submesh-to-parent map for cells
-  std::vector<std::size_t>& parent_cell_indices
-    = data().create_array("parent_cell_indices", D);
-  parent_cell_indices.resize(num_cells());
-  current_cell = 0;
-  for (std::vector<std::size_t>::iterator it
-         = submesh_cell_parent_indices.begin();
-       it != submesh_cell_parent_indices.end(); ++it)
-  {
-    parent_cell_indices[current_cell++] = *it;
-  }
+  data().create_array("parent_cell_indices", D) = submesh_cells;
 
   // Initialise present MeshDomain
   const MeshDomains& parent_domains = mesh.domains();
@@ -229,6 +229,117 @@ double TetrahedronCell::circumradius(const MeshEntity& tetrahedron) const
   return area/(6.0*volume(tetrahedron));
 }
 //-----------------------------------------------------------------------------
+void TetrahedronCell::quality(const double* x, std::size_t num_cells,
+                              std::size_t gdim, Quality measure,
+                              double* q) const
+{
+  if (gdim != 3)
+  {
+    dolfin_error("TetrahedronCell.cpp",
+                 "compute quality of tetrahedron cells",
+                 "Only know how to compute quality in R^3");
+  }
+
+  // Coordinate j of vertex i of cell c is x[(3*i + j)*n + c]
+  const std::size_t n = num_cells;
+  for (std::size_t c = 0; c < n; ++c)
+  {
+    double v[4][3];
+    for (std::size_t i = 0; i < 4; ++i)
+      for (std::size_t j = 0; j < 3; ++j)
+        v[i][j] = x[(3*i + j)*n + c];
+
+    // Edge vectors from vertex 0, and between vertices 1, 2 and 3
+    double e01[3], e02[3], e03[3], e12[3], e13[3], e23[3];
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      e01[j] = v[1][j] - v[0][j];
+      e02[j] = v[2][j] - v[0][j];
+      e03[j] = v[3][j] - v[0][j];
+      e12[j] = v[2][j] - v[1][j];
+      e13[j] = v[3][j] - v[1][j];
+      e23[j] = v[3][j] - v[2][j];
+    }
+
+    // Face normals scaled by twice the face area. Face i is opposite
+    // vertex i, and the normals all point outwards (or all inwards).
+    double f[4][3];
+    f[0][0] = e12[1]*e13[2] - e12[2]*e13[1];
+    f[0][1] = e12[2]*e13[0] - e12[0]*e13[2];
+    f[0][2] = e12[0]*e13[1] - e12[1]*e13[0];
+    f[1][0] = e03[1]*e02[2] - e03[2]*e02[1];
+    f[1][1] = e03[2]*e02[0] - e03[0]*e02[2];
+    f[1][2] = e03[0]*e02[1] - e03[1]*e02[0];
+    f[2][0] = e01[1]*e03[2] - e01[2]*e03[1];
+    f[2][1] = e01[2]*e03[0] - e01[0]*e03[2];
+    f[2][2] = e01[0]*e03[1] - e01[1]*e03[0];
+    f[3][0] = e02[1]*e01[2] - e02[2]*e01[1];
+    f[3][1] = e02[2]*e01[0] - e02[0]*e01[2];
+    f[3][2] = e02[0]*e01[1] - e02[1]*e01[0];
+    double fn[4];
+    for (std::size_t i = 0; i < 4; ++i)
+      fn[i] = std::sqrt(f[i][0]*f[i][0] + f[i][1]*f[i][1] + f[i][2]*f[i][2]);
+
+    const double volume
+      = std::abs(e03[0]*f[3][0] + e03[1]*f[3][1] + e03[2]*f[3][2])/6.0;
+    const double area = 0.5*(fn[0] + fn[1] + fn[2] + fn[3]);
+
+    // Edge lengths
+    auto norm = [](const double* e)
+      { return std::sqrt(e[0]*e[0] + e[1]*e[1] + e[2]*e[2]); };
+    const double l01 = norm(e01), l02 = norm(e02), l03 = norm(e03);
+    const double l12 = norm(e12), l13 = norm(e13), l23 = norm(e23);
+
+    // Circumradius, as in TetrahedronCell::circumradius
+    double R = 0.0;
+    if (measure == Quality::circumradius || measure == Quality::radius_ratio)
+    {
+      const double la = l12*l03;
+      const double lb = l02*l13;
+      const double lc = l01*l23;
+      const double s = 0.5*(la + lb + lc);
+      R = std::sqrt(s*(s - la)*(s - lb)*(s - lc))/(6.0*volume);
+    }
+
+    switch (measure)
+    {
+    case Quality::volume:
+      q[c] = volume;
+      break;
+    case Quality::circumradius:
+      q[c] = R;
+      break;
+    case Quality::inradius:
+      q[c] = (volume == 0.0) ? 0.0 : 3.0*volume/area;
+      break;
+    case Quality::radius_ratio:
+      q[c] = (volume == 0.0) ? 0.0 : 9.0*volume/(area*R);
+      break;
+    case Quality::edge_ratio:
+      q[c] = std::max({l01, l02, l03, l12, l13, l23})
+        /std::min({l01, l02, l03, l12, l13, l23});
+      break;
+    case Quality::min_angle:
+    {
+      // Dihedral angle between faces i and j has cosine -n_i.n_j
+      double cos_max = -1.0;
+      for (std::size_t i = 0; i < 4; ++i)
+      {
+        for (std::size_t j = i + 1; j < 4; ++j)
+        {
+          const double d = fn[i]*fn[j];
+          const double cos_angle = (d == 0.0) ? 1.0 :
+            -(f[i][0]*f[j][0] + f[i][1]*f[j][1] + f[i][2]*f[j][2])/d;
+          cos_max = std::max(cos_max, cos_angle);
+        }
+      }
+      q[c] = std::acos(std::min(1.0, cos_max));
+      break;
+    }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 double TetrahedronCell::squared_distance(const Cell& cell,
                                          const Point& point) const
 {
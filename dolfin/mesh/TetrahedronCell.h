@@ -70,6 +70,11 @@ namespace dolfin
     /// Compute circumradius of tetrahedron
     double circumradius(const MeshEntity& tetrahedron) const;
 
+    /// Compute a quality measure for a block of tetrahedra (see
+    /// CellType::quality)
+    void quality(const double* x, std::size_t num_cells, std::size_t gdim,
+                 Quality measure, double* q) const;
+
     /// Compute squared distance to given point
     double squared_distance(const Cell& cell, const Point& point) const;
 
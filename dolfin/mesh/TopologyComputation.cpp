@@ -16,7 +16,11 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <numeric>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -26,8 +30,10 @@
 #include <boost/version.hpp>
 
 #include <dolfin/common/Timer.h>
+#include <dolfin/common/threads.h>
 #include <dolfin/common/utils.h>
 #include <dolfin/log/log.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "Cell.h"
 #include "CellType.h"
 #include "Mesh.h"
@@ -38,6 +44,154 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Number of bits per radix sort pass
+  const int radix_bits = 11;
+  const std::int32_t radix_mask = (1 << radix_bits) - 1;
+
+  // Stable counting sort of x by digit(x[i]) in [0, num_buckets),
+  // using y as work array. Each thread counts and scatters a
+  // contiguous chunk of x, and the per-thread bucket offsets are
+  // ordered by bucket and then by thread to preserve stability.
+  template<typename T, typename Digit>
+  void counting_sort(std::vector<T>& x, std::vector<T>& y,
+                     std::size_t num_buckets, std::size_t num_threads,
+                     Digit digit)
+  {
+    dolfin_assert(x.size() == y.size());
+    num_threads = std::max<std::size_t>(1, std::min(num_threads, x.size()));
+
+    // Count entries per bucket and thread
+    std::vector<std::size_t> offsets(num_threads*num_buckets, 0);
+    parallel_for(num_threads, x.size(),
+                 [&](std::size_t t, std::size_t i0, std::size_t i1)
+    {
+      std::size_t* count = offsets.data() + t*num_buckets;
+      for (std::size_t i = i0; i < i1; ++i)
+        ++count[digit(x[i])];
+    });
+
+    // Compute offsets, and skip pass if all entries are in one bucket
+    std::size_t offset = 0;
+    for (std::size_t b = 0; b < num_buckets; ++b)
+    {
+      const std::size_t offset_b = offset;
+      for (std::size_t t = 0; t < num_threads; ++t)
+      {
+        const std::size_t count = offsets[t*num_buckets + b];
+        offsets[t*num_buckets + b] = offset;
+        offset += count;
+      }
+      if (offset - offset_b == x.size())
+        return;
+    }
+
+    // Scatter
+    parallel_for(num_threads, x.size(),
+                 [&](std::size_t t, std::size_t i0, std::size_t i1)
+    {
+      std::size_t* position = offsets.data() + t*num_buckets;
+      for (std::size_t i = i0; i < i1; ++i)
+        y[position[digit(x[i])]++] = x[i];
+    });
+    x.swap(y);
+  }
+
+  // Visitor for the connections d0 - d1 computed from the
+  // intersection d0 - d - d1, holding the work arrays of one thread
+  class IntersectionVisitor
+  {
+  public:
+
+    IntersectionVisitor(const Mesh& mesh, std::size_t d0, std::size_t d1,
+                        std::size_t d)
+      : _d0(d0), _d1(d1), _c0(mesh.topology()(d0, d)),
+        _c1(mesh.topology()(d, d1)), _v0(mesh.topology()(d0, 0)),
+        _v1(mesh.topology()(d1, 0)),
+        _e1_visited(mesh.topology().size(d1)),
+        _e0_vertices(mesh.type().num_vertices(d0)),
+        _e1_vertices(mesh.type().num_vertices(d1))
+    {
+      // Do nothing
+    }
+
+    // Call f(e1) for each entity e1 of dimension d1 connected to
+    // entity e0 of dimension d0, in order of discovery and without
+    // duplicates
+    template<typename F>
+    void operator() (unsigned int e0, F f)
+    {
+      // Sorted list of e0 vertex indices (necessary to test for
+      // presence of one list in another)
+      if (_d0 != _d1)
+      {
+        std::copy(_v0(e0), _v0(e0) + _e0_vertices.size(),
+                  _e0_vertices.begin());
+        std::sort(_e0_vertices.begin(), _e0_vertices.end());
+      }
+
+      // Initialise e1_visited to false for all neighbours of e0. The
+      // loop structure mirrors the one below.
+      const unsigned int* e = _c0(e0);
+      const std::size_t num_e = _c0.size(e0);
+      for (std::size_t i = 0; i < num_e; ++i)
+      {
+        const unsigned int* e1 = _c1(e[i]);
+        for (std::size_t j = 0; j < _c1.size(e[i]); ++j)
+          _e1_visited[e1[j]] = false;
+      }
+
+      // Iterate over all connected entities of dimension d
+      for (std::size_t i = 0; i < num_e; ++i)
+      {
+        // Iterate over all connected entities of dimension d1
+        const unsigned int* e1 = _c1(e[i]);
+        for (std::size_t j = 0; j < _c1.size(e[i]); ++j)
+        {
+          // Skip already visited connected entities (to avoid
+          // duplicates)
+          if (_e1_visited[e1[j]])
+            continue;
+          _e1_visited[e1[j]] = true;
+
+          if (_d0 == _d1)
+          {
+            // An entity is not a neighbor to itself
+            if (e0 != e1[j])
+              f(e1[j]);
+          }
+          else
+          {
+            // Sorted list of e1 vertex indices
+            std::copy(_v1(e1[j]), _v1(e1[j]) + _e1_vertices.size(),
+                      _e1_vertices.begin());
+            std::sort(_e1_vertices.begin(), _e1_vertices.end());
+
+            // Entity e1 must be completely contained in e0
+            if (std::includes(_e0_vertices.begin(), _e0_vertices.end(),
+                              _e1_vertices.begin(), _e1_vertices.end()))
+            {
+              f(e1[j]);
+            }
+          }
+        }
+      }
+    }
+
+  private:
+
+    const std::size_t _d0, _d1;
+    const MeshConnectivity& _c0;
+    const MeshConnectivity& _c1;
+    const MeshConnectivity& _v0;
+    const MeshConnectivity& _v1;
+    std::vector<bool> _e1_visited;
+    std::vector<unsigned int> _e0_vertices, _e1_vertices;
+
+  };
+}
+
 //-----------------------------------------------------------------------------
 std::size_t TopologyComputation::compute_entities(Mesh& mesh, std::size_t dim)
 {
@@ -198,123 +352,170 @@ std::int32_t TopologyComputation::compute_entities_by_key_matching(Mesh& mesh,
 
   dolfin_assert(N == num_vertices);
 
-  // Create data structure to hold entities
-  // ([vertices key], (cell_local_index, cell index), [entity vertices], entity index)
-  std::vector<std::tuple<std::array<std::int32_t, N>,
-                         std::pair<std::int8_t, std::int32_t>,
-                         std::array<std::int32_t, N>, std::int32_t>>
-    keyed_entities(num_entities*mesh.num_cells());
+  const std::size_t num_threads = (int) parameters["num_threads"];
+  const std::size_t tdim = topology.dim();
+  const MeshConnectivity& cell_vertices = topology(tdim, 0);
+  const std::size_t num_cells = mesh.num_cells();
+  const std::size_t ghost_offset = topology.ghost_offset(tdim);
+
+  // Create data structure to hold entities ([vertices key], position
+  // of entity in cell-entity list, i.e. cell_index*num_entities +
+  // cell_local_index)
+  typedef std::pair<std::array<std::int32_t, N>, std::int32_t> KeyedEntity;
+  std::vector<KeyedEntity> keyed_entities(num_entities*num_cells);
 
   // Loop over cells to build list of keyed (by vertices) entities
-  int entity_counter = 0;
-  for (CellIterator c(mesh, "all"); !c.end(); ++c)
+  parallel_for(num_threads, num_cells,
+               [&](std::size_t, std::size_t c0, std::size_t c1)
   {
-    // Get vertices from cell
-    const unsigned int* vertices = c->entities(0);
-    dolfin_assert(vertices);
-
-    // Iterate over entities of cell
-    const int cell_index = c->index();
-    for (std::int8_t i = 0; i < num_entities; ++i)
+    std::array<std::int32_t, N> entity;
+    for (std::size_t c = c0; c < c1; ++c)
     {
-      // Get entity vertices
-      auto& entity = std::get<2>(keyed_entities[entity_counter]);
-      for (std::int8_t j = 0; j < num_vertices; ++j)
-        entity[j] = vertices[e_vertices[i][j]];
-
-      // Sort entity vertices to create key
-      auto& entity_key = std::get<0>(keyed_entities[entity_counter]);
-      std::partial_sort_copy(entity.begin(), entity.end(),
-                             entity_key.begin(), entity_key.end());
-
-      // Attach (local index, cell index), making local_index negative
-      // if it is not a ghost cell. This ensures that non-ghosts come
-      // before ghosts when sorted. The index is corrected later.
-      if (!c->is_ghost())
-        std::get<1>(keyed_entities[entity_counter]) = {-i - 1, cell_index};
-      else
-        std::get<1>(keyed_entities[entity_counter]) = {i, cell_index};
+      // Get vertices from cell
+      const unsigned int* vertices = cell_vertices(c);
+      dolfin_assert(vertices);
 
-      // Increment entity counter
-      ++entity_counter;
+      // Iterate over entities of cell
+      for (std::int8_t i = 0; i < num_entities; ++i)
+      {
+        // Get entity vertices and sort them to create key
+        for (std::int8_t j = 0; j < num_vertices; ++j)
+          entity[j] = vertices[e_vertices[i][j]];
+        std::sort(entity.begin(), entity.end());
+        keyed_entities[c*num_entities + i] = {entity, c*num_entities + i};
+      }
     }
-  }
-
-  // Sort entities by key. For the same key, those beloning to
-  // non-ghost cells will appear before those belonging to ghost
-  // cells.
-  std::sort(keyed_entities.begin(), keyed_entities.end());
-
-  // Compute entity indices (using -1, -2, -3, etc, for ghost
-  // entities)
-  std::int32_t nonghost_index(0), ghost_index(-1);
-  std::array<std::int32_t, N> previous_key;
-  std::fill(previous_key.begin(), previous_key.end(), -1);
-  for (auto e = keyed_entities.begin(); e!= keyed_entities.end(); ++e)
+  });
+
+  // Sort entities by key using a stable LSD radix sort. The first
+  // pass orders entities with the same key such that those belonging
+  // to non-ghost cells (in reverse local index order) appear before
+  // those belonging to ghost cells (in local index order), which
+  // reproduces the entity ordering of a comparison sort on (key,
+  // signed local index, cell index).
+  std::vector<KeyedEntity> work(keyed_entities.size());
+  counting_sort(keyed_entities, work, 2*num_entities, num_threads,
+                [num_entities, ghost_offset](const KeyedEntity& e)
+                {
+                  const std::size_t c = e.second/num_entities;
+                  const std::size_t i = e.second % num_entities;
+                  return (c < ghost_offset) ? (num_entities - 1 - i)
+                    : (num_entities + i);
+                });
+
+  // Radix passes over the vertex indices, least significant first
+  const std::size_t num_mesh_vertices = mesh.num_vertices();
+  int num_bits = 0;
+  while (num_bits < 32 and (num_mesh_vertices - 1) >> num_bits)
+    ++num_bits;
+  for (int j = N - 1; j >= 0; --j)
   {
-    const auto& key = std::get<0>(*e);
-    if (key == previous_key)
+    for (int shift = 0; shift < num_bits; shift += radix_bits)
     {
-      // Repeated entity, reuse entity index
-      std::get<3>(*e) = std::get<3>(*(e - 1));
+      counting_sort(keyed_entities, work, 1 << radix_bits, num_threads,
+                    [j, shift](const KeyedEntity& e)
+                    { return (e.first[j] >> shift) & radix_mask; });
     }
-    else
+  }
+  std::vector<KeyedEntity>().swap(work);
+
+  // Compute entity indices (non-ghosts first) by a threaded prefix
+  // scan. An entity is new where the key changes, and it is a ghost
+  // if the first entity with the key belongs to a ghost cell.
+  const std::size_t num_keyed = keyed_entities.size();
+  auto is_new = [&keyed_entities](std::size_t k)
+    { return k == 0 or keyed_entities[k].first != keyed_entities[k - 1].first; };
+  auto is_ghost = [&keyed_entities, num_entities, ghost_offset](std::size_t k)
+    { return (std::size_t) keyed_entities[k].second/num_entities >= ghost_offset; };
+
+  // Count new non-ghost and ghost entities per chunk
+  const std::size_t num_chunks
+    = std::max<std::size_t>(1, std::min(num_threads, num_keyed));
+  std::vector<std::int32_t> chunk_offsets(2*num_chunks, 0);
+  parallel_for(num_chunks, num_keyed,
+               [&](std::size_t t, std::size_t k0, std::size_t k1)
+  {
+    for (std::size_t k = k0; k < k1; ++k)
     {
-      // New entity, so give index (negative for ghosts)
-      const auto local_index = std::get<1>(*e).first;
-      if (local_index < 0)
-        std::get<3>(*e) = nonghost_index++;
-      else
-        std::get<3>(*e) = ghost_index--;
-
-      // Update key
-      previous_key = key;
+      if (is_new(k))
+        ++chunk_offsets[2*t + (is_ghost(k) ? 1 : 0)];
     }
+  });
 
-    // Re-map local index (make all positive)
-    auto& local_index = std::get<1>(*e).first;
-    local_index = (local_index < 0) ? (-local_index - 1) : local_index;
+  // Exclusive scan over chunks (ghost entities are numbered after
+  // all non-ghost entities)
+  std::int32_t num_nonghost_entities = 0, num_ghost_entities = 0;
+  for (std::size_t t = 0; t < num_chunks; ++t)
+  {
+    const std::int32_t n = chunk_offsets[2*t];
+    chunk_offsets[2*t] = num_nonghost_entities;
+    num_nonghost_entities += n;
+  }
+  for (std::size_t t = 0; t < num_chunks; ++t)
+  {
+    const std::int32_t n = chunk_offsets[2*t + 1];
+    chunk_offsets[2*t + 1] = num_nonghost_entities + num_ghost_entities;
+    num_ghost_entities += n;
   }
-
-  // Total number of entities
-  const std::int32_t num_nonghost_entities = nonghost_index;
-  const std::int32_t num_ghost_entities = -(ghost_index + 1);
   const std::int32_t num_mesh_entities = num_nonghost_entities + num_ghost_entities;
 
+  // Number entities. Entities at the start of a chunk that continue
+  // a key from the previous chunk are numbered afterwards.
+  std::vector<std::int32_t> entity_index(num_keyed);
+  parallel_for(num_chunks, num_keyed,
+               [&](std::size_t t, std::size_t k0, std::size_t k1)
+  {
+    std::int32_t nonghost_index = chunk_offsets[2*t];
+    std::int32_t ghost_index = chunk_offsets[2*t + 1];
+    std::size_t k = k0;
+    while (k < k1 and !is_new(k))
+      ++k;
+    for (; k < k1; ++k)
+    {
+      if (is_new(k))
+        entity_index[k] = is_ghost(k) ? ghost_index++ : nonghost_index++;
+      else
+        entity_index[k] = entity_index[k - 1];
+    }
+  });
+  for (std::size_t t = 1; t < num_chunks; ++t)
+  {
+    const std::size_t k0 = (std::uint64_t) t*num_keyed/num_chunks;
+    for (std::size_t k = k0; k < num_keyed and !is_new(k); ++k)
+      entity_index[k] = entity_index[k - 1];
+  }
+
   // List of vertex indices connected to entity e
-  std::vector<std::array<int, N>> connectivity_ev(num_mesh_entities) ;
+  std::vector<std::array<int, N>> connectivity_ev(num_mesh_entities);
 
   // List of entity e indices connected to cell
   boost::multi_array<int, 2>
     connectivity_ce(boost::extents[mesh.num_cells()][num_entities]);
 
   // Build connectivity arrays (with ghost entities at the end)
-  //std::int32_t previous_index = -1;
-  std::int32_t previous_index = std::numeric_limits<std::int32_t>::min();
-  for (auto& entity : keyed_entities)
+  parallel_for(num_threads, num_keyed,
+               [&](std::size_t, std::size_t k0, std::size_t k1)
   {
-    // Get entity index, and remap for ghosts (negative entity index)
-    // to true index
-    auto& e_index = std::get<3>(entity);
-    if (e_index < 0)
-      e_index = num_nonghost_entities - (e_index + 1);
-
-    // Add to enity-to-vertex map if entity is new
-    if (e_index != previous_index)
+    for (std::size_t k = k0; k < k1; ++k)
     {
-      dolfin_assert(e_index < (std::int32_t) connectivity_ev.size());
-      connectivity_ev[e_index] = std::get<2>(entity);
+      const std::int32_t e_index = entity_index[k];
+      const std::size_t c = keyed_entities[k].second/num_entities;
+      const std::size_t i = keyed_entities[k].second % num_entities;
 
-      // Update index
-      previous_index = e_index;
-    }
+      // Add to entity-to-vertex map (vertices in order of the first
+      // cell containing the entity)
+      if (is_new(k))
+      {
+        dolfin_assert(e_index < (std::int32_t) connectivity_ev.size());
+        const unsigned int* vertices = cell_vertices(c);
+        for (std::int8_t j = 0; j < num_vertices; ++j)
+          connectivity_ev[e_index][j] = vertices[e_vertices[i][j]];
+      }
 
-    // Add to cell-to-entity map
-    const auto& cell = std::get<1>(entity);
-    const auto local_index = cell.first;
-    const auto cell_index = cell.second;
-    connectivity_ce[cell_index][local_index] = e_index;
-  }
+      // Add to cell-to-entity map
+      connectivity_ce[c][i] = e_index;
+    }
+  });
 
   // Initialise connectivity data structure
   topology.init(dim, num_mesh_entities, 0);
@@ -332,15 +533,20 @@ std::int32_t TopologyComputation::compute_entities_by_key_matching(Mesh& mesh,
 void TopologyComputation::compute_from_transpose(Mesh& mesh, std::size_t d0,
                                                  std::size_t d1)
 {
-  // The transpose is computed in three steps:
+  // The transpose is computed directly in compressed row storage in
+  // three steps:
   //
   //   1. Iterate over entities of dimension d1 and count the number
   //      of connections for each entity of dimension d0
   //
-  //   2. Allocate memory / prepare data structures
+  //   2. Compute offsets by a prefix sum over the counts
   //
   //   3. Iterate again over entities of dimension d1 and add connections
   //      for each entity of dimension d0
+  //
+  // In the threaded version, steps 1 and 3 use atomic counters and
+  // the connections of each entity are sorted afterwards, which
+  // gives the same result as the serial version.
 
   log(TRACE, "Computing mesh connectivity %d - %d from transpose.", d0, d1);
 
@@ -349,26 +555,94 @@ void TopologyComputation::compute_from_transpose(Mesh& mesh, std::size_t d0,
   MeshConnectivity& connectivity = topology(d0, d1);
 
   // Need connectivity d1 - d0
-  dolfin_assert(!topology(d1, d0).empty());
+  const MeshConnectivity& c10 = topology(d1, d0);
+  dolfin_assert(!c10.empty());
+
+  const std::size_t num_entities0 = topology.size(d0);
+  const std::size_t num_entities1 = topology.size(d1);
+  const std::size_t num_threads = (int) parameters["num_threads"];
 
-  // Temporary array
-  std::vector<std::size_t> tmp(topology.size(d0), 0);
+  std::vector<unsigned int> offsets(num_entities0 + 1, 0);
+  std::vector<unsigned int> connections(c10.size());
+  if (num_threads == 1)
+  {
+    // Count the number of connections
+    for (std::size_t e1 = 0; e1 < num_entities1; ++e1)
+    {
+      const unsigned int* e0 = c10(e1);
+      for (std::size_t i = 0; i < c10.size(e1); ++i)
+        ++offsets[e0[i] + 1];
+    }
+
+    // Compute offsets
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // Add the connections, using the offsets of the next entity as
+    // the current position and shifting back afterwards
+    for (std::size_t e1 = 0; e1 < num_entities1; ++e1)
+    {
+      const unsigned int* e0 = c10(e1);
+      for (std::size_t i = 0; i < c10.size(e1); ++i)
+        connections[offsets[e0[i]]++] = e1;
+    }
+    std::copy_backward(offsets.begin(), offsets.end() - 1, offsets.end());
+    offsets[0] = 0;
+  }
+  else
+  {
+    std::unique_ptr<std::atomic<unsigned int>[]>
+      position(new std::atomic<unsigned int>[num_entities0]);
+    for (std::size_t e0 = 0; e0 < num_entities0; ++e0)
+      position[e0] = 0;
+
+    // Count the number of connections
+    parallel_for(num_threads, num_entities1,
+                 [&](std::size_t, std::size_t e1_begin, std::size_t e1_end)
+    {
+      for (std::size_t e1 = e1_begin; e1 < e1_end; ++e1)
+      {
+        const unsigned int* e0 = c10(e1);
+        for (std::size_t i = 0; i < c10.size(e1); ++i)
+          position[e0[i]].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
 
-  // Count the number of connections
-  for (MeshEntityIterator e1(mesh, d1, "all"); !e1.end(); ++e1)
-    for (MeshEntityIterator e0(*e1, d0); !e0.end(); ++e0)
-      tmp[e0->index()]++;
+    // Compute offsets and reset current position for each entity
+    for (std::size_t e0 = 0; e0 < num_entities0; ++e0)
+    {
+      offsets[e0 + 1] = offsets[e0] + position[e0];
+      position[e0] = offsets[e0];
+    }
 
-  // Initialize the number of connections
-  connectivity.init(tmp);
+    // Add the connections
+    parallel_for(num_threads, num_entities1,
+                 [&](std::size_t, std::size_t e1_begin, std::size_t e1_end)
+    {
+      for (std::size_t e1 = e1_begin; e1 < e1_end; ++e1)
+      {
+        const unsigned int* e0 = c10(e1);
+        for (std::size_t i = 0; i < c10.size(e1); ++i)
+        {
+          const unsigned int pos
+            = position[e0[i]].fetch_add(1, std::memory_order_relaxed);
+          connections[pos] = e1;
+        }
+      }
+    });
 
-  // Reset current position for each entity
-  std::fill(tmp.begin(), tmp.end(), 0);
+    // Sort connections of each entity
+    parallel_for(num_threads, num_entities0,
+                 [&](std::size_t, std::size_t e0_begin, std::size_t e0_end)
+    {
+      for (std::size_t e0 = e0_begin; e0 < e0_end; ++e0)
+      {
+        std::sort(connections.begin() + offsets[e0],
+                  connections.begin() + offsets[e0 + 1]);
+      }
+    });
+  }
 
-  // Add the connections
-  for (MeshEntityIterator e1(mesh, d1, "all"); !e1.end(); ++e1)
-    for (MeshEntityIterator e0(*e1, d0); !e0.end(); ++e0)
-      connectivity.set(e0->index(), e1->index(), tmp[e0->index()]++);
+  connectivity.set(std::move(connections), std::move(offsets));
 }
 //----------------------------------------------------------------------------
 void TopologyComputation::compute_from_map(Mesh& mesh,
@@ -434,74 +708,45 @@ void TopologyComputation::compute_from_intersection(Mesh& mesh,
   dolfin_assert(!topology(d0, d).empty());
   dolfin_assert(!topology(d, d1).empty());
 
-  // Temporary dynamic storage, later copied into static storage
-  std::vector<std::vector<std::size_t>> connectivity(topology.size(d0));
+  const std::size_t num_entities0 = topology.size(d0);
+  const std::size_t num_threads = (int) parameters["num_threads"];
 
-  // A bitmap used to ensure we do not store duplicates
-  std::vector<bool> e1_visited(topology.size(d1));
+  // The connectivity is computed directly in compressed row storage:
+  // a first pass over all entities of dimension d0 counts the
+  // connections, and a second pass (after a prefix sum) fills
+  // them. Each pass is threaded over contiguous ranges of entities.
+  std::vector<unsigned int> offsets(num_entities0 + 1, 0);
+  std::vector<unsigned int> connections;
 
-  // Iterate over all entities of dimension d0
-  std::size_t max_size = 1;
-  const std::size_t e0_num_entities = mesh.type().num_vertices(d0);
-  const std::size_t e1_num_entities = mesh.type().num_vertices(d1);
-  std::vector<std::size_t> _e0(e0_num_entities);
-  std::vector<std::size_t> _e1(e1_num_entities);
-  for (MeshEntityIterator e0(mesh, d0, "all"); !e0.end(); ++e0)
+  // Count connections
+  parallel_for(num_threads, num_entities0,
+               [&](std::size_t, std::size_t e0_begin, std::size_t e0_end)
   {
-    // Get set of connected entities for current entity
-    std::vector<std::size_t>& entities = connectivity[e0->index()];
-
-    // Reserve space
-    entities.reserve(max_size);
-
-    // Sorted list of e0 vertex indices (necessary to test for
-    // presence of one list in another)
-    std::copy(e0->entities(0), e0->entities(0) + e0_num_entities, _e0.begin());
-    std::sort(_e0.begin(), _e0.end());
+    IntersectionVisitor visitor(mesh, d0, d1, d);
+    for (std::size_t e0 = e0_begin; e0 < e0_end; ++e0)
+    {
+      unsigned int& count = offsets[e0 + 1];
+      visitor(e0, [&count](unsigned int) { ++count; });
+    }
+  });
 
-    // Initialise e1_visited to false for all neighbours of e0. The
-    // loop structure mirrors the one below.
-    for (MeshEntityIterator e(*e0, d); !e.end(); ++e)
-      for (MeshEntityIterator e1(*e, d1); !e1.end(); ++e1)
-        e1_visited[e1->index()] = false;
+  // Compute offsets
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  connections.resize(offsets.back());
 
-    // Iterate over all connected entities of dimension d
-    for (MeshEntityIterator e(*e0, d); !e.end(); ++e)
+  // Add connections
+  parallel_for(num_threads, num_entities0,
+               [&](std::size_t, std::size_t e0_begin, std::size_t e0_end)
+  {
+    IntersectionVisitor visitor(mesh, d0, d1, d);
+    for (std::size_t e0 = e0_begin; e0 < e0_end; ++e0)
     {
-      // Iterate over all connected entities of dimension d1
-      for (MeshEntityIterator e1(*e, d1); !e1.end(); ++e1)
-      {
-        // Skip already visited connected entities (to avoid duplicates)
-        if (e1_visited[e1->index()])
-          continue;
-        e1_visited[e1->index()] = true;
-
-        if (d0 == d1)
-        {
-          // An entity is not a neighbor to itself (duplicate index
-          // entries removed at end)
-          if (e0->index() != e1->index())
-            entities.push_back(e1->index());
-        }
-        else
-        {
-          // Sorted list of e1 vertex indices
-          std::copy(e1->entities(0), e1->entities(0) + e1_num_entities,
-                    _e1.begin());
-          std::sort(_e1.begin(), _e1.end());
-
-          // Entity e1 must be completely contained in e0
-          if (std::includes(_e0.begin(), _e0.end(), _e1.begin(), _e1.end()))
-            entities.push_back(e1->index());
-        }
-      }
+      unsigned int pos = offsets[e0];
+      visitor(e0, [&connections, &pos](unsigned int e1)
+              { connections[pos++] = e1; });
     }
+  });
 
-    // Store maximum size
-    max_size = std::max(entities.size(), max_size);
-  }
-
-  // Copy to static storage
-  topology(d0, d1).set(connectivity);
+  topology(d0, d1).set(std::move(connections), std::move(offsets));
 }
 //-----------------------------------------------------------------------------
@@ -62,6 +62,11 @@ namespace dolfin
     // corresponding to a single enity. The entities are numbered such that ghost
     // entities come after al regular enrities.
     //
+    // The list is sorted with a stable LSD radix sort on the integer keys, and
+    // entity indices are assigned by a prefix scan. Both are threaded over
+    // contiguous chunks using the global parameter "num_threads"; the
+    // resulting numbering does not depend on the number of threads.
+    //
     // Returns the number of entities
     //
     //The function is templated over the number of vertices that make up an
@@ -197,6 +197,108 @@ double TriangleCell::circumradius(const MeshEntity& triangle) const
   return a*b*c/(4.0*volume(triangle));
 }
 //-----------------------------------------------------------------------------
+namespace
+{
+  // Quality measure for a block of triangles in R^GDIM (see
+  // CellType::quality)
+  template<std::size_t GDIM>
+  void triangle_quality(const double* x, std::size_t num_cells,
+                        CellType::Quality measure, double* q)
+  {
+    // Coordinate j of vertex i of cell c is x[(i*GDIM + j)*n + c]
+    const std::size_t n = num_cells;
+    for (std::size_t c = 0; c < n; ++c)
+    {
+      // Edges from vertex 0 and opposite edge
+      double u[GDIM], w[GDIM], e[GDIM];
+      for (std::size_t j = 0; j < GDIM; ++j)
+      {
+        const double x0 = x[j*n + c];
+        const double x1 = x[(GDIM + j)*n + c];
+        const double x2 = x[(2*GDIM + j)*n + c];
+        u[j] = x1 - x0;
+        w[j] = x2 - x0;
+        e[j] = x2 - x1;
+      }
+
+      // Squared edge lengths, opposite vertex 0, 1 and 2
+      double a2 = 0.0, b2 = 0.0, c2 = 0.0;
+      for (std::size_t j = 0; j < GDIM; ++j)
+      {
+        a2 += e[j]*e[j];
+        b2 += w[j]*w[j];
+        c2 += u[j]*u[j];
+      }
+
+      // Area
+      double area;
+      if (GDIM == 2)
+        area = 0.5*std::abs(u[0]*w[1] - u[1]*w[0]);
+      else
+      {
+        const double n0 = u[1]*w[2] - u[2]*w[1];
+        const double n1 = u[2]*w[0] - u[0]*w[2];
+        const double n2 = u[0]*w[1] - u[1]*w[0];
+        area = 0.5*std::sqrt(n0*n0 + n1*n1 + n2*n2);
+      }
+
+      const double a = std::sqrt(a2), b = std::sqrt(b2), cc = std::sqrt(c2);
+      switch (measure)
+      {
+      case CellType::Quality::volume:
+        q[c] = area;
+        break;
+      case CellType::Quality::circumradius:
+        q[c] = a*b*cc/(4.0*area);
+        break;
+      case CellType::Quality::inradius:
+        q[c] = 2.0*area/(a + b + cc);
+        break;
+      case CellType::Quality::radius_ratio:
+        q[c] = (area == 0.0) ? 0.0 : 16.0*area*area/((a + b + cc)*a*b*cc);
+        break;
+      case CellType::Quality::edge_ratio:
+        q[c] = std::max(a, std::max(b, cc))/std::min(a, std::min(b, cc));
+        break;
+      case CellType::Quality::min_angle:
+      {
+        // The smallest angle is opposite the shortest edge (m)
+        double m2 = a2, p2 = b2, r2 = c2;
+        if (b2 < m2 && b2 <= c2)
+        {
+          m2 = b2;
+          p2 = a2;
+        }
+        else if (c2 < m2)
+        {
+          m2 = c2;
+          r2 = a2;
+        }
+        const double d = 2.0*std::sqrt(p2*r2);
+        const double cos_angle = (d == 0.0) ? 1.0 : (p2 + r2 - m2)/d;
+        q[c] = std::acos(std::max(-1.0, std::min(1.0, cos_angle)));
+        break;
+      }
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void TriangleCell::quality(const double* x, std::size_t num_cells,
+                           std::size_t gdim, Quality measure, double* q) const
+{
+  if (gdim == 2)
+    triangle_quality<2>(x, num_cells, measure, q);
+  else if (gdim == 3)
+    triangle_quality<3>(x, num_cells, measure, q);
+  else
+  {
+    dolfin_error("TriangleCell.cpp",
+                 "compute quality of triangle cells",
+                 "Only know how to compute quality in R^2 or R^3");
+  }
+}
+//-----------------------------------------------------------------------------
 double TriangleCell::squared_distance(const Cell& cell,
                                       const Point& point) const
 {
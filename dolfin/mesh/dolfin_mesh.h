@@ -13,6 +13,7 @@
 #include <dolfin/mesh/MeshEntityIterator.h>
 #include <dolfin/mesh/MeshEntityIteratorBase.h>
 #include <dolfin/mesh/SubsetIterator.h>
+#include <dolfin/mesh/EntityRange.h>
 #include <dolfin/mesh/Vertex.h>
 #include <dolfin/mesh/Edge.h>
 #include <dolfin/mesh/Face.h>
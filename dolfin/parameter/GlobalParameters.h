@@ -74,6 +74,10 @@ namespace dolfin
       // Print the level of thread support provided by the MPI library
       p.add("print_mpi_thread_support_level", false);
 
+      // Number of threads used by threaded mesh algorithms on each
+      // process
+      p.add("num_threads", 1, 1, 1024);
+
       //-- dof ordering
 
       // DOF reordering when running in serial
@@ -93,25 +97,43 @@ namespace dolfin
       p.add("ghost_mode", "none",
             {"shared_facet", "shared_vertex", "none"});
 
+      // Generation of distributed built-in meshes: build on one
+      // process and partition ("partition"), or generate each
+      // process's block of the grid directly ("block")
+      p.add("mesh_generation", "partition", {"partition", "block"});
+
       // Mesh ordering via SCOTCH and GPS
       p.add("reorder_cells_gps", false);
       p.add("reorder_vertices_gps", false);
 
-      // Set default graph/mesh partitioner
+      // Mesh ordering along a space-filling curve within each
+      // partition (after distributing a mesh)
+      p.add("reorder_mesh_locality", "none", {"none", "hilbert", "morton"});
+
+      // Set default graph/mesh partitioner, falling back to the
+      // native partitioner when neither SCOTCH nor ParMETIS is
+      // available
       std::string default_mesh_partitioner = "SCOTCH";
-      #ifdef HAS_PARMETIS
-        #ifndef HAS_SCOTCH
+      #ifndef HAS_SCOTCH
+        #ifdef HAS_PARMETIS
         default_mesh_partitioner = "ParMETIS";
+        #else
+        default_mesh_partitioner = "RCB";
         #endif
       #endif
       p.add("mesh_partitioner", default_mesh_partitioner,
-            {"ParMETIS", "SCOTCH", "None"});
+            {"ParMETIS", "SCOTCH", "RCB", "Hilbert", "None"});
 
       // Approaches to partitioning (following Zoltan syntax)
       // but applies to ParMETIS
       p.add("partitioning_approach", "PARTITION",
             {"PARTITION", "REPARTITION", "REFINE"});
 
+      // Maximum number of passes of greedy refinement of the
+      // partition computed by the native ("RCB" and "Hilbert")
+      // partitioners
+      p.add("partitioning_refinement_passes", 4, 0, 100);
+
       #ifdef HAS_PARMETIS
       // Repartitioning parameter, determines how strongly to hold on
       // to cells when shifting between processes
@@ -127,6 +149,7 @@ namespace dolfin
       // Graph coloring
       std::set<std::string> allowed_coloring_libraries;
       allowed_coloring_libraries.insert("Boost");
+      allowed_coloring_libraries.insert("DOLFIN");
       #ifdef HAS_TRILINOS
       allowed_coloring_libraries.insert("Zoltan");
       #endif
@@ -141,6 +164,12 @@ namespace dolfin
       allowed_backends.insert("PETSc");
       default_backend = "PETSc";
       p.add("use_petsc_signal_handler", false);
+
+      // Preallocate PETSc AIJ matrices from the compressed row
+      // arrays of the sparsity pattern instead of from row counts.
+      // Only preallocation changes; values are still inserted with
+      // MatSetValuesLocal during assembly
+      p.add("petsc_matrix_csr_init", false);
       #endif
       #ifdef HAS_TRILINOS
       allowed_backends.insert("Tpetra");
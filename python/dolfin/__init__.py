@@ -50,6 +50,7 @@ from .cpp.ale import ALE
 from .cpp import MPI
 from .cpp.function import (Expression, Constant, FunctionAXPY,
                            LagrangeInterpolator, FunctionAssigner, assign,
+                           migrate,
                            MultiMeshSubSpace)
 from .cpp.fem import (FiniteElement, DofMap, Assembler, MultiMeshAssembler,
                       get_coordinates, create_mesh, set_coordinates,
@@ -114,7 +115,7 @@ from .cpp.log import (info, Table, set_log_level, get_log_level, LogLevel,
                       Progress, begin, end, error, warning, set_log_active)
 from .cpp.math import ipow, near, between
 from .cpp.mesh import (Mesh, MeshTopology, MeshGeometry, MeshEntity,
-                       MeshColoring, CellType, Cell, Facet, Face,
+                       MeshColoring, MeshRenumbering, CellType, Cell, Facet, Face,
                        Edge, Vertex, cells, facets, faces, edges,
                        entities, vertices, SubDomain, BoundaryMesh,
                        MeshEditor, MeshQuality, SubMesh,
@@ -26,6 +26,7 @@
 #include <dolfin/common/Array.h>
 #include <dolfin/common/Hierarchical.h>
 #include <dolfin/function/assign.h>
+#include <dolfin/function/migrate.h>
 #include <dolfin/function/Constant.h>
 #include <dolfin/function/Expression.h>
 #include <dolfin/function/Function.h>
@@ -516,6 +517,14 @@ namespace dolfin_wrappers
              }
            });
 
+    // dolfin::migrate interface
+    m.def("migrate", [](py::object u0, py::object u1)
+          {
+            auto _u0 = u0.attr("_cpp_object").cast<std::shared_ptr<const dolfin::Function>>();
+            auto _u1 = u1.attr("_cpp_object").cast<std::shared_ptr<dolfin::Function>>();
+            dolfin::migrate(*_u0, *_u1);
+          });
+
     py::class_<dolfin::MultiMeshSubSpace, std::shared_ptr<dolfin::MultiMeshSubSpace>, dolfin::MultiMeshFunctionSpace>(m, "MultiMeshSubSpace")
       .def(py::init<dolfin::MultiMeshFunctionSpace&, std::size_t, std::size_t>())
       .def(py::init<dolfin::MultiMeshFunctionSpace&, std::vector<std::size_t>>())
@@ -22,6 +22,7 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <dolfin/io/CSRFile.h>
 #include <dolfin/io/File.h>
 #include <dolfin/io/HDF5Attribute.h>
 #include <dolfin/io/HDF5File.h>
@@ -30,6 +31,7 @@
 #include <dolfin/io/X3DOM.h>
 #include <dolfin/function/Function.h>
 #include <dolfin/geometry/Point.h>
+#include <dolfin/la/GenericMatrix.h>
 #include <dolfin/la/GenericVector.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshFunction.h>
@@ -111,6 +113,55 @@ namespace dolfin_wrappers
       .def("write", [](dolfin::VTKFile& instance, const dolfin::Mesh& mesh)
            { instance.write(mesh); });
 
+    // dolfin::CSRFile
+    py::class_<dolfin::CSRFile, std::shared_ptr<dolfin::CSRFile>, dolfin::Variable>
+      csr_file(m, "CSRFile");
+
+    // dolfin::CSRFile::Mapping. The arrays are read-only views of the
+    // mapped memory and keep the mapping alive.
+    py::class_<dolfin::CSRFile::Mapping, std::shared_ptr<dolfin::CSRFile::Mapping>>
+      (csr_file, "Mapping")
+      .def_readonly("rank", &dolfin::CSRFile::Mapping::rank)
+      .def_readonly("num_rows", &dolfin::CSRFile::Mapping::num_rows)
+      .def_readonly("num_cols", &dolfin::CSRFile::Mapping::num_cols)
+      .def_readonly("num_nonzeros", &dolfin::CSRFile::Mapping::num_nonzeros)
+      .def_property_readonly("row_ptr", [](py::object self)
+        {
+          auto& mapping = self.cast<const dolfin::CSRFile::Mapping&>();
+          if (!mapping.row_ptr)
+            return py::object(py::none());
+          py::array_t<std::int64_t> a(mapping.num_rows + 1, mapping.row_ptr, self);
+          a.attr("flags").attr("writeable") = false;
+          return py::object(a);
+        })
+      .def_property_readonly("cols", [](py::object self)
+        {
+          auto& mapping = self.cast<const dolfin::CSRFile::Mapping&>();
+          if (!mapping.cols)
+            return py::object(py::none());
+          py::array_t<std::int64_t> a(mapping.num_nonzeros, mapping.cols, self);
+          a.attr("flags").attr("writeable") = false;
+          return py::object(a);
+        })
+      .def_property_readonly("values", [](py::object self)
+        {
+          auto& mapping = self.cast<const dolfin::CSRFile::Mapping&>();
+          py::array_t<double> a(mapping.num_nonzeros, mapping.values, self);
+          a.attr("flags").attr("writeable") = false;
+          return a;
+        });
+
+    csr_file
+      .def(py::init([](const MPICommWrapper comm, std::string filename)
+        { return std::unique_ptr<dolfin::CSRFile>(new dolfin::CSRFile(comm.get(), filename)); }),
+        py::arg("comm"), py::arg("filename"))
+      .def("write", (void (dolfin::CSRFile::*)(const dolfin::GenericMatrix&)) &dolfin::CSRFile::write)
+      .def("write", (void (dolfin::CSRFile::*)(const dolfin::GenericVector&)) &dolfin::CSRFile::write)
+      .def("read", (void (dolfin::CSRFile::*)(dolfin::GenericMatrix&)) &dolfin::CSRFile::read)
+      .def("read", (void (dolfin::CSRFile::*)(dolfin::GenericVector&)) &dolfin::CSRFile::read)
+      .def("map", [](const dolfin::CSRFile& self)
+           { return std::const_pointer_cast<dolfin::CSRFile::Mapping>(self.map()); });
+
 #ifdef HAS_HDF5
     // dolfin::HDF5Attribute
     py::class_<dolfin::HDF5Attribute, std::shared_ptr<dolfin::HDF5Attribute>>(m, "HDF5Attribute")
@@ -608,6 +608,10 @@ namespace dolfin_wrappers
              return py::array_t<double>(values.size(), values.data());
            })
       .def("axpy", &dolfin::GenericVector::axpy)
+      .def("axpby", &dolfin::GenericVector::axpby)
+      .def("maxpy", &dolfin::GenericVector::maxpy)
+      .def("mdot", &dolfin::GenericVector::mdot)
+      .def("inner_and_norm", &dolfin::GenericVector::inner_and_norm)
       .def("sum", (double (dolfin::GenericVector::*)() const) &dolfin::GenericVector::sum)
       .def("sum", [](const dolfin::GenericVector& self, py::array_t<std::size_t> rows)
            { const dolfin::Array<std::size_t> _rows(rows.size(), rows.mutable_data()); return self.sum(_rows); })
@@ -42,6 +42,7 @@
 #include <dolfin/mesh/MeshEntityIterator.h>
 #include <dolfin/mesh/MeshFunction.h>
 #include <dolfin/mesh/MeshPartitioning.h>
+#include <dolfin/mesh/MeshRenumbering.h>
 #include <dolfin/mesh/MeshValueCollection.h>
 #include <dolfin/mesh/MeshQuality.h>
 #include <dolfin/mesh/SubDomain.h>
@@ -101,9 +102,29 @@ namespace dolfin_wrappers
     py::class_<dolfin::MeshView, std::shared_ptr<dolfin::MeshView>>
       (m, "MeshView", "DOLFIN MeshView object")
       .def("mesh", &dolfin::MeshView::mesh)
-      .def("create", &dolfin::MeshView::create)
+      .def("create", (dolfin::Mesh (*)(const dolfin::MeshFunction<std::size_t>&, std::size_t))
+           &dolfin::MeshView::create)
+      .def("create", (dolfin::Mesh (*)(std::shared_ptr<const dolfin::Mesh>, std::size_t,
+                                       const std::vector<std::size_t>&))
+           &dolfin::MeshView::create)
+      .def("create_view", (std::shared_ptr<dolfin::MeshView> (*)(const dolfin::MeshFunction<std::size_t>&, std::size_t))
+           &dolfin::MeshView::create_view)
+      .def("create_view", (std::shared_ptr<dolfin::MeshView> (*)(std::shared_ptr<const dolfin::Mesh>, std::size_t,
+                                                             const std::vector<std::size_t>&))
+           &dolfin::MeshView::create_view)
       .def("cell_map", &dolfin::MeshView::cell_map)
-      .def("vertex_map", &dolfin::MeshView::vertex_map);
+      .def("vertex_map", &dolfin::MeshView::vertex_map)
+      .def("dim", &dolfin::MeshView::dim)
+      .def("num_cells", &dolfin::MeshView::num_cells)
+      .def("num_vertices", &dolfin::MeshView::num_vertices)
+      .def("x", [](const dolfin::MeshView& self, std::size_t i)
+           { return py::array_t<double>(self.mesh()->geometry().dim(), self.x(i)); })
+      .def("cell_vertices", [](const dolfin::MeshView& self, std::size_t i)
+           { return py::array_t<unsigned int>(self.mesh()->type().num_vertices(self.dim()),
+                                              self.cell_vertices(i)); })
+      .def("parent_cell_vertices", [](const dolfin::MeshView& self, std::size_t i)
+           { return py::array_t<unsigned int>(self.mesh()->type().num_vertices(self.dim()),
+                                              self.parent_cell_vertices(i)); });
 
     // dolfin::MeshTopology class
     py::class_<dolfin::MeshTopology, std::shared_ptr<dolfin::MeshTopology>, dolfin::Variable>
@@ -119,6 +140,13 @@ namespace dolfin_wrappers
            &dolfin::MeshTopology::operator(), py::return_value_policy::reference_internal)
       .def("size", &dolfin::MeshTopology::size)
       .def("hash", &dolfin::MeshTopology::hash)
+      .def("memory_usage", (std::size_t (dolfin::MeshTopology::*)() const)
+           &dolfin::MeshTopology::memory_usage)
+      .def("memory_usage", (std::size_t (dolfin::MeshTopology::*)(std::size_t, std::size_t) const)
+           &dolfin::MeshTopology::memory_usage)
+      .def("set_memory_budget", &dolfin::MeshTopology::set_memory_budget)
+      .def("memory_budget", &dolfin::MeshTopology::memory_budget)
+      .def("enforce_memory_budget", &dolfin::MeshTopology::enforce_memory_budget)
       .def("init_global_indices", &dolfin::MeshTopology::init_global_indices)
       .def("have_global_indices", &dolfin::MeshTopology::have_global_indices)
       .def("ghost_offset", &dolfin::MeshTopology::ghost_offset)
@@ -413,13 +441,13 @@ namespace dolfin_wrappers
            &dolfin::MeshFunction<SCALAR>::operator[]) \
       .def("__setitem__", [](dolfin::MeshFunction<SCALAR>& self, \
                              std::size_t index, SCALAR value) \
-           { self.operator[](index) = value;}) \
+           { self.set_value(index, value);}) \
       .def("__getitem__", (const SCALAR& (dolfin::MeshFunction<SCALAR>::*) \
                            (const dolfin::MeshEntity&) const) \
            &dolfin::MeshFunction<SCALAR>::operator[]) \
       .def("__setitem__", [](dolfin::MeshFunction<SCALAR>& self, \
                              const dolfin::MeshEntity& index, SCALAR value) \
-           { self.operator[](index) = value;}) \
+           { self.set_value(index.index(), value);}) \
       .def("__len__", &dolfin::MeshFunction<SCALAR>::size) \
       .def("dim", &dolfin::MeshFunction<SCALAR>::dim) \
       .def("size", &dolfin::MeshFunction<SCALAR>::size) \
@@ -433,6 +461,9 @@ namespace dolfin_wrappers
       .def("set_value", (void (dolfin::MeshFunction<SCALAR>::*)(std::size_t, const SCALAR&, const dolfin::Mesh&)) \
 	   &dolfin::MeshFunction<SCALAR>::set_value) \
       .def("where_equal", &dolfin::MeshFunction<SCALAR>::where_equal) \
+      .def("compress", &dolfin::MeshFunction<SCALAR>::compress) \
+      .def("decompress", &dolfin::MeshFunction<SCALAR>::decompress) \
+      .def("compressed", &dolfin::MeshFunction<SCALAR>::compressed) \
       .def("array", [](dolfin::MeshFunction<SCALAR>& self) \
            { return Eigen::Map<Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>>(self.values(), self.size()); }, \
            py::return_value_policy::reference_internal)
@@ -458,8 +489,9 @@ namespace dolfin_wrappers
            &dolfin::MeshValueCollection<SCALAR>::set_value) \
       .def("set_value", (bool (dolfin::MeshValueCollection<SCALAR>::*)(std::size_t, std::size_t, const SCALAR&)) \
            &dolfin::MeshValueCollection<SCALAR>::set_value) \
-      .def("values", (std::map<std::pair<std::size_t, std::size_t>, SCALAR>& (dolfin::MeshValueCollection<SCALAR>::*)()) \
-           &dolfin::MeshValueCollection<SCALAR>::values, py::return_value_policy::reference) \
+      .def("values", [](const dolfin::MeshValueCollection<SCALAR>& self) \
+           { const auto& v = self.values(); \
+             return std::map<std::pair<std::size_t, std::size_t>, SCALAR>(v.begin(), v.end()); }) \
       .def("assign", [](dolfin::MeshValueCollection<SCALAR>& self, const dolfin::MeshFunction<SCALAR>& mf) { self = mf; }) \
       .def("assign", [](dolfin::MeshValueCollection<SCALAR>& self, const dolfin::MeshValueCollection<SCALAR>& other) \
          { self = other; })
@@ -502,6 +534,12 @@ namespace dolfin_wrappers
       .def_static("radius_ratio_min_max", &dolfin::MeshQuality::radius_ratio_min_max)
       .def_static("radius_ratio_matplotlib_histogram", &dolfin::MeshQuality::radius_ratio_matplotlib_histogram,
                   py::arg("mesh"), py::arg("num_bins")=50)
+      .def_static("cell_quality", &dolfin::MeshQuality::cell_quality,
+                  py::arg("mesh"), py::arg("measure"))
+      .def_static("cell_quality_min_max", &dolfin::MeshQuality::cell_quality_min_max,
+                  py::arg("mesh"), py::arg("measure"))
+      .def_static("cell_quality_histogram_data", &dolfin::MeshQuality::cell_quality_histogram_data,
+                  py::arg("mesh"), py::arg("measure"), py::arg("num_bins")=50)
       .def_static("dihedral_angles_min_max", &dolfin::MeshQuality::dihedral_angles_min_max)
       .def_static("dihedral_angles_matplotlib_histogram", &dolfin::MeshQuality::dihedral_angles_matplotlib_histogram);
 
@@ -512,6 +550,8 @@ namespace dolfin_wrappers
       .def(py::init<const dolfin::Mesh&, const dolfin::SubDomain&>())
       .def(py::init<const dolfin::Mesh&, const dolfin::MeshFunction<std::size_t>&, std::size_t>());
 
+    typedef Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> PointArray;
+
     // dolfin::SubDomain trampoline class for user overloading from
     // Python
     class PySubDomain : public dolfin::SubDomain
@@ -521,6 +561,26 @@ namespace dolfin_wrappers
       bool inside(Eigen::Ref<const Eigen::VectorXd> x, bool on_boundary) const override
       { PYBIND11_OVERLOAD(bool, dolfin::SubDomain, inside, x, on_boundary); }
 
+      // Batched version: calls 'inside_points' if defined in Python,
+      // otherwise 'inside' point by point. Python code holds the GIL,
+      // so points are never checked by several threads.
+      void inside(Eigen::Ref<const PointArray> x, bool on_boundary,
+                  Eigen::Ref<Eigen::Array<bool, Eigen::Dynamic, 1>> values) const override
+      {
+        py::gil_scoped_acquire gil;
+        py::function overload = py::get_overload(static_cast<const dolfin::SubDomain*>(this),
+                                                 "inside_points");
+        if (overload)
+        {
+          auto result = overload(x, on_boundary);
+          values = result.cast<Eigen::Array<bool, Eigen::Dynamic, 1>>();
+          return;
+        }
+
+        for (Eigen::Index i = 0; i < x.rows(); ++i)
+          values[i] = inside(x.row(i).transpose().matrix(), on_boundary);
+      }
+
       void map(Eigen::Ref<const Eigen::VectorXd> x, Eigen::Ref<Eigen::VectorXd> y) const override
       { PYBIND11_OVERLOAD(void, dolfin::SubDomain, map, x, y); }
 
@@ -534,6 +594,13 @@ namespace dolfin_wrappers
       .def(py::init<double>(), py::arg("map_tol")=1.0e-10)
       .def("inside", (bool (dolfin::SubDomain::*)(Eigen::Ref<const Eigen::VectorXd>, bool) const)
            &dolfin::SubDomain::inside)
+      .def("inside_points", [](const dolfin::SubDomain& self,
+                               Eigen::Ref<const PointArray> x, bool on_boundary)
+           {
+             Eigen::Array<bool, Eigen::Dynamic, 1> values(x.rows());
+             self.inside(x, on_boundary, values);
+             return values;
+           }, py::arg("x"), py::arg("on_boundary"))
       .def("map", (void (dolfin::SubDomain::*)(Eigen::Ref<const Eigen::VectorXd>, Eigen::Ref<Eigen::VectorXd>) const)
            &dolfin::SubDomain::map)
       .def("snap", (void (dolfin::SubDomain::*)(Eigen::Ref<Eigen::VectorXd>) const)
@@ -561,7 +628,8 @@ namespace dolfin_wrappers
       (m, "PeriodicBoundaryComputation")
       .def(py::init<>())
       .def_static("compute_periodic_pairs", &dolfin::PeriodicBoundaryComputation::compute_periodic_pairs)
-      .def_static("masters_slaves", &dolfin::PeriodicBoundaryComputation::masters_slaves);
+      .def_static("masters_slaves", &dolfin::PeriodicBoundaryComputation::masters_slaves)
+      .def_static("clear_cache", &dolfin::PeriodicBoundaryComputation::clear_cache);
 
     // dolfin::MeshColoring
     py::class_<dolfin::MeshColoring>(m, "MeshColoring")
@@ -571,7 +639,23 @@ namespace dolfin_wrappers
 
     // dolfin::MeshPartitioning
     py::class_<dolfin::MeshPartitioning>(m, "MeshPartitioning")
-      .def_static("build_distributed_mesh", (void (*)(dolfin::Mesh&)) &dolfin::MeshPartitioning::build_distributed_mesh);
+      .def_static("build_distributed_mesh", (void (*)(dolfin::Mesh&)) &dolfin::MeshPartitioning::build_distributed_mesh)
+      .def_static("repartition", &dolfin::MeshPartitioning::repartition,
+                  py::arg("mesh"), py::arg("cell_weight")=std::vector<std::size_t>())
+      .def_static("redistribute", &dolfin::MeshPartitioning::redistribute)
+      .def_static("migrate", &dolfin::MeshPartitioning::migrate<std::size_t>)
+      .def_static("migrate", &dolfin::MeshPartitioning::migrate<int>)
+      .def_static("migrate", &dolfin::MeshPartitioning::migrate<double>)
+      .def_static("migrate", &dolfin::MeshPartitioning::migrate<bool>);
+
+    // dolfin::MeshRenumbering
+    py::class_<dolfin::MeshRenumbering>(m, "MeshRenumbering")
+      .def_static("renumber_by_locality", &dolfin::MeshRenumbering::renumber_by_locality,
+                  py::arg("mesh"), py::arg("curve")="hilbert")
+      .def_static("remap", &dolfin::MeshRenumbering::remap<bool>)
+      .def_static("remap", &dolfin::MeshRenumbering::remap<int>)
+      .def_static("remap", &dolfin::MeshRenumbering::remap<std::size_t>)
+      .def_static("remap", &dolfin::MeshRenumbering::remap<double>);
 
     // dolfin::MeshTransformation
     py::class_<dolfin::MeshTransformation>(m, "MeshTransformation")
@@ -77,6 +77,35 @@ def test_cell_assembly():
     assert round(assemble(L).norm("l2") - b_l2_norm, 10) == 0
 
 
+@pytest.mark.parametrize("backend", ["PETSc", "Eigen"])
+@pytest.mark.parametrize("coloring", ["Boost", "DOLFIN"])
+def test_threaded_cell_assembly(backend, coloring, pushpop_parameters):
+    if not has_linear_algebra_backend(backend):
+        pytest.skip("Linear algebra backend {} not available".format(backend))
+    if backend == "Eigen" and MPI.size(MPI.comm_world) > 1:
+        pytest.skip("Eigen backend is serial only")
+    parameters["linear_algebra_backend"] = backend
+    parameters["graph_coloring_library"] = coloring
+
+    mesh = UnitCubeMesh(4, 4, 4)
+    V = FunctionSpace(mesh, "CG", 2)
+    f = interpolate(Expression("x[0]*x[1] + x[2]", degree=2), V)
+    v = TestFunction(V)
+    u = TrialFunction(V)
+    a = f*inner(grad(v), grad(u))*dx
+    L = f*v*dx
+    M = f*dx
+
+    A1, b1, m1 = assemble(a), assemble(L), assemble(M)
+    parameters["num_threads"] = 4
+    A4, b4, m4 = assemble(a), assemble(L), assemble(M)
+
+    assert numpy.allclose(A4.array(), A1.array(), rtol=1.0e-13, atol=1.0e-13)
+    assert numpy.allclose(b4.get_local(), b1.get_local(), rtol=1.0e-13,
+                          atol=1.0e-13)
+    assert round(m4 - m1, 12) == 0
+
+
 def test_facet_assembly(pushpop_parameters):
     parameters["ghost_mode"] = "shared_facet"
     mesh = UnitSquareMesh(24, 24)
@@ -0,0 +1,170 @@
+"""Unit tests for the binary CSR io of matrices and vectors"""
+
+# Copyright (C) 2026 The FEniCS Project
+#
+# This file is part of DOLFIN.
+#
+# DOLFIN is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# DOLFIN is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+import os
+import numpy
+import pytest
+from dolfin import *
+from dolfin_utils.test import skip_if_not_PETSc, tempdir
+
+
+@skip_if_not_PETSc
+def test_save_and_read_vector(tempdir):
+    filename = os.path.join(tempdir, "x.bin")
+
+    x = PETScVector(MPI.comm_world, 197)
+    r0, r1 = x.local_range()
+    x.set_local(numpy.arange(r0, r1, dtype=numpy.float64))
+    x.apply("insert")
+    CSRFile(MPI.comm_world, filename).write(x)
+
+    y = PETScVector(MPI.comm_world)
+    CSRFile(MPI.comm_world, filename).read(y)
+    assert y.size() == x.size()
+    assert round(y.norm("l2") - x.norm("l2"), 10) == 0
+    assert round(y.sum() - x.sum(), 10) == 0
+
+
+@skip_if_not_PETSc
+def test_save_and_read_matrix(tempdir):
+    filename = os.path.join(tempdir, "A.bin")
+
+    mesh = UnitSquareMesh(MPI.comm_world, 8, 8)
+    V = FunctionSpace(mesh, "Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    A = PETScMatrix()
+    assemble(u*v*dx + inner(grad(u), grad(v))*dx, tensor=A)
+    CSRFile(MPI.comm_world, filename).write(A)
+
+    B = PETScMatrix()
+    CSRFile(MPI.comm_world, filename).read(B)
+    assert B.size(0) == A.size(0)
+    assert B.size(1) == A.size(1)
+    assert B.nnz() == A.nnz()
+    assert round(B.norm("frobenius") - A.norm("frobenius"), 10) == 0
+
+    # Matrix-vector products agree irrespective of row distribution
+    x = PETScVector(MPI.comm_world)
+    A.init_vector(x, 1)
+    x[:] = 1.0
+    y = PETScVector(MPI.comm_world)
+    A.init_vector(y, 0)
+    A.mult(x, y)
+    CSRFile(MPI.comm_world, os.path.join(tempdir, "x.bin")).write(x)
+    xb = PETScVector(MPI.comm_world)
+    B.init_vector(xb, 1)
+    CSRFile(MPI.comm_world, os.path.join(tempdir, "x.bin")).read(xb)
+    yb = PETScVector(MPI.comm_world)
+    B.init_vector(yb, 0)
+    B.mult(xb, yb)
+    assert round(yb.norm("l2") - y.norm("l2"), 10) == 0
+
+
+@skip_if_not_PETSc
+def test_map_matrix(tempdir):
+    filename = os.path.join(tempdir, "A_map.bin")
+
+    mesh = UnitSquareMesh(MPI.comm_world, 8, 8)
+    V = FunctionSpace(mesh, "Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    A = PETScMatrix()
+    assemble(u*v*dx + inner(grad(u), grad(v))*dx, tensor=A)
+    CSRFile(MPI.comm_world, filename).write(A)
+
+    data = CSRFile(MPI.comm_world, filename).map()
+    assert data.rank == 2
+    assert data.num_rows == A.size(0)
+    assert data.num_cols == A.size(1)
+    assert data.num_nonzeros == A.nnz()
+    assert data.row_ptr.shape == (A.size(0) + 1,)
+    assert data.row_ptr[0] == 0
+    assert data.row_ptr[-1] == A.nnz()
+
+    # Mapped rows agree with the source matrix
+    row_ptr, cols, values = data.row_ptr, data.cols, data.values
+    for row in range(*A.local_range(0)):
+        row_cols, row_values = A.getrow(row)
+        r0, r1 = row_ptr[row], row_ptr[row + 1]
+        assert numpy.array_equal(cols[r0:r1], row_cols)
+        assert numpy.array_equal(values[r0:r1], row_values)
+
+    # Arrays are read-only and outlive the Python reference to the
+    # mapping
+    assert not values.flags.writeable
+    del data
+    row = A.local_range(0)[0]
+    assert numpy.array_equal(values[row_ptr[row]:row_ptr[row + 1]],
+                             A.getrow(row)[1])
+
+
+@skip_if_not_PETSc
+def test_map_vector(tempdir):
+    filename = os.path.join(tempdir, "x_map.bin")
+
+    x = PETScVector(MPI.comm_world, 197)
+    r0, r1 = x.local_range()
+    x.set_local(numpy.arange(r0, r1, dtype=numpy.float64))
+    x.apply("insert")
+    CSRFile(MPI.comm_world, filename).write(x)
+
+    data = CSRFile(MPI.comm_world, filename).map()
+    assert data.rank == 1
+    assert data.num_rows == 197
+    assert data.row_ptr is None
+    assert data.cols is None
+    assert numpy.array_equal(data.values, numpy.arange(197))
+
+
+@skip_if_not_PETSc
+def test_map_invalid_file(tempdir):
+    filename = os.path.join(tempdir, "A_valid.bin")
+
+    mesh = UnitSquareMesh(MPI.comm_self, 4, 4)
+    V = FunctionSpace(mesh, "Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    A = PETScMatrix(MPI.comm_self)
+    assemble(u*v*dx, tensor=A)
+    CSRFile(MPI.comm_self, filename).write(A)
+    with open(filename, "rb") as f:
+        data = f.read()
+
+    # Integer arrays follow the 64 byte header
+    num_rows = A.size(0)
+    ints = numpy.frombuffer(data, dtype=numpy.int64)
+    row_ptr_offset, cols_offset = 8, 8 + num_rows + 1
+
+    def corrupt(i, value):
+        corrupted = ints.copy()
+        corrupted[i] = value
+        return corrupted.tobytes()
+
+    invalid = {"truncated": data[:-8],
+               "extended": data + bytes(8),
+               "first_row_offset": corrupt(row_ptr_offset, 1),
+               "decreasing_row_offsets": corrupt(row_ptr_offset + 1, -1),
+               "last_row_offset": corrupt(cols_offset - 1, A.nnz() - 1),
+               "negative_column": corrupt(cols_offset, -1),
+               "large_column": corrupt(cols_offset, A.size(1)),
+               "num_rows": corrupt(3, 2**62)}
+    for name, corrupted in invalid.items():
+        corrupted_filename = os.path.join(tempdir, "A_%s.bin" % name)
+        with open(corrupted_filename, "wb") as f:
+            f.write(corrupted)
+        with pytest.raises(RuntimeError):
+            CSRFile(MPI.comm_self, corrupted_filename).map()
@@ -21,8 +21,12 @@
 
 import pytest
 import os
+import numpy
 from dolfin import *
 from dolfin_utils.test import skip_if_not_HDF5, fixture, tempdir, xfail_with_serial_hdf5_in_parallel
+from dolfin_utils.test import set_parameters_fixture
+
+ghost_mode = set_parameters_fixture("ghost_mode", ["none", "shared_facet", "shared_vertex"])
 
 @skip_if_not_HDF5
 @xfail_with_serial_hdf5_in_parallel
@@ -237,6 +241,65 @@ def test_save_and_read_mesh_3D(tempdir):
     dim = mesh0.topology().dim()
     assert mesh0.num_entities_global(dim) == mesh1.num_entities_global(dim)
 
+@skip_if_not_HDF5
+@xfail_with_serial_hdf5_in_parallel
+def test_save_and_read_mesh_with_partition(tempdir, ghost_mode):
+    filename = os.path.join(tempdir, "mesh_partition.h5")
+
+    # Write to file
+    mesh0 = UnitCubeMesh(6, 5, 4)
+    mesh_file = HDF5File(mesh0.mpi_comm(), filename, "w")
+    mesh_file.write(mesh0, "/my_mesh")
+    mesh_file.close()
+
+    # Read from file, restoring the partition
+    mesh1 = Mesh()
+    mesh_file = HDF5File(mesh0.mpi_comm(), filename, "r")
+    mesh_file.read(mesh1, "/my_mesh", True)
+    mesh_file.close()
+
+    # Each process holds the same cells, including ghost cells
+    dim = mesh0.topology().dim()
+    assert mesh0.num_cells() == mesh1.num_cells()
+    assert mesh0.topology().ghost_offset(dim) == mesh1.topology().ghost_offset(dim)
+    assert sorted(mesh0.topology().global_indices(dim)) \
+        == sorted(mesh1.topology().global_indices(dim))
+    assert mesh0.num_entities_global(0) == mesh1.num_entities_global(0)
+    assert mesh0.num_entities_global(dim - 1) == mesh1.num_entities_global(dim - 1)
+    assert round(assemble(1.0*dx(mesh1)) - 1.0, 10) == 0
+    assert round(assemble(1.0*ds(mesh1)) - 6.0, 10) == 0
+
+@skip_if_not_HDF5
+@xfail_with_serial_hdf5_in_parallel
+def test_save_and_read_xdmf_mesh_with_partition(tempdir, ghost_mode):
+    filename = os.path.join(tempdir, "mesh_partition.xdmf")
+
+    # Write to file (cells are written in partition order, which
+    # differs from the order of the global cell indices in parallel)
+    mesh0 = UnitCubeMesh(6, 5, 4)
+    with XDMFFile(mesh0.mpi_comm(), filename) as xdmf:
+        xdmf.write(mesh0)
+
+    # Read from file, restoring the partition
+    mesh1 = Mesh()
+    with XDMFFile(mesh0.mpi_comm(), filename) as xdmf:
+        xdmf.read(mesh1)
+
+    # Each process holds the same cells, including ghost cells
+    dim = mesh0.topology().dim()
+    assert mesh0.num_cells() == mesh1.num_cells()
+    assert mesh0.topology().ghost_offset(dim) == mesh1.topology().ghost_offset(dim)
+
+    # Owned and ghost cells keep their global indices
+    def midpoints(mesh):
+        return {c.global_index(): tuple(numpy.round(c.midpoint().array(), 10))
+                for c in cells(mesh, "all")}
+    assert midpoints(mesh0) == midpoints(mesh1)
+    assert mesh0.num_entities_global(0) == mesh1.num_entities_global(0)
+    assert mesh0.num_entities_global(dim - 1) == mesh1.num_entities_global(dim - 1)
+    assert round(assemble(1.0*dx(mesh1)) - 1.0, 10) == 0
+    assert round(assemble(1.0*ds(mesh1)) - 6.0, 10) == 0
+
 @skip_if_not_HDF5
 @xfail_with_serial_hdf5_in_parallel
 def test_mpi_atomicity(tempdir):
@@ -117,3 +117,50 @@ def test_lu_solver_reuse(backend):
 
     # Reset backend
     parameters["linear_algebra_backend"] = prev_backend
+
+
+@pytest.mark.parametrize('backend', backends)
+def test_lu_solver_same_nonzero_pattern(backend):
+    """Test numeric re-factorisation with a fixed nonzero pattern"""
+
+    # Check whether backend is available
+    if not has_linear_algebra_backend(backend):
+        pytest.skip('Need %s as backend to run this test' % backend)
+
+    # Set linear algebra backend
+    prev_backend = parameters["linear_algebra_backend"]
+    parameters["linear_algebra_backend"] = backend
+
+    mesh = UnitSquareMesh(12, 12)
+    V = FunctionSpace(mesh, "Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    b = assemble(Constant(1.0)*v*dx)
+
+    A = assemble(Constant(1.0)*u*v*dx)
+    norm = 13.0
+
+    solver = LUSolver(A)
+    solver.parameters["same_nonzero_pattern"] = True
+    x = Vector()
+    solver.solve(x, b)
+    assert round(x.norm("l2") - norm, 10) == 0
+
+    # Change values only, then refactorise
+    for scale in (0.5, 0.25):
+        assemble(Constant(scale)*u*v*dx, tensor=A)
+        solver.set_operator(A)
+        solver.solve(x, b)
+        assert round(x.norm("l2") - norm/scale, 10) == 0
+
+    # New matrices with the same pattern, which leave the earlier
+    # operators unchanged
+    A0, A0_norm = A, A.norm("frobenius")
+    for scale in (2.0, 4.0):
+        A = assemble(Constant(scale)*u*v*dx)
+        solver.set_operator(A)
+        solver.solve(x, b)
+        assert round(x.norm("l2") - norm/scale, 10) == 0
+    assert round(A0.norm("frobenius") - A0_norm, 10) == 0
+
+    # Reset backend
+    parameters["linear_algebra_backend"] = prev_backend
@@ -106,6 +106,62 @@ def test_nullspace_orthogonal():
             assert null_space.is_orthonormal()
 
 
+def test_nullspace_orthogonalize_vector():
+    """Test orthogonalisation of a vector against a null space"""
+    mesh = UnitCubeMesh(4, 4, 4)
+    V = VectorFunctionSpace(mesh, 'CG', 1)
+    x = assemble(dot(TestFunction(V), Constant((1.0, 2.0, 3.0)))*dx)
+
+    null_space = build_elastic_nullspace(V, x)
+    null_space.orthonormalize()
+
+    y = x.copy()
+    null_space.orthogonalize(y)
+    for i in range(null_space.dim()):
+        assert abs(null_space[i].inner(y)) < 1.0e-10
+
+
+def test_nullspace_linear_dependency():
+    """Test that a linearly dependent basis is detected"""
+    mesh = UnitSquareMesh(8, 8)
+    V = VectorFunctionSpace(mesh, 'CG', 1)
+    x = assemble(dot(TestFunction(V), Constant((0.0, 0.0)))*dx)
+
+    basis = [x.copy() for i in range(3)]
+    V.sub(0).dofmap().set(basis[0], 1.0)
+    V.sub(1).dofmap().set(basis[1], 1.0)
+    V.sub(0).dofmap().set(basis[2], 2.0)
+    V.sub(1).dofmap().set(basis[2], -1.0)
+    for b in basis:
+        b.apply("insert")
+
+    with pytest.raises(RuntimeError):
+        VectorSpaceBasis(basis).orthonormalize()
+
+
+@pytest.mark.parametrize('scale', [1.0e-12, 1.0, 1.0e12])
+def test_nullspace_linear_dependency_relative(scale):
+    """Test that linear dependency is detected relative to the vector
+    norms, for a combination that is only dependent up to round-off"""
+    mesh = UnitSquareMesh(8, 8)
+    V = FunctionSpace(mesh, 'CG', 1)
+    v0 = interpolate(Expression("sin(3.0*x[0])", degree=2), V).vector()
+    v1 = interpolate(Expression("x[0]*x[1] + 1.0", degree=2), V).vector()
+    v0 *= scale
+    v1 *= scale
+
+    # Independent vectors of any size are accepted
+    basis = [v0.copy(), v1.copy()]
+    VectorSpaceBasis(basis).orthonormalize()
+    assert VectorSpaceBasis(basis).is_orthonormal()
+
+    v2 = v0.copy()
+    v2 *= 0.1
+    v2.axpy(0.3, v1)
+    with pytest.raises(RuntimeError):
+        VectorSpaceBasis([v0, v1, v2]).orthonormalize()
+
+
 @pytest.mark.parametrize('backend', backends)
 def test_nullspace_check(backend):
     # Check whether backend is available
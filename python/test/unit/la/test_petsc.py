@@ -20,6 +20,8 @@ GenericFoo interface
 # You should have received a copy of the GNU Lesser General Public License
 # along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 
+import numpy
+
 from dolfin import (UnitSquareMesh, TrialFunction, TestFunction,
                     MPI, FunctionSpace, assemble, Constant, dx, 
                     parameters, has_petsc)
@@ -234,3 +236,66 @@ def test_lu_cholesky():
     solver = PETScLUSolver(mesh.mpi_comm(), A, "petsc")
     pc_type = solver.ksp().getPC().getType()
     assert pc_type == "lu"
+
+
+@skip_if_not_PETSc
+def test_matrix_csr_init(pushpop_parameters):
+    "Test PETScMatrix created directly from sparsity pattern CSR arrays"
+
+    mesh = UnitSquareMesh(MPI.comm_world, 8, 8)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    a = u*v*dx
+
+    A0 = PETScMatrix(mesh.mpi_comm())
+    assemble(a, tensor=A0)
+
+    parameters["petsc_matrix_csr_init"] = True
+    A1 = PETScMatrix(mesh.mpi_comm())
+    assemble(a, tensor=A1)
+
+    def check_equal(A0, A1):
+        assert A1.nnz() == A0.nnz()
+        assert A1.local_range(0) == A0.local_range(0)
+        for i in range(*A0.local_range(0)):
+            cols0, values0 = A0.getrow(i)
+            cols1, values1 = A1.getrow(i)
+            assert numpy.array_equal(cols1, cols0)
+            assert numpy.allclose(values1, values0, rtol=1e-14, atol=1e-14)
+
+    check_equal(A0, A1)
+
+    # Re-assembly into the same matrix
+    assemble(a, tensor=A1)
+    check_equal(A0, A1)
+
+    # Options prefix is kept when the matrix is created from CSR arrays
+    A2 = PETScMatrix(mesh.mpi_comm())
+    A2.set_options_prefix("csr_init_")
+    assemble(a, tensor=A2)
+    assert A2.get_options_prefix() == "csr_init_"
+    check_equal(A0, A2)
+
+
+@skip_if_not_petsc4py
+def test_matrix_csr_init_options(pushpop_parameters):
+    "Test that PETSc options apply to matrices with CSR preallocation"
+
+    mesh = UnitSquareMesh(MPI.comm_world, 8, 8)
+    V = FunctionSpace(mesh, "Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    a = u*v*dx
+
+    A0 = PETScMatrix(mesh.mpi_comm())
+    assemble(a, tensor=A0)
+
+    # A matrix type given as an option is used, with the default
+    # preallocation for types other than AIJ
+    parameters["petsc_matrix_csr_init"] = True
+    PETScOptions.set("csr_options_mat_type", "baij")
+    A1 = PETScMatrix(mesh.mpi_comm())
+    A1.set_options_prefix("csr_options_")
+    assemble(a, tensor=A1)
+    PETScOptions.clear("csr_options_mat_type")
+    assert A1.mat().getType() in ("seqbaij", "mpibaij")
+    assert round(A1.norm("frobenius") - A0.norm("frobenius"), 10) == 0
@@ -164,3 +164,37 @@ def test_insert_local_global(mesh, V):
             assert nnz_d[local_row] == (nnz_on_diagonal if local_row in primary_dim_local_entries else 0)
         else:
             assert nnz_od[local_row] == (nnz_off_diagonal if local_row in primary_dim_local_entries else 0)
+
+
+@pytest.mark.parametrize("integrals", [(True, False, False),
+                                       (False, True, False),
+                                       (False, False, True),
+                                       (True, True, True)])
+def test_build_threaded(mesh, integrals):
+    "Test that building with threads gives the same pattern as in serial"
+    V = FunctionSpace(mesh, "DG", 1)
+    dm = V.dofmap()
+    index_map = dm.index_map()
+
+    def build(num_threads):
+        tl = TensorLayout(mesh.mpi_comm(), 0, TensorLayout.Sparsity.SPARSE)
+        tl.init([index_map, index_map], TensorLayout.Ghosts.UNGHOSTED)
+        sp = tl.sparsity_pattern()
+        sp.init([index_map, index_map])
+        parameters["num_threads"] = num_threads
+        SparsityPatternBuilder.build(sp, mesh, [dm, dm], *integrals,
+                                     False, False, init=False, finalize=True)
+        return sp
+
+    num_threads = parameters["num_threads"]
+    try:
+        sp1 = build(1)
+        sp3 = build(3)
+    finally:
+        parameters["num_threads"] = num_threads
+
+    assert sp3.num_nonzeros() == sp1.num_nonzeros()
+    assert (sp3.num_nonzeros_diagonal() == sp1.num_nonzeros_diagonal()).all()
+    assert (sp3.num_nonzeros_off_diagonal()
+            == sp1.num_nonzeros_off_diagonal()).all()
+    assert sp3.str(True) == sp1.str(True)
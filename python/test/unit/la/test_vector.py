@@ -218,6 +218,29 @@ class TestVectorForAnyBackend:
         v0.axpy(2.0, v1)
         assert v0.sum() == 2*n + n
 
+    def test_maxpy(self, any_backend):
+        n = 301
+        v0 = Vector(MPI.comm_world, n)
+        v0[:] = 1.0
+        v1 = Vector(v0)
+        v2 = Vector(v0)
+        v2[:] = 2.0
+        v0.maxpy([2.0, -3.0], [v1, v2])
+        assert v0.sum() == (1.0 + 2.0 - 6.0)*n
+        with pytest.raises(RuntimeError):
+            v0.maxpy([1.0], [v1, v2])
+
+    def test_mdot(self, any_backend):
+        n = 301
+        v0 = Vector(MPI.comm_world, n)
+        v0[:] = 2.0
+        v1 = Vector(MPI.comm_world, n)
+        v1[:] = 3.0
+        v2 = Vector(MPI.comm_world, n)
+        v2[:] = -1.0
+        assert v0.mdot([v1, v2, v0]) == [6.0*n, -2.0*n, 4.0*n]
+        assert v0.mdot([]) == []
+
     def test_abs(self, any_backend):
         n = 301
         v0 = Vector(MPI.comm_world, n)
@@ -756,3 +756,34 @@ def test_mesh_connectivity_lifetime():
     assert sys.getrefcount(conn) == rc + 1
     del cells
     assert sys.getrefcount(conn) == rc
+
+
+def test_mesh_topology_memory_budget():
+    """Check that connectivity is evicted when the memory budget is
+    enforced and recomputed on demand"""
+    mesh = UnitCubeMesh(MPI.comm_self, 4, 4, 4)
+    topology = mesh.topology()
+    mesh.init(0, 3)
+    num_connections = topology(0, 3).size()
+    assert topology.memory_usage(0, 3) > 0
+    assert topology.memory_usage() >= topology.memory_usage(0, 3)
+
+    # Computing new connectivity does not evict anything
+    topology.set_memory_budget(1)
+    mesh.init(1, 3)
+    assert topology(0, 3).size() == num_connections
+    assert topology(1, 3).size() > 0
+
+    # Enforcing the budget evicts least recently used connectivity
+    topology.set_memory_budget(topology.memory_usage() - topology.memory_usage(0, 3))
+    assert topology.enforce_memory_budget() > 0
+    assert topology(0, 3).size() == 0
+    assert topology(1, 3).size() > 0
+    assert topology(3, 0).size() > 0
+
+    # Evicted connectivity is recomputed on demand
+    mesh.init(0, 3)
+    assert topology(0, 3).size() == num_connections
+    topology.enforce_memory_budget()
+    assert topology(0, 3).size() == num_connections
+    assert topology(1, 3).size() == 0
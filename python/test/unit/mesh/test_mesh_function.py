@@ -158,3 +158,31 @@ def test_meshfunction_where_equal():
     vf[2] = 1
     assert list(vf.where_equal(1)) == [1, 2]
     assert list(vf.where_equal(3)) == [0] + list(range(3, vf.size()))
+
+
+def test_meshfunction_compress():
+    mesh = UnitSquareMesh(4, 4)
+    ff = MeshFunction("size_t", mesh, mesh.topology().dim()-1, 0)
+    ff[2] = 3
+    ff[3] = 3
+    ff[7] = 1
+    values = ff.array().copy()
+
+    ff.compress(0)
+    assert ff.compressed()
+    assert [ff[i] for i in range(ff.size())] == list(values)
+    assert list(ff.where_equal(3)) == [2, 3]
+
+    # Setting values keeps the function compressed
+    ff[4] = 3
+    assert ff.compressed()
+    assert list(ff.where_equal(3)) == [2, 3, 4]
+
+    # Array access requires explicit decompression
+    with pytest.raises(RuntimeError):
+        ff.array()
+    assert ff.compressed()
+    ff.decompress()
+    assert not ff.compressed()
+    values[4] = 3
+    assert (ff.array() == values).all()
@@ -0,0 +1,133 @@
+"Unit tests for redistributing meshes and migrating data"
+
+# Copyright (C) 2026 The FEniCS Project
+#
+# This file is part of DOLFIN.
+#
+# DOLFIN is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# DOLFIN is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+import pytest
+import numpy
+from dolfin import *
+
+from dolfin_utils.test import pushpop_parameters
+
+
+def strip(mesh, c):
+    "Destination process of cell c when partitioning by y strips"
+    size = MPI.size(mesh.mpi_comm())
+    return min(size - 1, int(Cell(mesh, c).midpoint()[1]*size))
+
+
+def test_redistribute():
+    """Move cells to prescribed processes and migrate markers and
+    mesh functions"""
+    mesh = UnitSquareMesh(12, 9)
+    for c in cells(mesh):
+        mesh.domains().set_marker((c.index(), 7 if c.midpoint()[0] < 0.5 else 1), 2)
+    cf = MeshFunction("double", mesh, 2, 0.0)
+    for c in cells(mesh):
+        cf[c] = c.midpoint()[0] + 2.0*c.midpoint()[1]
+    ef = MeshFunction("size_t", mesh, 1, 0)
+    for e in edges(mesh):
+        ef[e] = int(1000*e.midpoint()[0]) + 1000000*int(1000*e.midpoint()[1])
+
+    destinations = [strip(mesh, c) for c in range(mesh.num_cells())]
+    mesh2 = MeshPartitioning.redistribute(mesh, destinations)
+
+    rank = MPI.rank(mesh.mpi_comm())
+    assert mesh2.num_entities_global(2) == mesh.num_entities_global(2)
+    assert all(strip(mesh2, c) == rank for c in range(mesh2.num_cells()))
+    assert numpy.isclose(MPI.sum(mesh2.mpi_comm(),
+                                 sum(c.volume() for c in cells(mesh2))), 1.0)
+
+    markers = MeshFunction("size_t", mesh2, 2, mesh2.domains())
+    for c in cells(mesh2):
+        assert markers[c] == (7 if c.midpoint()[0] < 0.5 else 1)
+
+    cf2 = MeshFunction("double", mesh2, 2, -1.0)
+    MeshPartitioning.migrate(cf, cf2)
+    for c in cells(mesh2):
+        assert numpy.isclose(cf2[c], c.midpoint()[0] + 2.0*c.midpoint()[1])
+
+    ef2 = MeshFunction("size_t", mesh2, 1, 0)
+    MeshPartitioning.migrate(ef, ef2)
+    for e in edges(mesh2):
+        assert ef2[e] == int(1000*e.midpoint()[0]) + 1000000*int(1000*e.midpoint()[1])
+
+
+def test_migrate_function():
+    """Migrate a Function to a redistributed mesh"""
+    mesh = UnitSquareMesh(8, 8)
+    V = FunctionSpace(mesh, "CG", 2)
+    u = interpolate(Expression("x[0]*x[0] + 3*x[1]", degree=2), V)
+
+    destinations = [strip(mesh, c) for c in range(mesh.num_cells())]
+    mesh2 = MeshPartitioning.redistribute(mesh, destinations)
+    V2 = FunctionSpace(mesh2, "CG", 2)
+    u2 = Function(V2)
+    migrate(u, u2)
+
+    for c in cells(mesh2):
+        x = c.midpoint()
+        assert numpy.isclose(u2(x), x[0]*x[0] + 3*x[1])
+    assert numpy.isclose(assemble(u2*dx(mesh2)), assemble(u*dx(mesh)))
+
+
+@pytest.mark.parametrize("partitioner", ["RCB", "Hilbert"])
+@pytest.mark.parametrize("ghost_mode", ["none", "shared_facet", "shared_vertex"])
+def test_geometric_partitioner(pushpop_parameters, partitioner, ghost_mode):
+    """Distribute meshes with the native partitioners"""
+    parameters["mesh_partitioner"] = partitioner
+    parameters["ghost_mode"] = ghost_mode
+    for passes in [0, 4]:
+        parameters["partitioning_refinement_passes"] = passes
+        mesh = UnitCubeMesh(6, 5, 4)
+        comm = mesh.mpi_comm()
+        num_cells = mesh.topology().ghost_offset(3)
+        assert MPI.sum(comm, num_cells) == 6*6*5*4
+        assert numpy.isclose(MPI.sum(comm, sum(c.volume() for c in cells(mesh))), 1.0)
+
+        # Balanced to within the refinement tolerance
+        assert MPI.max(comm, num_cells) <= 1.05*6*6*5*4/MPI.size(comm) + 1
+
+
+@pytest.mark.parametrize("ghost_mode", ["none", "shared_facet", "shared_vertex"])
+def test_block_generation(pushpop_parameters, ghost_mode):
+    """Generate distributed built-in meshes block by block"""
+    parameters["ghost_mode"] = ghost_mode
+    meshes = []
+    for generation in ["partition", "block"]:
+        parameters["mesh_generation"] = generation
+        meshes.append([UnitCubeMesh(5, 4, 3), UnitSquareMesh(7, 5),
+                       UnitSquareMesh(7, 5, "crossed"),
+                       UnitSquareMesh.create(6, 9, CellType.Type.quadrilateral)])
+
+    for mesh0, mesh1 in zip(*meshes):
+        comm = mesh1.mpi_comm()
+        tdim = mesh1.topology().dim()
+        for d in [0, 1, tdim]:
+            mesh0.init_global(d)
+            mesh1.init_global(d)
+            assert mesh1.num_entities_global(d) == mesh0.num_entities_global(d)
+
+        # Regular cells cover the mesh once, with the serial global
+        # cell indices
+        num_cells = mesh1.topology().ghost_offset(tdim)
+        assert MPI.sum(comm, num_cells) == mesh0.num_entities_global(tdim)
+        indices = mesh1.topology().global_indices(tdim)[:num_cells]
+        assert MPI.sum(comm, float(sum(indices))) \
+            == sum(range(mesh0.num_entities_global(tdim)))
+        volume = sum(Cell(mesh1, c).volume() for c in range(num_cells))
+        assert numpy.isclose(MPI.sum(comm, volume), 1.0)
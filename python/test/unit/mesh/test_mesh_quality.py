@@ -120,3 +120,36 @@ def test_dihedral_angles_matplotlib():
     mesh = UnitCubeMesh(12, 12, 12)
     test = MeshQuality.dihedral_angles_matplotlib_histogram(mesh, 5)
     print(test)
+
+
+def test_cell_quality():
+    mesh = UnitCubeMesh(4, 4, 4)
+    volumes = MeshQuality.cell_quality(mesh, "volume")
+    ratios = MeshQuality.cell_quality(mesh, "radius_ratio")
+    for c in cells(mesh):
+        assert round(volumes[c] - c.volume(), 10) == 0
+        assert round(ratios[c] - c.radius_ratio(), 10) == 0
+
+    angle_min, angle_max = MeshQuality.cell_quality_min_max(mesh, "min_angle")
+    dang_min, dang_max = MeshQuality.dihedral_angles_min_max(mesh)
+    assert round(angle_min - dang_min, 10) == 0
+
+    bins, values = MeshQuality.cell_quality_histogram_data(mesh, "edge_ratio", 4)
+    assert len(bins) == 4
+    assert MPI.sum(mesh.mpi_comm(), mesh.num_cells()) == sum(values)
+
+
+@skip_in_parallel
+def test_cell_quality_quadrilateral_hexahedron():
+    mesh = UnitSquareMesh.create(3, 3, CellType.Type.quadrilateral)
+    vmin, vmax = MeshQuality.cell_quality_min_max(mesh, "volume")
+    assert round(vmin - 1.0/9.0, 10) == 0
+    assert round(vmax - 1.0/9.0, 10) == 0
+
+    mesh = UnitCubeMesh.create(2, 2, 2, CellType.Type.hexahedron)
+    mesh.coordinates()[:, 0] *= 2.0
+    assert round(sum(MeshQuality.cell_quality(mesh, "volume").array()) - 2.0, 10) == 0
+    amin, amax = MeshQuality.cell_quality_min_max(mesh, "min_angle")
+    assert round(amin - numpy.pi/2, 10) == 0
+    emin, emax = MeshQuality.cell_quality_min_max(mesh, "edge_ratio")
+    assert round(emax - 2.0, 10) == 0
@@ -0,0 +1,83 @@
+"""Unit tests for mesh renumbering"""
+
+# Copyright (C) 2026 The FEniCS Project
+#
+# This file is part of DOLFIN.
+#
+# DOLFIN is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# DOLFIN is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+import pytest
+import numpy
+from dolfin import *
+from dolfin_utils.test import skip_in_parallel
+
+
+@skip_in_parallel
+@pytest.mark.parametrize("curve", ["hilbert", "morton"])
+def test_renumber_by_locality(curve):
+    """Renumber cells and vertices along a space-filling curve."""
+    mesh = UnitCubeMesh(6, 6, 6)
+    mesh.init(2)
+    volume = sum(c.volume() for c in cells(mesh))
+
+    # Attach cell markers and create a facet function
+    for c in cells(mesh):
+        mesh.domains().set_marker((c.index(), int(c.midpoint()[0] > 0.5)), 3)
+    ff = MeshFunction("size_t", mesh, 2)
+    for f in facets(mesh):
+        ff[f] = int(1000*f.midpoint()[1])
+    old_x = [Facet(mesh, i).midpoint()[1] for i in range(mesh.num_facets())]
+
+    new_indices = MeshRenumbering.renumber_by_locality(mesh, curve)
+    MeshRenumbering.remap(ff, new_indices)
+
+    # Mesh is still ordered and geometry unchanged
+    assert mesh.ordered()
+    assert numpy.isclose(sum(c.volume() for c in cells(mesh)), volume)
+    assert mesh.num_facets() == len(old_x)
+    assert sorted(new_indices[3]) == list(range(mesh.num_cells()))
+
+    # Markers and mesh functions follow the entities
+    markers = MeshFunction("size_t", mesh, 3, mesh.domains())
+    for c in cells(mesh):
+        assert markers[c] == int(c.midpoint()[0] > 0.5)
+    for f in facets(mesh):
+        assert ff[f] == int(1000*f.midpoint()[1])
+    for i, y in enumerate(old_x):
+        assert numpy.isclose(Facet(mesh, new_indices[2][i]).midpoint()[1], y)
+
+    # Neighbouring cells are close in memory
+    jumps = [abs(c0.index() - c1.index()) for c0 in cells(mesh)
+             for c1 in entities(c0, 3)]
+    assert numpy.median(jumps) < mesh.num_cells()/10
+
+
+@skip_in_parallel
+@pytest.mark.parametrize("curve", ["hilbert", "morton"])
+def test_renumber_by_locality_1d(curve):
+    """Renumber an interval mesh, which orders cells and vertices by
+    coordinate."""
+    mesh = UnitIntervalMesh(40)
+    length = sum(c.volume() for c in cells(mesh))
+
+    # Reverse the vertex coordinates so that the numbering changes
+    mesh.coordinates()[:] = 1.0 - mesh.coordinates()
+
+    MeshRenumbering.renumber_by_locality(mesh, curve)
+    assert mesh.ordered()
+    assert numpy.isclose(sum(c.volume() for c in cells(mesh)), length)
+    x = mesh.coordinates()[:, 0]
+    assert numpy.all(numpy.diff(x) > 0.0)
+    midpoints = [c.midpoint()[0] for c in cells(mesh)]
+    assert numpy.all(numpy.diff(midpoints) > 0.0)
@@ -115,3 +115,62 @@ def test_make_edges_view(cube):
     assert m2.num_cells() == c
     assert m2.num_cells() == len(m2.topology().mapping()[cube.id()].cell_map())
     assert m2.num_vertices() == len(m2.topology().mapping()[cube.id()].vertex_map())
+
+
+@skip_in_parallel
+def test_make_view_from_entity_list(cube):
+    """Create view from a list of entities and from a compressed marker"""
+
+    marker = MeshFunction("size_t", cube, 2, 0)
+    for i in range(0, marker.size(), 5):
+        marker.set_value(i, 1)
+    entities = marker.where_equal(1)
+
+    m1 = MeshView.create(marker, 1)
+    m2 = MeshView.create(cube, 2, entities)
+    marker.compress(0)
+    m3 = MeshView.create(marker, 1)
+
+    for m in (m1, m2, m3):
+        mapping = m.topology().mapping()[cube.id()]
+        assert m.num_cells() == len(entities)
+        assert list(mapping.cell_map()) == list(entities)
+        vertex_map = mapping.vertex_map()
+        assert m.num_vertices() == len(vertex_map)
+        for c in range(m.num_cells()):
+            view_vertices = sorted(vertex_map[v] for v in
+                                   m.topology()(2, 0)(c))
+            parent_vertices = sorted(cube.topology()(2, 0)(entities[c]))
+            assert view_vertices == parent_vertices
+        x = cube.coordinates()[vertex_map]
+        assert (m.coordinates() == x).all()
+
+
+@skip_in_parallel
+def test_create_view_without_mesh(cube):
+    """Create a view which references the parent mesh instead of
+    building a new Mesh"""
+
+    marker = MeshFunction("size_t", cube, 2, 0)
+    for i in range(0, marker.size(), 3):
+        marker.set_value(i, 1)
+    entities = marker.where_equal(1)
+
+    m = MeshView.create(marker, 1)
+    mapping = m.topology().mapping()[cube.id()]
+    view = MeshView.create_view(marker, 1)
+    assert view.dim() == 2
+    assert view.num_cells() == len(entities)
+    assert list(view.cell_map()) == list(entities)
+    assert list(view.vertex_map()) == list(mapping.vertex_map())
+    assert view.num_vertices() == m.num_vertices()
+
+    x = cube.coordinates()
+    vertex_map = view.vertex_map()
+    for v in range(view.num_vertices()):
+        assert (view.x(v) == x[vertex_map[v]]).all()
+    for c in range(view.num_cells()):
+        parent_vertices = cube.topology()(2, 0)(entities[c])
+        assert list(view.parent_cell_vertices(c)) == list(parent_vertices)
+        assert [vertex_map[v] for v in view.cell_vertices(c)] \
+            == list(parent_vertices)
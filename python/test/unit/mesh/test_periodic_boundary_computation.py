@@ -65,3 +65,18 @@ def test_MastersSlaves(periodic_boundary, mesh):
     mf = PeriodicBoundaryComputation.masters_slaves(mesh, periodic_boundary, 1)
     assert len(np.where(mf.array() == 1)[0]) == 4
     assert len(np.where(mf.array() == 2)[0]) == 4
+
+
+@skip_in_parallel
+def test_cached_periodic_pairs(periodic_boundary, mesh):
+
+    # Verify that pairs are reused, and recomputed when the mesh moves
+    pairs = PeriodicBoundaryComputation.compute_periodic_pairs(mesh, periodic_boundary, 0)
+    assert PeriodicBoundaryComputation.compute_periodic_pairs(mesh, periodic_boundary, 0) == pairs
+
+    mesh.translate(Point(1.0, 0.0))
+    assert len(PeriodicBoundaryComputation.compute_periodic_pairs(mesh, periodic_boundary, 0)) == 0
+
+    mesh.translate(Point(-1.0, 0.0))
+    PeriodicBoundaryComputation.clear_cache(mesh)
+    assert PeriodicBoundaryComputation.compute_periodic_pairs(mesh, periodic_boundary, 0) == pairs
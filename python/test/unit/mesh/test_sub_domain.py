@@ -227,3 +227,36 @@ def test_snap_boundary():
             for x_i in x:
                 assert x_i==0.0
     
+
+
+def test_batched_marking():
+
+    class Left(SubDomain):
+        def inside(self, x, on_boundary):
+            return x[0] < 0.5 + DOLFIN_EPS
+
+    class LeftPoints(SubDomain):
+        def inside_points(self, x, on_boundary):
+            return x[:, 0] < 0.5 + DOLFIN_EPS
+
+    left = Left()
+    assert (left.inside_points(np.array([[0.25, 0.0], [0.75, 0.0]]), False)
+            == [True, False]).all()
+
+    mesh = UnitCubeMesh(6, 6, 6)
+    compiled = CompiledSubDomain("x[0] < 0.5 + DOLFIN_EPS")
+    num_threads = parameters["num_threads"]
+    for dim in range(4):
+        reference = MeshFunction("size_t", mesh, dim, 0)
+        left.mark(reference, 1)
+        assert (reference.array() == 1).any()
+
+        f = MeshFunction("size_t", mesh, dim, 0)
+        LeftPoints().mark(f, 1)
+        assert (f.array() == reference.array()).all()
+
+        parameters["num_threads"] = 3
+        f = MeshFunction("size_t", mesh, dim, 0)
+        compiled.mark(f, 1)
+        parameters["num_threads"] = num_threads
+        assert (f.array() == reference.array()).all()
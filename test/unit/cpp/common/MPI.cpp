@@ -0,0 +1,202 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Unit tests for sparse and nonblocking MPI exchanges and for the
+// MPI communication profiler
+
+#include <dolfin.h>
+#include <catch.hpp>
+
+using namespace dolfin;
+
+TEST_CASE("MPI exchanges")
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  const std::size_t size = dolfin::MPI::size(comm);
+  const std::size_t rank = dolfin::MPI::rank(comm);
+
+  // Each process sends (rank + 1) values to itself and to the next
+  // two processes only
+  std::vector<std::vector<std::int64_t>> send(size);
+  for (std::size_t k = 0; k < std::min(size, (std::size_t) 3); ++k)
+  {
+    const std::size_t p = (rank + k) % size;
+    send[p].assign(rank + 1, 100*rank + p);
+  }
+
+  SECTION("sparse all-to-all")
+  {
+    // Repeat to check that consecutive exchanges are kept apart
+    for (int i = 0; i < 3; ++i)
+    {
+      std::vector<std::vector<std::int64_t>> recv;
+      dolfin::MPI::sparse_all_to_all(comm, send, recv);
+      REQUIRE(recv.size() == size);
+      for (std::size_t p = 0; p < size; ++p)
+      {
+        const std::size_t k = (rank + size - p) % size;
+        if (k < 3)
+          CHECK(recv[p] == std::vector<std::int64_t>(p + 1, 100*p + rank));
+        else
+          CHECK(recv[p].empty());
+      }
+    }
+
+    // Exchange on a communicator that is freed afterwards, together
+    // with the duplicate cached for the exchange
+    {
+      dolfin::MPI::Comm dup(comm);
+      std::vector<std::vector<std::int64_t>> recv;
+      dolfin::MPI::sparse_all_to_all(dup.comm(), send, recv);
+      REQUIRE(recv.size() == size);
+      CHECK(recv[rank] == send[rank]);
+    }
+  }
+
+  SECTION("nonblocking exchange")
+  {
+    // Receive sizes are known from the communication pattern
+    std::vector<std::size_t> recv_sizes(size, 0);
+    for (std::size_t k = 0; k < std::min(size, (std::size_t) 3); ++k)
+    {
+      const std::size_t p = (rank + size - k) % size;
+      recv_sizes[p] = p + 1;
+    }
+
+    // Pending requests refer to the buffers, so copying is disabled
+    static_assert(!std::is_copy_constructible<
+                  dolfin::MPI::NonblockingExchange<std::int64_t>>::value,
+                  "NonblockingExchange must not be copyable");
+
+    // Messages of the same shape from the next process on comm, with
+    // the tags used by the exchanges, must not be matched by the
+    // exchange, and neither must the messages of a sparse all-to-all
+    // while it is pending
+    const int next = (rank + 1) % size;
+    const int previous = (rank + size - 1) % size;
+    const std::vector<std::int64_t> user_send(next + 1, -1);
+    std::vector<std::vector<std::int64_t>> user_recv(3,
+      std::vector<std::int64_t>(rank + 1));
+    std::vector<MPI_Request> user_requests(6);
+    for (int tag = 0; tag < 3; ++tag)
+    {
+      MPI_Isend(user_send.data(), user_send.size(), MPI_INT64_T, next, tag,
+                comm, &user_requests[tag]);
+    }
+    std::vector<std::vector<std::int64_t>> sparse_send = send;
+
+    dolfin::MPI::NonblockingExchange<std::int64_t> exchange;
+    exchange.start(comm, send, recv_sizes);
+    CHECK(send.empty());
+    std::vector<std::vector<std::int64_t>> sparse_recv;
+    dolfin::MPI::sparse_all_to_all(comm, sparse_send, sparse_recv);
+    CHECK(sparse_recv[rank] == sparse_send[rank]);
+    const std::vector<std::vector<std::int64_t>>& recv = exchange.wait();
+
+    for (int tag = 0; tag < 3; ++tag)
+    {
+      MPI_Irecv(user_recv[tag].data(), user_recv[tag].size(), MPI_INT64_T,
+                previous, tag, comm, &user_requests[3 + tag]);
+    }
+    MPI_Waitall(6, user_requests.data(), MPI_STATUSES_IGNORE);
+    for (int tag = 0; tag < 3; ++tag)
+      CHECK(user_recv[tag] == std::vector<std::int64_t>(rank + 1, -1));
+    REQUIRE(recv.size() == size);
+    for (std::size_t p = 0; p < size; ++p)
+    {
+      if (recv_sizes[p] > 0)
+        CHECK(recv[p] == std::vector<std::int64_t>(p + 1, 100*p + rank));
+      else
+        CHECK(recv[p].empty());
+    }
+  }
+}
+
+TEST_CASE("MPI neighbourhood communicator")
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  const int size = dolfin::MPI::size(comm);
+  const int rank = dolfin::MPI::rank(comm);
+
+  // Previous and next process in a ring
+  std::set<int> ring = {(rank + 1) % size, (rank + size - 1) % size};
+  ring.erase(rank);
+  const std::vector<int> neighbours(ring.begin(), ring.end());
+
+  // The communicator is owned, so it can be moved but not copied
+  static_assert(!std::is_copy_constructible<dolfin::MPI::NeighbourComm>::value,
+                "NeighbourComm must not be copyable");
+  dolfin::MPI::NeighbourComm neighbour_comm0(comm, neighbours);
+  dolfin::MPI::NeighbourComm neighbour_comm(std::move(neighbour_comm0));
+  CHECK(neighbour_comm0.neighbours().empty());
+  REQUIRE(neighbour_comm.neighbours() == neighbours);
+
+  const std::vector<std::vector<int>> send(neighbours.size(),
+                                           std::vector<int>(1, rank));
+  std::vector<std::vector<int>> recv;
+  neighbour_comm.all_to_all(send, recv);
+  REQUIRE(recv.size() == neighbours.size());
+  for (std::size_t i = 0; i < neighbours.size(); ++i)
+    CHECK(recv[i] == std::vector<int>(1, neighbours[i]));
+}
+
+TEST_CASE("MPI communication profiler")
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  const std::size_t rank = dolfin::MPI::rank(comm);
+
+  // Discard earlier records and profile communication inside and
+  // outside a timed task
+  dolfin::MPI::Profiler::summary(comm, true);
+  dolfin::MPI::Profiler::enable();
+  {
+    // Running timers are tracked by address, so they cannot be copied
+    // or moved
+    static_assert(!std::is_copy_constructible<Timer>::value
+                  && !std::is_move_constructible<Timer>::value,
+                  "Timer must not be copyable or movable");
+    Timer timer("Profiled task");
+    for (int i = 0; i < 3; ++i)
+      dolfin::MPI::sum(comm, 1.0);
+    std::vector<std::vector<std::int64_t>> out_values;
+    dolfin::MPI::all_gather(comm, std::vector<std::int64_t>(2, rank),
+                            out_values);
+  }
+  dolfin::MPI::max(comm, 1);
+  dolfin::MPI::Profiler::enable(false);
+
+  const Table table = dolfin::MPI::Profiler::summary(comm, true);
+  if (rank == 0)
+  {
+    CHECK(table.get_value("Profiled task: sum", "calls") == 3);
+    CHECK(table.get_value("Profiled task: sum", "bytes max")
+          == 3*sizeof(double));
+    CHECK(table.get_value("Profiled task: all_gather", "calls") == 1);
+    CHECK(table.get_value("Profiled task: all_gather", "bytes avg")
+          == 2*sizeof(std::int64_t));
+    CHECK(table.get_value("max", "calls") == 1);
+
+    // Wrappers called by other wrappers are not recorded
+    const std::string s = table.str(true);
+    CHECK(s.find("all_reduce") == std::string::npos);
+  }
+
+  // Records have been cleared
+  const Table cleared = dolfin::MPI::Profiler::summary(comm, false);
+  if (rank == 0)
+    CHECK(cleared.str(true).find("sum") == std::string::npos);
+}
@@ -0,0 +1,83 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Unit tests for the thread pool and parallel_for
+
+#include <atomic>
+#include <stdexcept>
+#include <dolfin.h>
+#include <dolfin/common/threads.h>
+#include <catch.hpp>
+
+using namespace dolfin;
+
+TEST_CASE("Thread pool")
+{
+  ThreadPool pool(4);
+  CHECK(pool.size() == 4);
+
+  SECTION("run tasks")
+  {
+    std::vector<int> count(1000, 0);
+    pool.run(count.size(), [&count](std::size_t i) { ++count[i]; });
+    CHECK(count == std::vector<int>(count.size(), 1));
+  }
+
+  SECTION("nested tasks")
+  {
+    std::atomic<std::size_t> sum(0);
+    std::atomic<bool> same_pool(true);
+    pool.run(8, [&pool, &sum, &same_pool](std::size_t i)
+             {
+               if (ThreadPool::current() != nullptr
+                   and ThreadPool::current() != &pool)
+                 same_pool = false;
+               pool.run(100, [&sum, i](std::size_t j) { sum += i*100 + j; });
+             });
+    CHECK(sum == 800*799/2);
+    CHECK(same_pool);
+  }
+
+  SECTION("exceptions")
+  {
+    std::atomic<std::size_t> num_calls(0);
+    CHECK_THROWS_AS(pool.run(100, [&num_calls](std::size_t i)
+                             {
+                               ++num_calls;
+                               if (i == 50)
+                                 throw std::runtime_error("task failed");
+                             }), std::runtime_error);
+    CHECK(num_calls == 100);
+  }
+}
+
+TEST_CASE("Threaded parallel_for")
+{
+  // Chunks are the same whatever the number of threads in the pool
+  parameters["num_threads"] = 3;
+  std::vector<std::size_t> chunks(5*2, 0);
+  parallel_for(5, 103, [&chunks](std::size_t t, std::size_t begin,
+                                 std::size_t end)
+               {
+                 chunks[2*t] = begin;
+                 chunks[2*t + 1] = end;
+               });
+  CHECK(chunks == std::vector<std::size_t>({0, 20, 20, 41, 41, 61, 61, 82,
+                                            82, 103}));
+  CHECK(SubSystemsManager::thread_pool().size() == 3);
+  parameters["num_threads"] = 1;
+}
@@ -0,0 +1,51 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Unit tests for threaded construction of bounding box trees
+
+#include <dolfin.h>
+#include <catch.hpp>
+
+using namespace dolfin;
+
+TEST_CASE("Threaded bounding box tree")
+{
+  UnitCubeMesh mesh(MPI_COMM_SELF, 10, 9, 8);
+
+  parameters["num_threads"] = 1;
+  BoundingBoxTree serial_tree;
+  serial_tree.build(mesh);
+
+  parameters["num_threads"] = 4;
+  BoundingBoxTree tree;
+  tree.build(mesh);
+  parameters["num_threads"] = 1;
+
+  // Trees are the same, so queries give the same results in the same
+  // order
+  for (double x : {0.0, 0.13, 0.5, 0.77, 1.0})
+  {
+    const Point p(x, 1.0 - x, 0.3*x + 0.2);
+    CHECK(tree.compute_collisions(p) == serial_tree.compute_collisions(p));
+    CHECK(tree.compute_entity_collisions(p)
+          == serial_tree.compute_entity_collisions(p));
+    CHECK(tree.compute_closest_entity(p)
+          == serial_tree.compute_closest_entity(p));
+  }
+  CHECK(tree.compute_collisions(serial_tree)
+        == serial_tree.compute_collisions(serial_tree));
+}
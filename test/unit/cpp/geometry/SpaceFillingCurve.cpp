@@ -0,0 +1,65 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Unit tests for SpaceFillingCurve
+
+#include <algorithm>
+#include <vector>
+#include <dolfin.h>
+#include <catch.hpp>
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Space-filling curve")
+{
+  SECTION("1D curve is monotone and clamped to the interval")
+  {
+    for (std::string curve : {"hilbert", "morton"})
+    {
+      const SpaceFillingCurve key({-1.0}, {2.0}, curve);
+      CHECK(key.bits() == 32);
+
+      std::vector<std::uint64_t> keys;
+      for (std::size_t i = 0; i <= 300; ++i)
+      {
+        const double x = -1.0 + 0.01*i;
+        keys.push_back(key(&x));
+      }
+      CHECK(std::is_sorted(keys.begin(), keys.end()));
+      CHECK(keys.front() == 0);
+      CHECK(keys.back() == (std::uint64_t(1) << 32) - 1);
+
+      // Points outside the interval map to the end points
+      const double x0 = -5.0, x1 = 1.0e10;
+      CHECK(key(&x0) == keys.front());
+      CHECK(key(&x1) == keys.back());
+    }
+  }
+
+  SECTION("Points outside the box are clamped")
+  {
+    for (std::string curve : {"hilbert", "morton"})
+    {
+      const SpaceFillingCurve key({0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}, curve);
+      const double x0[3] = {-1.0, 0.5, 2.0}, y0[3] = {0.0, 0.5, 1.0};
+      const double x1[3] = {1.0e30, -1.0e30, 0.25}, y1[3] = {1.0, 0.0, 0.25};
+      CHECK(key(x0) == key(y0));
+      CHECK(key(x1) == key(y1));
+    }
+  }
+}
@@ -0,0 +1,90 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Unit tests for GraphBuilder
+
+#include <dolfin.h>
+#include <catch.hpp>
+
+using namespace dolfin;
+
+namespace
+{
+  // Check that a CSR graph has the same (sorted) edges as a graph
+  bool same_graph(const CSRGraph<int>& csr_graph, const Graph& graph)
+  {
+    if (csr_graph.size() != graph.size())
+      return false;
+    for (std::size_t i = 0; i < graph.size(); ++i)
+    {
+      std::vector<int> edges(graph[i].begin(), graph[i].end());
+      edges.erase(std::remove(edges.begin(), edges.end(), (int) i),
+                  edges.end());
+      std::sort(edges.begin(), edges.end());
+      if (!std::equal(edges.begin(), edges.end(), csr_graph[i].begin())
+          or edges.size() != csr_graph[i].size())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+TEST_CASE("GraphBuilder")
+{
+  SECTION("CSR graphs of mesh entities")
+  {
+    UnitCubeMesh mesh(MPI_COMM_SELF, 5, 4, 3);
+    const std::size_t D = mesh.topology().dim();
+    for (std::size_t num_threads : {1, 3})
+    {
+      parameters["num_threads"] = (int) num_threads;
+      for (auto dims : std::vector<std::pair<std::size_t, std::size_t>>
+             {{D, 0}, {D, 1}, {D, D - 1}, {0, 1}, {0, D}, {1, D}})
+      {
+        const CSRGraph<int> csr_graph
+          = GraphBuilder::local_csr_graph(mesh, dims.first, dims.second);
+        CHECK(same_graph(csr_graph,
+                         GraphBuilder::local_graph(mesh, dims.first,
+                                                   dims.second)));
+      }
+    }
+    parameters["num_threads"] = 1;
+
+    const CSRGraph<int> dual_graph = GraphBuilder::local_csr_dual_graph(mesh);
+    CHECK(same_graph(dual_graph, GraphBuilder::local_graph(mesh, D, D - 1)));
+  }
+
+  SECTION("CSR graph of cell nodes")
+  {
+    // Two triangles (0, 1, 2) and (1, 2, 3), and an isolated node 4
+    const std::vector<int> cell_offsets = {0, 3, 6};
+    const std::vector<int> cell_nodes = {2, 0, 1, 1, 3, 2};
+    const CSRGraph<int> graph
+      = GraphBuilder::local_csr_graph(5, cell_offsets, cell_nodes);
+    CHECK(graph.nodes() == std::vector<int>({0, 2, 5, 8, 10, 10}));
+    CHECK(graph.edges()
+          == std::vector<int>({1, 2, 0, 2, 3, 0, 1, 3, 1, 2}));
+
+    // Reverse Cuthill-McKee ordering is a permutation
+    std::vector<int> map = BoostGraphOrdering::compute_cuthill_mckee(graph,
+                                                                     true);
+    std::sort(map.begin(), map.end());
+    CHECK(map == std::vector<int>({0, 1, 2, 3, 4}));
+  }
+}
@@ -34,8 +34,7 @@ TEST_CASE("MeshValueCollection IO test", "[!hide][meshvaluecollection_io]")
   CHECK(dolfin::MPI::sum(mesh->mpi_comm(), markers.size()) == (std::size_t) 6);
 
   // Check sum of values
-  const std::map<std::pair<std::size_t, std::size_t>, std::size_t>&
-    values = markers.values();
+  const auto& values = markers.values();
   std::size_t sum = 0;
   for (auto it = values.begin(); it != values.end(); ++it)
     sum += it->second;
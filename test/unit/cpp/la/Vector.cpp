@@ -61,6 +61,34 @@ namespace
     v*=u;
     CHECK(v.sum() == v.size()*5.0);
   }
+
+  void _test_fused_operations(MPI_Comm comm)
+  {
+    Vector x(comm, 10), y(comm, 10), z(comm, 10);
+    x = 1.0;
+    y = 2.0;
+    z = 3.0;
+
+    // axpby: x = 2*y + 3*x
+    x.axpby(2.0, y, 3.0);
+    CHECK(x.sum() == 7.0*x.size());
+
+    // maxpy: x = x + y - z
+    x.maxpy({1.0, -1.0}, {&y, &z});
+    CHECK(x.sum() == 6.0*x.size());
+
+    // mdot
+    const std::vector<double> dots = x.mdot({&x, &y, &z});
+    CHECK(dots.size() == 3);
+    CHECK(dots[0] == Approx(x.inner(x)));
+    CHECK(dots[1] == Approx(x.inner(y)));
+    CHECK(dots[2] == Approx(x.inner(z)));
+
+    // inner_and_norm
+    const std::pair<double, double> dot_norm = x.inner_and_norm(y);
+    CHECK(dot_norm.first == Approx(x.inner(y)));
+    CHECK(dot_norm.second == Approx(x.norm("l2")));
+  }
 }
 
 
@@ -71,11 +99,13 @@ TEST_CASE("Test Vector", "[test_vector]")
     // Eigen
     parameters["linear_algebra_backend"] = "Eigen";
     _test_operators(MPI_COMM_SELF);
+    _test_fused_operations(MPI_COMM_SELF);
 
     // PETSc
 #ifdef HAS_PETSC
     parameters["linear_algebra_backend"] = "PETSc";
     _test_operators(MPI_COMM_WORLD);
+    _test_fused_operations(MPI_COMM_WORLD);
 #endif
   }
 
@@ -0,0 +1,105 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Unit tests for the global numbering of distributed mesh entities
+
+#include <dolfin.h>
+#include <catch.hpp>
+
+using namespace dolfin;
+
+namespace
+{
+  // Check that the global indices of entities of dimension d are a
+  // numbering of the entities of the serial mesh, which agrees
+  // between processes and with the sharing processes of each entity
+  void check_numbering(const Mesh& mesh, const Mesh& serial_mesh,
+                       std::size_t d)
+  {
+    const MPI_Comm comm = mesh.mpi_comm();
+    const std::size_t rank = dolfin::MPI::rank(comm);
+    mesh.init_global(d);
+    serial_mesh.init(d);
+    const std::int64_t N = serial_mesh.num_entities(d);
+    CHECK(mesh.num_entities_global(d) == (std::size_t) N);
+
+    // Send (global index, number of processes holding the entity,
+    // sorted global vertex indices) of all local entities
+    const std::size_t n = mesh.type().num_vertices(d);
+    const bool have_shared = mesh.topology().have_shared_entities(d);
+    std::vector<std::int64_t> local_data;
+    for (MeshEntityIterator e(mesh, d, "all"); !e.end(); ++e)
+    {
+      const std::set<unsigned int> sharing = have_shared
+        ? e->sharing_processes() : std::set<unsigned int>();
+      CHECK(sharing.count(rank) == 0);
+      local_data.push_back(e->global_index());
+      local_data.push_back(sharing.size() + 1);
+      std::vector<std::int64_t> vertices;
+      for (VertexIterator v(*e); !v.end(); ++v)
+        vertices.push_back(v->global_index());
+      std::sort(vertices.begin(), vertices.end());
+      local_data.insert(local_data.end(), vertices.begin(), vertices.end());
+    }
+    std::vector<std::vector<std::int64_t>> data;
+    dolfin::MPI::all_gather(comm, local_data, data);
+
+    std::vector<std::vector<std::int64_t>> keys(N);
+    std::vector<std::int64_t> copies(N, 0), num_processes(N, 0);
+    std::map<std::vector<std::int64_t>, std::int64_t> index;
+    for (auto& d_p : data)
+    {
+      for (std::size_t i = 0; i < d_p.size(); i += n + 2)
+      {
+        const std::int64_t gi = d_p[i];
+        REQUIRE(gi >= 0);
+        REQUIRE(gi < N);
+        const std::vector<std::int64_t> key(d_p.begin() + i + 2,
+                                            d_p.begin() + i + 2 + n);
+        if (keys[gi].empty())
+          keys[gi] = key;
+        CHECK(keys[gi] == key);
+        auto it = index.insert({key, gi}).first;
+        CHECK(it->second == gi);
+        ++copies[gi];
+        num_processes[gi] = d_p[i + 1];
+      }
+    }
+
+    // Every index is used, by each process holding the entity
+    CHECK(index.size() == (std::size_t) N);
+    CHECK(copies == num_processes);
+  }
+}
+
+TEST_CASE("Distributed entity numbering")
+{
+  for (std::string ghost_mode : {"none", "shared_facet", "shared_vertex"})
+  {
+    parameters["ghost_mode"] = ghost_mode;
+
+    UnitCubeMesh mesh3(MPI_COMM_WORLD, 6, 5, 4);
+    UnitCubeMesh serial_mesh3(MPI_COMM_SELF, 6, 5, 4);
+    for (std::size_t d : {1, 2})
+      check_numbering(mesh3, serial_mesh3, d);
+
+    UnitSquareMesh mesh2(MPI_COMM_WORLD, 7, 6, "crossed");
+    UnitSquareMesh serial_mesh2(MPI_COMM_SELF, 7, 6, "crossed");
+    check_numbering(mesh2, serial_mesh2, 1);
+  }
+  parameters["ghost_mode"] = "none";
+}
@@ -17,7 +17,9 @@
 //
 // Unit tests for the mesh library
 
+#include <atomic>
 #include <dolfin.h>
+#include <dolfin/common/threads.h>
 #include <catch.hpp>
 
 using namespace dolfin;
@@ -142,6 +144,47 @@ TEST_CASE("Mesh iterators")
     CHECK(n == 4*mesh.num_cells());
   }
 
+  SECTION("Test entity ranges")
+  {
+    // Iterate over vertices of cells by index
+    UnitCubeMesh mesh(5, 5, 5);
+    const EntityRange cells(mesh, mesh.topology().dim());
+    const MeshConnectivity& cell_vertices = cells.connectivity(0);
+    std::vector<double> coordinate_dofs, coordinate_dofs_cell;
+    unsigned int n = 0;
+    for (std::size_t c : cells)
+    {
+      n += cell_vertices.size(c);
+      cells.get_coordinate_dofs(c, cell_vertices, coordinate_dofs);
+      Cell(mesh, c).get_coordinate_dofs(coordinate_dofs_cell);
+      CHECK(coordinate_dofs == coordinate_dofs_cell);
+    }
+
+    CHECK(n == 4*mesh.num_cells());
+
+    // Creating the range computes the edges
+    const EntityRange edges(mesh, 1);
+    CHECK(edges.size() == mesh.num_edges());
+
+    // Random access iteration
+    const EntityRange::iterator first = cells.begin();
+    const EntityRange::iterator last = cells.end();
+    CHECK((std::size_t) std::distance(first, last) == mesh.num_cells());
+    CHECK(first[7] == 7);
+    CHECK(*(first + 7) == 7);
+    CHECK(*(7 + first) == 7);
+    CHECK(*(last - 1) == mesh.num_cells() - 1);
+    CHECK(first < last);
+    CHECK(last >= first);
+    CHECK(*std::lower_bound(first, last, 100) == 100);
+    typedef std::reverse_iterator<EntityRange::iterator> reverse_iterator;
+    const std::vector<std::size_t> reversed(reverse_iterator{last},
+                                            reverse_iterator{first});
+    CHECK(reversed.size() == mesh.num_cells());
+    CHECK(reversed.front() == mesh.num_cells() - 1);
+    CHECK(reversed.back() == 0);
+  }
+
   SECTION("Test boundary computation")
   {
     // Compute boundary of mesh
@@ -250,3 +293,96 @@ TEST_CASE("PyCCInterface")
     CHECK(mesh.topology().size(2) == (std::size_t) 50);
   }
 }
+
+TEST_CASE("Threaded topology computation")
+{
+  // Connectivity computed with several threads, while accesses are
+  // recorded for a memory budget, must match the serial result. Run
+  // under ThreadSanitizer to detect data races on the topology.
+  const int num_threads = parameters["num_threads"];
+
+  parameters["num_threads"] = 1;
+  UnitCubeMesh mesh0(MPI_COMM_SELF, 6, 6, 6);
+  mesh0.init(1, 2);
+  mesh0.init(2, 3);
+  mesh0.init(0, 3);
+
+  parameters["num_threads"] = 4;
+  UnitCubeMesh mesh1(MPI_COMM_SELF, 6, 6, 6);
+  mesh1.topology().set_memory_budget(std::size_t(1) << 30);
+  mesh1.init(1, 2);
+  mesh1.init(2, 3);
+  mesh1.init(0, 3);
+
+  // Iterate concurrently over entities of cells, which calls
+  // Mesh::init from each thread
+  std::atomic<bool> equal(true);
+  parallel_for(4, mesh1.num_cells(),
+               [&](std::size_t, std::size_t begin, std::size_t end)
+               {
+                 for (std::size_t c = begin; c < end; ++c)
+                 {
+                   const Cell cell0(mesh0, c);
+                   const Cell cell1(mesh1, c);
+                   for (std::size_t d = 0; d < 3; ++d)
+                   {
+                     MeshEntityIterator e0(cell0, d);
+                     MeshEntityIterator e1(cell1, d);
+                     for (; !e0.end(); ++e0, ++e1)
+                     {
+                       if (e1.end() or e0->index() != e1->index())
+                         equal = false;
+                     }
+                   }
+                 }
+               });
+  parameters["num_threads"] = num_threads;
+
+  CHECK(equal);
+  for (std::size_t d0 = 0; d0 <= 3; ++d0)
+  {
+    CHECK(mesh1.num_entities(d0) == mesh0.num_entities(d0));
+    for (std::size_t d1 = 0; d1 <= 3; ++d1)
+    {
+      const MeshConnectivity& c0 = mesh0.topology()(d0, d1);
+      const MeshConnectivity& c1 = mesh1.topology()(d0, d1);
+      CHECK(c1.size() == c0.size());
+      CHECK(c1() == c0());
+    }
+  }
+}
+
+TEST_CASE("Memory budget with nested iterators")
+{
+  // Nested iterators call Mesh::init while the outer iterators hold
+  // references to connectivity, so nothing may be evicted until the
+  // budget is enforced explicitly
+  UnitCubeMesh mesh0(MPI_COMM_SELF, 3, 3, 3);
+  UnitCubeMesh mesh1(MPI_COMM_SELF, 3, 3, 3);
+  mesh1.topology().set_memory_budget(1);
+
+  auto count = [](const Mesh& mesh)
+  {
+    std::size_t sum = 0;
+    for (VertexIterator v(mesh); !v.end(); ++v)
+      for (EdgeIterator e(*v); !e.end(); ++e)
+        for (FaceIterator f(*e); !f.end(); ++f)
+          sum += v->index() + e->index() + f->index();
+    return sum;
+  };
+
+  const std::size_t sum = count(mesh0);
+  CHECK(count(mesh1) == sum);
+  CHECK(!mesh1.topology()(0, 1).empty());
+  CHECK(!mesh1.topology()(1, 2).empty());
+
+  // Enforcing the budget evicts connectivity, which is recomputed on
+  // demand
+  const std::size_t bytes = mesh1.topology().memory_usage();
+  CHECK(mesh1.topology().enforce_memory_budget() > 0);
+  CHECK(mesh1.topology().memory_usage() < bytes);
+  CHECK(mesh1.topology()(0, 1).empty());
+  CHECK(mesh1.topology()(1, 2).empty());
+  CHECK(!mesh1.topology()(3, 0).empty());
+  CHECK(count(mesh1) == sum);
+}
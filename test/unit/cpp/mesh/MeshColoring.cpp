@@ -56,4 +56,94 @@ TEST_CASE("MeshColoring")
     const MeshFunction<std::size_t> colors_vertex_2
       = MeshColoring::cell_colors(mesh, coloring_type);
   }
+
+  SECTION("speculative coloring computation")
+  {
+    UnitCubeMesh mesh(MPI_COMM_SELF, 12, 12, 12);
+    const std::size_t D = mesh.topology().dim();
+    const Graph graph = GraphBuilder::local_graph(mesh, D, 0);
+    const CSRGraph<std::int32_t> csr_graph(MPI_COMM_SELF, graph);
+
+    for (std::size_t num_threads : {1, 4})
+    {
+      parameters["num_threads"] = (int) num_threads;
+      for (std::size_t distance : {1, 2})
+      {
+        for (bool balance : {false, true})
+        {
+          std::vector<std::size_t> colors;
+          const std::size_t num_colors
+            = GraphColoring::compute_speculative_vertex_coloring(
+              csr_graph, colors, distance, balance);
+          REQUIRE(colors.size() == graph.size());
+
+          // Check that vertices within the distance have different
+          // colors and that all colors are used
+          REQUIRE(*std::max_element(colors.begin(), colors.end())
+                  < num_colors);
+          std::size_t num_conflicts = 0;
+          std::vector<std::size_t> class_sizes(num_colors, 0);
+          for (std::size_t v = 0; v < graph.size(); ++v)
+          {
+            ++class_sizes[colors[v]];
+            for (auto u : graph[v])
+            {
+              if ((std::size_t) u != v and colors[u] == colors[v])
+                ++num_conflicts;
+              if (distance == 1)
+                continue;
+              for (auto w : graph[u])
+              {
+                if ((std::size_t) w != v and colors[w] == colors[v])
+                  ++num_conflicts;
+              }
+            }
+          }
+          CHECK(num_conflicts == 0);
+          CHECK(*std::min_element(class_sizes.begin(), class_sizes.end()) > 0);
+          if (balance)
+          {
+            const std::size_t target = (graph.size() + num_colors - 1)/num_colors;
+            CHECK(*std::max_element(class_sizes.begin(), class_sizes.end())
+                  <= 2*target);
+          }
+        }
+      }
+    }
+    parameters["num_threads"] = 1;
+
+    // Distance-2 coloring of the cell-facet graph is a valid coloring
+    // of the distance-2 mesh graph
+    parameters["graph_coloring_library"] = "DOLFIN";
+    const std::vector<std::size_t> coloring_type = {D, D - 1, D, D - 1, D};
+    std::vector<std::size_t> colors(mesh.num_cells());
+    MeshColoring::compute_colors(mesh, colors, coloring_type);
+    const Graph graph2 = GraphBuilder::local_graph(mesh, coloring_type);
+    std::size_t num_conflicts = 0;
+    for (std::size_t v = 0; v < graph2.size(); ++v)
+    {
+      for (auto u : graph2[v])
+      {
+        if ((std::size_t) u != v and colors[u] == colors[v])
+          ++num_conflicts;
+      }
+    }
+    CHECK(num_conflicts == 0);
+
+    // Cells sharing a facet (colored through the dual graph) have
+    // different colors
+    MeshColoring::compute_colors(mesh, colors, {D, D - 1, D});
+    const Graph graph1 = GraphBuilder::local_graph(mesh, D, D - 1);
+    num_conflicts = 0;
+    for (std::size_t v = 0; v < graph1.size(); ++v)
+    {
+      for (auto u : graph1[v])
+      {
+        if ((std::size_t) u != v and colors[u] == colors[v])
+          ++num_conflicts;
+      }
+    }
+    CHECK(num_conflicts == 0);
+    parameters["graph_coloring_library"] = "Boost";
+  }
 }
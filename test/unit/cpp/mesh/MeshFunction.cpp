@@ -75,4 +75,63 @@ TEST_CASE("MeshFunctions")
         CHECK(mf[i] == i);
     }
   }
+
+  SECTION("Test compressed storage")
+  {
+    auto mesh = std::make_shared<UnitCubeMesh>(4, 4, 4);
+    const std::size_t D = mesh->topology().dim();
+
+    // Mark a few runs of facets
+    MeshFunction<int> mf(mesh, D - 1, 0);
+    for (std::size_t i = 10; i < 20; ++i)
+      mf[i] = 3;
+    mf[20] = 4;
+    mf[mf.size() - 1] = 5;
+    std::vector<int> dense;
+    mf.get_values(dense);
+
+    mf.compress(0);
+    CHECK(mf.compressed());
+    CHECK(mf.runs().size() == 3);
+    CHECK(mf.runs()[0].begin == 10);
+    CHECK(mf.runs()[0].end == 20);
+
+    // Check lookup through const access
+    const MeshFunction<int>& cmf = mf;
+    for (std::size_t i = 0; i < mf.size(); ++i)
+      CHECK(cmf[i] == dense[i]);
+
+    // Set values, splitting and merging runs
+    mf.set_value(15, 0);
+    mf.set_value(20, 3);
+    mf.set_value(21, 3);
+    mf.set_value(0, 7);
+    dense[15] = 0;
+    dense[20] = 3;
+    dense[21] = 3;
+    dense[0] = 7;
+    CHECK(mf.compressed());
+    CHECK(mf.runs().size() == 4);
+    std::vector<int> values;
+    mf.get_values(values);
+    CHECK(values == dense);
+    CHECK(mf.where_equal(3).size() == 11);
+    CHECK(mf.where_equal(0).size() == mf.size() - 13);
+
+    // Non-const access requires explicit decompression
+    MeshFunction<int> mf2(mf);
+    CHECK(mf2.compressed());
+    CHECK_THROWS(mf2[1] = 8);
+    CHECK_THROWS(mf2.values());
+    CHECK(mf2.compressed());
+    mf2.decompress();
+    mf2[1] = 8;
+    CHECK(mf2[0] == 7);
+    CHECK(mf2[1] == 8);
+
+    mf.decompress();
+    CHECK(!mf.compressed());
+    for (std::size_t i = 0; i < mf.size(); ++i)
+      CHECK(mf[i] == dense[i]);
+  }
 }
@@ -162,4 +162,64 @@ TEST_CASE("MeshValueCollections")
         CHECK(25 == g.get_value(cell->index(), i));
     }
   }
+
+  SECTION("Test set values in bulk")
+  {
+    auto mesh = std::make_shared<UnitSquareMesh>(3, 3);
+    mesh->init(1);
+    const std::size_t nfacets = mesh->num_facets();
+
+    // Set values for facets in reverse order, then overwrite half
+    MeshValueCollection<int> f(mesh, 1);
+    MeshValueCollection<int> g(mesh, 1);
+    std::vector<std::size_t> indices;
+    std::vector<int> values;
+    for (std::size_t i = nfacets; i-- > 0; )
+    {
+      f.set_value(i, i);
+      indices.push_back(i);
+      values.push_back(i);
+    }
+    for (std::size_t i = 0; i < nfacets; i += 2)
+    {
+      f.set_value(i, 100 + i);
+      indices.push_back(i);
+      values.push_back(100 + i);
+    }
+    g.set_values(indices, values);
+
+    CHECK(f.size() == nfacets);
+    CHECK(g.size() == nfacets);
+    auto it = f.values().begin();
+    for (const auto& v : g.values())
+    {
+      CHECK(v.first == it->first);
+      CHECK(v.second == it->second);
+      ++it;
+    }
+
+    // Check conversion to MeshFunction
+    MeshFunction<int> mf(mesh, g);
+    for (std::size_t i = 0; i < nfacets; ++i)
+      CHECK(mf[i] == (int) (i % 2 == 0 ? 100 + i : i));
+  }
+
+  SECTION("Test std::map interface of values")
+  {
+    auto mesh = std::make_shared<UnitSquareMesh>(3, 3);
+    MeshValueCollection<int> f(mesh, 2);
+    for (std::size_t c = 0; c < mesh->num_cells(); c += 3)
+      f.set_value(c, 0, c);
+
+    const std::map<std::pair<std::size_t, std::size_t>, int> m = f.values();
+    CHECK(m.size() == f.size());
+    for (const auto& v : m)
+      CHECK(f.values().at(v.first) == v.second);
+    CHECK_THROWS_AS(f.values().at({1, 0}), std::out_of_range);
+
+    CHECK(f.values().erase({3, 0}) == 1);
+    CHECK(f.values().erase({3, 0}) == 0);
+    CHECK(f.size() == m.size() - 1);
+    CHECK(f.values().count({6, 0}) == 1);
+  }
 }
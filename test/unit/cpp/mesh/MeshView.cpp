@@ -0,0 +1,57 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Unit tests for MeshView
+
+#include <memory>
+#include <vector>
+#include <dolfin.h>
+#include <catch.hpp>
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+TEST_CASE("MeshView without a new Mesh")
+{
+  auto mesh = std::make_shared<UnitCubeMesh>(MPI_COMM_SELF, 3, 3, 3);
+  mesh->init(1);
+  std::vector<std::size_t> edges;
+  for (std::size_t e = 0; e < mesh->num_edges(); e += 4)
+    edges.push_back(e);
+
+  auto view = MeshView::create_view(mesh, 1, edges);
+  CHECK(view->dim() == 1);
+  CHECK(view->num_cells() == edges.size());
+  CHECK(view->cell_map() == edges);
+
+  // Coordinates and cell vertices are those stored by the parent mesh
+  const auto& vertex_map = view->vertex_map();
+  for (std::size_t v = 0; v < view->num_vertices(); ++v)
+    CHECK(view->x(v) == mesh->geometry().x(vertex_map[v]));
+  for (std::size_t c = 0; c < view->num_cells(); ++c)
+  {
+    const unsigned int* v = view->parent_cell_vertices(c);
+    CHECK(v == mesh->topology()(1, 0)(edges[c]));
+    const unsigned int* w = view->cell_vertices(c);
+    for (std::size_t i = 0; i < 2; ++i)
+      CHECK(vertex_map[w[i]] == v[i]);
+  }
+
+  // Same numbering as a view built as a new Mesh
+  Mesh submesh = MeshView::create(mesh, 1, edges);
+  CHECK(submesh.topology().mapping()[mesh->id()]->vertex_map() == vertex_map);
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2026 The FEniCS Project
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Unit tests for PeriodicBoundaryComputation
+
+#include <dolfin.h>
+#include <catch.hpp>
+
+using namespace dolfin;
+
+namespace
+{
+  // Periodic in the x-direction on the unit square
+  class PeriodicBoundary : public SubDomain
+  {
+    bool inside(const Array<double>& x, bool on_boundary) const
+    { return x[0] < DOLFIN_EPS; }
+
+    void map(const Array<double>& x, Array<double>& y) const
+    {
+      y[0] = x[0] - 1.0;
+      y[1] = x[1];
+    }
+  };
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("Cached periodic pairs")
+{
+  const PeriodicBoundary periodic_boundary;
+
+  // Meshes with the same vertices, where one has a hole near the
+  // bottom boundary and so different edge numbering
+  Mesh mesh = UnitSquareMesh(MPI_COMM_SELF, 4, 4);
+  Mesh other(MPI_COMM_SELF);
+  MeshEditor editor;
+  editor.open(other, "triangle", 2, 2);
+  editor.init_vertices(mesh.num_vertices());
+  for (std::size_t v = 0; v < mesh.num_vertices(); ++v)
+    editor.add_vertex(v, mesh.geometry().point(v));
+  std::vector<std::vector<std::size_t>> cells;
+  for (CellIterator c(mesh); !c.end(); ++c)
+  {
+    const Point p = c->midpoint();
+    if (p.x() < 0.25 or p.x() > 0.5 or p.y() > 0.25)
+      cells.push_back({c->entities(0)[0], c->entities(0)[1], c->entities(0)[2]});
+  }
+  editor.init_cells(cells.size());
+  for (std::size_t c = 0; c < cells.size(); ++c)
+    editor.add_cell(c, cells[c]);
+  editor.close();
+
+  const auto other_pairs
+    = PeriodicBoundaryComputation::compute_periodic_pairs(other,
+                                                          periodic_boundary, 1);
+  CHECK(other_pairs.size() == 4);
+
+  const auto pairs
+    = PeriodicBoundaryComputation::compute_periodic_pairs(mesh,
+                                                          periodic_boundary, 1);
+  CHECK(PeriodicBoundaryComputation::compute_periodic_pairs(mesh,
+          periodic_boundary, 1) == pairs);
+  CHECK(pairs != other_pairs);
+
+  // Pairs cached for the old topology are not reused after assignment
+  mesh = other;
+  CHECK(PeriodicBoundaryComputation::compute_periodic_pairs(mesh,
+          periodic_boundary, 1) == other_pairs);
+
+  // Pairs of SubDomains created in a loop, which evict the entries
+  // of earlier SubDomains from the cache, are unchanged
+  for (std::size_t i = 0; i < 40; ++i)
+  {
+    const PeriodicBoundary sub_domain;
+    CHECK(PeriodicBoundaryComputation::compute_periodic_pairs(mesh,
+            sub_domain, 1) == other_pairs);
+  }
+  CHECK(PeriodicBoundaryComputation::compute_periodic_pairs(mesh,
+          periodic_boundary, 1) == other_pairs);
+}